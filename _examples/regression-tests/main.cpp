@@ -10,6 +10,8 @@ extern bool regSugiyama();
 extern bool regPlanarityTest();
 extern bool regSteinerTree();
 extern bool regLCA();
+extern bool regMinCostFlow();
+extern bool regLPSolver();
 
 struct regTest {
 	const char *what;
@@ -37,12 +39,13 @@ static struct regTest regTests[] = {
 		"Sugiyama layout",
 		"SugiyamaLayout, LongestPathRanking, OptimalRanking,\n"
 		"       BarycenterHeuristic, MedianHeuristic,\n"
-		"       FastHierarchyLayout, OptimalHierarchyLayout",
+		"       FastHierarchyLayout, OptimalHierarchyLayout,\n"
+		"       NetworkSimplexRanking",
 		regSugiyama,
 	},
 	{
 		"planarity testing and embedding",
-		"BoothLueker, BoyerMyrvold",
+		"BoothLueker, BoyerMyrvold, IncrementalPlanarityTest",
 		regPlanarityTest
 	},
 	{
@@ -55,6 +58,16 @@ static struct regTest regTests[] = {
 		"LCA",
 		regLCA
 	},
+	{
+		"min-cost flow algorithms",
+		"MinCostFlowReinelt, MinCostFlowNetworkSimplex, MinCostFlowCostScaling",
+		regMinCostFlow
+	},
+	{
+		"LP solver",
+		"LPSolver (sessions with added and removed rows)",
+		regLPSolver
+	},
 	{ NULL, NULL, NULL }
 };
 
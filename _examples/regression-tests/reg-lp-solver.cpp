@@ -0,0 +1,228 @@
+//*********************************************************
+//  Regression test for LPSolver
+//
+//  Tested classes:
+//    - LPSolver
+//*********************************************************
+
+#include <ogdf/basic/List.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/lpsolver/LPSolver.h>
+
+using namespace ogdf;
+
+#ifdef OGDF_LP_SOLVER
+
+// a constraint sum(value[j] * x[index[j]]) (sense) rhs
+struct LPRow {
+	Array<int>    index;
+	Array<double> value;
+	char          sense;
+	double        rhs;
+};
+
+// creates a random row with non-negative coefficients; x = 0 satisfies all rows
+static void randomRow(LPRow &row, int numCols)
+{
+	int nnz = randomNumber(1, min(numCols, 6));
+	row.index.init(nnz);
+	row.value.init(nnz);
+
+	// distinct columns: the first nnz of a random permutation
+	Array<int> perm(numCols);
+	for (int j = 0; j < numCols; ++j)
+		perm[j] = j;
+	for (int k = 0; k < nnz; ++k) {
+		swap(perm[k], perm[randomNumber(k, numCols-1)]);
+		row.index[k] = perm[k];
+		row.value[k] = randomNumber(1, 9);
+	}
+	row.sense = 'L';
+	row.rhs   = randomNumber(5, 50);
+}
+
+// solves the LP given by the rows and columns from scratch
+static LPSolver::Status solveFresh(
+	const List<LPRow> &rows,
+	Array<double> &obj,
+	Array<double> &lowerBound,
+	Array<double> &upperBound,
+	double &optimum,
+	Array<double> &x)
+{
+	const int numCols = obj.size();
+	const int numRows = rows.size();
+
+	Array<int> count(0, numCols-1, 0);
+	int numNonzeroes = 0;
+	ListConstIterator<LPRow> it;
+	for (it = rows.begin(); it.valid(); ++it) {
+		for (int k = 0; k < (*it).index.size(); ++k)
+			++count[(*it).index[k]];
+		numNonzeroes += (*it).index.size();
+	}
+
+	Array<int> matrixBegin(numCols), matrixCount(numCols), next(numCols);
+	int sum = 0;
+	for (int j = 0; j < numCols; ++j) {
+		matrixBegin[j] = next[j] = sum;
+		matrixCount[j] = count[j];
+		sum += count[j];
+	}
+
+	Array<int>    matrixIndex(numNonzeroes);
+	Array<double> matrixValue(numNonzeroes);
+	Array<double> rightHandSide(numRows);
+	Array<char>   equationSense(numRows);
+
+	int i = 0;
+	for (it = rows.begin(); it.valid(); ++it, ++i) {
+		const LPRow &row = *it;
+		for (int k = 0; k < row.index.size(); ++k) {
+			int pos = next[row.index[k]]++;
+			matrixIndex[pos] = i;
+			matrixValue[pos] = row.value[k];
+		}
+		rightHandSide[i] = row.rhs;
+		equationSense[i] = row.sense;
+	}
+
+	LPSolver solver;
+	x.init(numCols);
+	return solver.optimize(LPSolver::lpMaximize, obj, matrixBegin, matrixCount, matrixIndex, matrixValue,
+		rightHandSide, equationSense, lowerBound, upperBound, optimum, x);
+}
+
+// changes an LP session by adding and removing rows and by changing bounds,
+// objective and right-hand sides; after each round, the optimum of resolve()
+// must equal the optimum of a fresh solve
+static bool testSession(int numCols, int numRows, int rounds)
+{
+	cout << "-> " << numCols << " columns, " << numRows << " rows, " << rounds << " rounds... " << endl;
+
+	Array<double> obj(numCols), lowerBound(numCols), upperBound(numCols);
+	for (int j = 0; j < numCols; ++j) {
+		obj[j] = randomNumber(1, 10);
+		lowerBound[j] = 0;
+		upperBound[j] = randomNumber(1, 20);
+	}
+
+	List<LPRow> rows;
+	for (int i = 0; i < numRows; ++i)
+		randomRow(*rows.pushBack(LPRow()), numCols);
+
+	// the initial session is loaded from an empty matrix, all rows are added afterwards
+	LPSolver session;
+	Array<int> matrixBegin(0, numCols-1, 0), matrixCount(0, numCols-1, 0), matrixIndex(0);
+	Array<double> matrixValue(0), rightHandSide(0);
+	Array<char> equationSense(0);
+	session.loadProblem(LPSolver::lpMaximize, obj, matrixBegin, matrixCount, matrixIndex, matrixValue,
+		rightHandSide, equationSense, lowerBound, upperBound);
+
+	ListConstIterator<LPRow> it;
+	for (it = rows.begin(); it.valid(); ++it)
+		session.addRow((*it).index, (*it).value, (*it).sense, (*it).rhs);
+
+	for (int r = 0; r <= rounds; ++r) {
+		if (r > 0) {
+			// remove some rows
+			ArrayBuffer<int> removed;
+			int i = 0;
+			ListIterator<LPRow> itNext;
+			for (ListIterator<LPRow> itRow = rows.begin(); itRow.valid(); itRow = itNext, ++i) {
+				itNext = itRow.succ();
+				if (randomNumber(0, 9) == 0) {
+					removed.push(i);
+					rows.del(itRow);
+				}
+			}
+			Array<int> removedRows;
+			removed.compactCopy(removedRows);
+			session.removeRows(removedRows);
+
+			// add some rows
+			for (int k = randomNumber(0, numRows/10); k > 0; --k) {
+				LPRow &row = *rows.pushBack(LPRow());
+				randomRow(row, numCols);
+				if (session.addRow(row.index, row.value, row.sense, row.rhs) != rows.size()-1) {
+					cout << "    addRow() returned a wrong index!" << endl;
+					return false;
+				}
+			}
+
+			// change right-hand sides, bounds and objective coefficients
+			i = 0;
+			for (ListIterator<LPRow> itRow = rows.begin(); itRow.valid(); ++itRow, ++i) {
+				if (randomNumber(0, 9) == 0) {
+					(*itRow).rhs = randomNumber(5, 50);
+					session.setRow(i, (*itRow).sense, (*itRow).rhs);
+				}
+			}
+			for (int j = 0; j < numCols; ++j) {
+				if (randomNumber(0, 9) == 0) {
+					upperBound[j] = randomNumber(1, 20);
+					session.setColumnBounds(j, lowerBound[j], upperBound[j]);
+				}
+				if (randomNumber(0, 9) == 0) {
+					obj[j] = randomNumber(1, 10);
+					session.setObjective(j, obj[j]);
+				}
+			}
+		}
+
+		if (session.numberOfRows() != rows.size() || session.numberOfColumns() != numCols) {
+			cout << "    the session has " << session.numberOfRows() << " rows instead of " << rows.size() << "!" << endl;
+			return false;
+		}
+
+		double optimum, freshOptimum;
+		Array<double> x, freshX;
+		LPSolver::Status status = session.resolve(optimum, x);
+		LPSolver::Status freshStatus = solveFresh(rows, obj, lowerBound, upperBound, freshOptimum, freshX);
+
+		if (status != LPSolver::lpOptimal || freshStatus != LPSolver::lpOptimal) {
+			cout << "    no optimum found in round " << r << "!" << endl;
+			return false;
+		}
+		if (fabs(optimum - freshOptimum) > 1e-6 * max(1.0, fabs(freshOptimum))) {
+			cout << "    resolve() computed " << optimum << " instead of " << freshOptimum
+				<< " in round " << r << "!" << endl;
+			return false;
+		}
+
+		// the solution of resolve() must satisfy the current rows and bounds
+		for (it = rows.begin(); it.valid(); ++it) {
+			double activity = 0;
+			for (int k = 0; k < (*it).index.size(); ++k)
+				activity += (*it).value[k] * x[(*it).index[k]];
+			if (activity > (*it).rhs + 1e-6) {
+				cout << "    resolve() computed an infeasible solution in round " << r << "!" << endl;
+				return false;
+			}
+		}
+		for (int j = 0; j < numCols; ++j) {
+			if (x[j] < lowerBound[j] - 1e-6 || x[j] > upperBound[j] + 1e-6) {
+				cout << "    resolve() violated the bounds of column " << j << " in round " << r << "!" << endl;
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
+
+
+bool regLPSolver()
+{
+#ifdef OGDF_LP_SOLVER
+	srand(4711);
+	return testSession(10,  20,   20)
+	    && testSession(100, 200,  20)
+	    && testSession(500, 1000, 10);
+#else
+	cout << "-> no LP solver available, nothing to test" << endl;
+	return true;
+#endif
+}
@@ -0,0 +1,208 @@
+//**************************************************************
+//  regression test for min-cost flow algorithms
+//**************************************************************
+
+#include <ogdf/graphalg/MinCostFlowReinelt.h>
+#include <ogdf/graphalg/MinCostFlowNetworkSimplex.h>
+#include <ogdf/graphalg/MinCostFlowCostScaling.h>
+#include <ogdf/basic/graph_generators.h>
+
+using namespace ogdf;
+
+// creates a random feasible problem: a random graph together with a
+// bidirected cycle of expensive edges with unbounded capacity
+static void
+generateFeasibleProblem(
+	Graph &G,
+	int n,
+	int m,
+	EdgeArray<int> &lowerBound,
+	EdgeArray<int> &upperBound,
+	EdgeArray<int> &cost,
+	NodeArray<int> &supply)
+{
+	randomGraph(G, n, m);
+
+	Array<node> nodes(n);
+	int i = 0;
+	node v;
+	forall_nodes(v, G)
+		nodes[i++] = v;
+
+	lowerBound.init(G, 0);
+	upperBound.init(G);
+	cost.init(G);
+	supply.init(G);
+
+	edge e;
+	forall_edges(e, G) {
+		upperBound[e] = randomNumber(1, 10);
+		cost[e] = randomNumber(-10, 100);
+		if (randomNumber(0, 3) == 0)
+			lowerBound[e] = randomNumber(0, upperBound[e]);
+	}
+	for (i = 0; i < n; ++i) {
+		edge e1 = G.newEdge(nodes[i], nodes[(i + 1) % n]);
+		edge e2 = G.newEdge(nodes[(i + 1) % n], nodes[i]);
+		lowerBound[e1] = lowerBound[e2] = 0;
+		upperBound[e1] = upperBound[e2] = numeric_limits<int>::max();
+		cost[e1] = cost[e2] = 200;
+	}
+
+	int sum = 0;
+	forall_nodes(v, G)
+		sum += (supply[v] = randomNumber(-5, 5));
+	supply[G.firstNode()] -= sum;
+}
+
+// checks the complementary slackness conditions for the computed duals
+static bool
+checkDuals(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const EdgeArray<int> &flow,
+	const NodeArray<int> &dual)
+{
+	edge e;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+		int reducedCost = cost[e] - dual[e->source()] + dual[e->target()];
+		if ((flow[e] < upperBound[e] && reducedCost < 0) || (flow[e] > lowerBound[e] && reducedCost > 0))
+			return false;
+	}
+	return true;
+}
+
+static bool
+testMinCostFlow(int n, int m, int count, bool withReinelt = true)
+{
+	const char *names[] = { "MinCostFlowReinelt", "MinCostFlowNetworkSimplex", "MinCostFlowCostScaling" };
+	MinCostFlowReinelt reinelt;
+	MinCostFlowNetworkSimplex simplex;
+	MinCostFlowCostScaling scaling;
+	MinCostFlowModule *modules[] = { &reinelt, &simplex, &scaling };
+	__int64 times[] = { 0, 0, 0 };
+
+	cout << "-> " << count << " random problems with " << n << " nodes and " << m + 2*n << " edges\n";
+
+	for (int i = 0; i < count; ++i) {
+		Graph G;
+		EdgeArray<int> lowerBound, upperBound, cost;
+		NodeArray<int> supply;
+		generateFeasibleProblem(G, n, m, lowerBound, upperBound, cost, supply);
+
+		int optimum = 0;
+		for (int k = withReinelt ? 0 : 1; k < 3; ++k) {
+			EdgeArray<int> flow(G);
+			NodeArray<int> dual(G);
+
+			__int64 time;
+			System::usedRealTime(time);
+			bool feasible = modules[k]->call(G, lowerBound, upperBound, cost, supply, flow, dual);
+			times[k] += System::usedRealTime(time);
+
+			int value;
+			if (!feasible
+			 || !MinCostFlowModule::checkComputedFlow(G, lowerBound, upperBound, cost, supply, flow, value)
+			 || !checkDuals(G, lowerBound, upperBound, cost, flow, dual))
+			{
+				cout << "    " << names[k] << " computed an infeasible flow or wrong duals!\n";
+				return false;
+			}
+			if (k > (withReinelt ? 0 : 1) && value != optimum) {
+				cout << "    " << names[k] << " computed a flow of cost " << value << " instead of " << optimum << "!\n";
+				return false;
+			}
+			optimum = value;
+		}
+	}
+
+	for (int k = withReinelt ? 0 : 1; k < 3; ++k)
+		cout << "    avg time " << names[k] << " in ms: " << double(times[k]) / count << "\n";
+	return true;
+}
+
+// solves random problems again after changing costs or bounds in place, starting
+// from the previous solution; the costs must equal those of a solution from scratch
+static bool
+testWarmStart(int n, int m, int count)
+{
+	const char *names[] = { "MinCostFlowReinelt", "MinCostFlowNetworkSimplex", "MinCostFlowCostScaling" };
+	MinCostFlowReinelt reinelt;
+	MinCostFlowNetworkSimplex simplex;
+	MinCostFlowCostScaling scaling;
+	MinCostFlowModule *modules[] = { &reinelt, &simplex, &scaling };
+
+	cout << "-> warm starts after changing costs or bounds, " << count << " random problems with "
+		<< n << " nodes and " << m + 2*n << " edges\n";
+
+	for (int i = 0; i < count; ++i) {
+		Graph G;
+		EdgeArray<int> lowerBound, upperBound, cost;
+		NodeArray<int> supply;
+		generateFeasibleProblem(G, n, m, lowerBound, upperBound, cost, supply);
+
+		EdgeArray<int> flow[3];
+		NodeArray<int> dual[3];
+		for (int k = 0; k < 3; ++k) {
+			flow[k].init(G);
+			dual[k].init(G);
+			modules[k]->call(G, lowerBound, upperBound, cost, supply, flow[k], dual[k]);
+		}
+
+		for (int round = 0; round < 5; ++round) {
+			// change costs and bounds of some of the random edges (the cycle keeps the problem feasible)
+			edge e;
+			forall_edges(e, G) {
+				if (upperBound[e] == numeric_limits<int>::max() || randomNumber(0, 9) != 0)
+					continue;
+				if (randomNumber(0, 1) == 0)
+					cost[e] = randomNumber(-10, 100);
+				else {
+					upperBound[e] = randomNumber(1, 10);
+					lowerBound[e] = (randomNumber(0, 3) == 0) ? randomNumber(0, upperBound[e]) : 0;
+				}
+			}
+
+			EdgeArray<int> coldFlow(G);
+			NodeArray<int> coldDual(G);
+			reinelt.call(G, lowerBound, upperBound, cost, supply, coldFlow, coldDual);
+			int optimum;
+			MinCostFlowModule::checkComputedFlow(G, lowerBound, upperBound, cost, supply, coldFlow, optimum);
+
+			for (int k = 0; k < 3; ++k) {
+				int value;
+				if (!modules[k]->callWarmStart(G, lowerBound, upperBound, cost, supply, flow[k], dual[k])
+				 || !MinCostFlowModule::checkComputedFlow(G, lowerBound, upperBound, cost, supply, flow[k], value)
+				 || !checkDuals(G, lowerBound, upperBound, cost, flow[k], dual[k]))
+				{
+					cout << "    " << names[k] << " computed an infeasible flow or wrong duals after a warm start!\n";
+					return false;
+				}
+				if (value != optimum) {
+					cout << "    " << names[k] << " computed a flow of cost " << value
+						<< " instead of " << optimum << " after a warm start!\n";
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool
+regMinCostFlow()
+{
+	srand(4711);
+	return testMinCostFlow(10,    20,    1000)
+	    && testMinCostFlow(100,   300,   100)
+	    && testMinCostFlow(1000,  4000,  10)
+	    && testMinCostFlow(10000, 40000, 2)
+	    && testMinCostFlow(20000, 80000, 1, false)
+	    && testWarmStart(10,   20,   200)
+	    && testWarmStart(1000, 4000, 5);
+}
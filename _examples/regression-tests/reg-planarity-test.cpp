@@ -4,6 +4,7 @@
 //  Tested classes:
 //    - BoothLueker
 //    - BoyerMyrvold
+//    - IncrementalPlanarityTest
 //
 //  Author: Carsten Gutwenger
 //*********************************************************
@@ -13,6 +14,7 @@
 #include <ogdf/planarity/BoyerMyrvold.h>
 #include <ogdf/planarity/FastPlanarSubgraph.h>
 #include <ogdf/planarity/MaximalPlanarSubgraphSimple.h>
+#include <ogdf/planarity/IncrementalPlanarityTest.h>
 
 using namespace ogdf;
 
@@ -84,6 +86,69 @@ void addRandomMultiEdges(Graph &G, int add)
 	}
 }
 
+// inserts the edges (src[i],tgt[i]) one by one with IncrementalPlanarityTest and
+// compares each decision with a planarity test of the graph including the edge
+bool checkIncrementalInsertion(
+	Graph &G,
+	const Array<node> &src,
+	const Array<node> &tgt,
+	int &accepted,
+	int &rejected)
+{
+	BoyerMyrvold bm;
+	IncrementalPlanarityTest test(G);
+
+	for(int i = src.low(); i <= src.high(); ++i)
+	{
+		edge e = G.newEdge(src[i],tgt[i]);
+		bool planar = bm.isPlanar(G);
+		G.delEdge(e);
+
+		bool insertable = test.canInsertEdge(src[i],tgt[i]);
+		edge eInserted  = test.insertEdge(src[i],tgt[i]);
+
+		if(insertable != planar || (eInserted != 0) != planar)
+			return false;
+		if(planar) accepted++; else rejected++;
+	}
+
+	return true;
+}
+
+// builds a spanning tree of K5 (resp. K3,3) and inserts the remaining edges;
+// all but the last one must be accepted
+bool checkKuratowskiInsertion(bool k33)
+{
+	Graph G;
+	Array<node> v(6);
+	for(int i = 0; i < (k33 ? 6 : 5); ++i)
+		v[i] = G.newNode();
+
+	Array<node> src, tgt;
+	if(k33) {
+		// v0,v1,v2 and v3,v4,v5 are the two sides
+		G.newEdge(v[0],v[3]); G.newEdge(v[0],v[4]); G.newEdge(v[0],v[5]);
+		G.newEdge(v[1],v[3]); G.newEdge(v[2],v[3]);
+		src.init(4); tgt.init(4);
+		src[0] = v[1]; tgt[0] = v[4];
+		src[1] = v[1]; tgt[1] = v[5];
+		src[2] = v[2]; tgt[2] = v[4];
+		src[3] = v[2]; tgt[3] = v[5];
+	} else {
+		G.newEdge(v[0],v[1]); G.newEdge(v[0],v[2]); G.newEdge(v[0],v[3]); G.newEdge(v[0],v[4]);
+		src.init(6); tgt.init(6);
+		int k = 0;
+		for(int i = 1; i < 5; ++i)
+			for(int j = i+1; j < 5; ++j) {
+				src[k] = v[i]; tgt[k] = v[j]; ++k;
+			}
+	}
+
+	int accepted = 0, rejected = 0;
+	return checkIncrementalInsertion(G, src, tgt, accepted, rejected)
+		&& accepted == src.size()-1 && rejected == 1;
+}
+
 bool regPlanarityTest()
 {
 	const int numGraphs = 10;
@@ -594,6 +659,52 @@ bool regPlanarityTest()
 	cout << "  removed: " << sumDelEdges << " (avg. " << double(sumDelEdges)/ng << ")" << endl;
 	cout << "  fails:   " << fails << endl;
 
+	cout << "-> Incremental planarity test, edge insertions... " << endl;
+	srand(4711);
+
+	fails = 0;
+	if(checkKuratowskiInsertion(false) == false) {
+		cout << "  inserting K5 failed" << endl;
+		fails++;
+	}
+	if(checkKuratowskiInsertion(true) == false) {
+		cout << "  inserting K3,3 failed" << endl;
+		fails++;
+	}
+
+	int accepted = 0, rejected = 0;
+	for(int n = 100; n <= 500; n += 100)
+	{
+		cout << "\r" << n << flush;
+		for(int i = 0; i < numGraphs; ++i)
+		{
+			// a random tree and 3n random edges
+			Array<node> nodes(n);
+			G1.clear();
+			for(int j = 0; j < n; ++j) {
+				nodes[j] = G1.newNode();
+				if(j > 0)
+					G1.newEdge(nodes[randomNumber(0,j-1)], nodes[j]);
+			}
+
+			Array<node> src(3*n), tgt(3*n);
+			for(int j = 0; j < 3*n; ++j) {
+				src[j] = nodes[randomNumber(0,n-1)];
+				tgt[j] = nodes[randomNumber(0,n-1)];
+			}
+
+			if(checkIncrementalInsertion(G1, src, tgt, accepted, rejected) == false)
+				fails++;
+		}
+	}
+
+	if(fails > 0) result = false;
+
+	cout << "\r";
+	cout << "  accepted: " << accepted << endl;
+	cout << "  rejected: " << rejected << endl;
+	cout << "  fails:    " << fails << endl;
+
 	cout << "-> Runtime test: Planar biconnected graphs, planar embedding... " << endl;
 	cout << "   nodes  BL time [errors]  BM time [errors]" << endl;
 	srand(4711);
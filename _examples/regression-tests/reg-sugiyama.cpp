@@ -3,6 +3,7 @@
 //
 //  Tested classes:
 //    - SugiyamaLayout
+//    - NetworkSimplexRanking
 //
 //  Author: Carsten Gutwenger
 //*********************************************************
@@ -14,8 +15,11 @@
 #include <ogdf/layered/OptimalHierarchyLayout.h>
 #include <ogdf/layered/OptimalRanking.h>
 #include <ogdf/layered/LongestPathRanking.h>
+#include <ogdf/layered/NetworkSimplexRanking.h>
 #include <ogdf/layered/GreedyCycleRemoval.h>
 #include <ogdf/layered/DfsAcyclicSubgraph.h>
+#include <ogdf/layered/Hierarchy.h>
+#include <ogdf/basic/GraphCopyAttributes.h>
 
 #include <ogdf/basic/graph_generators.h>
 #include <ogdf/basic/simple_graph_alg.h>
@@ -59,6 +63,256 @@ void createDisconnectedGraph(
 }
 
 
+// returns the total edge length of the ranking, or -1 if an edge is shorter than 1
+static int rankingLength(const Graph &G, const NodeArray<int> &rank)
+{
+	int sum = 0;
+	edge e;
+	forall_edges(e,G) {
+		int len = rank[e->target()] - rank[e->source()];
+		if(len < 1)
+			return -1;
+		sum += len;
+	}
+	return sum;
+}
+
+// inserts an edge between u and v directed by increasing key (keeps G acyclic)
+static void insertAcyclicEdge(Graph &G, const NodeArray<double> &key, node u, node v)
+{
+	if(u == v || G.searchEdge(u,v) != 0)
+		return;
+	if(key[u] < key[v])
+		G.newEdge(u,v);
+	else
+		G.newEdge(v,u);
+}
+
+// checks repeated warm-started calls of NetworkSimplexRanking after inserting nodes
+// and edges; the rankings must be feasible and as short as the optimal ones
+static bool testIncrementalRanking(int n, int rounds)
+{
+	Graph G;
+	NodeArray<double> key(G);
+	Array<node> nodes(0, 2*n, 0);
+	int numNodes = 0;
+
+	for(int i = 0; i < n; ++i) {
+		node v = nodes[numNodes++] = G.newNode();
+		key[v] = randomDouble(0,1);
+	}
+	for(int i = 0; i < 2*n; ++i)
+		insertAcyclicEdge(G, key, nodes[randomNumber(0,numNodes-1)], nodes[randomNumber(0,numNodes-1)]);
+
+	NetworkSimplexRanking incremental, cold;
+	OptimalRanking optimal;
+	NodeArray<int> rank;
+	incremental.call(G, rank);
+
+	for(int r = 0; r < rounds; ++r) {
+		// new nodes with a few incident edges, and some edges between existing nodes
+		for(int i = 0; i < n/rounds && numNodes <= 2*n; ++i) {
+			node v = nodes[numNodes++] = G.newNode();
+			key[v] = randomDouble(0,1);
+			for(int k = randomNumber(0,3); k > 0; --k)
+				insertAcyclicEdge(G, key, v, nodes[randomNumber(0,numNodes-2)]);
+		}
+		for(int i = randomNumber(1,5); i > 0; --i)
+			insertAcyclicEdge(G, key, nodes[randomNumber(0,numNodes-1)], nodes[randomNumber(0,numNodes-1)]);
+
+		incremental.callIncremental(G, rank);
+
+		NodeArray<int> coldRank, optRank;
+		cold.call(G, coldRank);
+		optimal.call(G, optRank);
+
+		int len = rankingLength(G, rank);
+		if(len < 0) {
+			cout << "    NetworkSimplexRanking::callIncremental computed an infeasible ranking!" << endl;
+			return false;
+		}
+		if(len != rankingLength(G, coldRank) || len != rankingLength(G, optRank)) {
+			cout << "    NetworkSimplexRanking::callIncremental computed a ranking of length " << len
+				<< " instead of " << rankingLength(G, optRank) << "!" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+#ifdef OGDF_LP_SOLVER
+
+// inserts an edge from u to v unless it exists already
+static void insertLevelEdge(Graph &G, node u, node v)
+{
+	if(G.searchEdge(u,v) == 0)
+		G.newEdge(u,v);
+}
+
+// appends a connected component to G whose levels start with firstLevel; it consists
+// of numBlocks blocks of numLevels levels with up to width nodes each; consecutive
+// blocks are joined by a long edge, such that the level between them only contains
+// the dummy node of this edge; returns the number of nodes of the component
+static int appendLayeredComponent(
+	Graph &G,
+	GraphAttributes &GA,
+	NodeArray<int> &rank,
+	int firstLevel,
+	int numBlocks,
+	int numLevels,
+	int width)
+{
+	int level = firstLevel, numNodes = 0;
+	node last = 0; // a node on the last level of the previous block
+
+	for(int b = 0; b < numBlocks; ++b, ++level) {
+		Array<node> prev;
+		for(int i = 0; i < numLevels; ++i, ++level) {
+			Array<node> cur(randomNumber((width+1)/2, width));
+			for(int j = 0; j < cur.size(); ++j) {
+				node v = cur[j] = G.newNode();
+				rank[v] = level;
+				GA.width(v)  = randomNumber(5,30);
+				GA.height(v) = randomNumber(5,30);
+			}
+			numNodes += cur.size();
+
+			if(i == 0) {
+				// the nodes on a single level are joined by an adjacent node on the next one
+				if(numLevels == 1)
+					break;
+				if(last != 0)
+					G.newEdge(last, cur[randomNumber(0,cur.high())]);
+			} else {
+				// a zigzag keeps the block connected, the random edges cause crossings
+				for(int j = 0; j < max(prev.size(), cur.size()); ++j) {
+					insertLevelEdge(G, prev[min(j,prev.high())], cur[min(j,cur.high())]);
+					insertLevelEdge(G, prev[min(j+1,prev.high())], cur[min(j,cur.high())]);
+				}
+				for(int k = cur.size()/4; k > 0; --k)
+					insertLevelEdge(G, prev[randomNumber(0,prev.high())], cur[randomNumber(0,cur.high())]);
+			}
+			prev = cur;
+		}
+		if(numLevels > 1)
+			last = prev[randomNumber(0,prev.high())];
+	}
+
+	return numNodes;
+}
+
+// checks the separation of the nodes on each level and of consecutive levels
+static bool checkLevelSeparation(const HierarchyLevels &levels, const GraphCopyAttributes &AGC,
+	const OptimalHierarchyLayout &ohl)
+{
+	const double eps = 1e-4;
+
+	for(int i = 0; i < levels.size(); ++i) {
+		const Level &L = levels[i];
+		for(int j = 1; j < L.size(); ++j) {
+			if(AGC.x(L[j]) - AGC.x(L[j-1]) < ohl.nodeDistance() + 0.5*(AGC.getWidth(L[j]) + AGC.getWidth(L[j-1])) - eps) {
+				cout << "    nodes " << j-1 << " and " << j << " on level " << i << " overlap!" << endl;
+				return false;
+			}
+		}
+		for(int j = 1; j < L.size(); ++j) {
+			if(AGC.y(L[j]) != AGC.y(L[0])) {
+				cout << "    the nodes on level " << i << " have different y-coordinates!" << endl;
+				return false;
+			}
+		}
+		if(i > 0 && L.size() > 0 && levels[i-1].size() > 0
+			&& AGC.y(L[0]) - AGC.y(levels[i-1][0]) < ohl.layerDistance() - eps)
+		{
+			cout << "    the levels " << i-1 << " and " << i << " are too close!" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// computes the x-coordinates of levels with ohl using 1 and maxThreads threads;
+// the layouts must be separated and identical
+static bool layoutHierarchy(
+	const HierarchyLevels &levels,
+	GraphAttributes &GA,
+	OptimalHierarchyLayout &ohl,
+	int maxThreads,
+	NodeArray<double> &x)
+{
+	const Hierarchy &H  = levels.hierarchy();
+	const GraphCopy &GC = H;
+	x.init(GC);
+
+	for(int threads = 1; ; threads = maxThreads) {
+		ohl.maxThreads(threads);
+		GraphCopyAttributes AGC(H, GA);
+		ohl.call(levels, AGC);
+
+		if(!checkLevelSeparation(levels, AGC, ohl))
+			return false;
+
+		node v;
+		forall_nodes(v,GC) {
+			if(threads == 1)
+				x[v] = AGC.x(v);
+			else if(x[v] != AGC.x(v)) {
+				cout << "    the layouts with 1 and " << threads << " threads differ!" << endl;
+				return false;
+			}
+		}
+
+		if(threads == maxThreads)
+			return true;
+	}
+}
+
+// lays out a hierarchy of large components, which are split into several subproblems at
+// levels with a single (dummy) node, and many small components, which are combined;
+// maxPartSize() must switch the large subproblems to FastSimpleHierarchyLayout
+static bool testOptimalHierarchyLayout(int maxThreads)
+{
+	Graph G;
+	GraphAttributes GA(G);
+	NodeArray<int> rank(G);
+
+	int n = appendLayeredComponent(G, GA, rank, 0, 3, 15, 60);
+	n += appendLayeredComponent(G, GA, rank, 5, 3, 15, 60);
+	for(int i = 0; i < 40; ++i)
+		n += appendLayeredComponent(G, GA, rank, randomNumber(0,40), 1, randomNumber(1,5), 6);
+
+	cout << "-> " << n << " nodes, " << G.numberOfEdges() << " edges... " << endl;
+
+	Hierarchy H(G, rank);
+	const GraphCopy &GC = H;
+	HierarchyLevels levels(H);
+	NodeArray<int> component(GC);
+	levels.separateCCs(connectedComponents(GC, component), component);
+
+	OptimalHierarchyLayout ohl;
+	NodeArray<double> x, xFallback;
+	if(!layoutHierarchy(levels, GA, ohl, maxThreads, x))
+		return false;
+
+	ohl.maxPartSize(300);
+	if(!layoutHierarchy(levels, GA, ohl, maxThreads, xFallback))
+		return false;
+
+	node v;
+	forall_nodes(v,GC)
+		if(x[v] != xFallback[v])
+			return true;
+
+	cout << "    maxPartSize() has no effect!" << endl;
+	return false;
+}
+
+#endif
+
+
 bool regSugiyama()
 {
 	const int numGraphs = 10;
@@ -240,5 +494,21 @@ bool regSugiyama()
 			double(cr)/numGraphs << " crossings" << endl;
 	}
 
+
+	cout << "\n-> NetworkSimplexRanking, incremental calls after insertions... " << endl;
+	srand(4711);
+
+	if(!testIncrementalRanking(100, 20)
+	|| !testIncrementalRanking(1000, 20)
+	|| !testIncrementalRanking(2000, 4))
+		return false;
+
+#ifdef OGDF_LP_SOLVER
+	cout << "\n-> OptimalHierarchyLayout, large hierarchies with several components... " << endl;
+	srand(4711);
+
+	return testOptimalHierarchyLayout(4);
+#else
 	return true;
+#endif
 }
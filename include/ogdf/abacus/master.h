@@ -44,6 +44,7 @@
 
 #include <ogdf/abacus/hash.h>
 #include <ogdf/basic/Stopwatch.h>
+#include <ogdf/basic/CriticalSection.h>
 
 
 class OsiSolverInterface;
@@ -812,6 +813,39 @@ public:
 	 */
 	void conElimAge(int age) { conElimAge_ = age; }
 
+	//! Returns the age at which unused items are removed from the cut pools (0 if never).
+	int cutPoolMaxAge() const { return cutPoolMaxAge_; }
+
+	//! Changes the age at which unused items are removed from the cut pools to \a age.
+	/**
+	 * The age is passed to the default cut pool when it is created (see
+	 * StandardPool::maxAge()); derived masters may apply it to their own pools.
+	 *
+	 * \param age The new age, 0 if cuts never age out (default).
+	 */
+	void cutPoolMaxAge(int age) { cutPoolMaxAge_ = age; }
+
+	//! Returns the size up to which a dynamic cut pool is enlarged (0 if unbounded).
+	int cutPoolMaxSize() const { return cutPoolMaxSize_; }
+
+	//! Limits the size of dynamic cut pools to \a size.
+	/**
+	 * The size is passed to the default cut pool when it is created (see
+	 * StandardPool::maxSize()); derived masters may apply it to their own pools.
+	 *
+	 * \param size The new maximal size, 0 if the pools can grow unbounded (default).
+	 */
+	void cutPoolMaxSize(int size) { cutPoolMaxSize_ = size; }
+
+	//! Returns the tolerance below which the slack of a pool item keeps it from aging.
+	double poolSlackEps() const { return poolSlackEps_; }
+
+	//! Changes the tolerance below which the slack of a pool item keeps it from aging to \a eps.
+	/**
+	 * \param eps The new tolerance.
+	 */
+	void poolSlackEps(double eps) { poolSlackEps_ = eps; }
+
 	/**
 	 * \return true  Then variables are fixed and set by reduced cost criteria.
 	 * \return false Then no variables are fixed or set by reduced cost criteria.
@@ -921,6 +955,30 @@ public:
 	 */
 	void newRootReOptimize(bool on) { newRootReOptimize_ = on; }
 
+	//! Returns the maximal number of threads processing subproblems concurrently.
+	int nThreads() const { return nThreads_; }
+
+	//! Sets the maximal number of threads processing subproblems concurrently.
+	/**
+	 * If \a n is greater than 1, the subproblems are selected from the set of
+	 * open subproblems (according to the enumeration strategy) and optimized by
+	 * \a n threads. All problem specific code, e.g., separation, pricing, and
+	 * heuristics, as well as the pools, the bounds and the enumeration tree are
+	 * protected by a global lock which is only released while the linear programs
+	 * of the subproblems (each one owned by its thread) are solved. Derived
+	 * subproblems must therefore not rely on the master's state being unchanged
+	 * across a call of Sub::solveLp(). The reoptimization of new root nodes
+	 * (see newRootReOptimize()) is skipped in this mode, and the cpu time limit
+	 * refers to the cpu time of all threads.
+	 *
+	 * \param n The new number of threads (default: 1).
+	 */
+	void nThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) nThreads_ = n;
+#endif
+	}
+
 	//! Returns the name of the file that stores the optimum solutions.
 	const string &optimumFileName() const { return optimumFileName_; }
 
@@ -1203,6 +1261,35 @@ private:
 	 */
 	Sub   *select();
 
+	class Worker;
+
+	//! Processes subproblems by \a nThreads_ threads (see nThreads()).
+	void _optimizeParallel();
+
+	//! Lets the calling thread select and optimize subproblems until the enumeration is finished.
+	/**
+	 * \param id The index of the thread in \a runningSub_.
+	 */
+	void _processOpenSubs(int id);
+
+	//! Releases the global lock of the parallel mode while an LP is solved.
+	void _unlockTree() {
+		if (treeLock_) treeLock_->leave();
+	}
+
+	//! Reacquires the global lock of the parallel mode after an LP has been solved.
+	void _lockTree() {
+		if (treeLock_) treeLock_->enter();
+	}
+
+	//! Wakes up the threads of the parallel mode waiting for open subproblems.
+	/**
+	 * Must be called with the global lock held.
+	 */
+	void _treeChanged() {
+		if (treeChanged_) treeChanged_->notifyAll();
+	}
+
 	int initLP();
 
 	//! Writes the string \a info to the stream associated with the Tree Interface.
@@ -1473,6 +1560,15 @@ private:
 	//! The number of iterations an elimination criterion must be satisfied until a variable can be removed.
 	int varElimAge_;
 
+	//! The age at which unused items are removed from the cut pools (0 if never).
+	int cutPoolMaxAge_;
+
+	//! The size up to which dynamic cut pools are enlarged (0 if unbounded).
+	int cutPoolMaxSize_;
+
+	//! The tolerance below which the slack of a pool item keeps it from aging.
+	double poolSlackEps_;
+
 	//! The current status of the optimization.
 	STATUS status_;
 
@@ -1526,6 +1622,30 @@ private:
 	//! The number of changes of the root of the remaining branch-and-bound tree.
 	int nNewRoot_;
 
+	//! The maximal number of threads processing subproblems concurrently.
+	int nThreads_;
+
+	//! The global lock of the parallel mode (0 if the subproblems are processed sequentially).
+	ogdf::CriticalSection *treeLock_;
+
+	//! Signalled in the parallel mode when a subproblem is added to the open subproblems or a thread finishes a subproblem.
+	ogdf::ConditionVariable *treeChanged_;
+
+	//! The subproblems currently optimized by the threads in the parallel mode.
+	ogdf::Array<Sub*> runningSub_;
+
+	//! The number of threads currently optimizing a subproblem in the parallel mode.
+	int nBusy_;
+
+	//! If \a true, the threads of the parallel mode stop selecting subproblems.
+	bool stopThreads_;
+
+	//! If \a true, an exception has been thrown in one of the threads of the parallel mode.
+	bool threadFailed_;
+
+	//! The code of the exception thrown in one of the threads of the parallel mode.
+	ogdf::AlgorithmFailureCode threadFailure_;
+
 	Master(const Master &rhs);
 	const Master &operator=(const Master& rhs);
 };
@@ -93,7 +93,7 @@ public:
 	 * Before the function \a insert() tries to insert a constraint/variable
 	 * in the pool, it checks if the constraint/variable is already contained in the
 	 * pool. If the constraint/variable \a cv is contained in the pool,
-	 * it is deleted.
+	 * it is deleted and the age of the item in the pool is reset.
 	 *
 	 * \param cv The constraint/variable being inserted.
 	 *
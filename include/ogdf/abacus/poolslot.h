@@ -123,6 +123,13 @@ public:
 	//! Returns a pointer to the constraint/variable in the pool slot.
 	BaseType *conVar() const { return conVar_; }
 
+	//! Returns the age of the constraint/variable in the pool slot.
+	/**
+	 * The age is the number of consecutive pool separations in which the
+	 * inactive item has not been violated (see StandardPool::maxAge()).
+	 */
+	int age() const { return age_; }
+
 
 private:
 
@@ -176,6 +183,7 @@ private:
 	BaseType *conVar_;		//!< A pointer to the constraint/variable.
 	unsigned long version_;	//!< The version of the constraint in the slot.
 	Pool<BaseType, CoType> *pool_; //!< A pointer to the corresponding pool.
+	int age_;	//!< The age of the constraint/variable in the slot.
 
 
 	PoolSlot(const PoolSlot<BaseType, CoType> &rhs);
@@ -60,7 +60,12 @@ ostream& operator<< (ostream &out, const StandardPool<BaseType,CoType> &rhs);
  *
  * A standard pool can be static or dynamic. A static standard pool
  * has a fixed size, whereas a dynamic standard pool is automatically
- * enlarged by ten percent if it is full and an item is inserted.
+ * enlarged by ten percent if it is full and an item is inserted,
+ * unless it has reached its maximal size (see maxSize()).
+ *
+ * Optionally, the pool ages its inactive items during the pool
+ * separation and removes those not violated for a given number
+ * of separations (see maxAge()).
  */
 template<class BaseType, class CoType>
 class StandardPool:public Pool<BaseType,CoType> {
@@ -100,7 +105,8 @@ public:
 	/**
 	 * If there is no free slot available, we try to generate free slots by removing redundant
 	 * items, i.e., items which have no reference to them.
-	 * If this fails, we either perform an automatic reallocation of the pool or remove non-active items.
+	 * If this fails, we either perform an automatic reallocation of the pool or remove non-active items;
+	 * the latter also if the pool has reached its maximal size.
 	 *
 	 * \param cv The constraint/variable being inserted.
 	 *
@@ -129,6 +135,33 @@ public:
 	//! Return the maximal number of constraints/variables that can be inserted in the pool.
 	int size() const { return pool_.size(); }
 
+	//! Returns the size up to which a dynamic pool is enlarged (0 if unbounded).
+	int maxSize() const { return maxSize_; }
+
+	//! Limits the automatic reallocation of the pool to \a size slots.
+	/**
+	 * If a full pool has reached this size, inactive items are removed
+	 * instead, preferring those with few references and a high age.
+	 *
+	 * \param size The new maximal size, 0 if the pool can grow unbounded (default).
+	 */
+	void maxSize(int size) { maxSize_ = size; }
+
+	//! Returns the age at which unused items are removed from the pool (0 if never).
+	int maxAge() const { return maxAge_; }
+
+	//! Changes the age at which unused items are removed from the pool to \a age.
+	/**
+	 * In each call of separate(), an inactive item that is not violated
+	 * and whose slack (reduced cost) is at least Master::poolSlackEps()
+	 * in absolute value becomes one older, all other checked items
+	 * become young again. An item reaching the age \a age is removed
+	 * if it is deletable, i.e., if no subproblem refers to it anymore.
+	 *
+	 * \param age The new age, 0 if items never age out (default).
+	 */
+	void maxAge(int age) { maxAge_ = age; }
+
 	//! Returns a pointer to the <i>i</i>-th slot in the pool.
 	/**
 	 * \param i The number of the slot being accessed.
@@ -143,6 +176,7 @@ public:
 	 * the associated active constraints.
 	 *
 	 * Before a constraint or variable is generated we check if it is valid for the subproblem \a sub.
+	 * If maxAge() is positive, the checked items are aged as described there.
 	 *
 	 * The function defines the pure virtual function of the base class Pool.
 	 *
@@ -176,7 +210,8 @@ protected:
 	//! Tries to remove at most \a maxRemove  inactive items from the pool.
 	/**
 	 * A minimum heap of the items with the reference counter as
-	 * key is built up and items are removed in this order.
+	 * key is built up and items are removed in this order. Items
+	 * with the same number of references are removed oldest first.
 	 */
 	int removeNonActive(int maxRemove);
 
@@ -212,6 +247,9 @@ protected:
 	 */
 	bool autoRealloc_;
 
+	int maxSize_; //!< The size up to which the pool is reallocated automatically (0 if unbounded).
+	int maxAge_;  //!< The age at which unused items are removed in the pool separation (0 if never).
+
 private:
 
 	StandardPool(const StandardPool&rhs);
@@ -55,6 +55,7 @@
 namespace ogdf {
 
 	class DynamicBCTree;
+	class IncrementalPlanarityTest;
 
 
 /**
@@ -105,6 +106,10 @@ private:
 	 * \brief The corresponding BC-Tree.
 	 */
 	DynamicBCTree* m_pBCTree;
+	/**
+	 * \brief The incremental planarity test for new edges.
+	 */
+	IncrementalPlanarityTest* m_pPlanarityTest;
 
 	/**
 	 * \brief The inserted edges by the algorithm.
@@ -205,7 +205,7 @@ public:
 		if (m_numThreadsReachedSync == m_threadCount)
 		{
 			m_syncNumber++;
-			pthread_cond_signal( &m_allThreadsReachedSync);
+			pthread_cond_broadcast( &m_allThreadsReachedSync);
 			m_numThreadsReachedSync = 0;
 		}
 		else
@@ -128,6 +128,8 @@ public:
 	}
 
 private:
+	friend class ConditionVariable;
+
 #if _WIN32_WINNT >= 0x0600
 	SRWLOCK m_srwLock;
 #else
@@ -174,6 +176,8 @@ public:
 	}
 
 private:
+	friend class ConditionVariable;
+
 	pthread_mutex_t m_mutex;
 	int             m_spinCount;
 };
@@ -181,6 +185,94 @@ private:
 #endif
 
 
+//! Representation of a condition variable.
+/**
+ * A condition variable lets threads wait inside a critical section until another
+ * thread signals that the protected state has changed. Since wakeups may be spurious,
+ * a waiting thread has to check its condition again after wait() returns.
+ */
+#if defined(OGDF_SYSTEM_WINDOWS)
+
+class OGDF_EXPORT ConditionVariable
+{
+public:
+	ConditionVariable() {
+#if _WIN32_WINNT >= 0x0600
+		InitializeConditionVariable(&m_cv);
+#else
+		m_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+#endif
+	}
+
+	~ConditionVariable() {
+#if _WIN32_WINNT < 0x0600
+		CloseHandle(m_event);
+#endif
+	}
+
+	//! Leaves \a cs, waits until notified, and enters \a cs again.
+	/**
+	 * The calling thread must be in the critical section \a cs.
+	 */
+	void wait(CriticalSection &cs) {
+#if _WIN32_WINNT >= 0x0600
+		SleepConditionVariableSRW(&m_cv, &cs.m_srwLock, INFINITE, 0);
+#else
+		ResetEvent(m_event);
+		cs.leave();
+		WaitForSingleObject(m_event, 100);
+		cs.enter();
+#endif
+	}
+
+	//! Wakes up all threads waiting on this condition variable.
+	/**
+	 * The calling thread should be in the critical section used by the waiting threads.
+	 */
+	void notifyAll() {
+#if _WIN32_WINNT >= 0x0600
+		WakeAllConditionVariable(&m_cv);
+#else
+		SetEvent(m_event);
+#endif
+	}
+
+private:
+#if _WIN32_WINNT >= 0x0600
+	CONDITION_VARIABLE m_cv;
+#else
+	HANDLE m_event; //!< Manual-reset event (Windows XP has no condition variables).
+#endif
+};
+
+#else
+
+class OGDF_EXPORT ConditionVariable
+{
+public:
+	ConditionVariable() {
+		pthread_cond_init(&m_cond, NULL);
+	}
+
+	~ConditionVariable() {
+		pthread_cond_destroy(&m_cond);
+	}
+
+	void wait(CriticalSection &cs) {
+		pthread_cond_wait(&m_cond, &cs.m_mutex);
+	}
+
+	void notifyAll() {
+		pthread_cond_broadcast(&m_cond);
+	}
+
+private:
+	pthread_cond_t m_cond;
+};
+
+#endif
+
+
 } // end namespace ogdf
 
 
@@ -0,0 +1,169 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of functions for processing index ranges
+ *        with several threads.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_PARALLEL_RANGE_H
+#define OGDF_PARALLEL_RANGE_H
+
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/Array.h>
+
+
+namespace ogdf {
+
+
+//! Processes a block of a range in a separate thread (used by parallelBlocks()).
+template<class FUNC>
+class RangeWorker : public Thread
+{
+	const FUNC &m_func;
+	int m_begin;
+	int m_end;
+	int m_count;
+
+public:
+	RangeWorker(const FUNC &func, int begin, int end)
+		: m_func(func), m_begin(begin), m_end(end), m_count(0) { }
+
+	void run() { m_count = m_func(m_begin, m_end); }
+
+	int count() const { return m_count; }
+
+protected:
+	virtual void doWork() { run(); }
+};
+
+
+//! Calls a member function of an object for a range (used by parallelRange()).
+template<class T>
+class RangeMethod
+{
+	T &m_obj;
+	int (T::*m_method)(int begin, int end);
+
+public:
+	RangeMethod(T &obj, int (T::*method)(int begin, int end)) : m_obj(obj), m_method(method) { }
+
+	int operator()(int begin, int end) const { return (m_obj.*m_method)(begin, end); }
+};
+
+
+//! Calls \a func for the blocks [\a bound[t], \a bound[t+1]) with one thread per block.
+/**
+ * The first block is processed by the calling thread, which waits for the other
+ * threads afterwards.
+ *
+ * @param bound contains the boundaries of the blocks; \a bound[0] is the first
+ *        index of the range and \a bound[bound.high()] the index after its end.
+ * @param func is called as <tt>func(begin, end)</tt> for each block and returns an
+ *        int (e.g., the number of processed elements); it must be safe to call
+ *        \a func concurrently for disjoint blocks.
+ * @return the sum of the values returned by \a func.
+ */
+template<class FUNC>
+int parallelBlocks(const Array<int> &bound, const FUNC &func)
+{
+	const int numThreads = bound.size() - 1;
+	OGDF_ASSERT(numThreads >= 1);
+
+	Array<RangeWorker<FUNC> *> worker(numThreads);
+	for (int t = 0; t < numThreads; t++)
+		worker[t] = new RangeWorker<FUNC>(func, bound[bound.low()+t], bound[bound.low()+t+1]);
+
+	for (int t = 1; t < numThreads; t++)
+		worker[t]->start();
+	worker[0]->run();
+
+	int count = worker[0]->count();
+	for (int t = 1; t < numThreads; t++) {
+		worker[t]->join();
+		count += worker[t]->count();
+	}
+	for (int t = 0; t < numThreads; t++)
+		delete worker[t];
+
+	return count;
+}
+
+
+//! Calls \a func for the range [0, \a n), split into blocks of equal size for up to \a maxThreads threads.
+/**
+ * Each thread gets at least \a minPerThread elements, such that its work takes
+ * considerably longer than creating it; smaller ranges are processed by
+ * calling <tt>func(0, n)</tt> directly.
+ *
+ * @param n is the size of the range.
+ * @param maxThreads is the maximal number of threads.
+ * @param minPerThread is the minimal number of elements per thread.
+ * @param func is called as in parallelBlocks().
+ * @return the sum of the values returned by \a func.
+ */
+template<class FUNC>
+int parallelRange(int n, int maxThreads, int minPerThread, const FUNC &func)
+{
+	const int numThreads = max(1, min(maxThreads, n / minPerThread));
+	if (numThreads == 1)
+		return func(0, n);
+
+	Array<int> bound(numThreads+1);
+	for (int t = 0; t <= numThreads; t++)
+		bound[t] = (int)((__int64)n * t / numThreads);
+
+	return parallelBlocks(bound, func);
+}
+
+
+//! Calls the member function \a method of \a obj for the range [0, \a n) like parallelRange() above.
+template<class T>
+int parallelRange(int n, int maxThreads, int minPerThread, T &obj, int (T::*method)(int begin, int end))
+{
+	return parallelRange(n, maxThreads, minPerThread, RangeMethod<T>(obj, method));
+}
+
+
+} // end namespace ogdf
+
+
+#endif
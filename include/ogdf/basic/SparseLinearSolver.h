@@ -0,0 +1,191 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class SparseLinearSolver (iterative solvers
+ *        for sparse systems of linear equations).
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_SPARSE_LINEAR_SOLVER_H
+#define OGDF_SPARSE_LINEAR_SOLVER_H
+
+
+#include <ogdf/basic/SparseMatrix.h>
+
+
+namespace ogdf {
+
+
+//! Iterative solver for sparse systems of linear equations.
+/**
+ * The class SparseLinearSolver solves systems <i>A x = b</i>, where \a A is a
+ * (square) SparseMatrix, with one of the following iterative methods:
+ *   - the conjugate gradient method with Jacobi (diagonal) preconditioning;
+ *     requires \a A to be symmetric and positive definite;
+ *   - successive over-relaxation (SOR), which is the Gauss-Seidel method for
+ *     relaxation factor 1; requires non-zero diagonal entries and converges, e.g.,
+ *     if \a A is symmetric and positive definite and 0 < relaxation < 2.
+ *
+ * The iteration stops as soon as the residual |<i>b - A x</i>| is at most
+ * <i>tolerance</i> * |<i>b</i>|, or after <i>maxIterations</i> iterations.
+ * The matrix-vector products of the conjugate gradient method can be
+ * computed by several threads.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>method</i><td>Method<td>lsConjugateGradient
+ *     <td>The iterative method.
+ *   </tr><tr>
+ *     <td><i>tolerance</i><td>double<td>1e-8
+ *     <td>The relative residual below which the iteration stops.
+ *   </tr><tr>
+ *     <td><i>maxIterations</i><td>int<td>10000
+ *     <td>The maximal number of iterations.
+ *   </tr><tr>
+ *     <td><i>relaxation</i><td>double<td>1.0
+ *     <td>The relaxation factor of SOR (1.0 yields the Gauss-Seidel method).
+ *   </tr><tr>
+ *     <td><i>maxThreads</i><td>int<td>System::numberOfProcessors()
+ *     <td>The maximal number of threads used for matrix-vector products.
+ *   </tr>
+ * </table>
+ */
+class OGDF_EXPORT SparseLinearSolver
+{
+public:
+	//! The iterative methods.
+	enum Method {
+		lsConjugateGradient, //!< Jacobi preconditioned conjugate gradient method.
+		lsSOR                //!< Successive over-relaxation (Gauss-Seidel for relaxation 1).
+	};
+
+	//! Creates a solver with default settings.
+	SparseLinearSolver();
+
+	//! Solves <i>A x = b</i>.
+	/**
+	 * @param A is the (finalized) coefficient matrix.
+	 * @param b is the right hand side.
+	 * @param x contains the initial guess and is assigned the solution; if \a x does
+	 *        not have the right size, the iteration starts with the zero vector.
+	 * @return true iff the required accuracy has been reached.
+	 */
+	bool solve(const SparseMatrix &A, const Array<double> &b, Array<double> &x);
+
+
+	/**
+	 *  @name Optional parameters
+	 *  @{
+	 */
+
+	//! Returns the iterative method.
+	Method method() const { return m_method; }
+
+	//! Sets the iterative method to \a m.
+	void method(Method m) { m_method = m; }
+
+	//! Returns the relative residual below which the iteration stops.
+	double tolerance() const { return m_tolerance; }
+
+	//! Sets the relative residual below which the iteration stops to \a eps.
+	void tolerance(double eps) { m_tolerance = eps; }
+
+	//! Returns the maximal number of iterations.
+	int maxIterations() const { return m_maxIterations; }
+
+	//! Sets the maximal number of iterations to \a n.
+	void maxIterations(int n) { m_maxIterations = n; }
+
+	//! Returns the relaxation factor of SOR.
+	double relaxation() const { return m_relaxation; }
+
+	//! Sets the relaxation factor of SOR to \a omega (0 < \a omega < 2).
+	void relaxation(double omega) { m_relaxation = omega; }
+
+	//! Returns the maximal number of threads used for matrix-vector products.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for matrix-vector products to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
+
+	/** @}
+	 *  @name Further information
+	 *  @{
+	 */
+
+	//! Returns the number of iterations performed by the last call of solve().
+	int numberOfIterations() const { return m_numIterations; }
+
+	//! Returns the relative residual |<i>b - A x</i>| / |<i>b</i>| after the last call of solve().
+	double residual() const { return m_residual; }
+
+	//! @}
+
+private:
+	//! Implements the conjugate gradient method.
+	bool solveCG(const SparseMatrix &A, const Array<double> &b, Array<double> &x);
+
+	//! Implements successive over-relaxation.
+	bool solveSOR(const SparseMatrix &A, const Array<double> &b, Array<double> &x);
+
+	Method m_method;      //!< The iterative method.
+	double m_tolerance;   //!< The relative residual below which the iteration stops.
+	int    m_maxIterations; //!< The maximal number of iterations.
+	double m_relaxation;  //!< The relaxation factor of SOR.
+	int    m_maxThreads;  //!< The maximal number of threads for matrix-vector products.
+
+	int    m_numIterations; //!< The number of iterations of the last call.
+	double m_residual;    //!< The relative residual after the last call.
+};
+
+
+} // end namespace ogdf
+
+
+#endif
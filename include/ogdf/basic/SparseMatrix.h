@@ -0,0 +1,164 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class SparseMatrix (sparse matrices in
+ *        compressed sparse row format).
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_SPARSE_MATRIX_H
+#define OGDF_SPARSE_MATRIX_H
+
+
+#include <ogdf/basic/ArrayBuffer.h>
+
+
+namespace ogdf {
+
+
+//! Sparse matrix in compressed sparse row (CSR) format.
+/**
+ * A sparse matrix is assembled by adding its non-zero entries with addEntry()
+ * in arbitrary order (entries added several times are summed up). Calling
+ * finalize() builds the compressed row representation, in which the entries
+ * of each row are sorted by column. After finalization, the matrix can be
+ * multiplied with vectors (optionally using several threads) and passed
+ * to SparseLinearSolver.
+ *
+ * Rows and columns are numbered starting with 0.
+ */
+class OGDF_EXPORT SparseMatrix
+{
+public:
+	//! Creates an empty 0 x 0 matrix.
+	SparseMatrix() : m_rows(0), m_cols(0) {
+		m_rowStart.init(1);
+		m_rowStart[0] = 0;
+	}
+
+	//! Creates a \a rows x \a cols matrix without non-zero entries.
+	SparseMatrix(int rows, int cols) {
+		init(rows, cols);
+	}
+
+	//! Reinitializes the matrix as a \a rows x \a cols matrix without non-zero entries.
+	void init(int rows, int cols);
+
+	//! Adds \a value to entry (\a i,\a j).
+	/**
+	 * The entry is only stored temporarily; it becomes part of the matrix
+	 * when finalize() is called.
+	 */
+	void addEntry(int i, int j, double value) {
+		OGDF_ASSERT(0 <= i && i < m_rows && 0 <= j && j < m_cols);
+		m_tripletRow.push(i);
+		m_tripletCol.push(j);
+		m_tripletValue.push(value);
+	}
+
+	//! Builds the compressed row representation including all entries added so far.
+	void finalize();
+
+	//! Returns true iff all added entries are contained in the compressed row representation.
+	bool finalized() const { return m_tripletRow.empty(); }
+
+
+	//! Returns the number of rows.
+	int numberOfRows() const { return m_rows; }
+
+	//! Returns the number of columns.
+	int numberOfColumns() const { return m_cols; }
+
+	//! Returns the number of stored entries.
+	int numberOfNonzeros() const { return m_rowStart[m_rows]; }
+
+	//! Returns entry (\a i,\a j), which is 0 if it is not stored.
+	double operator()(int i, int j) const;
+
+	//! Returns the index of the first stored entry in row \a i.
+	int rowBegin(int i) const { return m_rowStart[i]; }
+
+	//! Returns the index after the last stored entry in row \a i.
+	int rowEnd(int i) const { return m_rowStart[i+1]; }
+
+	//! Returns the column of the \a k-th stored entry.
+	int column(int k) const { return m_column[k]; }
+
+	//! Returns the value of the \a k-th stored entry.
+	double value(int k) const { return m_value[k]; }
+
+
+	//! Computes \a y = A \a x, where A is this matrix.
+	/**
+	 * @param x is a vector with numberOfColumns() entries.
+	 * @param y is assigned the result (numberOfRows() entries).
+	 * @param nThreads is the maximal number of threads used; the rows are
+	 *        distributed in blocks with roughly the same number of entries.
+	 *        Since the threads are created for each call, each thread gets
+	 *        at least 2^18 entries; smaller matrices are always multiplied
+	 *        by a single thread.
+	 * \pre The matrix is finalized.
+	 */
+	void multiply(const Array<double> &x, Array<double> &y, int nThreads = 1) const;
+
+private:
+	class RowMultiplication;
+
+	//! Computes the rows \a begin, ..., \a end - 1 of \a y = A \a x.
+	void multiplyRows(const double *x, double *y, int begin, int end) const;
+
+	int m_rows; //!< The number of rows.
+	int m_cols; //!< The number of columns.
+
+	Array<int>    m_rowStart; //!< The entries of row i are m_rowStart[i], ..., m_rowStart[i+1]-1.
+	Array<int>    m_column;   //!< The column of each entry.
+	Array<double> m_value;    //!< The value of each entry.
+
+	ArrayBuffer<int>    m_tripletRow;   //!< The rows of the entries added since the last finalize().
+	ArrayBuffer<int>    m_tripletCol;   //!< The columns of the entries added since the last finalize().
+	ArrayBuffer<double> m_tripletValue; //!< The values of the entries added since the last finalize().
+};
+
+
+} // end namespace ogdf
+
+
+#endif
@@ -53,6 +53,8 @@
 
 #include <ogdf/orthogonal/OrthoRep.h>
 #include <ogdf/cluster/ClusterPlanRep.h>
+#include <ogdf/graphalg/MinCostFlowReinelt.h>
+#include <ogdf/basic/ModuleOption.h>
 
 
 namespace ogdf {
@@ -76,6 +78,7 @@ public:
 		m_deg4free        = false; //!< if set to true, free angle assignment at degree four nodes allowed
 		m_align           = false; //!< if set to true, nodes are aligned on same hierarchy level
 		m_topToBottom     = defaultCost;     //bend costs depend on edges cluster depth
+		m_minCostFlow.set(new MinCostFlowReinelt);
 	};
 
 	~ClusterOrthoShaper() { }
@@ -126,6 +129,9 @@ public:
 
 	void bendCostTopDown(BendCost i) { m_topToBottom = i; }
 
+	//! Sets the module for solving the min-cost flow problem (default: MinCostFlowReinelt).
+	void setMinCostFlow(MinCostFlowModule *pMinCostFlow) { m_minCostFlow.set(pMinCostFlow); }
+
 	//return cluster dependant bend cost for standard cost pbc
 	int clusterProgBendCost(int clDepth, int treeDepth, int pbc)
 	{
@@ -175,6 +181,8 @@ public:
 
 
 private:
+	ModuleOption<MinCostFlowModule> m_minCostFlow; // option for min-cost flow
+
 	bool m_distributeEdges; // distribute edges among all sides if degree > 4
 	bool m_fourPlanar;      // should the input graph be four planar
 							// (no zero degree)
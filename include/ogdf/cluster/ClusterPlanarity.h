@@ -103,6 +103,7 @@ public:
 		m_kuratowskiIterations(10),
 		m_subdivisions(10),
 		m_kSupportGraphs(10),
+		m_kuratowskiThreads(System::numberOfProcessors()),
 		m_kuratowskiHigh(0.8),
 		m_kuratowskiLow(0.8),
 		m_perturbation(false),
@@ -144,6 +145,8 @@ public:
 	void setNumberOfKuraIterations(int i) {m_kuratowskiIterations = i;}
 	void setNumberOfSubDivisions(int i) {m_subdivisions = i;}
 	void setNumberOfSupportGraphs(int i) {m_kSupportGraphs = i;}
+	//! Sets the number of threads used for extracting Kuratowski subdivisions.
+	void setNumberOfKuraThreads(int i) {m_kuratowskiThreads = i;}
 	void setUpperRounding(double d) {m_kuratowskiHigh = d;}
 	void setLowerRounding(double d) {m_kuratowskiLow = d;}
 	void setPerturbation(bool b) {m_perturbation = b;}
@@ -214,7 +217,7 @@ private:
 	int m_heuristicLevel, m_heuristicRuns;
 	double m_heuristicOEdgeBound;
 	int m_heuristicNPermLists, m_kuratowskiIterations;
-	int m_subdivisions, m_kSupportGraphs;
+	int m_subdivisions, m_kSupportGraphs, m_kuratowskiThreads;
 	double m_kuratowskiHigh, m_kuratowskiLow;
 	bool m_perturbation;
 	double m_branchingGap;
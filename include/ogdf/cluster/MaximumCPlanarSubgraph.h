@@ -97,6 +97,7 @@ public:
 							   m_kuratowskiIterations(10),
 							   m_subdivisions(10),
 							   m_kSupportGraphs(10),
+							   m_kuratowskiThreads(System::numberOfProcessors()),
 							   m_kuratowskiHigh(0.8),
 							   m_kuratowskiLow(0.8),
 							   m_perturbation(false),
@@ -107,6 +108,8 @@ public:
 							   m_numAddVariables(15),
 							   m_strongConstraintViolation(0.3),
 							   m_strongVariableViolation(0.3),
+							   m_cutPoolMaxAge(0),
+							   m_cutPoolMaxSize(0),
 							   m_totalTime(-1.0),
 							   m_heurTime(-1.0),
 							   m_lpTime(-1.0),
@@ -142,6 +145,8 @@ public:
 	void setNumberOfKuraIterations(int i) {m_kuratowskiIterations = i;}
 	void setNumberOfSubDivisions(int i) {m_subdivisions = i;}
 	void setNumberOfSupportGraphs(int i) {m_kSupportGraphs = i;}
+	//! Sets the number of threads used for extracting Kuratowski subdivisions.
+	void setNumberOfKuraThreads(int i) {m_kuratowskiThreads = i;}
 	void setUpperRounding(double d) {m_kuratowskiHigh = d;}
 	void setLowerRounding(double d) {m_kuratowskiLow = d;}
 	void setPerturbation(bool b) {m_perturbation = b;}
@@ -153,6 +158,10 @@ public:
 	void setNumAddVariables(int n) { m_numAddVariables = n;}
 	void setStrongConstraintViolation(double d) { m_strongConstraintViolation=d;}
 	void setStrongVariableViolation(double d) { m_strongVariableViolation=d;}
+	//! Removes cuts not violated in \a i consecutive pool separations from the cut pools (0: never).
+	void setCutPoolMaxAge(int i) { m_cutPoolMaxAge = i;}
+	//! Limits the number of cuts in each cut pool to \a n (0: unbounded).
+	void setCutPoolMaxSize(int n) { m_cutPoolMaxSize = n;}
 	//! Use default abacus master cut pool or dedicated connectivity and
 	//! kuratowski cut pools
 	bool & useDefaultCutPool() {return m_defaultCutPool;}
@@ -218,7 +227,7 @@ private:
 	int m_heuristicLevel, m_heuristicRuns;
 	double m_heuristicOEdgeBound;
 	int m_heuristicNPermLists, m_kuratowskiIterations;
-	int m_subdivisions, m_kSupportGraphs;
+	int m_subdivisions, m_kSupportGraphs, m_kuratowskiThreads;
 	double m_kuratowskiHigh, m_kuratowskiLow;
 	bool m_perturbation;
 	double m_branchingGap;
@@ -228,6 +237,8 @@ private:
 	int m_numAddVariables;
 	double m_strongConstraintViolation;
 	double m_strongVariableViolation;
+	int m_cutPoolMaxAge;//<! Age at which unused cuts are removed from the pools
+	int m_cutPoolMaxSize;//<! Maximal size of the cut pools
 
 	const char* getPortaFileName()
 	{
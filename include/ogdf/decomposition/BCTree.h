@@ -48,6 +48,7 @@
 #ifndef OGDF_BC_TREE_H
 #define OGDF_BC_TREE_H
 
+#include <ogdf/basic/Array.h>
 #include <ogdf/basic/BoundedStack.h>
 #include <ogdf/basic/EdgeArray.h>
 #include <ogdf/basic/NodeArray.h>
@@ -307,6 +308,14 @@ protected:
  * member of class BCTree due to recursive calls to biComp().
  */
 	SList<node> m_nodes;
+/**
+ * \brief Temporary array.
+ *
+ * It is needed for the generation of the BC-tree by DFS method. It is the
+ * explicit DFS stack of biComp(), i.e., it contains the current adjacency entry
+ * of each vertex on the DFS path (indexed by depth).
+ */
+	Array<adjEntry> m_dfsAdj;
 
 /** @}
  * \brief Initialization.
@@ -329,7 +338,8 @@ protected:
 	void initNotConnected (node vG);
 /**
  * \brief generates the BC-tree and the biconnected components graph
- * recursively.
+ * by an iterative DFS (using an explicit stack, so deep graphs do not
+ * overflow the call stack).
  *
  * The DFS algorithm is based on J. Hopcroft and R. E. Tarjan: Algorithm 447:
  * Efficient algorithms for graph manipulation. <em>Comm. ACM</em>, 16:372-378
@@ -283,6 +283,15 @@ public:
  */
 	DynamicSPQRForest (Graph& G) : DynamicBCTree(G) { init(); }
 
+/** @} @{
+ * \brief returns the graph containing the vertices of all SPQR-trees.
+ *
+ * Only the proper representatives of the UNION/FIND-trees are vertices of
+ * SPQR-trees; vertices of this graph are never deleted.
+ * \return the graph containing the vertices of all SPQR-trees.
+ */
+	const Graph& spqrTree () const { return m_T; }
+
 /** @} @{
  * \brief finds the proper representative of the SPQR-tree-vertex which
  * a given real or virtual edge is belonging to.
@@ -56,6 +56,25 @@ namespace ogdf {
 
 
 //! The Davidson-Harel approach for drawing graphs.
+/**
+ * The layout is optimized by simulated annealing: a random vertex is moved
+ * to a random position on a disk around its current position, and the move
+ * is accepted depending on the change of the weighted sum of the energy
+ * functions and the current temperature.
+ *
+ * If the number of replicas is set to \a k > 1, the method performs parallel
+ * tempering: \a k independent annealing chains (replicas) on copies of the
+ * layout run in separate threads. At each temperature step, the replicas are
+ * assigned the temperatures <i>T</i>, <i>c T</i>, ..., <i>c</i><sup><i>k</i>-1</sup> <i>T</i>
+ * (<i>c</i> is the cooling factor) and the disk radii are scaled accordingly;
+ * after each step, replicas with neighboring temperatures are exchanged with
+ * the usual Metropolis criterion. The layout of the replica with the lowest
+ * energy is returned. This requires that all energy functions support
+ * EnergyFunction::clone(); otherwise, a single chain is used.
+ *
+ * All random decisions are derived from the random seed (see setRandomSeed()),
+ * hence the result is reproducible for a fixed seed and number of replicas.
+ */
 class OGDF_EXPORT DavidsonHarel
 {
 public:
@@ -71,6 +90,28 @@ public:
 	//! Sets the number of iterations for each temperature step to \a steps.
 	void setNumberOfIterations(int steps);
 
+	//! Sets the number of replicas (annealing chains run in parallel) to \a n.
+	void setNumberOfReplicas(int n);
+
+	//! Returns the number of replicas.
+	int numberOfReplicas() const { return m_numberOfReplicas; }
+
+	//! Sets the seed of the random number generators to \a seed.
+	void setRandomSeed(int seed) { m_randomSeed = seed; }
+
+	//! Returns the seed of the random number generators.
+	int randomSeed() const { return m_randomSeed; }
+
+	//! Sets the maximal number of threads used for running the replicas to \a n.
+	void setMaxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
+
+	//! Returns the maximal number of threads used for running the replicas.
+	int maxThreads() const { return m_maxThreads; }
+
 	//! Adds an energy function \a F with a certain weight.
 	void addEnergyFunction(EnergyFunction *F, double weight);
 
@@ -100,23 +141,27 @@ private:
 	double m_diskRadius;        //!< The radius of the disk around the old position of a vertex where the new position will be.
 	double m_energy;            //!< The current energy of the system.
 	int m_numberOfIterations;   //!< The number of iterations per temperature step.
+	int m_numberOfReplicas;     //!< The number of replicas.
+	int m_randomSeed;           //!< The seed of the random number generators.
+	int m_maxThreads;           //!< The maximal number of threads used for the replicas.
 
 	List<EnergyFunction*> m_energyFunctions; //!< The list of the energy functions.
 	List<double> m_weightsOfEnergyFunctions; //!< The list of the weights for the energy functions.
 
 	List<node> m_nonIsolatedNodes; //!< The list of nodes with degree greater 0.
 
+	class RandomGenerator;
+	class Replica;
+	class Worker;
+
 	//! Resets the parameters for subsequent runs.
 	void initParameters();
 
-	//! Randomly computes a node and a new position for that node.
-	node computeCandidateLayout(const GraphAttributes &, DPoint &) const;
-
-	//! Tests if new energy value satisfies annealing property (only better if m_fineTune).
-	bool testEnergyValue(double newVal);
+	//! Creates the replicas; returns false if an energy function cannot be cloned.
+	bool createReplicas(GraphAttributes &AG, Array<Replica *> &replica) const;
 
-	//! Computes a random number between zero and one
-	double randNum() const;
+	//! Exchanges replicas with neighboring temperatures (in \a slot) according to the Metropolis criterion.
+	void exchangeReplicas(Array<Replica *> &slot, int parity, RandomGenerator &rng) const;
 
 	//! Computes the first disk radius as the half the diamter of the enclosing rectangle.
 	void computeFirstRadius(const GraphAttributes &AG);
@@ -143,6 +143,21 @@ public:
 	//! (*number of nodes of graph)
 	void setIterationNumberAsFactor(bool b) {m_itAsFactor = b;}
 
+	//! Sets the number of replicas (annealing chains run in parallel) to \a n.
+	/**
+	 * For \a n > 1, the layout is computed by parallel tempering (see DavidsonHarel).
+	 */
+	void setNumberOfReplicas(int n);
+
+	//! Returns the number of replicas.
+	int getNumberOfReplicas() const {return m_numberOfReplicas;}
+
+	//! Sets the seed of the random number generators to \a seed.
+	void setRandomSeed(int seed) {m_randomSeed = seed;}
+
+	//! Returns the seed of the random number generators.
+	int getRandomSeed() const {return m_randomSeed;}
+
 private:
 	double m_repulsionWeight;   //!< The weight for repulsion energy.
 	double m_attractionWeight;  //!< The weight for attraction energy.
@@ -155,6 +170,8 @@ private:
 	double m_prefEdgeLength;    //!< Preferred edge length (abs value), only used if > 0
 	bool m_crossings;           //!< Should crossings be computed?
 	bool m_itAsFactor;          //!< Should m_numberOfIterations be factor (true) or fixed number
+	int m_numberOfReplicas;     //!< The number of replicas.
+	int m_randomSeed;           //!< The seed of the random number generators.
 };
 
 }
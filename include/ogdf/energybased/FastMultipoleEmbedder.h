@@ -90,6 +90,25 @@ public:
 	//! Calls the algorithm for graph \a GA and returns the layout information in \a GA.
 	void call(GraphAttributes &GA);
 
+	//! Calls the algorithm for a graph given as binary edge list file and writes the layout to a file.
+	/**
+	 * This is meant for graphs which do not fit into main memory. The edges are never
+	 * loaded, the file is mapped into memory and streamed block by block whenever
+	 * the edge forces are computed. Only the coordinates, degrees and the quadtree
+	 * of the nodes are kept in memory.
+	 *
+	 * The edge list file consists of one pair of 32-bit unsigned integers (the indices
+	 * of the source and the target node) per edge in native byte order; the number of
+	 * nodes is the largest index plus one. All nodes have the default node size and all
+	 * edges the default edge length. The positions are written as one pair of 32-bit
+	 * floats (x and y coordinate) per node in the order of the node indices.
+	 *
+	 * @param edgeListFile the name of the edge list file
+	 * @param positionFile the name of the file the positions are written to
+	 * \return false if the edge list file cannot be read or the position file cannot be written
+	 */
+	bool callOutOfCore(const char *edgeListFile, const char *positionFile);
+
 	//! sets the maximum number of iterations
 	void setNumIterations(__uint32 numIterations) { m_numIterations = numIterations; }
 
@@ -114,6 +133,11 @@ public:
 
 	//void setEnablePostProcessing(bool b) { m_doPostProcessing = b; }
 private:
+	friend class FastMultipoleMultilevelEmbedder;
+
+	//! Calls the algorithm for the array graph \a G and returns the layout information in \a G.
+	void call(ArrayGraph& G);
+
 	void initOptions();
 
 	void runMultipole();
@@ -129,6 +153,12 @@ private:
 	//! frees the memory
 	void deallocate();
 
+	//! allocates the options and the thread pool for a graph with \a numNodes nodes
+	void allocateSimulation(__uint32 numNodes);
+
+	//! frees the options and the thread pool
+	void deallocateSimulation();
+
 	__uint32 m_numIterations;
 
 	ArrayGraph* m_pGraph;
@@ -162,6 +192,7 @@ public:
 	//! sets the bound for the number of nodes for multilevel step
 	void multilevelUntilNumNodesAreLess(int nodesBound) { m_multiLevelNumNodesBound = nodesBound; }
 
+	//! sets the maximum number of threads used for building the levels and for the layout of each level
 	void maxNumThreads(int numThreads) { m_iMaxNumThreads = numThreads; }
 private:
 	//! internal function to compute a good edgelength
@@ -171,7 +202,7 @@ private:
 	void run(GraphAttributes& GA, const EdgeArray<float>& edgeLength);
 
 	//! creates all multilevels
-	void createMultiLevelGraphs(Graph* pGraph, GraphAttributes& GA, const EdgeArray<float>& edgeLength);
+	void createMultiLevelGraphs(GraphAttributes& GA, const EdgeArray<float>& edgeLength);
 
 	//! init the original graphs multilevel
 	void initFinestLevel(GraphAttributes &GA, const EdgeArray<float>& edgeLength);
@@ -208,16 +239,9 @@ private:
 	GalaxyMultilevel* m_pFinestLevel;
 	GalaxyMultilevel* m_pCoarsestLevel;
 
-	Graph*			  m_pCurrentGraph;
-	NodeArray<float>* m_pCurrentNodeXPos;
-	NodeArray<float>* m_pCurrentNodeYPos;
-	EdgeArray<float>* m_pCurrentEdgeLength;
-	NodeArray<float>* m_pCurrentNodeSize;
-	NodeArray<float>  m_adjustedNodeSize;
+	ArrayGraph*		  m_pCurrentGraph;
+	ArrayGraph*		  m_pLastGraph;
 	int				  m_iCurrentLevelNr;
-
-	NodeArray<float>* m_pLastNodeXPos;
-	NodeArray<float>* m_pLastNodeYPos;
 };
 
 } // end of namespace ogdf
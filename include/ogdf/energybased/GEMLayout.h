@@ -53,6 +53,7 @@
 
 #include <ogdf/module/LayoutModule.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/internal/energybased/RepulsiveForces.h>
 
 
 namespace ogdf {
@@ -122,8 +123,18 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>pageRatio</i><td>double<td>1.0
  *     <td>The page ratio used for the layout of connected components.
+ *   </tr><tr>
+ *     <td><i>repulsionMethod</i><td>RepulsiveForces::Method<td>RepulsiveForces::rfExact
+ *     <td>The method for computing the repulsive forces.
  *   </tr>
  * </table>
+ *
+ * The repulsive forces acting on a node are computed from all other nodes in
+ * each round, which takes O(n) time per node. RepulsiveForces::rfBarnesHut
+ * and RepulsiveForces::rfMultipole approximate them in O(log n) time per node
+ * using a quadtree that is rebuilt after each permutation of the nodes, and
+ * RepulsiveForces::rfGrid only considers nodes closer than twice the desired
+ * edge length (plus the node size).
 */
 class OGDF_EXPORT GEMLayout : public LayoutModule
 {
@@ -143,6 +154,7 @@ class OGDF_EXPORT GEMLayout : public LayoutModule
 	int m_attractionFormula;        //!< The used formula for attraction.
 	double m_minDistCC;             //!< The minimal distance between connected components.
 	double m_pageRatio;             //!< The page ratio used for the layout of connected components.
+	RepulsiveForces::Method m_repulsionMethod; //!< The method for computing the repulsive forces.
 
 	// node data used by the algorithm
 
@@ -161,6 +173,9 @@ class OGDF_EXPORT GEMLayout : public LayoutModule
 	double m_cos; //!< Cosine of m_oscillationAngle / 2.
 	double m_sin; //!< Sine of (pi + m_rotationAngle) / 2.
 
+	RepulsiveForces *m_repulsion;    //!< The repulsive forces (0 if computed exactly).
+	NodeArray<int> m_repulsionIndex; //!< The index of each node in m_repulsion.
+
 public:
 
 	//! Creates an instance of GEM layout.
@@ -287,6 +302,12 @@ public:
 	//! Sets the page ratio used for the layout of connected components to \a x.
 	void pageRatio(double x) { m_pageRatio = x; }
 
+	//! Returns the method for computing the repulsive forces.
+	RepulsiveForces::Method repulsionMethod() const { return m_repulsionMethod; }
+
+	//! Sets the method for computing the repulsive forces to \a m.
+	void repulsionMethod(RepulsiveForces::Method m) { m_repulsionMethod = m; }
+
 
 private:
 	//! Returns the length of the vector (\a x,\a y).
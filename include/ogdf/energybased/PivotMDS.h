@@ -74,9 +74,38 @@ value == std::numeric_limits<T>::infinity();
 #endif
 
 
+/**
+ * \brief The Pivot MDS layout algorithm.
+ *
+ * The graph distances from a set of pivots chosen by the maxmin strategy are
+ * stored in a contiguous column-major matrix (one column per pivot). The
+ * breadth-first searches from the pivots, the centering of the matrix and
+ * the matrix products of the eigen-solver are distributed among several
+ * threads (see option maxThreads); the matrix products use SSE2 if available.
+ *
+ * If the graph attributes contain GraphAttributes::threeD, a 3-dimensional
+ * layout is computed, otherwise a 2-dimensional one.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>numberOfPivots</i><td>int<td>250
+ *     <td>The number of pivots.
+ *   </tr><tr>
+ *     <td><i>edgeCosts</i><td>double<td>100
+ *     <td>The desired distance between adjacent nodes.
+ *   </tr><tr>
+ *     <td><i>maxThreads</i><td>int<td>System::numberOfProcessors()
+ *     <td>The maximal number of threads used.
+ *   </tr>
+ * </table>
+ */
 class OGDF_EXPORT PivotMDS : public LayoutModule {
 public:
-	PivotMDS() : m_numberOfPivots(250), m_edgeCosts(100), m_hasEdgeCostsAttribute(false) { }
+	PivotMDS();
 
 	virtual ~PivotMDS() { }
 
@@ -92,6 +121,16 @@ public:
 		m_edgeCosts = edgeCosts;
 	}
 
+	//! Returns the maximal number of threads used.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
+
 	//! Calls the layout algorithm for graph attributes \a GA.
 	void call(GraphAttributes& GA);
 
@@ -101,9 +140,9 @@ public:
 
 private:
 
-	//! The dimension count determines the number of evecs that
-	//! will be computed. Nevertheless PivotMDS only takes the first two
-	//! with the highest eigenwert into account.
+	//! The maximal dimension count; it determines the number of evecs
+	//! that are computed for a 3-dimensional layout. For a 2-dimensional
+	//! layout, only the first two with the highest eigenwert are computed.
 	const static int DIMENSION_COUNT = 3;
 
 	//! Convergence factor used for power iteration.
@@ -125,25 +164,34 @@ private:
 	//! edge costs attribute
 	bool m_hasEdgeCostsAttribute;
 
-	//! Centers the pivot matrix.
-	void centerPivotmatrix(Array<Array<double> >& pivotMatrix);
+	//! The maximal number of threads used.
+	int m_maxThreads;
+
+	//! Performs the shortest path computations from the pivots.
+	class PivotSearch;
+
+	//! Performs a matrix operation on a part of the pivot matrix.
+	class MatrixOperation;
+
+	//! Centers the pivot matrix \a C (\a n rows, \a l columns).
+	void centerPivotmatrix(Array<double>& C, int n, int l, int nThreads);
 
 	//! Computes the pivot mds layout of the given connected graph of \a GA.
 	void pivotMDSLayout(GraphAttributes& GA);
 
-	void copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom);
-
 	//! Computes the layout of a path.
 	void doPathLayout(GraphAttributes& GA, const node& v);
 
-	//! Computes the eigen value decomposition based on power iteration.
+	//! Computes the eigen value decomposition of the \a l x \a l matrix \a K based on power iteration.
 	void eigenValueDecomposition(
-		Array<Array<double> >& K,
+		const Array<double>& K,
+		int l,
 		Array<Array<double> >& eVecs,
-		Array<double>& eValues);
+		Array<double>& eValues,
+		bool useSSE2);
 
-	//! Computes the pivot distance matrix based on the maxmin strategy
-	void getPivotDistanceMatrix(const GraphAttributes& GA, Array<Array<double> >& pivDistMatrix);
+	//! Computes the pivot distance matrix \a C (\a n rows, one column per pivot) based on the maxmin strategy.
+	void getPivotDistanceMatrix(const GraphAttributes& GA, Array<double>& C, int l, int nThreads);
 
 	//! Checks whether the given graph is a path or not.
 	node getRootedPath(const Graph& G);
@@ -157,14 +205,18 @@ private:
 	//! Fills the given \a matrix with random doubles d 0 <= d <= 1.
 	void randomize(Array<Array<double> >& matrix);
 
-	//! Computes the self product of \a d.
-	void selfProduct(const Array<Array<double> >&d, Array<Array<double> >& result);
+	//! Computes the self product \a K = C^T C of \a C (\a n rows, \a l columns).
+	void selfProduct(Array<double>& C, int n, int l, Array<double>& K, int nThreads, bool useSSE2);
 
-	//! Computes the singular value decomposition of matrix \a K.
+	//! Computes the singular value decomposition of the centered pivot matrix \a C.
 	void singularValueDecomposition(
-		Array<Array<double> >& K,
+		Array<double>& C,
+		int n,
+		int l,
 		Array<Array<double> >& eVecs,
-		Array<double>& eVals);
+		Array<double>& eVals,
+		int nThreads,
+		bool useSSE2);
 };
 
 
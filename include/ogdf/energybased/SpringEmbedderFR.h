@@ -52,6 +52,7 @@
 
 #include <ogdf/module/LayoutModule.h>
 #include <ogdf/basic/Array2D.h>
+#include <ogdf/internal/energybased/RepulsiveForces.h>
 
 
 namespace ogdf {
@@ -96,8 +97,18 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>userBoundingBox</i><td>rectangle<td>(0.0,100.0,0.0,100.0)
  *     <td>The user bounding box for scaling (used if scaling = scUserBoundingBox).
+ *   </tr><tr>
+ *     <td><i>repulsionMethod</i><td>RepulsiveForces::Method<td>RepulsiveForces::rfGrid
+ *     <td>The method for computing the repulsive forces.
  *   </tr>
  * </table>
+ *
+ * With RepulsiveForces::rfGrid, a node is only repelled by the nodes in
+ * neighboring cells of a grid whose distance is less than twice the optimal
+ * distance (the grid variant of the publication). All other methods consider
+ * all pairs of nodes; RepulsiveForces::rfBarnesHut and
+ * RepulsiveForces::rfMultipole approximate the forces in O(n log n) time per
+ * iteration.
  */
 class OGDF_EXPORT SpringEmbedderFR : public LayoutModule
 {
@@ -190,10 +201,23 @@ public:
 		m_bbYmax = ymax;
 	}
 
+	//! Returns the method for computing the repulsive forces.
+	RepulsiveForces::Method repulsionMethod() const {
+		return m_repulsionMethod;
+	}
+
+	//! Sets the method for computing the repulsive forces to \a m.
+	void repulsionMethod(RepulsiveForces::Method m) {
+		m_repulsionMethod = m;
+	}
+
 private:
 	bool initialize(GraphCopy &G, GraphCopyAttributes &AG);
 
 	void mainStep(GraphCopy &G, GraphCopyAttributes &AG);
+
+	//! Adds the repulsive forces between all pairs of nodes (computed with m_repulsionMethod) to \a xdisp and \a ydisp.
+	void allPairsRepulsion(GraphCopy &G, GraphCopyAttributes &AG, NodeArray<double> &xdisp, NodeArray<double> &ydisp);
 	void cleanup() {
 		delete m_A;
 		m_A = 0;
@@ -251,6 +275,8 @@ private:
 
 	double m_minDistCC; //!< The minimal distance between connected components.
 	double m_pageRatio; //!< The page ratio.
+
+	RepulsiveForces::Method m_repulsionMethod; //!< The method for computing the repulsive forces.
 };
 
 
@@ -50,6 +50,7 @@
 
 
 #include <ogdf/module/LayoutModule.h>
+#include <ogdf/basic/Array.h>
 #include <ogdf/basic/Array2D.h>
 #include <ogdf/basic/tuples.h>
 
@@ -74,10 +75,16 @@ namespace ogdf {
  * There are some parameters that can be tuned to optimize the
  * algorithm's behavior regarding runtime and layout quality.
  * First of all note that the algorithm uses all pairs shortest path
- * to compute the graph theoretic distance. This can be done either
- * with BFS (ignoring node sizes) in quadratic time or by using
- * e.g. Floyd's algorithm in cubic time with given edge lengths
- * that may reflect the node sizes.  Also m_computeMaxIt decides
+ * to compute the graph theoretic distance. This is done either
+ * with BFS (ignoring node sizes) or with Dijkstra's algorithm
+ * using given edge lengths that may reflect the node sizes,
+ * started once from each node. The single source computations
+ * are distributed among several threads (see option maxThreads),
+ * and the distances are stored in a single flat |V| x |V| matrix.
+ * The node coordinates are kept in contiguous arrays during the
+ * optimization, such that the computation of the partial
+ * derivatives can make use of SSE2 instructions if available.
+ * Also m_computeMaxIt decides
  * if the computation is stopped after a fixed maximum number of
  * iterations. The desirable edge length can either be set or computed
  * from the graph and the given layout.
@@ -89,6 +96,9 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>tolerance</i><td>int<td>0.0001
  *     <td>Tolerance for the energy level (below which the main loop stops).
+ *   </tr><tr>
+ *     <td><i>maxThreads</i><td>int<td>System::numberOfProcessors()
+ *     <td>The maximal number of threads used for the shortest path computation.
  *   </tr>
  * </table>
  */
@@ -107,12 +117,7 @@ public:
 	};
 
 	//! Constructor: Constructs instance of Kamada Kawai Layout
-	SpringEmbedderKK() : m_tolerance(0.001), m_ltolerance(0.0001), m_computeMaxIt(true),
-		m_K(5.0), m_desLength(0.0), m_distFactor(2.0), m_useLayout(true),
-		m_gItBaseVal(50), m_gItFactor(16)
-	{
-		m_maxLocalIt = m_maxGlobalIt = maxVal;
-	}
+	SpringEmbedderKK();
 
 	//! Destructor
 	~SpringEmbedderKK() {}
@@ -172,6 +177,16 @@ public:
 	{
 		m_computeMaxIt = b;
 	}
+
+	//! Returns the maximal number of threads used for the shortest path computation.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for the shortest path computation to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
 	//We could add some noise to the computation
 	// Returns the current setting of nodes.
 	//bool noise() const {
@@ -235,32 +250,31 @@ protected:
 		EdgeArray<double>& adaptedLengths);
 	//! Adapts positions to avoid degeneracy (all nodes on a single point)
 	void shufflePositions(GraphAttributes& GA);
-	//! Computes contribution of node u to the first partial
-	//! derivatives (dE/dx_m, dE/dy_m) (for node m) (eq. 7 and 8 in paper)
-	dpair computeParDer(node m,
-		node u,
-		GraphAttributes& GA,
-		NodeArray< NodeArray<double> >& ss,
-		NodeArray< NodeArray<double> >& dist);
 	//! Compute partial derivative for v
-	dpair computeParDers(node v,
-		GraphAttributes& GA,
-		NodeArray< NodeArray<double> >& ss,
-		NodeArray< NodeArray<double> >& dist);
+	dpair computeParDers(int v,
+		const Array<double>& x,
+		const Array<double>& y,
+		const Array<double,__int64>& dist,
+		double L) const;
 	//! Does the necessary initialization work for the call functions
+	/**
+	 * Fills the coordinate arrays \a x and \a y, computes the graph theoretic
+	 * distances \a dist (a flat |V| x |V| matrix, nodes are numbered in the order of
+	 * the node list of the graph) and the desirable edge length \a L.
+	 */
 	void initialize(GraphAttributes& GA,
-		NodeArray<dpair>& partialDer,
 		const EdgeArray<double>& eLength,
-		NodeArray< NodeArray<double> >& oLength,
-		NodeArray< NodeArray<double> >& sstrength,
+		Array<double>& x,
+		Array<double>& y,
+		Array<double,__int64>& dist,
 		double & maxDist,
+		double & L,
 		bool simpleBFS);
 	//! Main computation loop, nodes are moved here
-	void mainStep(GraphAttributes& GA,
-		NodeArray<dpair>& partialDer,
-		NodeArray< NodeArray<double> >& oLength,
-		NodeArray< NodeArray<double> >& sstrength,
-		const double maxDist);
+	void mainStep(Array<double>& x,
+		Array<double>& y,
+		const Array<double,__int64>& dist,
+		const double L);
 	//! Does the scaling if no edge lengths are given but node sizes
 	//! are respected
 	void scale(GraphAttributes& GA);
@@ -286,6 +300,8 @@ private:
 	//!< avoid degeneration
 	int m_gItBaseVal; //!< minimum number of global iterations
 	int m_gItFactor;  //!< factor for global iterations: m_gItBaseVal+m_gItFactor*|V|
+	int m_maxThreads; //!< maximal number of threads for the shortest path computation
+	bool m_useSSE2;   //!< use SSE2 instructions in the current call
 
 	static const double startVal;
 	static const double minVal;
@@ -293,9 +309,28 @@ private:
 	//! Smaller values are treated as zero
 	static const int maxVal; //! defines infinite upper bound for iteration number
 
-	double allpairsspBFS(const Graph& G, NodeArray< NodeArray<double> >& distance);
-	double allpairssp(const Graph& G, const EdgeArray<double>& eLengths,
-		NodeArray< NodeArray<double> >& distance,	const double threshold = DBL_MAX);
+	class ShortestPathWorker;
+
+	//! Computes all pairs shortest paths with BFS (if \a eLengths is 0) or
+	//! Dijkstra's algorithm in the flat matrix \a distance; returns the maximum distance.
+	double allpairssp(const Graph& G, const EdgeArray<double>* eLengths,
+		Array<double,__int64>& distance);
+
+	//! Adds the derivatives for the nodes in [\a begin, \a end) to (\a dx, \a dy) (see computeParDers()).
+	//! \a dist is the row of the distance matrix belonging to \a m.
+	void addParDers(int m, int begin, int end,
+		const double *x, const double *y, const double *dist, double L,
+		double &dx, double &dy) const;
+
+	//! Adds the contributions of nodes in [\a begin, \a end) to the Jacobian of node \a m.
+	void addJacobian(int m, int begin, int end,
+		const double *x, const double *y, const double *dist, double L,
+		double &dxdx, double &dxdy, double &dydy) const;
+
+	//! Stores the contribution of node \a u to the partial derivatives of each node in (\a cx, \a cy).
+	void parDerContributions(int u, int n,
+		const double *x, const double *y, const double *dist, double L,
+		double *cx, double *cy) const;
 };//SpringEmbedderKK
 
 //Things that potentially could be added
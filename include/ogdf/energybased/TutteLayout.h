@@ -62,25 +62,19 @@
 
 #include <ogdf/module/LayoutModule.h>
 #include <ogdf/basic/geometry.h>
-#include <ogdf/external/coin.h>
-
-#ifdef USE_COIN
-#include <coin/CoinPackedMatrix.hpp>
-#endif
 
 namespace ogdf {
 
+//! Tutte's barycentric layout algorithm.
+/**
+ * The nodes of a largest face (or the given nodes) are placed on a circle, and each
+ * other node is placed in the barycenter of its neighbors. The resulting sparse
+ * system of linear equations is solved with SparseLinearSolver (Jacobi
+ * preconditioned conjugate gradient method). If the iteration does not reach
+ * the required accuracy, the approximate solution is used.
+ */
 class OGDF_EXPORT TutteLayout : public LayoutModule
 {
-#ifndef USE_COIN
-public:
-
-	void call(GraphAttributes &AG) { THROW_NO_COIN_EXCEPTION; }
-	void call(GraphAttributes &AG, const List<node>& givenNodes) { THROW_NO_COIN_EXCEPTION; }
-
-};
-
-#else // USE_COIN
 public:
 
 	TutteLayout();
@@ -100,12 +94,6 @@ public:
 
 private:
 
-	static bool solveLP(
-		int cols,
-		const CoinPackedMatrix &Matrix,
-		const Array<double> &rightHandSide,
-		Array<double> &x);
-
 	void setFixedNodes(const Graph &G, List<node> &nodes,
 		List<DPoint> &pos, double radius = 1.0);
 	/*! sets the positions of the nodes in a largest face of $G$ in the
@@ -119,6 +107,7 @@ private:
 	/*! the method is overloaded for a given set of nodes.
 	*/
 
+	//! Computes the layout; returns false if the positions are only approximate.
 	bool doCall(GraphAttributes &AG,
 		const List<node> &fixedNodes,
 		List<DPoint> &fixedPositions);
@@ -126,8 +115,6 @@ private:
 	DRect m_bbox;
 };
 
-#endif // USE_COIN
-
 } // end namespace ogdf
 
 #endif // OGDF_TUTTE_LAYOUT_H
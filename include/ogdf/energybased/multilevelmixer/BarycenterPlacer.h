@@ -56,6 +56,8 @@ class OGDF_EXPORT BarycenterPlacer : public InitialPlacer
 private:
 	bool m_weightedPositions;
 
+	void placeNodes(MultilevelGraph &MLG, int begin, int end);
+
 public:
 	BarycenterPlacer();
 
@@ -41,6 +41,7 @@
  ***************************************************************/
 
 #include <ogdf/energybased/multilevelmixer/MultilevelBuilder.h>
+#include <ogdf/basic/Array.h>
 
 #ifdef _MSC_VER
 #pragma once
@@ -51,10 +52,46 @@
 
 namespace ogdf {
 
+//! Builds all levels from a hierarchy of independent sets.
+/**
+ * The first level is a maximal independent set chosen greedily in a random
+ * order of the nodes. With more than one thread, it is computed in rounds: a
+ * node joins the set if it comes first among its undecided neighbors. This
+ * selects exactly the same nodes as the sequential greedy algorithm, so the
+ * result does not depend on the number of threads. All merges of a level are
+ * applied at once by MultilevelGraph::mergeLevel().
+ */
 class OGDF_EXPORT IndependentSetMerger : public MultilevelBuilder
 {
 private:
 	float m_base;
+	int m_maxThreads;
+
+	//! The state of a node during the computation of the independent set.
+	enum State { undecided, selected, covered };
+
+	// the graph in adjacency array format
+	Array<int> m_adjBegin;  //!< The neighbors of node i are stored at [m_adjBegin[i], m_adjBegin[i+1]).
+	Array<int> m_adjTwin;   //!< The opposite node of an adjacency entry.
+	Array<int> m_key;       //!< Random key of a node.
+	Array<int> m_state;     //!< The state of a node.
+	Array<bool> m_first;    //!< True iff a node comes first among its undecided neighbors.
+
+	//! A phase working on the nodes in [\a begin, \a end); returns a count that is summed up over all threads.
+	typedef int (IndependentSetMerger::*Phase)(int begin, int end);
+
+	//! Runs \a phase for all nodes, in parallel if the graph is large enough, and returns the sum of the counts.
+	int runPhase(Phase phase);
+
+	//! Returns true iff node \a v comes before node \a w in the selection order.
+	bool before(int v, int w) const {
+		if (m_key[v] != m_key[w]) return m_key[v] < m_key[w];
+		return v < w;
+	}
+
+	int findFirstNodes(int begin, int end);
+	int selectFirstNodes(int begin, int end);
+	void selectSequential();
 
 	std::vector<node> prebuildLevel(const Graph &G, const std::vector<node> &oldLevelNodes, int level);
 	bool buildOneLevel(MultilevelGraph &MLG) { return false; }
@@ -64,6 +101,16 @@ public:
 	void buildAllLevels(MultilevelGraph &MLG);
 	void setSearchDepthBase(float base);
 
+	//! Returns the maximal number of threads used for computing the independent set.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for computing the independent set to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
+
 	IndependentSetMerger();
 };
 
@@ -49,16 +49,55 @@
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/internal/energybased/MultilevelGraph.h>
+#include <vector>
 
 namespace ogdf {
 
+//! Base class for placing the nodes of a level into the next finer level.
+/**
+ * Placers that derive their positions only from the nodes of the coarser level
+ * can use placeLevel(): it undoes all merges of the current level and then calls
+ * placeNodes() for ranges of the reinserted nodes, in parallel if the level is
+ * large enough (see option maxThreads). The result does not depend on the
+ * number of threads.
+ */
 class OGDF_EXPORT InitialPlacer
 {
 protected:
+	class RangePlacer;
+
 	bool m_randomOffset;
+	int m_maxThreads;
+
+	// the nodes reinserted by placeLevel(), in the order of reinsertion
+	std::vector<node> m_levelNodes;   //!< The reinserted nodes.
+	std::vector<node> m_levelAnchor;  //!< The node of the coarser level into which a reinserted node was merged (directly or via other reinserted nodes).
+	std::vector< std::vector< std::pair<int, double> > > m_levelPositions; //!< The NodeMerge::m_position data of a reinserted node (if requested).
+	std::vector<double> m_levelRandom; //!< Two random numbers in [-1,1] for each reinserted node.
+	std::vector<int> m_levelIndex;     //!< For each node index, the position in m_levelNodes or -1 if the node belongs to the coarser level.
+
+	//! Undoes all merges of the current level of \a MLG and calls placeNodes() for all reinserted nodes.
+	/**
+	 * @param MLG is the multilevel graph.
+	 * @param keepPositions determines if the NodeMerge::m_position data is stored in m_levelPositions.
+	 */
+	void placeLevel(MultilevelGraph &MLG, bool keepPositions = false);
+
+	//! Places the reinserted nodes m_levelNodes[\a begin], ..., m_levelNodes[\a end - 1].
+	/**
+	 * Must only read the positions of nodes of the coarser level and only write
+	 * the positions of the given nodes, since it may run concurrently for other ranges.
+	 */
+	virtual void placeNodes(MultilevelGraph &/* MLG */, int /* begin */, int /* end */) { }
+
+	//! Returns \a v if it belongs to the coarser level and its anchor otherwise.
+	node placedNode(node v) const {
+		int i = m_levelIndex[v->index()];
+		return (i < 0) ? v : m_levelAnchor[i];
+	}
 
 public:
-	InitialPlacer():m_randomOffset(true) { }
+	InitialPlacer();
 	virtual ~InitialPlacer() { }
 
 	virtual void placeOneLevel(MultilevelGraph &MLG) = 0;
@@ -68,6 +107,15 @@ public:
 		m_randomOffset = on;
 	}
 
+	//! Returns the maximal number of threads used for placing a level.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for placing a level to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
 };
 
 } // namespace ogdf
@@ -41,6 +41,7 @@
  ***************************************************************/
 
 #include <ogdf/energybased/multilevelmixer/MultilevelBuilder.h>
+#include <ogdf/basic/Array.h>
 
 #ifdef _MSC_VER
 #pragma once
@@ -51,17 +52,71 @@
 
 namespace ogdf {
 
+//! Merges the end nodes of the edges of a maximal matching.
+/**
+ * The nodes are visited in random order, each free node is matched with a
+ * random free neighbor (or, if selectByNodeMass is set, with a free neighbor
+ * of minimum mass). This is the same as matching the edges greedily in the
+ * corresponding edge order. With more than one thread, the matching is
+ * computed in rounds: an edge is matched if it comes first among the free
+ * edges at both of its end nodes. This matches exactly the same edges as the
+ * sequential algorithm, so the result does not depend on the number of
+ * threads. All merges of a level are applied at once by
+ * MultilevelGraph::mergeLevel().
+ */
 class OGDF_EXPORT MatchingMerger : public MultilevelBuilder
 {
 private:
 	NodeArray<unsigned int> m_mass;
 	bool m_selectByMass;
+	int m_maxThreads;
+
+	// the current level in adjacency array format
+	Array<node> m_node;        //!< The nodes.
+	Array<int>  m_adjBegin;    //!< The adjacency of node i is stored at [m_adjBegin[i], m_adjBegin[i+1]).
+	Array<int>  m_adjTwin;     //!< The opposite node of an adjacency entry.
+	Array<int>  m_adjEdge;     //!< The edge of an adjacency entry.
+	Array<edge> m_edge;        //!< The edges (without self-loops).
+	Array<int>  m_edgeEnd;     //!< The end nodes of edge e are m_edgeEnd[2e] and m_edgeEnd[2e+1].
+	Array<int>  m_edgeRank;    //!< The position of the first end node of an edge in the random node order.
+	Array<unsigned int> m_edgeMass; //!< The mass of the second end node of an edge (only used if selectByMass is set).
+	Array<int>  m_edgeKey;     //!< Random key of an edge (for choosing among the neighbors at random).
+	Array<int>  m_candidate;   //!< The adjacency entry of the first free edge at a node, -1 if there is none.
+	Array<int>  m_mate;        //!< The matched edge at a node, -1 if the node is free.
+
+	//! A phase working on the nodes in [\a begin, \a end); returns a count that is summed up over all threads.
+	typedef int (MatchingMerger::*Phase)(int begin, int end);
+
+	//! Runs \a phase for all nodes, in parallel if the graph is large enough, and returns the sum of the counts.
+	int runPhase(Phase phase);
+
+	//! Returns true iff edge \a e comes before edge \a f in the matching order.
+	bool before(int e, int f) const {
+		if (m_edgeRank[e] != m_edgeRank[f]) return m_edgeRank[e] < m_edgeRank[f];
+		if (m_selectByMass && m_edgeMass[e] != m_edgeMass[f]) return m_edgeMass[e] < m_edgeMass[f];
+		if (m_edgeKey[e] != m_edgeKey[f]) return m_edgeKey[e] < m_edgeKey[f];
+		return e < f;
+	}
+
+	int selectCandidates(int begin, int end);
+	int matchCandidates(int begin, int end);
+	void matchSequential();
 
 	bool buildOneLevel(MultilevelGraph &MLG);
 
 public:
 	MatchingMerger();
 	void selectByNodeMass(bool on);
+
+	//! Returns the maximal number of threads used for computing the matching.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for computing the matching to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
 };
 
 } // namespace ogdf
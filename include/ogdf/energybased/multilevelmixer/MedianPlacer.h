@@ -57,7 +57,7 @@ public:
 	void placeOneLevel(MultilevelGraph &MLG);
 
 private:
-	void placeOneNode(MultilevelGraph &MLG);
+	void placeNodes(MultilevelGraph &MLG, int begin, int end);
 };
 
 } // namespace ogdf
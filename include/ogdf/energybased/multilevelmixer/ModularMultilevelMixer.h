@@ -84,6 +84,12 @@ namespace ogdf {
  *     <td>The layout module applied to the final drawing for additional beautification.
  *   </tr>
  * </table>
+ *
+ * After a call, the sizes of the levels and the time spent on coarsening, on placing
+ * the nodes of each level and on the layout of each level can be queried
+ * (see levelSize(), timeCoarsening(), timePlacement(), timeLayout()).
+ * The placement of a level runs in parallel for placers that support it
+ * (see InitialPlacer::maxThreads()).
  */
 class OGDF_EXPORT ModularMultilevelMixer : public LayoutModule
 {
@@ -199,8 +205,28 @@ public:
 	//! Returns the ratio c/p between sizes of previous (p) and current (c) level graphs.
 	double coarseningRatio() { return m_coarseningRatio; }
 
+	//! Returns the time (in seconds) used for building the levels in the last call.
+	double timeCoarsening() const { return m_timeCoarsening; }
+
+	//! Returns the number of levels in the last call (level 0 is the input graph).
+	int numberOfLevels() const { return (int)m_levelSize.size(); }
+
+	//! Returns the number of nodes on level \a i in the last call.
+	int levelSize(int i) const { return m_levelSize[i]; }
+
+	//! Returns the time (in seconds) used for placing the nodes of level \a i in the last call.
+	double timePlacement(int i) const { return m_timePlacement[i]; }
+
+	//! Returns the time (in seconds) used by the layout modules on level \a i in the last call.
+	double timeLayout(int i) const { return m_timeLayout[i]; }
+
 private:
 	erc m_errorCode; //!< The error code of the last call.
+
+	double m_timeCoarsening;            //!< The time for building the levels.
+	std::vector<int> m_levelSize;       //!< The number of nodes of each level.
+	std::vector<double> m_timePlacement; //!< The time for placing the nodes of each level.
+	std::vector<double> m_timeLayout;   //!< The time for the layout of each level.
 };
 
 } // namespace ogdf
@@ -58,6 +58,9 @@ namespace ogdf {
 /*! Scales a Graph relative to the ScalingType.
  *
  * For use with ModularMultilevelMixer.
+ * Each scaling step calls the secondary layout module, so a secondary layout
+ * that runs in parallel (e.g. FastMultipoleEmbedder or SpringEmbedderFR with
+ * a multi-threaded repulsion backend) makes all passes use its threads.
  */
 class OGDF_EXPORT ScalingLayout : public MultilevelLayoutModule
 {
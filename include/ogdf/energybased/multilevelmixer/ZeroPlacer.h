@@ -53,7 +53,7 @@ namespace ogdf {
 
 class OGDF_EXPORT ZeroPlacer : public InitialPlacer
 {
-	void placeOneNode(MultilevelGraph &MLG);
+	void placeNodes(MultilevelGraph &MLG, int begin, int end);
 
 	double m_randomRange;
 
@@ -0,0 +1,175 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class MinCostFlowCostScaling.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_MIN_COST_FLOW_COST_SCALING_H
+#define OGDF_MIN_COST_FLOW_COST_SCALING_H
+
+
+#include <ogdf/module/MinCostFlowModule.h>
+#include <ogdf/basic/Array.h>
+
+
+namespace ogdf {
+
+
+//! Computes a min-cost flow with Goldberg's cost scaling push-relabel algorithm.
+/**
+ * The costs are multiplied by \f$n+2\f$ and an \f$\varepsilon\f$-optimal flow
+ * is computed for \f$\varepsilon = C/16, C/256, \ldots, 1\f$, where \f$C\f$ is the
+ * largest scaled cost; the last flow is optimal. Each phase saturates all arcs with
+ * negative reduced cost and then discharges the active nodes in FIFO order.
+ * The residual network is stored in compressed form (the residual arcs leaving a
+ * node are consecutive).
+ *
+ * A warm start (see callWarmStart()) starts from the given flow and from
+ * node prices derived from the given dual variables; the scaling begins with the
+ * smallest \f$\varepsilon\f$ for which this pair is \f$\varepsilon\f$-optimal.
+ *
+ * Edges with upper bound infinity() are bounded by the sum of all positive supplies
+ * and finite capacities, which does not change the optimum of a bounded problem.
+ *
+ * The dual variables are only computed by the variant of call() returning them. They
+ * are obtained by a label-correcting shortest path computation in the optimal residual
+ * network, started from the scaled node prices, and satisfy the same conditions as the
+ * ones computed by MinCostFlowReinelt. Self-loops are set to their lower bound.
+ */
+class OGDF_EXPORT MinCostFlowCostScaling : public MinCostFlowModule
+{
+public:
+	MinCostFlowCostScaling() { }
+
+	bool call(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow);            // computed flow
+
+	bool call(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow,             // computed flow
+		NodeArray<int> &dual);            // computed dual variables
+
+	bool callWarmStart(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow,             // initial and computed flow
+		NodeArray<int> &dual);            // initial and computed dual variables
+
+	bool callWarmStart(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow);            // initial and computed flow
+
+private:
+	//! Solves the problem, the dual variables are only assigned if \a dual is not 0.
+	/**
+	 * If \a warmStart is true, \a flow and \a dual (if not 0) contain the initial solution.
+	 */
+	bool solve(
+		const Graph &G,
+		const EdgeArray<int> &lowerBound,
+		const EdgeArray<int> &upperBound,
+		const EdgeArray<int> &cost,
+		const NodeArray<int> &supply,
+		EdgeArray<int> &flow,
+		NodeArray<int> *dual,
+		bool warmStart);
+
+	//! Computes an \a eps -optimal flow from an (\a eps * 16)-optimal flow.
+	void refine(__int64 eps);
+
+	//! Pushes flow from \a u along admissible arcs and relabels \a u until its excess is zero.
+	void discharge(int u, __int64 eps);
+
+	//! Computes shortest path distances \a d with the original costs.
+	/**
+	 * If \a infiniteOnly is true, only the forward arcs of original arcs with infinite
+	 * capacity are considered, otherwise all original residual arcs. The labels in \a d
+	 * are corrected starting from their initial values.
+	 * \return false if a negative cycle has been found.
+	 */
+	bool shortestPaths(Array<__int64> &d, bool infiniteOnly);
+
+	int m_numNodes;        //!< number of nodes (including the artificial root)
+	int m_numArcs;         //!< number of original arcs (without self-loops)
+	__int64 m_alpha;       //!< the factor the costs are multiplied with
+
+	// residual network; the residual arcs leaving u are m_first[u], ..., m_first[u+1]-1
+	Array<int> m_first;
+	Array<int> m_head;
+	Array<int> m_rev;      //!< the reverse residual arc
+	Array<int> m_resCap;
+	Array<__int64> m_cost; //!< the scaled cost
+
+	Array<int> m_forward;  //!< the forward residual arc of each arc
+	Array<bool> m_infinite;//!< true if the arc has unbounded capacity
+
+	// node data
+	Array<__int64> m_price;
+	Array<__int64> m_excess;
+	Array<int> m_current;  //!< the current arc of each node
+
+	// FIFO queue of active nodes
+	Array<int> m_queue;
+	Array<bool> m_inQueue;
+	int m_queueHead, m_queueSize;
+};
+
+
+} // end namespace ogdf
+
+
+#endif
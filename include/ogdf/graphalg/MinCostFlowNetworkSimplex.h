@@ -0,0 +1,183 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class MinCostFlowNetworkSimplex.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_MIN_COST_FLOW_NETWORK_SIMPLEX_H
+#define OGDF_MIN_COST_FLOW_NETWORK_SIMPLEX_H
+
+
+#include <ogdf/module/MinCostFlowModule.h>
+#include <ogdf/basic/Array.h>
+
+
+namespace ogdf {
+
+
+//! Computes a min-cost flow with the primal network simplex algorithm.
+/**
+ * The spanning tree of the current basis is stored in flat arrays (parent,
+ * thread and subtree size of each node), so a pivot only touches the nodes
+ * on the cycle and the subtree that is moved. The entering arc is chosen by
+ * block search: the arcs are scanned in blocks of size about \f$\sqrt{m}\f$
+ * and the arc with most negative reduced cost in the first block that
+ * contains an improving arc enters the basis.
+ *
+ * A warm start (see callWarmStart()) keeps the initial flow on the original
+ * arcs; only the difference to the supplies is routed over artificial arcs
+ * as in a cold start. Arcs whose initial flow lies strictly between their
+ * bounds are split into two parallel arcs, one at its upper and one at its
+ * lower bound, so that the initial basis is valid.
+ *
+ * Self-loops are set to their lower bound. The dual variables satisfy the
+ * same conditions as the ones computed by MinCostFlowReinelt.
+ */
+class OGDF_EXPORT MinCostFlowNetworkSimplex : public MinCostFlowModule
+{
+public:
+	MinCostFlowNetworkSimplex() { }
+
+	bool call(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow);            // computed flow
+
+	bool call(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow,             // computed flow
+		NodeArray<int> &dual);            // computed dual variables
+
+	bool callWarmStart(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow,             // initial and computed flow
+		NodeArray<int> &dual);            // initial and computed dual variables
+
+	bool callWarmStart(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow);            // initial and computed flow
+
+private:
+	//! Solves the problem, the dual variables are only assigned if \a dual is not 0.
+	/**
+	 * If \a warmStart is true, \a flow contains the initial solution.
+	 */
+	bool solve(
+		const Graph &G,
+		const EdgeArray<int> &lowerBound,
+		const EdgeArray<int> &upperBound,
+		const EdgeArray<int> &cost,
+		const NodeArray<int> &supply,
+		EdgeArray<int> &flow,
+		NodeArray<int> *dual,
+		bool warmStart);
+
+	//! Builds the initial basis consisting of the artificial arcs.
+	void init(Array<int> &supply);
+
+	//! Runs the simplex iterations, returns false if the problem is unbounded.
+	bool simplex();
+
+	bool findEnteringArc();
+	void findJoinNode();
+	bool findLeavingArc();
+	void changeFlow(bool change);
+	void updateTreeStructure();
+	void updatePotential();
+
+	enum { stateUpper = -1, stateTree = 0, stateLower = 1 }; //!< states of the arcs
+	enum { dirUp = 1, dirDown = -1 };                         //!< directions of tree arcs
+
+	int m_numNodes;     //!< number of nodes (without the root)
+	int m_numArcs;      //!< number of arcs (without the artificial arcs)
+	int m_root;         //!< the artificial root of the spanning tree
+
+	// arc data (the artificial arcs follow the original arcs)
+	Array<int> m_source;
+	Array<int> m_target;
+	Array<int> m_cap;
+	Array<__int64> m_cost;
+	Array<int> m_flow;
+	Array<int> m_state;
+
+	// node data of the spanning tree
+	Array<__int64> m_pi;
+	Array<int> m_parent;
+	Array<int> m_pred;
+	Array<int> m_predDir;
+	Array<int> m_thread;
+	Array<int> m_revThread;
+	Array<int> m_succNum;
+	Array<int> m_lastSucc;
+	Array<int> m_dirtyRevs;
+	int m_numDirtyRevs;
+
+	// data of the current pivot
+	int m_inArc;
+	int m_join;
+	int m_uIn, m_vIn, m_uOut, m_vOut;
+	int m_delta;
+
+	// data of the block search
+	int m_blockSize;
+	int m_nextArc;
+};
+
+
+} // end namespace ogdf
+
+
+#endif
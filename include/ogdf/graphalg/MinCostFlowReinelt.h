@@ -82,8 +82,6 @@ public:
 		EdgeArray<int> &flow,			  // computed flow
 		NodeArray<int> &dual);            // computed dual variables
 
-	int infinity() const { return numeric_limits<int>::max(); }
-
 private:
 
 	struct arctype;
@@ -117,6 +117,7 @@ public:
 	int getKIterations() const {return m_nKuratowskiIterations;}
 	int getNSubdivisions() const {return m_nSubdivisions;}
 	int getNKuratowskiSupportGraphs() const {return m_nKuratowskiSupportGraphs;}
+	int getNKuratowskiThreads() const {return m_nKuratowskiThreads;}
 	int getHeuristicLevel() const {return m_heuristicLevel;}
 	int getHeuristicRuns() const {return m_nHeuristicRuns;}
 	double getKBoundHigh() const {return m_kuratowskiBoundHigh;}
@@ -139,6 +140,7 @@ public:
 	void setKIterations(int n) {m_nKuratowskiIterations = n;}
 	void setNSubdivisions(int n) {m_nSubdivisions = n;}
 	void setNKuratowskiSupportGraphs(int n) {m_nKuratowskiSupportGraphs = n;}
+	void setNKuratowskiThreads(int n) {m_nKuratowskiThreads = max(n, 1);}
 	void setNHeuristicRuns(int n) {m_nHeuristicRuns = n;}
 	void setKBoundHigh(double n) {m_kuratowskiBoundHigh = ((n>0.0 && n<1.0) ? n : 0.8);}
 	void setKBoundLow(double n) {m_kuratowskiBoundLow = ((n>0.0 && n<1.0) ? n : 0.2);}
@@ -250,6 +252,7 @@ protected:
 	int m_nKuratowskiSupportGraphs; 	// Maximal number of times the Kuratowski support graph is computed
 	int m_nKuratowskiIterations; 		// Maximal number of times BoyerMyrvold is invoked
 	int m_nSubdivisions; 				// Maximal number of extracted Kuratowski subdivisions
+	int m_nKuratowskiThreads; 			// Number of threads used for extracting Kuratowski subdivisions
 	int m_nMaxVars; 					// Max Number of variables
 	int m_heuristicLevel; 				// Indicates if primal heuristic shall be used or not
 	int m_nHeuristicRuns; 				// Counts how often the primal heuristic has been called
@@ -86,6 +86,11 @@ public:
 	inline int coeff(const nodePair& n) const { return coeff(n.v1,n.v2); }
 	int coeff(node v1, node v2) const;
 
+	// The signature of chunk and cochunk, used for detecting duplicates in a pool
+	virtual unsigned hashKey() const { return m_hashKey; }
+	virtual const char *name() const { return "ChunkConnection"; }
+	virtual bool equal(const abacus::ConVar *cv) const;
+
 	void printMe(ostream& out) const {
 		out << "[ChunkCon: (";
 		int j;
@@ -104,6 +109,9 @@ private:
 	// The nodePairs corresponding to the constraint
 	Array<node> m_chunk;
 	Array<node> m_cochunk;
+
+	// The hash key of the sorted chunk and cochunk
+	unsigned m_hashKey;
 };
 
 }
@@ -68,6 +68,11 @@ public:
 	inline int coeff(const nodePair& n) const { return coeff(n.v1,n.v2); }
 	int coeff(node n1, node n2) const;
 
+	// The signature of the cut edges, used for detecting duplicates in the cut pool
+	virtual unsigned hashKey() const { return m_hashKey; }
+	virtual const char *name() const { return "CutConstraint"; }
+	virtual bool equal(const abacus::ConVar *cv) const;
+
 	void printMe(ostream& out) const {
 		out << "[CutCon: ";
 		forall_listiterators(nodePair, it, m_cutEdges) {
@@ -82,6 +87,9 @@ private:
 	// The list containing the node pairs corresponding to the cut edges
 	List<nodePair> m_cutEdges;
 
+	// The hash key of the normalized cut edges
+	unsigned m_hashKey;
+
 };
 
 }
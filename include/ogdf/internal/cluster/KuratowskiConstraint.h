@@ -71,6 +71,11 @@ public:
 	// Computes and returns the coefficient for the given variable
 	virtual double coeff(const abacus::Variable *v) const;
 
+	// The signature of the subdivision, used for detecting duplicates in the cut pool
+	virtual unsigned hashKey() const { return m_hashKey; }
+	virtual const char *name() const { return "ClusterKuratowskiConstraint"; }
+	virtual bool equal(const abacus::ConVar *cv) const;
+
 	void printMe(ostream& out) const {
 		out << "[KuraCon: ";
 		forall_listiterators(nodePair, it, m_subdivision) {
@@ -85,6 +90,9 @@ private:
 	// The subdivision containing edges forming a SubGraph that is not planar
 	List<nodePair> m_subdivision;
 
+	// The hash key of the normalized subdivision
+	unsigned m_hashKey;
+
 };
 
 }
@@ -49,6 +49,7 @@
 #include <ogdf/abacus/master.h>
 #include <ogdf/abacus/constraint.h>
 #include <ogdf/basic/Graph_d.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/cluster/ClusterGraph.h>
 #include <ogdf/cluster/ClusterGraphAttributes.h>
 
@@ -65,6 +66,81 @@ struct nodePair {
 };
 std::ostream &operator<<(std::ostream &os, const nodePair& v);
 
+//! Compares node pairs lexicographically by the indices of their nodes.
+class NodePairComparer {
+public:
+	static int compare(const nodePair &x, const nodePair &y) {
+		if (x.v1 != y.v1)
+			return x.v1->index() - y.v1->index();
+		return x.v2->index() - y.v2->index();
+	}
+	OGDF_AUGMENT_STATICCOMPARER(nodePair)
+};
+
+//! Compares nodes by their indices.
+class NodeIndexComparer {
+public:
+	static int compare(const node &v, const node &w) {
+		return v->index() - w->index();
+	}
+	OGDF_AUGMENT_STATICCOMPARER(node)
+};
+
+//! Brings the node pairs of a cut into canonical order and returns their hash key.
+/**
+ * Each pair is ordered by node index and the list is sorted, hence two lists
+ * describing the same set of node pairs become equal. The hash key serves
+ * as signature of the cut for the duplicate detection in a NonDuplPool.
+ */
+inline unsigned normalizeNodePairs(List<nodePair> &pairs)
+{
+	for (ListIterator<nodePair> it = pairs.begin(); it.valid(); ++it) {
+		nodePair &np = *it;
+		if (np.v1->index() > np.v2->index())
+			std::swap(np.v1, np.v2);
+	}
+	pairs.quicksort(NodePairComparer());
+
+	unsigned key = pairs.size();
+	for (ListConstIterator<nodePair> it = pairs.begin(); it.valid(); ++it)
+		key = 31 * key + 7 * (*it).v1->index() + (*it).v2->index();
+	return key;
+}
+
+//! Returns true iff the normalized node pair lists \a l1 and \a l2 are equal.
+inline bool equalNodePairs(const List<nodePair> &l1, const List<nodePair> &l2)
+{
+	if (l1.size() != l2.size())
+		return false;
+	ListConstIterator<nodePair> it1 = l1.begin(), it2 = l2.begin();
+	for (; it1.valid(); ++it1, ++it2)
+		if ((*it1).v1 != (*it2).v1 || (*it1).v2 != (*it2).v2)
+			return false;
+	return true;
+}
+
+//! Removes (and deletes) constraints from \a cons that duplicate an earlier entry.
+/**
+ * Duplicates are detected via hashKey() and equal(), the order of the
+ * remaining constraints is preserved.
+ */
+inline void removeDuplicates(ArrayBuffer<abacus::Constraint*> &cons)
+{
+	int n = 0;
+	for (int i = 0; i < cons.size(); ++i) {
+		abacus::Constraint *c = cons[i];
+		bool duplicate = false;
+		for (int j = 0; j < n && !duplicate; ++j)
+			duplicate = (cons[j]->hashKey() == c->hashKey() && cons[j]->equal(c));
+		if (duplicate)
+			delete c;
+		else
+			cons[n++] = c;
+	}
+	while (cons.size() > n)
+		cons.pop();
+}
+
 
 //! Struct for attaching the current lp-value to the corresponding edge.
 //! Used in the primal heuristic.
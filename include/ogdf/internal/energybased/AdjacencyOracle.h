@@ -50,27 +50,34 @@
 
 
 #include <ogdf/internal/energybased/EnergyFunction.h>
-#include <ogdf/basic/Array2D.h>
 
 
 namespace ogdf {
 
-//! Tells you in linear time if two nodes are adjacent
+//! Tells you in logarithmic time if two nodes are adjacent
 /**
  * AdjacencyOracle is intialized with a Graph and returns for
- * any pair of nodes in constant time if they are adajcent.
+ * any pair of nodes in time O(log deg) if they are adajcent.
+ * It stores for each node the sorted list of its neighbors (without
+ * self-loops and multiple edges), hence it requires only linear space.
  */
 class AdjacencyOracle {
 public:
 	//! The one and only constrcutor for the class
 	AdjacencyOracle(const Graph &G);
 	//! This is the destructor
-	~AdjacencyOracle() {delete m_adjacencyMatrix;}
+	~AdjacencyOracle() { }
 	//! This returns true if the two nodes are adjacent in G, false otherwise
 	bool adjacent(const node, const node) const;
+	//! Returns the number of distinct neighbors of \a v (not counting \a v itself)
+	int numberOfNeighbors(const node v) const {
+		return m_start[v->index()+1] - m_start[v->index()];
+	}
+	//! Returns the \a i-th neighbor of \a v (0 <= \a i < numberOfNeighbors(\a v))
+	node neighbor(const node v, int i) const { return m_neighbor[m_start[v->index()] + i]; }
 private:
-	NodeArray<int> m_nodeNum; //!< The internal number given to each node
-	Array2D<bool> *m_adjacencyMatrix; //!< A 2D-array where the entry is true if the nodes with the corresponding number are adjacent
+	Array<int>  m_start;    //!< The neighbors of node v are stored at positions m_start[v->index()],...,m_start[v->index()+1]-1
+	Array<node> m_neighbor; //!< The neighbors of all nodes, each list sorted by index
 };
 
 }
@@ -68,6 +68,8 @@ public:
 		//Initializes data structures to speed up later computations
 		Attraction(GraphAttributes &AG);
 		~Attraction() {}
+		//! returns a new instance of Attraction for layout AG with the same preferred edge length
+		EnergyFunction *clone(GraphAttributes &AG) const;
 		//! set the preferred edge length to the absolute value l
 		void setPreferredEdgelength(double l) {m_preferredEdgeLength = l;}
 		//! set multiplier for the edge length with repspect to node size to multi
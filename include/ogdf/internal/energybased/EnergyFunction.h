@@ -72,6 +72,15 @@ public:
 	//! computes energy for the layout at the beginning of the optimization process
 	virtual void computeEnergy() = 0;
 
+	//! Returns a new instance of this energy function for the layout \a AG of the same graph.
+	/**
+	 * The new instance has the same settings as this energy function; its energy
+	 * still has to be computed with computeEnergy(). This is used by DavidsonHarel
+	 * for running several annealing chains in parallel. The default implementation
+	 * returns 0, i.e., the energy function cannot be cloned.
+	 */
+	virtual EnergyFunction *clone(GraphAttributes & /* AG */) const { return 0; }
+
 	//! sets m_testNode, m_testX and m_testY and computes the energy for the new configuration (vertex v moves to newPos)
 	double computeCandidateEnergy(
 		const node v,
@@ -57,23 +57,33 @@ namespace ogdf {
 //Stores info on merging for a refinement level
 struct NodeMerge
 {
+	//! State of an edge before it was changed or deleted by the merge.
+	struct EdgeState
+	{
+		int m_index;
+		int m_source;
+		int m_target;
+		double m_weight;
+
+		EdgeState(int index, int source, int target, double weight)
+			: m_index(index), m_source(source), m_target(target), m_weight(weight) { }
+	};
+
 	// Node/Edge IDs instead of pointers as the nodes themselves may be nonexistent.
-	std::vector<int> m_deletedEdges;
-	std::vector<int> m_changedEdges;
-	std::map<int, double> m_doubleWeight; // for changed and deleted edges
-	std::map<int, int> m_source;
-	std::map<int, int> m_target;
+	std::vector<EdgeState> m_deletedEdges;
+	std::vector<EdgeState> m_changedEdges; // an edge may occur more than once, undo restores the first entry
 
 	int m_mergedNode;
+	double m_mergedRadius;
 	std::vector< std::pair<int, double> > m_position; // optional information <target, distance>. mergedNode will be placed at average of relative distances to target.
 
 	std::vector<int> m_changedNodes; // there may be placement strategies that use more than one reference-node.
-	std::map<int, double> m_radius; // for changed nodes and the merged node
+	std::vector<double> m_changedRadius; // radius of m_changedNodes[i] before the merge
 
 	int m_level;
 
 
-	NodeMerge(int level) : m_level(level) { }
+	NodeMerge(int level) : m_mergedNode(-1), m_mergedRadius(0.0), m_level(level) { }
 	~NodeMerge() { }
 };
 
@@ -98,6 +108,11 @@ private:
 	std::vector<int> m_reverseNodeMergeWeight;//<! Keeps number of vertices represented by vertex with given index
 	std::vector<edge> m_reverseEdgeIndex;
 
+	// first edge of the marked parent to each neighbor, valid if m_markStamp[neighbor] == m_stamp
+	std::vector<edge> m_parentEdge;
+	std::vector<int> m_markStamp;
+	int m_stamp;
+
 	MultilevelGraph * removeOneCC(std::vector<node> &componentSubArray);
 	void copyFromGraph(const Graph &G, NodeArray<int> &nodeAssociations, EdgeArray<int> &edgeAssociations);
 	void prepareGraphAttributes(GraphAttributes &GA) const;
@@ -105,6 +120,9 @@ private:
 	void initReverseIndizes();
 	void initInternal();
 
+	void markParent(node parent);
+	std::vector<edge> moveEdgesToMarkedParent(NodeMerge * NM, node theNode, node parent, bool deleteDoubleEdges, int adjustEdgeLengths);
+
 public:
 	~MultilevelGraph();
 	MultilevelGraph();
@@ -164,6 +182,15 @@ public:
 	bool changeEdge(NodeMerge * NM, edge theEdge, double newWeight, node newSource, node newTarget);
 	bool deleteEdge(NodeMerge * NM, edge theEdge);
 	std::vector<edge> moveEdgesToParent(NodeMerge * NM, node theNode, node parent, bool deleteDoubleEndges, int adjustEdgeLengths);
+	//! Merges a whole level at once.
+	/**
+	 * Each pair in \a merges consists of the node to be merged and its parent. The merges
+	 * are applied in the given order, each one is recorded as a NodeMerge of level \a level.
+	 * Consecutive merges into the same parent share the lookup of the parent's neighbors,
+	 * so mergers should group the pairs by parent.
+	 * \return the number of merges that could be applied.
+	 */
+	int mergeLevel(int level, const std::vector< std::pair<node, node> > &merges, bool deleteDoubleEdges, int adjustEdgeLengths);
 	NodeMerge * getLastMerge();
 	node undoLastMerge();
 
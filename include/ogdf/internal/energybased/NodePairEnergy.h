@@ -54,18 +54,29 @@
 #include <ogdf/internal/energybased/AdjacencyOracle.h>
 #include <ogdf/internal/energybased/EnergyFunction.h>
 #include <ogdf/internal/energybased/IntersectionRectangle.h>
+#include <ogdf/internal/energybased/SpatialGrid.h>
 
 
 namespace ogdf {
 
+//! Energy function where the energy is the sum of energies of pairs of vertices.
+/**
+ * Only vertices with degree greater zero are considered. The pair energies are
+ * not stored but recomputed for the pairs affected by a move, hence the memory
+ * consumption is linear. Which pairs need to be considered depends on
+ * \a range given to the constructor:
+ *   - If \a range is negative, only adjacent vertices may have non-zero pair energy.
+ *   - Otherwise, only vertices whose shapes have distance at most \a range may have
+ *     non-zero pair energy; these pairs are found with a SpatialGrid. Derived classes
+ *     must return 0 in computeCoordEnergy() for all other pairs.
+ */
 class NodePairEnergy: public EnergyFunction {
 public:
 	//Initializes data dtructures to speed up later computations
-	NodePairEnergy(const string energyname, GraphAttributes &AG);
+	NodePairEnergy(const string energyname, GraphAttributes &AG, double range = -1.0);
 
 	virtual ~NodePairEnergy() {
-		delete m_nodeNums;
-		delete m_pairEnergy;
+		delete m_grid;
 	}
 
 	//computes the energy of the initial layout
@@ -75,32 +86,38 @@ protected:
 	//computes the energy stored by a pair of vertices at the given positions
 	virtual double computeCoordEnergy(node, node, const DPoint&, const DPoint&) const = 0;
 
-	//returns the internal number given to each vertex
-	int nodeNum(node v) const { return (*m_nodeNums)[v]; }
-
-	//returns true in constant time if two vertices are adjacent
+	//returns true in logarithmic time if two vertices are adjacent
 	bool adjacent(const node v, const node w) const { return m_adjacentOracle.adjacent(v,w); }
 
 	//returns the shape of a vertex as an IntersectionRectangle
 	const IntersectionRectangle& shape(const node v) const { return m_shape[v]; }
 
+	//returns the maximal distance of vertices with non-zero pair energy (negative if only adjacent vertices)
+	double range() const { return m_range; }
+
 #ifdef OGDF_DEBUG
 	virtual void printInternalData() const;
 #endif
 
 private:
-	NodeArray<int> *m_nodeNums;//stores internal number of each vertex
-	Array2D<double> *m_pairEnergy;//stores for each pair of vertices its energy
-	NodeArray<double> m_candPairEnergy;//stores for each vertex its pair energy with
-	//respect to the vertex to be moved if its new position is chosen
 	NodeArray<IntersectionRectangle> m_shape;//stores the shape of each vertex as
 	//an IntersectionRectangle
 	List<node> m_nonIsolated;//list of vertices with degree greater zero
-	const AdjacencyOracle m_adjacentOracle;//structure for constant time adjacency queries
+	const AdjacencyOracle m_adjacentOracle;//structure for fast adjacency queries
+	double m_range;//maximal distance of vertices with non-zero pair energy
+	SpatialGrid *m_grid;//contains the shapes of the non-isolated vertices (0 if m_range < 0)
+	Array<node> m_indexToNode;//maps node indices to nodes
+	mutable ArrayBuffer<int> m_near;//buffer for the result of grid queries
 
 	//function computes energy stored in a certain pair of vertices
 	double computePairEnergy(const node v, const node w) const;
 
+	//computes the sum of the pair energies of v with all other vertices if v is at position p
+	double nodeEnergy(node v, const DPoint &p) const;
+
+	//inserts v into the grid at its current position
+	void insertIntoGrid(node v);
+
 	//computes energy of whole layout if new position of the candidate vertex is chosen
 	void compCandEnergy();
 
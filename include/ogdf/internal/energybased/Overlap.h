@@ -66,6 +66,9 @@ public:
 	//Initializes private data structures
 	Overlap(GraphAttributes &AG);
 	~Overlap() { }
+
+	//returns a new instance of Overlap for layout AG
+	EnergyFunction *clone(GraphAttributes &AG) const { return new Overlap(AG); }
 private:
 	//computes for two vertices at the given position the overlap energy
 	double computeCoordEnergy(node,node, const DPoint&, const DPoint &) const;
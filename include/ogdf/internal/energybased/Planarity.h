@@ -52,12 +52,19 @@
 
 
 #include <ogdf/internal/energybased/EnergyFunction.h>
-#include <ogdf/basic/Array2D.h>
+#include <ogdf/internal/energybased/SpatialGrid.h>
 
 
 namespace ogdf {
 
 
+//! Energy function counting the number of edge crossings.
+/**
+ * The bounding boxes of the edges are stored in a SpatialGrid, so that
+ * moving a vertex only tests its incident edges against the edges
+ * nearby instead of all edges. Crossings are not stored but recounted
+ * for the edges incident to the moved vertex.
+ */
 class Planarity: public EnergyFunction {
 public:
 	//! Initializes data structures to speed up later computations.
@@ -65,28 +72,31 @@ public:
 
 	~Planarity();
 
+	//! Returns a new instance of Planarity for layout \a AG.
+	EnergyFunction *clone(GraphAttributes &AG) const { return new Planarity(AG); }
+
 	//! Computes energy of initial layout and stores it in \a m_energy.
 	void computeEnergy();
 
 private:
-	struct ChangedCrossing {
-		int edgeNum1;
-		int edgeNum2;
-		bool cross;
-	};
-
 	//! Returns 1 if edges cross else 0.
 	bool intersect(const edge, const edge) const;
 
+	//! Returns the number of edges (other than \a e) crossing segment \a p1-\a p2.
+	/**
+	 * Only edges not sharing an endpoint with \a e are counted.
+	 */
+	int countCrossings(const edge e, const DPoint &p1, const DPoint &p2) const;
+
+	//! Inserts \a e as a segment at its current position into the grid.
+	void insertIntoGrid(const edge e);
+
 	//! Computes energy of candidate.
 	void compCandEnergy();
 
 	//! Changes internal data if candidate is taken.
 	void internalCandidateTaken();
 
-	//! Releases memory allocated for \a m_candidateCrossings.
-	void clearCandidateCrossings();
-
 	//! Tests if two lines given by four points intersect.
 	bool lowLevelIntersect( const DPoint&, const DPoint&, const DPoint&,
 		 const DPoint&) const;
@@ -95,14 +105,9 @@ private:
 		virtual void printInternalData() const;
 #endif
 
-	EdgeArray<int> *m_edgeNums; //!< numbers of edges
-	Array2D<bool> *m_crossingMatrix; //!< stores for each pair of edges if they cross
-
-	/**
-	 * stores for all edges incident to the test node
-	 * an array with the crossings that change if the candidate position is chosen
-	 */
-	List<ChangedCrossing> m_crossingChanges;
+	SpatialGrid *m_grid; //!< contains all edges that are not self loops (as segments)
+	Array<edge> m_indexToEdge; //!< maps edge indices to edges
+	mutable ArrayBuffer<int> m_near; //!< buffer for the result of grid queries
 
 	List<edge> m_nonSelfLoops; //!< list of edges that are not slef loops
 }; // class Planarity
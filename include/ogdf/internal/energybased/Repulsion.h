@@ -62,7 +62,12 @@ class Repulsion: public NodePairEnergy {
 public:
 	//Initializes data structures to speed up later computations
 	Repulsion(GraphAttributes &AG);
+
+	//returns a new instance of Repulsion for layout AG
+	EnergyFunction *clone(GraphAttributes &AG) const { return new Repulsion(AG); }
 private:
+	//distance beyond which the repulsive energy of a pair is neglected
+	static const double CUTOFF;
 	//computes for two vertices an the given positions the repulsive energy
 	double computeCoordEnergy(node, node, const DPoint&, const DPoint&) const;
 };
@@ -0,0 +1,208 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class RepulsiveForces (repulsive forces between
+ *        points computed exactly or approximately).
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_REPULSIVE_FORCES_H
+#define OGDF_REPULSIVE_FORCES_H
+
+
+#include <ogdf/basic/Array.h>
+
+
+namespace ogdf {
+
+class SpatialGrid;
+class LinearQuadtree;
+class LinearQuadtreeExpansion;
+
+
+//! Repulsive forces between points in the plane.
+/**
+ * Computes for a point \a i the sum of (\a p_i - \a p_j) / |\a p_i - \a p_j|^2
+ * over all other points \a j, i.e., each point repels each other point with
+ * a force inversely proportional to their distance (the repulsive force of
+ * SpringEmbedderFR and GEMLayout). Pairs closer than minDistance() are treated
+ * as if they had this distance. The sum is computed by one of the following
+ * methods:
+ *   - rfExact: all pairs of points, O(\a n) per point.
+ *   - rfGrid: only pairs closer than cutoff(); the points are stored in a
+ *     uniform grid (SpatialGrid) with this cell size.
+ *   - rfBarnesHut: a quadtree cell is replaced by the center of mass of its
+ *     points if its size is less than theta() times its distance to the point.
+ *   - rfMultipole: a fast multipole method with precision() coefficients per
+ *     expansion.
+ *
+ * Both approximating methods build the LinearQuadtree of FastMultipoleEmbedder.
+ * rfBarnesHut traverses it once per point. rfMultipole computes the multipole
+ * expansions with LinearQuadtreeExpansion, but uses its own well-separated pair
+ * decomposition, which has a stricter separation criterion than the one of
+ * FastMultipoleEmbedder, and its own translations into local expansions and
+ * their evaluation.
+ *
+ * After init() the points may be moved one by one with move(), so that the
+ * sequential updates of GEMLayout work as well: rfExact, rfGrid and
+ * rfBarnesHut always use the current positions, rfMultipole uses the current
+ * positions for nearby points only and keeps the far field of the last
+ * init().
+ */
+class OGDF_EXPORT RepulsiveForces
+{
+public:
+	//! The methods for computing the forces.
+	enum Method {
+		rfExact,     //!< Exact computation over all pairs of points.
+		rfGrid,      //!< Exact computation over all pairs closer than cutoff().
+		rfBarnesHut, //!< Barnes-Hut approximation using a quadtree.
+		rfMultipole  //!< Fast multipole method.
+	};
+
+	//! Creates an instance using method \a m.
+	explicit RepulsiveForces(Method m = rfExact);
+
+	~RepulsiveForces();
+
+	//! Returns the method for computing the forces.
+	Method method() const { return m_method; }
+
+	//! Sets the method for computing the forces to \a m.
+	void method(Method m) { m_method = m; }
+
+	//! Returns the distance beyond which points do not interact (used by rfGrid).
+	double cutoff() const { return m_cutoff; }
+
+	//! Sets the distance beyond which points do not interact (used by rfGrid) to \a d > 0.
+	void cutoff(double d) { if(d > 0) m_cutoff = d; }
+
+	//! Returns the opening criterion of rfBarnesHut.
+	double theta() const { return m_theta; }
+
+	//! Sets the opening criterion of rfBarnesHut to \a t > 0.
+	/**
+	 * Smaller values are more accurate but slower; 0.5 is a common choice.
+	 */
+	void theta(double t) { if(t > 0) m_theta = t; }
+
+	//! Returns the number of coefficients of the expansions used by rfMultipole.
+	int precision() const { return m_precision; }
+
+	//! Sets the number of coefficients of the expansions used by rfMultipole to \a p >= 1.
+	void precision(int p) { if(p >= 1) m_precision = p; }
+
+	//! Returns the minimal distance of two points used in the force computation.
+	double minDistance() const { return m_minDist; }
+
+	//! Sets the minimal distance of two points used in the force computation to \a d > 0.
+	void minDistance(double d) { if(d > 0) m_minDist = d; }
+
+	//! Initializes the points 0,...,\a n - 1 with positions (\a x[i],\a y[i]) and builds the data structures.
+	void init(const Array<double> &x, const Array<double> &y);
+
+	//! Moves point \a i to (\a x,\a y).
+	void move(int i, double x, double y);
+
+	//! Returns the x-coordinate of point \a i.
+	double x(int i) const { return m_x[i]; }
+
+	//! Returns the y-coordinate of point \a i.
+	double y(int i) const { return m_y[i]; }
+
+	//! Returns the number of points.
+	int numberOfPoints() const { return m_n; }
+
+	//! Computes the force (\a fx,\a fy) acting on point \a i.
+	/**
+	 * This function does not modify the data structures, so several threads
+	 * may call it concurrently.
+	 */
+	void force(int i, double &fx, double &fy) const;
+
+	//! Computes the forces acting on all points.
+	void forces(Array<double> &fx, Array<double> &fy) const;
+
+private:
+	//! Adds the force exerted by the points with tree positions \a first,...,\a last-1 on (\a x,\a y), skipping point \a i.
+	void addDirect(int first, int last, int i, double x, double y, double &fx, double &fy) const;
+
+	void initGrid();     //!< Builds the grid for rfGrid.
+	void initTree();     //!< Builds the quadtree for rfBarnesHut and rfMultipole.
+	void initMultipole(); //!< Computes the expansions and direct neighbors for rfMultipole.
+	void freeAll();      //!< Releases all data structures.
+
+	void forceGrid(int i, double &fx, double &fy) const;
+	void forceBarnesHut(int i, double &fx, double &fy) const;
+	void forceMultipole(int i, double &fx, double &fy) const;
+
+	Method m_method;    //!< The method used.
+	double m_cutoff;    //!< The cutoff distance for rfGrid.
+	double m_theta;     //!< The opening criterion for rfBarnesHut.
+	int    m_precision; //!< The number of coefficients for rfMultipole.
+	double m_minDist;   //!< The minimal distance of two points.
+
+	Method m_builtFor;  //!< The method the data structures have been built for.
+	int m_n;            //!< The number of points.
+	Array<double> m_x, m_y; //!< The current positions of the points.
+
+	SpatialGrid *m_grid; //!< The grid used by rfGrid.
+
+	LinearQuadtree *m_tree;             //!< The quadtree used by rfBarnesHut and rfMultipole.
+	LinearQuadtreeExpansion *m_expansion; //!< The expansions used by rfMultipole.
+	float *m_treeX, *m_treeY, *m_treeSize; //!< The positions and charges the quadtree is built from.
+	Array<int> m_treePos;               //!< The position of each point in the quadtree order.
+	Array<int> m_parent;                //!< The parent of each quadtree node (-1 for the root).
+	Array<double> m_sumX, m_sumY;       //!< The coordinate sums of the points of each quadtree node.
+	Array<int> m_directBegin;           //!< The first direct neighbor of each quadtree node (in m_direct).
+	Array<int> m_direct;                //!< The nodes whose points interact directly with a node (rfMultipole).
+	Array<bool> m_directSelf;           //!< True iff the points of a node interact directly with each other.
+
+	// avoid automatic creation of copy constructor and assignment operator
+	RepulsiveForces(const RepulsiveForces &);
+	RepulsiveForces &operator=(const RepulsiveForces &);
+};
+
+
+} // end namespace ogdf
+
+
+#endif
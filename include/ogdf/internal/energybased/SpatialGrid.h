@@ -0,0 +1,189 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class SpatialGrid (uniform grid for
+ *        range queries on rectangles).
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_SPATIAL_GRID_H
+#define OGDF_SPATIAL_GRID_H
+
+
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/HashArray2D.h>
+
+
+namespace ogdf {
+
+
+//! Uniform grid for range queries on axis-parallel rectangles.
+/**
+ * Each element (numbered 0,...,n-1) is either a rectangle, which is stored in
+ * all grid cells overlapped by it, or a line segment, which is only stored in
+ * the cells crossed by it (instead of all cells overlapped by its bounding box).
+ * Only non-empty cells are stored (in a hash table), hence the grid is unbounded
+ * and its memory consumption is linear in the number of (element, cell)
+ * incidences. A query returns all elements stored in cells overlapped by the
+ * query rectangle, i.e., a superset of the elements intersecting the query
+ * rectangle.
+ *
+ * Queries do not modify the grid, so several threads may query the grid
+ * concurrently.
+ *
+ * SpatialGrid is used by the energy functions of DavidsonHarel and by
+ * BertaultLayout for finding the nodes and edges near a node.
+ */
+class SpatialGrid
+{
+public:
+	//! Creates an empty grid for elements 0,...,\a numElements - 1 with the given cell size.
+	SpatialGrid(int numElements, double cellSize);
+
+	//! Inserts element \a i with bounding rectangle (\a x1,\a y1)-(\a x2,\a y2).
+	/**
+	 * \pre \a i is not contained in the grid, \a x1 <= \a x2 and \a y1 <= \a y2.
+	 */
+	void insert(int i, double x1, double y1, double x2, double y2);
+
+	//! Inserts element \a i as the line segment from (\a x1,\a y1) to (\a x2,\a y2).
+	/**
+	 * The segment is stored in the cells crossed by it, which are found by walking
+	 * along the segment column by column. Hence, the number of cells is
+	 * proportional to the length of the segment (in cells) instead of the area
+	 * of its bounding box.
+	 * \pre \a i is not contained in the grid.
+	 */
+	void insertSegment(int i, double x1, double y1, double x2, double y2);
+
+	//! Removes element \a i from the grid.
+	void remove(int i);
+
+	//! Replaces the bounding rectangle of element \a i by (\a x1,\a y1)-(\a x2,\a y2).
+	/**
+	 * Nothing needs to be done if the element still overlaps the same cells.
+	 * \pre \a i is contained in the grid, \a x1 <= \a x2 and \a y1 <= \a y2.
+	 */
+	void update(int i, double x1, double y1, double x2, double y2);
+
+	//! Replaces the line segment of element \a i by the segment from (\a x1,\a y1) to (\a x2,\a y2).
+	/**
+	 * \pre \a i has been inserted as a segment.
+	 */
+	void updateSegment(int i, double x1, double y1, double x2, double y2);
+
+	//! Returns true iff element \a i is contained in the grid.
+	bool contains(int i) const { return m_contained[i]; }
+
+	//! Appends all elements stored in cells overlapped by rectangle (\a x1,\a y1)-(\a x2,\a y2) to \a result.
+	/**
+	 * Each element is reported at most once.
+	 */
+	void query(double x1, double y1, double x2, double y2, ArrayBuffer<int> &result) const;
+
+	//! Returns the side length of a cell.
+	double cellSize() const { return m_cellSize; }
+
+private:
+	//! Returns the index of the cell containing coordinate \a x.
+	int cell(double x) const {
+		double c = floor(x / m_cellSize);
+		if(!(c >= -maxCell)) return -maxCell; // also catches NaN
+		if(c >  maxCell) return  maxCell;
+		return int(c);
+	}
+
+	//! Returns the range [\a cy1, \a cy2] of cells in column \a cx occupied by element \a i.
+	/**
+	 * \pre \a cx lies in [\a m_x1[\a i], \a m_x2[\a i]].
+	 */
+	void columnCells(int i, int cx, int &cy1, int &cy2) const;
+
+	//! Computes the range [\a cy1, \a cy2] of cells in column \a cx crossed by the segment \a m_segment[\a i].
+	/**
+	 * \pre \a cx lies in [\a m_x1[\a i], \a m_x2[\a i]].
+	 */
+	void segmentCells(int i, int cx, int &cy1, int &cy2) const;
+
+	//! Returns true iff element \a i is stored in all cells of its bounding box.
+	bool fillsBox(int i) const {
+		// a segment within a single column or row occupies its bounding box
+		return !m_isSegment[i] || m_x1[i] == m_x2[i] || m_y1[i] == m_y2[i];
+	}
+
+	//! Returns the entry of element \a i in a cell, where \a lowest tells if the cell is the lowest one of \a i in its column.
+	/**
+	 * Elements filling their bounding boxes are stored as \a i, other segments
+	 * as ~(2\a i+\a lowest), which lets queries skip all but the lowest cells
+	 * without looking at the segment.
+	 */
+	int cellEntry(int i, bool lowest) const { return fillsBox(i) ? i : ~(2*i + (lowest ? 1 : 0)); }
+
+	//! Returns true iff column \a cx is the first column in which segment \a i occupies a cell of rows [\a cy1, \a cy2] in a query of columns [\a cx1, ...].
+	/**
+	 * \pre \a i occupies a cell of column \a cx in rows [\a cy1, \a cy2].
+	 */
+	bool firstSegmentColumn(int i, int cx, int cx1, int cy1, int cy2) const;
+
+	static const int maxCell; //!< Bound for cell indices (avoids overflow for huge coordinates).
+
+	double m_cellSize; //!< The side length of a cell.
+
+	HashArray2D<int,int,ArrayBuffer<int> > m_cells; //!< The entries (see cellEntry()) stored in each non-empty cell.
+
+	Array<int>  m_x1, m_y1, m_x2, m_y2; //!< The range of cells occupied by each element (bounding box for segments).
+	Array<bool> m_contained;            //!< True iff an element is contained in the grid.
+
+	//! A line segment with \a m_x1 <= \a m_x2.
+	struct Segment {
+		double m_x1, m_y1, m_x2, m_y2;
+	};
+
+	Array<bool>    m_isSegment; //!< True iff an element is a segment.
+	Array<Segment> m_segment;   //!< The segment of each element inserted as a segment.
+	Array<ArrayBuffer<int> > m_rows; //!< For segments, the lowest and highest cell of each column (from \a m_x1 to \a m_x2).
+};
+
+
+} // end namespace ogdf
+
+
+#endif
@@ -67,6 +67,9 @@ public:
 
 	double infinity() const;
 
+	int numberOfRows() const { return osi->getNumRows(); }
+	int numberOfColumns() const { return osi->getNumCols(); }
+
 	// Call of LP solver
 	//
 	// Input is an optimization goal, an objective function, a matrix in sparse format, an
@@ -102,6 +105,52 @@ public:
 		Array<double> &x               // x-vector of optimal solution (if result is lpOptimal)
 	);
 
+	// Persistent LP session
+	//
+	// loadProblem() builds the model from the sparse input (same format as in optimize());
+	// afterwards, rows can be added or removed and bounds, objective and right-hand sides
+	// can be changed. resolve() solves the current model, starting from the basis of the
+	// previous solve if there is one.
+
+	void loadProblem(
+		OptimizationGoal goal,               // goal of optimization (minimize or maximize)
+		const Array<double> &obj,            // objective function vector
+		const Array<int>    &matrixBegin,    // matrixBegin[i] = begin of column i
+		const Array<int>    &matrixCount,    // matrixCount[i] = number of nonzeroes in column i
+		const Array<int>    &matrixIndex,    // matrixIndex[n] = index of matrixValue[n] in its column
+		const Array<double> &matrixValue,    // matrixValue[n] = non-zero value in matrix
+		const Array<double> &rightHandSide,  // right-hand side of LP constraints
+		const Array<char>   &equationSense,  // 'E' ==   'G' >=   'L' <=
+		const Array<double> &lowerBound,     // lower bound of x[i]
+		const Array<double> &upperBound      // upper bound of x[i]
+	);
+
+	// adds the row sum(value[j] * x[index[j]]) (equationSense) rightHandSide and returns its index
+	int addRow(
+		const Array<int>    &index,          // column indices of the non-zeroes
+		const Array<double> &value,          // non-zero values
+		char equationSense,                  // 'E' ==   'G' >=   'L' <=
+		double rightHandSide);
+
+	// removes the given rows; the remaining rows keep their order
+	void removeRows(const Array<int> &rows);
+
+	void setRow(int row, char equationSense, double rightHandSide) {
+		osi->setRowType(row, equationSense, rightHandSide, 0.0);
+	}
+	void setColumnBounds(int col, double lowerBound, double upperBound) {
+		osi->setColBounds(col, lowerBound, upperBound);
+	}
+	void setObjective(int col, double coefficient) {
+		osi->setObjCoeff(col, coefficient);
+	}
+
+	// solves the current model
+	Status resolve(
+		double &optimum,               // optimum value of objective function (if result is lpOptimal)
+		Array<double> &x               // x-vector of optimal solution (if result is lpOptimal)
+	);
+
 	bool checkFeasibility(
 		const Array<int>    &matrixBegin,   // matrixBegin[i] = begin of column i
 		const Array<int>    &matrixCount,   // matrixCount[i] = number of nonzeroes in column i
@@ -116,6 +165,7 @@ public:
 
 private:
 	OsiSolverInterface* osi;
+	bool m_solved; // true iff osi holds a basis of a previous solve
 };
 
 
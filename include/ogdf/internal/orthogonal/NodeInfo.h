@@ -181,10 +181,13 @@ public:
 	int gen_pos(OrthoDir od) const { return m_gen_pos[od]; }
 	bool has_gen(OrthoDir od) { return m_gen_pos[od] > -1; }
 
-	bool is_in_edge(OrthoDir od, int pos) {
-		ListConstIterator<bool> b_it = point_in[od].get(pos);
-		return *b_it;
-	}
+	//positional access to the side lists, requires buildSideIndex()
+	bool is_in_edge(OrthoDir od, int pos) const { return m_pointInAt[od][pos]; }
+	edge inEdge(OrthoDir od, int pos) const { return m_inEdgeAt[od][pos]; }
+
+	//builds the positional index of in_edges / point_in, call after
+	//the side lists are complete (they are not changed afterwards)
+	void buildSideIndex();
 
 	//set
 	void reclassify(OrthoDir) { }//set m_nbf, nb, m_routable based on bend_type values on s,
@@ -288,6 +291,9 @@ private:
 	List<edge> in_edges[4]; //inedges on each side will be replaced by dynamic ops
 	//preliminary bugfix of in/out dilemma
 	List<bool> point_in[4]; //save in/out info
+	//array copies of the side lists for constant time access by position
+	Array<edge> m_inEdgeAt[4];
+	Array<bool> m_pointInAt[4];
 	adjEntry m_adj; //entry of inner cage face
 	//degree of expanded vertex
 	int m_vdegree;
@@ -52,6 +52,7 @@
 
 #include <ogdf/basic/Timeouter.h>
 #include <ogdf/basic/Module.h>
+#include <ogdf/module/EdgeInsertionModule.h>
 #include <ogdf/planarity/PlanRepLight.h>
 #include <ogdf/planarity/RemoveReinsertType.h>
 
@@ -69,10 +70,14 @@ namespace ogdf {
 			const EdgeArray<int>      *pCostOrig,
 			const EdgeArray<bool>     *pForbiddenOrig,
 			const EdgeArray<__uint32> *pEdgeSubgraphs)
-			: m_pr(pr), m_pCost(pCostOrig), m_pForbidden(pForbiddenOrig), m_pSubgraph(pEdgeSubgraphs) { }
+			: m_pr(pr), m_pCost(pCostOrig), m_pForbidden(pForbiddenOrig), m_pSubgraph(pEdgeSubgraphs),
+			  m_pCrossingBound(0) { }
 
 		virtual ~VarEdgeInserterCore() { }
 
+		//! Sets the crossing bound (see EdgeInsertionModule::crossingBound()).
+		void crossingBound(const __int32 volatile *pBound) { m_pCrossingBound = pBound; }
+
 		Module::ReturnType call(
 			const Array<edge> &origEdges,
 			RemoveReinsertType rrPost,
@@ -133,6 +138,8 @@ namespace ogdf {
 		node m_v1, m_v2;
 
 		int m_runsPostprocessing; //!< Runs of remove-reinsert method.
+
+		const __int32 volatile *m_pCrossingBound; //!< The crossing bound (0 if not set).
 	};
 
 
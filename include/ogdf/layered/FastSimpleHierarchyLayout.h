@@ -51,7 +51,7 @@
 
 #include <ogdf/module/HierarchyLayoutModule.h>
 #include <ogdf/layered/Hierarchy.h>
-#include <ogdf/basic/NodeArray.h>
+#include <ogdf/basic/Array.h>
 
 namespace ogdf {
 
@@ -69,6 +69,9 @@ namespace ogdf {
  *
  * The <i>Alignment</i> and <i>Horzontal Compactation</i> phase are calculated downward, upward,
  * left-to-right and right-to-left. The four resulting layouts are combined in a balancing step.
+ * Since the four directions are independent of each other, they are computed concurrently
+ * (see option <i>maxThreads</i>). Internally, all per-node data is stored in arrays indexed by
+ * the position of a node in hierarchy order (level by level).
  *
  * The implementation is based on:
  *
@@ -95,6 +98,10 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>downward</i></td><td>bool</td><td>true</td>
  *     <td>determines whether block alignment is computed by a downward (true) or upward traversal</td>
+ *   </tr><tr>
+ *     <td><i>maxThreads</i></td><td>int</td><td>System::numberOfProcessors()</td>
+ *     <td>the maximal number of threads used in balanced mode; the four directions are
+ *     computed concurrently (hence at most 4 threads are used). Set to 1 for sequential behaviour.</td>
  *   </tr>
  * </table>
  */
@@ -106,6 +113,7 @@ private:
 	bool   m_balanced;	//!< stores the option <i>balanced</i>.
 	bool   m_downward;	//!< stores the option <i>downward</i>.
 	bool   m_leftToRight;	//!< stores the option <i>left-to-right</i>.
+	int    m_maxThreads;	//!< stores the option <i>maxThreads</i>.
 
 protected:
 	void doCall(const HierarchyLevels &levels, GraphCopyAttributes &AGC);
@@ -181,59 +189,88 @@ public:
 		m_balanced = b;
 	}
 
+	//! Returns the option <i>maxThreads</i>.
+	int maxThreads() const {
+		return m_maxThreads;
+	}
+
+	//! Sets the option <i>maxThreads</i> to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = n;
+#endif
+	}
+
 
 private:
+	class PackedHierarchy;
+	class Worker;
+
+	/**
+	 * Computes the layout for one of the four directions of the algorithm, i.e.,
+	 * vertical alignment, block widths and horizontal compactation.
+	 *
+	 * @param H The packed hierarchy (with marked type1 conflicts)
+	 * @param x The x-coordinates for each node (calculated by this method)
+	 * @param blockWidth The width of each block, stored for the root (calculated by this method)
+	 * @param root The root for each node (calculated by this method)
+	 * @param downward The level direction
+	 * @param leftToRight The node direction on each level
+	 */
+	void computeDirection(
+		const PackedHierarchy &H,
+		Array<double> &x,
+		Array<double> &blockWidth,
+		Array<int> &root,
+		const bool downward,
+		const bool leftToRight) const;
+
 	/**
 	 * Preprocessing step to find all type1 conflicts.
 	 * A type1 conflict is a crossing of a inner segment with a non-inner segment.
 	 *
-	 * This is for preferring straight inner segments.
+	 * This is for preferring straight inner segments. The conflicts are the same for
+	 * all four directions, so they are stored once in \a H.
 	 *
-	 * @param levels The Hierarchy
-	 * @param downward The level direction
-	 * @param type1Conflicts is assigned the conflicts, (type1Conflicts[v])[u]=true means (u,v) is marked, u is the upper node
+	 * @param H The packed hierarchy; its conflict flags are assigned by this method
 	 */
-	void markType1Conflicts(const HierarchyLevels &levels, bool downward, NodeArray<NodeArray<bool> > &type1Conflicts);
+	void markType1Conflicts(PackedHierarchy &H) const;
 
 	/**
 	 * Align each node to a node on the next higher level. The result is a blockgraph where each
 	 * node is in a block whith a nother node when they have the same root.
 	 *
-	 * @param levels The Hierarchy
+	 * @param H The packed hierarchy
 	 * @param root The root for each node (calculated by this method)
 	 * @param align The alignment to the next level node (align(v)=u <=> u is aligned to v) (calculated by this method)
-	 * @param type1Conflicts Type1 conflicts to prefer straight inner segments
 	 * @param downward The level direction
 	 * @param leftToRight The node direction on each level
 	 */
 	void verticalAlignment(
-		const HierarchyLevels &levels,
-		NodeArray<node> &root,
-		NodeArray<node> &align,
-		const NodeArray<NodeArray<bool> > &type1Conflicts,
+		const PackedHierarchy &H,
+		Array<int> &root,
+		Array<int> &align,
 		const bool downward,
-		const bool leftToRight);
+		const bool leftToRight) const;
 
 	/**
 	 * Computes the width of each block, i.e., the maximal width of a node in the block, and
 	 * stores it in blockWidth for the root of the block.
 	 *
-	 * @param GC The input graph copy
-	 * @param GCA The input graph copies (gives in particular the widths of nodes)
-	 * @param root The root for each node (calculated by this method)
+	 * @param H The packed hierarchy (gives in particular the widths of nodes)
+	 * @param root The root for each node
 	 * @param blockWidth Is assigned the width of each block (stored for the root)
 	 */
 	void computeBlockWidths(
-		const GraphCopy &GC,
-		const GraphCopyAttributes &GCA,
-		NodeArray<node> &root,
-		NodeArray<double> &blockWidth);
+		const PackedHierarchy &H,
+		const Array<int> &root,
+		Array<double> &blockWidth) const;
 
 	/**
 	 * Calculate the coordinates for each node
 	 *
+	 * @param H The packed hierarchy
 	 * @param align The alignment to the next level node (align(v)=u <=> u is aligned to v)
-	 * @param levels The Hierarchy
 	 * @param root The root for each node
 	 * @param blockWidth The width of each block
 	 * @param x The x-coordinates for each node (calculated by this method)
@@ -241,13 +278,13 @@ private:
 	 * @param downward The level direction
 	 */
 	void horizontalCompactation(
-		const NodeArray<node> &align,
-		const HierarchyLevels &levels,
-		const NodeArray<node> &root,
-		const NodeArray<double> &blockWidth,
-		NodeArray<double> &x,
+		const PackedHierarchy &H,
+		const Array<int> &align,
+		const Array<int> &root,
+		const Array<double> &blockWidth,
+		Array<double> &x,
 		const bool leftToRight,
-		bool downward);
+		const bool downward) const;
 
 	/**
 	 * Calculate the coordinate for root nodes (placing)
@@ -256,40 +293,22 @@ private:
 	 * @param sink The Sink for each node. A sink identifies each block class (calculated by this method)
 	 * @param shift The shift for each class (calculated by this method)
 	 * @param x The class relative x-coordinate for each node (calculated by this method)
+	 * @param H The packed hierarchy
 	 * @param align The alignment to the next level node (align(v)=u <=> u is aligned to v)
-	 * @param levels The Hierarchy
 	 * @param blockWidth The width of each block
 	 * @param root The root for each node
 	 * @param leftToRight The node direction on each level
 	 */
 	void placeBlock(
-		node v,
-		NodeArray<node> &sink,
-		NodeArray<double> &shift,
-		NodeArray<double> &x,
-		const NodeArray<node> &align,
-		const HierarchyLevels &levels,
-		const NodeArray<double> &blockWidth,
-		const NodeArray<node> &root,
-		const bool leftToRight);
-
-	/**
-	 * The twin of an inner Segment
-	 *
-	 * @return Parent node which is connected by an inner segment.
-	 * nullptr if there is no parent segment or if the segment is not an inner segment.
-	 */
-	node virtualTwinNode(const HierarchyLevels &levels, const node v, const HierarchyLevels::TraversingDir dir) const;
-
-	/**
-	 * Predecessor of v on the same level,
-	 *
-	 * @param v The node for which the predecessor should be calculated.
-	 * @param levels The Hierarchy
-	 * @param leftToRight If true the left predecessor is choosen. Otherwise the right predecessor.
-	 * @return Predescessor on the same level. nullptr if there is no predecessor.
-	 */
-	node pred(const node v, const HierarchyLevels &levels, const bool leftToRight);
+		int v,
+		Array<int> &sink,
+		Array<double> &shift,
+		Array<double> &x,
+		const PackedHierarchy &H,
+		const Array<int> &align,
+		const Array<double> &blockWidth,
+		const Array<int> &root,
+		const bool leftToRight) const;
 };
 
 } // end namespace ogdf
@@ -0,0 +1,227 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of the network simplex ranking algorithm for
+ *        Sugiyama algorithm.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_NETWORK_SIMPLEX_RANKING_H
+#define OGDF_NETWORK_SIMPLEX_RANKING_H
+
+
+
+#include <ogdf/module/RankingModule.h>
+#include <ogdf/module/AcyclicSubgraphModule.h>
+#include <ogdf/basic/ModuleOption.h>
+#include <ogdf/basic/NodeArray.h>
+#include <ogdf/basic/EdgeArray.h>
+
+
+namespace ogdf {
+
+//! The network simplex ranking algorithm.
+/**
+ * The class NetworkSimplexRanking computes a node ranking with minimal
+ * (weighted) edge lengths by solving the layering LP directly with the network
+ * simplex method on feasible spanning trees, which can be used as first phase
+ * in SugiyamaLayout. It computes the same optimal rankings as OptimalRanking,
+ * but does not need to build a min-cost flow instance.
+ *
+ * The cut values of the tree edges are kept in a cache; after exchanging a tree
+ * edge, only the cut values on the tree path between the endpoints of the entering
+ * edge and the postorder numbering of the subtree below their lowest common
+ * ancestor are updated.
+ *
+ * The algorithm can be warm started from a previous ranking (see callIncremental()).
+ * The given ranks are made feasible and the feasible tree is grown from the edges
+ * that are already tight, so that re-ranking after small modifications of the graph
+ * requires only few pivots. Nodes without a previous rank (negative entries, e.g.,
+ * nodes added after the last call, since the ranking is initialized with default
+ * value -1) are placed as in a cold start.
+ *
+ * The implementation is based on:
+ *
+ * E.R. Gansner, E. Koutsofios, S.C. North, K.-P. Vo: <i>A technique for drawing
+ * directed graphs</i>. IEEE Transactions on Software Engineering 19(3), pp. 214-230, 1993.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>separateMultiEdges</i><td>bool<td>true
+ *     <td>If set to true, multi-edges will span at least two layers.
+ *   </tr><tr>
+ *     <td><i>searchSize</i><td>int<td>30
+ *     <td>The number of tree edges with negative cut value that are inspected
+ *     when searching for a leaving edge (the one with minimal cut value is taken).
+ *   </tr>
+ * </table>
+ *
+ * <H3>%Module options</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>subgraph</i><td>AcyclicSubgraphModule<td>DfsAcyclicSubgraph
+ *     <td>The module for the computation of the acyclic subgraph.
+ *   </tr>
+ * </table>
+ */
+class OGDF_EXPORT NetworkSimplexRanking : public RankingModule {
+
+	ModuleOption<AcyclicSubgraphModule> m_subgraph; //!< The acyclic sugraph module.
+	bool m_separateMultiEdges; //!< Separate multi-edges?
+	int  m_searchSize;         //!< The number of candidates for the leaving edge.
+
+	int  m_numPivots;          //!< The number of pivots performed in the last call.
+
+public:
+	//! Creates an instance of network simplex ranking.
+	NetworkSimplexRanking();
+
+
+	/**
+	 *  @name Algorithm call
+	 *  @{
+	 */
+
+	//! Computes a node ranking of \a G in \a rank.
+	void call(const Graph &G, NodeArray<int> &rank);
+
+	//! Computes a cost-minimal node ranking of \a G for given edge costs and minimal edge lengths in \a rank.
+	/**
+	 * @param G is the input graph.
+	 * @param length specifies the minimal length of each edge.
+	 * @param cost specifies the cost of each edge.
+	 * @param rank is assigned the rank (layer) of each node.
+	 */
+	void call(
+		const Graph &G,
+		const EdgeArray<int> &length,
+		const EdgeArray<int> &cost,
+		NodeArray<int> &rank);
+
+	//! Computes a node ranking of \a G in \a rank, warm started from the ranking in \a rank.
+	/**
+	 * @param G is the input graph.
+	 * @param rank contains a previous ranking of \a G (e.g., computed before \a G was
+	 *        modified) and is assigned the new rank (layer) of each node. Nodes with
+	 *        negative rank have no previous rank. If \a rank is not associated with
+	 *        \a G, a ranking is computed from scratch.
+	 */
+	void callIncremental(const Graph &G, NodeArray<int> &rank);
+
+	//! Computes a cost-minimal node ranking of \a G in \a rank, warm started from the ranking in \a rank.
+	/**
+	 * @param G is the input graph.
+	 * @param length specifies the minimal length of each edge.
+	 * @param cost specifies the cost of each edge.
+	 * @param rank contains a previous ranking of \a G (negative for nodes without
+	 *        previous rank) and is assigned the new rank (layer) of each node.
+	 */
+	void callIncremental(
+		const Graph &G,
+		const EdgeArray<int> &length,
+		const EdgeArray<int> &cost,
+		NodeArray<int> &rank);
+
+
+	/** @}
+	 *  @name Optional parameters
+	 *  @{
+	 */
+
+	//! Returns the current setting of option separateMultiEdges.
+	/**
+	 * If set to true, multi-edges will span at least two layers. Since
+	 * each such edge will have at least one dummy node, the edges will
+	 * automaticall be separated in a Sugiyama drawing.
+	 */
+	bool separateMultiEdges() const { return m_separateMultiEdges; }
+
+	//! Sets the option separateMultiEdges to \a b.
+	void separateMultiEdges(bool b) { m_separateMultiEdges = b; }
+
+	//! Returns the current setting of option searchSize.
+	int searchSize() const { return m_searchSize; }
+
+	//! Sets the option searchSize to \a n (must be at least 1).
+	void searchSize(int n) { m_searchSize = max(1, n); }
+
+	//! Returns the number of pivots (tree edge exchanges) performed in the last call.
+	int numberOfPivots() const { return m_numPivots; }
+
+
+	/** @}
+	 *  @name Module options
+	 *  @{
+	 */
+
+	//! Sets the module for the computation of the acyclic subgraph.
+	void setSubgraph(AcyclicSubgraphModule *pSubgraph) {
+		m_subgraph.set(pSubgraph);
+	}
+
+	//! @}
+
+private:
+	class Solver;
+
+	//! Computes the edges to be reversed and the default edge lengths.
+	void prepare(const Graph &G, EdgeArray<bool> &reversed, EdgeArray<int> *pLength);
+
+	//! Implements the algorithm call.
+	void doCall(const Graph& G,
+		NodeArray<int> &rank,
+		const EdgeArray<bool> &reversed,
+		const EdgeArray<int> &length,
+		const EdgeArray<int> &cost,
+		bool warmStart);
+};
+
+
+} // end namespace ogdf
+
+
+#endif
@@ -52,6 +52,7 @@
 
 
 #include <ogdf/module/HierarchyLayoutModule.h>
+#include <ogdf/basic/NodeArray.h>
 
 
 namespace ogdf {
@@ -67,6 +68,15 @@ namespace ogdf {
  * long vertical segments as in FastHierarchyLayout. An additional balancing
  * can be used which balances the successors below a node.
  *
+ * The LP decomposes into independent subproblems: connected components of the
+ * proper hierarchy (unless their left-to-right order differs between levels), and
+ * blocks of a component separated by levels on which it consists of a single node.
+ * Small components are combined into one subproblem. The subproblems are solved
+ * concurrently (see option <i>maxThreads</i>) and combined by translation, which
+ * yields an optimal solution of the whole LP. Subproblems with more than
+ * <i>maxPartSize</i> nodes, or whose LP cannot be solved, get the x-coordinates
+ * computed by FastSimpleHierarchyLayout instead.
+ *
  * <H3>Optional parameters</H3>
  *
  * <table>
@@ -88,6 +98,13 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>weightBalancing</i><td>double<td>0.1
  *     <td>The weight for balancing successors below a node; 0.0 means no balancing.
+ *   </tr><tr>
+ *     <td><i>maxPartSize</i><td>int<td>0
+ *     <td>The maximal number of nodes of a subproblem solved by an LP; larger subproblems
+ *     are laid out by FastSimpleHierarchyLayout; 0 means no limit.
+ *   </tr><tr>
+ *     <td><i>maxThreads</i><td>int<td>System::numberOfProcessors()
+ *     <td>The maximal number of threads solving subproblems concurrently.
  *   </tr>
  * </table>
  */
@@ -179,6 +196,30 @@ public:
 			m_weightBalancing = w;
 	}
 
+	//! Returns the maximal number of nodes of a subproblem solved by an LP; 0 means no limit.
+	int maxPartSize() const {
+		return m_maxPartSize;
+	}
+
+	//! Sets the maximal number of nodes of a subproblem solved by an LP to \a n; 0 means no limit.
+	void maxPartSize(int n) {
+		if(n >= 0)
+			m_maxPartSize = n;
+	}
+
+	//! Returns the maximal number of threads solving subproblems concurrently.
+	int maxThreads() const {
+		return m_maxThreads;
+	}
+
+	//! Sets the maximal number of threads solving subproblems concurrently to \a n.
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if(n >= 1)
+			m_maxThreads = n;
+#endif
+	}
+
 	//! @}
 
 protected:
@@ -186,9 +227,20 @@ protected:
 	void doCall(const HierarchyLevels &levels,GraphCopyAttributes &AGC);
 
 private:
+	struct SubLP;
+	class SubLPSolver;
+
 	void computeXCoordinates(
 		const HierarchyLevels &levels,
 		GraphCopyAttributes &AGC);
+	void solveSubLP(
+		const HierarchyLevels &levels,
+		const GraphCopyAttributes &AGC,
+		const NodeArray<bool> &isVirtual,
+		const NodeArray<int> &segment,
+		SubLP &lp,
+		Array<int> &col,
+		Array<int> &segCol) const;
 	void computeYCoordinates(
 		const HierarchyLevels &levels,
 		GraphCopyAttributes &AGC);
@@ -200,6 +252,8 @@ private:
 
 	double m_weightSegments;  //!< The weight of edge segments.
 	double m_weightBalancing; //!< The weight for balancing.
+	int    m_maxPartSize;     //!< The maximal size of a subproblem solved by an LP.
+	int    m_maxThreads;      //!< The maximal number of threads.
 
 #endif
 };
@@ -53,6 +53,7 @@
 
 #include <ogdf/module/RankingModule.h>
 #include <ogdf/module/AcyclicSubgraphModule.h>
+#include <ogdf/module/MinCostFlowModule.h>
 #include <ogdf/basic/ModuleOption.h>
 #include <ogdf/basic/NodeArray.h>
 
@@ -86,12 +87,16 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>subgraph</i><td>AcyclicSubgraphModule<td>DfsAcyclicSubgraph
  *     <td>The module for the computation of the acyclic subgraph.
+ *   </tr><tr>
+ *     <td><i>minCostFlow</i><td>MinCostFlowModule<td>MinCostFlowReinelt
+ *     <td>The module for solving the min-cost flow problem (the dual of the ranking LP).
  *   </tr>
  * </table>
  */
 class OGDF_EXPORT OptimalRanking : public RankingModule {
 
 	ModuleOption<AcyclicSubgraphModule> m_subgraph; // option for acyclic sugraph
+	ModuleOption<MinCostFlowModule> m_minCostFlow;  // option for min-cost flow
 	bool m_separateMultiEdges;
 
 public:
@@ -156,6 +161,11 @@ public:
 		m_subgraph.set(pSubgraph);
 	}
 
+	//! Sets the module for solving the min-cost flow problem.
+	void setMinCostFlow(MinCostFlowModule *pMinCostFlow) {
+		m_minCostFlow.set(pMinCostFlow);
+	}
+
 	//! @}
 
 private:
@@ -42,6 +42,7 @@
 #include <ogdf/basic/List.h>
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/CombinatorialEmbedding.h>
 #include <ogdf/planarity/PlanRep.h>
 
@@ -50,6 +51,14 @@
 namespace ogdf {
 
 
+/**
+ * In each iteration, the forces on all nodes are computed first and then the
+ * nodes are moved within their zones. A uniform grid over the nodes and the
+ * edge segments, which is updated after each iteration, restricts the
+ * node-edge repulsion and the zone computation to nearby edges and nodes.
+ * Both passes treat each node independently and are distributed over
+ * several threads (see maxThreads()).
+ */
 class OGDF_EXPORT BertaultLayout : public LayoutModule
 {
 public:
@@ -83,6 +92,26 @@ public:
 	//! Returns the required length
 	double reqlength() { return req_length; }
 
+	//! Sets the cutoff for node-node repulsion (as multiple of the required length); 0 means no cutoff.
+	/**
+	 * With a cutoff, node pairs farther apart do not repel each other, and
+	 * the repulsive forces are computed with the grid instead of for all pairs.
+	 */
+	void repulsionCutoff(double factor) { rep_cutoff=factor; }
+
+	//! Returns the cutoff for node-node repulsion
+	double repulsionCutoff() { return rep_cutoff; }
+
+	//! Sets the maximal number of threads used for computing forces and zones
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		max_threads=n;
+#endif
+	}
+
+	//! Returns the maximal number of threads used for computing forces and zones
+	int maxThreads() { return max_threads; }
+
 	/** Set the initPositions of nodes. Must for graphs without node attributes
 	* c accepts character arguments:
 	* 'm' for Grid-like Layout of nodes
@@ -102,27 +131,37 @@ public:
 
 protected:
 
+	//! a structure which stores the projection of a node on an edge
+	struct proj
+	{
+		double x;
+		double y;
+	};
+
 	//! Calculates the repulsive force on node v due to node j and adds it to total force on v
 	void f_Node_Repulsive(node *v,node *j, GraphAttributes &AG);
 
 	//! Calculates the attractive force on node v due to node j and adds it to total force on v
 	void f_Node_Attractive(node *v,node *j, GraphAttributes &AG);
 
-	//! Computes the projection of node v on the edge (a,b)
-	void compute_I(node *v, edge *e, GraphAttributes &AG);
+	//! Computes the projection i of node v on the edge (a,b)
+	void compute_I(node *v, edge *e, proj &i, GraphAttributes &AG);
 
-	//! Returns true if node i lies on the edge (a,b)
-	bool i_On_Edge(edge *e, GraphAttributes &AG);
+	//! Returns true if the projection i lies on the edge (a,b)
+	bool i_On_Edge(edge *e, const proj &i, GraphAttributes &AG);
 
-	//! Calculates the repulsive force on node v due to the edge on which node i lies and adds it to total force on v
-	void f_Edge(node *v, edge *e, GraphAttributes &AG);
+	//! Calculates the repulsive force (fx,fy) on node v due to the edge on which its projection i lies. The endpoints of the edge get the opposite force
+	void f_Edge(node *v, edge *e, const proj &i, double &fx, double &fy, GraphAttributes &AG);
 
-	//! Calculates the radii of the zones of node v if node i lies on edge (a,b)
-	void r_Calc_On_Edge(node *v, edge *e, GraphAttributes &AG);
+	//! Calculates the radii of the zones of node v if its projection i lies on edge (a,b)
+	void r_Calc_On_Edge(node *v, edge *e, const proj &i, GraphAttributes &AG);
 
-	//! Calculates the radii of the zones of node v if node i does not lie on edge (a,b)
+	//! Calculates the radii of the zones of node v if its projection does not lie on edge (a,b)
 	void r_Calc_Outside_Edge(node *v,edge *e, GraphAttributes &AG);
 
+	//! Calculates the radii of the zones of the endpoint a of an edge due to node w with projection i (onEdge tells if i lies on the edge)
+	void r_Calc_Endpoint(node *a, node *w, const proj &i, bool onEdge, GraphAttributes &AG);
+
 	//! Moves the node v according to the forces Fx and Fy on it. Also ensures that movement is within the respective zones
 	void move(node *v, GraphAttributes &AG);
 
@@ -147,6 +186,9 @@ protected:
 
 
 private:
+	class SpatialIndex;
+	class NodeComputation;
+
 	//! The sections associated with each node
 	class BertaultSections
 	{
@@ -163,6 +205,18 @@ private:
 	};
 
 
+	//! Returns the section (1,...,8) of the direction (x_diff,y_diff)
+	static int section(double x_diff, double y_diff);
+
+	//! Computes the total force on node v
+	void computeForces(node v, GraphAttributes &AG, const SpatialIndex &index, ArrayBuffer<int> &buffer);
+
+	//! Computes the radii of the zones of node v (only the radius of the section in which v moves is exact, and only if it is smaller than the move)
+	void computeZones(node v, GraphAttributes &AG, const SpatialIndex &index, ArrayBuffer<int> &buffer);
+
+	//! Calls computeForces() (or computeZones() if zones is true) for all nodes, using up to max_threads threads
+	void computeAll(bool zones, const Array<node> &nodes, GraphAttributes &AG, const SpatialIndex &index);
+
 	//! preprocessing for ImPrEd
 	void preprocess(GraphAttributes &AG);
 
@@ -181,12 +235,6 @@ private:
 	//! Computes the surrounding edges from the data calculated so far
 	void compute(CCElement* element,PlanRep &PG,GraphAttributes &AG1,GraphCopy &G1);
 
-	//! a structure which stores the projection of a node on an edge
-	struct proj
-	{
-		double x;
-		double y;
-	} i;
 	NodeArray<BertaultSections> sect;				//! Sections associated with all nodes
 	NodeArray<double> F_x;					//! Force in x direction
 	NodeArray<double> F_y;      				//! Force in y direction
@@ -194,6 +242,8 @@ private:
 	double limit;						//! limit is the max distance (between node and its projection) at which the edge force on node is considered
 	int iter_no;						//! number of iterations to be performed
 	bool impred;						//! sets the algorithm to ImPrEd when true
+	double rep_cutoff;					//! cutoff for node-node repulsion (as multiple of req_length), 0 if none
+	int max_threads;					//! maximal number of threads
 	Array2D<bool> surr;					//! stores the indices of the surrounding edges for each node
 
 	OGDF_NEW_DELETE
@@ -52,6 +52,7 @@
 #include <ogdf/basic/Module.h>
 #include <ogdf/basic/Timeouter.h>
 #include <ogdf/planarity/PlanRepLight.h>
+#include <ogdf/planarity/RemoveReinsertType.h>
 
 
 namespace ogdf {
@@ -63,10 +64,13 @@ namespace ogdf {
 	class OGDF_EXPORT EdgeInsertionModule : public Module, public Timeouter {
 	public:
 		//! Initializes an edge insertion module (default constructor).
-		EdgeInsertionModule() { }
+		EdgeInsertionModule() : m_pCrossingBound(0) { }
 
 		//! Initializes an edge insertion module (copy constructor).
-		EdgeInsertionModule(const EdgeInsertionModule &eim) : Timeouter(eim) { }
+		/**
+		 * The crossing bound is not copied.
+		 */
+		EdgeInsertionModule(const EdgeInsertionModule &eim) : Timeouter(eim), m_pCrossingBound(0) { }
 
 		//! Destructor.
 		virtual ~EdgeInsertionModule() { }
@@ -206,6 +210,25 @@ namespace ogdf {
 		}
 
 
+		//! Returns the currently set crossing bound (0 if no bound is set).
+		const __int32 volatile *crossingBound() const { return m_pCrossingBound; }
+
+		//! Sets a (shared) crossing bound; \a pBound = 0 removes the bound.
+		/**
+		 * If a crossing bound is set, an insertion module may abort as soon as the number
+		 * of crossings introduced so far is at least the value pointed to by \a pBound,
+		 * in which case it returns retNoFeasibleSolution. The value may be decreased by
+		 * other threads while the insertion is running (e.g., the best crossing number
+		 * found by parallel permutations in SubgraphPlanarizer).
+		 *
+		 * The bound is only checked if it is valid for the final result, i.e., for unweighted
+		 * insertion without subgraphs and without remove-reinsert postprocessing (which
+		 * might decrease the number of crossings again). Implementations not supporting
+		 * crossing bounds ignore this setting.
+		 */
+		void crossingBound(const __int32 volatile *pBound) { m_pCrossingBound = pBound; }
+
+
 	protected:
 		//! Actual algorithm call that has to be implemented by derived classes.
 		/**
@@ -225,10 +248,28 @@ namespace ogdf {
 			const EdgeArray<bool>     *pForbiddenOrig,
 			const EdgeArray<__uint32> *pEdgeSubGraphs) = 0;
 
+		const __int32 volatile *m_pCrossingBound; //!< The crossing bound (0 if not set).
+
 
 		OGDF_MALLOC_NEW_DELETE
 	};
 
+
+	//! Returns true if an insertion may be aborted since \a cr crossings reach the crossing bound \a pBound.
+	/**
+	 * The bound is only valid for unweighted insertion without subgraphs and without
+	 * remove-reinsert postprocessing (see EdgeInsertionModule::crossingBound()).
+	 */
+	inline bool exceedsCrossingBound(
+		const __int32 volatile    *pBound,
+		RemoveReinsertType         rrPost,
+		const EdgeArray<int>      *pCost,
+		const EdgeArray<__uint32> *pSubgraph,
+		int cr)
+	{
+		return pBound != 0 && rrPost == rrNone && pCost == 0 && pSubgraph == 0 && cr >= *pBound;
+	}
+
 } // end namespace ogdf
 
 #endif
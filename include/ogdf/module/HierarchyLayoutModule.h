@@ -81,6 +81,15 @@ public:
 		AGC.transform();
 	}
 
+	/**
+	 * \brief Computes a hierarchy layout of \a levels in \a AGC.
+	 * @param levels is the input hierarchy.
+	 * @param AGC    is assigned the hierarchy layout (without transforming it to the original graph).
+	 */
+	void call(const HierarchyLevels &levels, GraphCopyAttributes &AGC) {
+		doCall(levels,AGC);
+	}
+
 	//
 	// * \brief Computes a hierarchy layout of \a H in \a AG.
 	// * @param H is the input hierarchy.
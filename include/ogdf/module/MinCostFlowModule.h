@@ -95,6 +95,86 @@ public:
 		NodeArray<int> &dual            // computed dual variables
 		) = 0;
 
+	/**
+	 * \brief Computes a min-cost flow in the directed graph \a G.
+	 *
+	 * This variant does not return the dual variables, which allows implementations
+	 * to skip their computation.
+	 *
+	 * \pre \a G must be connected, \a lowerBound[\a e] \f$\leq\f$ \a upperBound[\a e]
+	 *      for all edges \a e, and the sum over all supplies must be zero.
+	 *
+	 * @param G is the directed input graph.
+	 * @param lowerBound gives the lower bound for the flow on each edge.
+	 * @param upperBound gives the upper bound for the flow on each edge.
+	 * @param cost gives the costs for each edge.
+	 * @param supply gives the supply (or demand if negative) of each node.
+	 * @param flow is assigned the computed flow on each edge.
+	 * \return true iff a feasible min-cost flow exists.
+	 */
+	virtual bool call(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow)             // computed flow
+	{
+		NodeArray<int> dual(G);
+		return call(G, lowerBound, upperBound, cost, supply, flow, dual);
+	}
+
+	/**
+	 * \brief Computes a min-cost flow in the directed graph \a G starting from a given solution.
+	 *
+	 * On entry, \a flow and \a dual contain an initial solution, e.g., the result of a
+	 * previous call for the same graph whose costs, bounds or supplies have been changed
+	 * in place since then. The initial flow need neither respect the bounds (values
+	 * outside are moved to the nearest bound) nor the supplies. The closer the initial
+	 * solution is to an optimal one, the faster implementations supporting warm starts
+	 * are; the default implementation ignores it and calls call().
+	 *
+	 * @param G is the directed input graph.
+	 * @param lowerBound gives the lower bound for the flow on each edge.
+	 * @param upperBound gives the upper bound for the flow on each edge.
+	 * @param cost gives the costs for each edge.
+	 * @param supply gives the supply (or demand if negative) of each node.
+	 * @param flow contains the initial flow and is assigned the computed flow on each edge.
+	 * @param dual contains the initial dual variables and is assigned the computed dual variables.
+	 * \return true iff a feasible min-cost flow exists.
+	 */
+	virtual bool callWarmStart(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow,             // initial and computed flow
+		NodeArray<int> &dual)             // initial and computed dual variables
+	{
+		return call(G, lowerBound, upperBound, cost, supply, flow, dual);
+	}
+
+	/**
+	 * \brief Computes a min-cost flow in the directed graph \a G starting from a given flow.
+	 *
+	 * This variant neither takes initial dual variables nor returns the dual variables;
+	 * see the variant above for the initial flow.
+	 */
+	virtual bool callWarmStart(
+		const Graph &G,                   // directed graph
+		const EdgeArray<int> &lowerBound, // lower bound for flow
+		const EdgeArray<int> &upperBound, // upper bound for flow
+		const EdgeArray<int> &cost,       // cost of an edge
+		const NodeArray<int> &supply,     // supply (if neg. demand) of a node
+		EdgeArray<int> &flow)             // initial and computed flow
+	{
+		return call(G, lowerBound, upperBound, cost, supply, flow);
+	}
+
+	//! Returns the value used as upper bound of edges with unbounded capacity.
+	int infinity() const { return numeric_limits<int>::max(); }
+
 
 	//
 	// static functions
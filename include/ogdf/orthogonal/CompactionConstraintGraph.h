@@ -116,6 +116,8 @@ public:
 
 	edge pathToOriginal(node v) {return m_pathToEdge[v];}
 
+	OGDF_MALLOC_NEW_DELETE
+
 protected:
 	// construction
 	CompactionConstraintGraphBase(const OrthoRep &OR,
@@ -172,17 +172,17 @@ public:
 	//! adjEntries for edges in inLists
 	adjEntry outEntry(NodeInfo& inf, OrthoDir d, int pos) {
 		if (inf.is_in_edge(d, pos))
-			return (*inf.inList(d).get(pos))->adjTarget();
+			return inf.inEdge(d, pos)->adjTarget();
 		else
-			return (*inf.inList(d).get(pos))->adjSource();//we only bend on outentries
+			return inf.inEdge(d, pos)->adjSource();//we only bend on outentries
 	}
 
 	//! adjEntries for edges in inLists
 	adjEntry inEntry(NodeInfo& inf, OrthoDir d, int pos) {
 		if (inf.is_in_edge(d, pos))
-			return (*inf.inList(d).get(pos))->adjSource();
+			return inf.inEdge(d, pos)->adjSource();
 		else
-			return (*inf.inList(d).get(pos))->adjTarget();
+			return inf.inEdge(d, pos)->adjTarget();
 	}
 
 	//! sets position for node v in layout to value x,y, invoked to have central control over change
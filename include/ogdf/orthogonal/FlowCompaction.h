@@ -56,6 +56,8 @@
 #include <ogdf/internal/orthogonal/RoutingChannel.h>
 #include <ogdf/orthogonal/MinimumEdgeDistances.h>
 #include <ogdf/basic/GridLayoutMapped.h>
+#include <ogdf/module/MinCostFlowModule.h>
+#include <ogdf/basic/ModuleOption.h>
 
 
 namespace ogdf {
@@ -65,8 +67,17 @@ namespace ogdf {
 
 
 //! represents compaction algorithm using min-cost flow in the dual of the constraint graph
+/**
+ * Apart from its visibility arcs, the constraint graph for the y-coordinates depends
+ * only on the orthogonal representation and the vertex sizes. It is therefore built on
+ * a separate thread while the x-coordinates are computed (see option maxThreads); the
+ * visibility arcs, which depend on the new x-coordinates, are inserted afterwards.
+ * The result does not depend on the number of threads.
+ */
 class OGDF_EXPORT FlowCompaction
 {
+	class Worker;
+
 public:
 	//! construction
 	FlowCompaction(int maxImprovementSteps = 0,
@@ -137,6 +148,24 @@ public:
 	//! set alignment option
 	void align(bool b) {m_align = b;}
 
+	//! sets the module for solving the min-cost flow problem (default: MinCostFlowReinelt)
+	/**
+	 * The improvement heuristics start each flow computation from the current drawing,
+	 * which only speeds up modules supporting warm starts (see MinCostFlowModule::callWarmStart()),
+	 * e.g., MinCostFlowNetworkSimplex.
+	 */
+	void setMinCostFlow(MinCostFlowModule *pMinCostFlow) { m_minCostFlow.set(pMinCostFlow); }
+
+	//! Returns the maximal number of used threads.
+	int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of used threads to \a n (1 builds and compacts one after the other).
+	void maxThreads(int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		if (n > 0) m_maxThreads = n;
+#endif
+	}
+
 
 private:
 	void computeCoords(
@@ -161,6 +190,8 @@ private:
 	int m_numGenSteps; //!< number of steps reserved for generalization compaction
 	int m_scalingSteps; //!< number of improvement steps with decreasing separation
 	bool m_align; //!< toggle if brother nodes in hierarchies should be aligned
+	ModuleOption<MinCostFlowModule> m_minCostFlow; //!< the min-cost flow algorithm
+	int m_maxThreads; //!< maximal number of used threads
 
 
 	EdgeArray<edge> m_dualEdge;
@@ -55,6 +55,8 @@
 #include <ogdf/orthogonal/MinimumEdgeDistances.h>
 #include <ogdf/basic/GridLayoutMapped.h>
 #include <ogdf/module/OrthoCompactionModule.h>
+#include <ogdf/module/MinCostFlowModule.h>
+#include <ogdf/basic/ModuleOption.h>
 
 
 namespace ogdf {
@@ -110,6 +112,14 @@ public:
 	//! sets number of separation scaling improvement steps
 	void scalingSteps(int sc) {m_scalingSteps = sc;}
 
+	//! sets the module for solving the min-cost flow problem (default: MinCostFlowReinelt)
+	/**
+	 * The improvement heuristics start each flow computation from the current drawing,
+	 * which only speeds up modules supporting warm starts (see MinCostFlowModule::callWarmStart()),
+	 * e.g., MinCostFlowNetworkSimplex.
+	 */
+	void setMinCostFlow(MinCostFlowModule *pMinCostFlow) { m_minCostFlow.set(pMinCostFlow); }
+
 
 private:
 	void computeCoords(
@@ -128,6 +138,7 @@ private:
 	int m_maxImprovementSteps; //!< maximal number of improvement steps
 	bool m_cageExpense; //!< should cageedges be more expensive than others? will be propagated to compactionConstraintGraph
 	int m_scalingSteps; //!< number of improvement steps with decreasing separation
+	ModuleOption<MinCostFlowModule> m_minCostFlow; //!< the min-cost flow algorithm
 
 	EdgeArray<edge> m_dualEdge;
 	EdgeArray<int>  m_flow;
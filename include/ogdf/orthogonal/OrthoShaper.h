@@ -54,6 +54,8 @@
 
 #include <ogdf/orthogonal/OrthoRep.h>
 #include <ogdf/uml/PlanRepUML.h>
+#include <ogdf/graphalg/MinCostFlowReinelt.h>
+#include <ogdf/basic/ModuleOption.h>
 
 
 namespace ogdf {
@@ -67,6 +69,7 @@ public:
 
 	OrthoShaper() {
 		setDefaultSettings();
+		m_minCostFlow.set(new MinCostFlowReinelt);
 	}
 
 	~OrthoShaper() { }
@@ -129,7 +132,12 @@ public:
 	void setBendBound(int i){ OGDF_ASSERT(i >= 0); m_startBoundBendsPerEdge = i;}
 	int getBendBound(){return m_startBoundBendsPerEdge;}
 
+	//! Sets the module for solving the min-cost flow problem (default: MinCostFlowReinelt).
+	void setMinCostFlow(MinCostFlowModule *pMinCostFlow) { m_minCostFlow.set(pMinCostFlow); }
+
 private:
+	ModuleOption<MinCostFlowModule> m_minCostFlow; // option for min-cost flow
+
 	bool m_distributeEdges; // distribute edges among all sides if degree > 4
 	bool m_fourPlanar;      // should the input graph be four planar
 							// (no zero degree)
@@ -161,6 +161,9 @@ protected:
 	//! The number of extracted Structures for statistical purposes
 	int nOfStructures;
 
+	//! Performs a range of randomized extraction runs
+	class RandomizedRuns;
+
 public:
 	//! Constructor
 	BoyerMyrvold() { pBMP = 0; }
@@ -281,6 +284,30 @@ public:
 		bool limitStructures = false,
 		bool randomDFSTree = false,
 		bool avoidE2Minors = true);
+
+	//! Extracts Kuratowski Subdivisions of \a g in several runs with random DFS-Trees
+	/** Each run works on its own copy of \a g, hence \a g is not changed and the runs
+	 * can be distributed over several threads. The subdivisions extracted in run \a i
+	 * are returned in \a output[\a i] and consist of edges of \a g.
+	 * @param g is the input graph; it has to be simple.
+	 * @param output is assigned the subdivisions of each run.
+	 * @param runs is the number of runs.
+	 * @param embeddingGrade is a flag bounding the number of extracted subdivisions per run
+	 * @param bundles extracts much more subdivisions, if set
+	 * @param limitStructures limits the number of Kuratowski Structures to \a embeddingGrade, if set
+	 * @param avoidE2Minors avoids all \a E2-Minors and ensures unique subdivisions, if set
+	 * @param nThreads is the maximal number of threads performing the runs.
+	 * @return true, iff \a g is planar.
+	 */
+	bool extractRandomizedKuratowskis(
+		const Graph& g,
+		Array<SList<KuratowskiWrapper> >& output,
+		int runs,
+		int embeddingGrade,
+		bool bundles = false,
+		bool limitStructures = false,
+		bool avoidE2Minors = true,
+		int nThreads = 1);
 };
 
 }
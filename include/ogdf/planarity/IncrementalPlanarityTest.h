@@ -0,0 +1,175 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class IncrementalPlanarityTest, which tests
+ *        planarity incrementally for edge-by-edge insertion.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_INCREMENTAL_PLANARITY_TEST_H
+#define OGDF_INCREMENTAL_PLANARITY_TEST_H
+
+
+#include <ogdf/basic/NodeArray.h>
+#include <ogdf/basic/EdgeArray.h>
+
+
+namespace ogdf {
+
+class DynamicSPQRForest;
+
+
+//! Incremental planarity test for edge-by-edge insertion.
+/**
+ * An instance of this class maintains the BC-tree and the SPQR-trees of a
+ * connected planar graph \a G (using a DynamicSPQRForest) and answers
+ * queries of the form "is \a G + (\a u,\a v) still planar?" without testing
+ * the whole graph again.
+ *
+ * An edge (\a u,\a v) can be inserted into \a G without destroying planarity
+ * if and only if it can be inserted with zero crossings in an optimal edge
+ * insertion over all embeddings of \a G. Crossings are only caused by
+ * R-nodes on the paths between \a u and \a v in the SPQR-trees of the blocks on
+ * the path between \a u and \a v in the BC-tree. Hence, a query only checks
+ * whether the representatives of \a u and \a v (vertices or virtual edges) share
+ * a face in the embeddings of these R-nodes.
+ *
+ * The embedding of an R-node is computed by the first query visiting it (in time
+ * linear in the size of its skeleton) and kept until an inserted edge changes the
+ * R-node. Inserted edges are merged into the decomposition incrementally and only
+ * invalidate the embeddings of the R-nodes on the paths between their end vertices.
+ * With cached embeddings, a query takes time proportional to the lengths of the
+ * paths and the degrees of the representatives in the R-nodes on the paths. Note,
+ * however, that these R-nodes may be large (in the worst case, the whole graph is
+ * a single R-node which is embedded again after each insertion).
+ *
+ * The implementation is based on:
+ *
+ * C. Gutwenger, P. Mutzel, R. Weiskircher: <i>Inserting an edge into
+ * a planar graph</i>. Algorithmica 41(4), pp. 289-308, 2005.
+ *
+ * Typical use:
+ * \code
+ * IncrementalPlanarityTest test(G); // G is connected and planar
+ * ...
+ * edge e = test.insertEdge(u,v);    // inserts (u,v) into G if G stays planar
+ * \endcode
+ */
+class OGDF_EXPORT IncrementalPlanarityTest
+{
+public:
+	//! Creates the incremental planarity test for graph \a G.
+	/**
+	 * \pre \a G is connected and planar.
+	 *
+	 * \a G is not copied, i.e., edges inserted into \a G by any other means than
+	 * insertEdge() must be passed to updateInsertedEdge().
+	 */
+	explicit IncrementalPlanarityTest(Graph &G);
+
+	~IncrementalPlanarityTest();
+
+	//! Returns true iff \a G remains planar after inserting an edge (\a u,\a v).
+	bool canInsertEdge(node u, node v);
+
+	//! Inserts edge (\a u,\a v) into \a G if \a G remains planar.
+	/**
+	 * @return the new edge, or 0 if inserting (\a u,\a v) would make \a G non-planar.
+	 */
+	edge insertEdge(node u, node v);
+
+	//! Updates the data structure after edge \a e has been inserted into \a G.
+	/**
+	 * \pre \a G is planar (including \a e).
+	 */
+	void updateInsertedEdge(edge e);
+
+	//! Returns the graph.
+	const Graph &graph() const { return m_G; }
+
+private:
+	struct RSkeleton;
+
+	//! Returns true iff an edge can be inserted in the block containing \a sH and \a tH without crossings.
+	bool blockInsertable(node sH, node tH);
+
+	//! Returns the embedded skeleton of R-node \a vT (computed if not cached).
+	RSkeleton &skeleton(node vT);
+
+	//! Returns the node representing \a xH in the cached skeleton of \a vT.
+	node skeletonNode(node vT, node xH) const;
+
+	//! Discards the cached embeddings of R-nodes changed by inserting an edge between \a u and \a v.
+	void invalidatePath(node u, node v);
+
+	//! Returns true iff \a xH is a vertex of the skeleton of \a vT.
+	bool containsVertex(node vT, node xH) const;
+
+	//! Returns true iff the representatives of \a sH / \a eS and \a tH / \a eT share a face in R-node \a vT.
+	/**
+	 * \a eS (\a eT) is the virtual edge in the skeleton of \a vT leading to the predecessor (successor)
+	 * of \a vT on the path in the SPQR-tree, or 0 if \a vT contains \a sH (\a tH).
+	 */
+	bool shareFace(node vT, edge eS, edge eT, node sH, node tH);
+
+	//! Initializes the arrays for the decomposition \a m_pForest.
+	void initForest();
+
+	//! Discards all cached embeddings.
+	void clearSkeletons();
+
+	Graph             &m_G;       //!< The (planar) graph.
+	DynamicSPQRForest *m_pForest; //!< The BC- and SPQR-trees of \a m_G (0 if \a m_G has no edges).
+	NodeArray<node>    m_skelNode; //!< Maps nodes in the auxiliary graph of \a m_pForest to a skeleton (while building it).
+	EdgeArray<edge>    m_skelEdge; //!< Maps edges in the auxiliary graph of \a m_pForest to the cached skeleton of their R-node.
+	NodeArray<RSkeleton*> m_rSkeleton; //!< The cached embedded skeleton of each R-node (or 0).
+	int                m_stamp;   //!< Counter for marking faces of cached skeletons in queries.
+
+	// avoid automatic creation of copy constructor and assignment operator
+	IncrementalPlanarityTest(const IncrementalPlanarityTest &);
+	IncrementalPlanarityTest &operator=(const IncrementalPlanarityTest &);
+};
+
+
+} // end namespace ogdf
+
+
+#endif
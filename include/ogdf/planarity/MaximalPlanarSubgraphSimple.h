@@ -60,7 +60,9 @@ namespace ogdf {
 //---------------------------------------------------------
 // MaximalPlanarSubgraphSimple
 // implements a maximal planar subgraph algorithm using
-// planarity testing
+// planarity testing; after inserting a spanning forest,
+// the remaining edges are tested with an incremental
+// planarity test (see IncrementalPlanarityTest)
 //---------------------------------------------------------
 class OGDF_EXPORT MaximalPlanarSubgraphSimple : public PlanarSubgraphModule
 {
@@ -90,6 +92,18 @@ protected:
 		List<edge> &delEdges,
 		const EdgeArray<int>  *pCost,
 		bool preferedImplyPlanar);
+
+private:
+	// finds the root of the tree containing v (with path halving)
+	static node findRoot(NodeArray<node> &parent, node v);
+
+	// inserts eG into H if it connects two trees of the spanning forest
+	static void insertForestEdge(
+		edge eG,
+		NodeArray<node> &parent,
+		const NodeArray<node> &mapToH,
+		EdgeArray<bool> &visited,
+		Graph &H);
 };
 
 
@@ -136,6 +136,7 @@ public:
 		ATTRIBUTE( bool, bundle )
 		ATTRIBUTE( bool, noE2 )
 		ATTRIBUTE( bool, veryDifferent )
+		ATTRIBUTE( int, threads )
 	public:
 		BoyerMyrvoldSeparationParams() :
 			_runs(20),
@@ -145,7 +146,8 @@ public:
 			_maxCuts(1000),
 			_bundle(false),
 			_noE2(true),
-			_veryDifferent(false) {}
+			_veryDifferent(false),
+			_threads(System::numberOfProcessors()) {}
 	};
 
 protected:
@@ -98,6 +98,15 @@ namespace ogdf
  *     algorithm. At the moment, each permutation is parallelized, hence the there will
  *     never be used more threads than permutations. To achieve sequential behaviour, set
  *     maxThreads to 1.
+ *     Each thread keeps track of its own best solution and aborts an edge insertion
+ *     phase as soon as the best crossing number found by any thread is reached (if the
+ *     edge insertion module supports crossing bounds, see EdgeInsertionModule::crossingBound()).
+ *     Only the best solution found by any thread is stored.
+ *
+ *     Note that the crossing bound is only applied without remove-reinsert postprocessing,
+ *     since postprocessing may still decrease the number of crossings. Hence, it has no
+ *     effect with the default edge insertion module (VariableEmbeddingInserter with
+ *     remove-reinsert rrAll); use rrNone in order to benefit from it.
  *   </tr>
  * </table>
  *
@@ -186,6 +195,16 @@ private:
 #endif
 	);
 
+	static bool insertEdges(
+		PlanRepLight &prl,
+		int cc,
+		const EdgeArray<int>  *pCost,
+		const EdgeArray<bool> *pForbid,
+		const EdgeArray<__uint32> *pEdgeSubGraphs,
+		const Array<edge> &deletedEdges,
+		EdgeInsertionModule &inserter,
+		int &crossingNumber);
+
 	static bool doSinglePermutation(
 		PlanRepLight &prl,
 		int cc,
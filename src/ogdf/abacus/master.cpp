@@ -46,6 +46,8 @@
 #include <ogdf/abacus/setbranchrule.h>
 #include <ogdf/abacus/standardpool.h>
 
+#include <ogdf/basic/Thread.h>
+
 namespace abacus {
 
 const char* Master::STATUS_[] = {
@@ -165,6 +167,9 @@ Master::Master(
 	varElimEps_(0.001),
 	conElimAge_(1),
 	varElimAge_(1),
+	cutPoolMaxAge_(0),
+	cutPoolMaxSize_(0),
+	poolSlackEps_(0.001),
 	status_(Unprocessed),
 	nSub_(0),
 	nLp_(0),
@@ -174,7 +179,14 @@ Master::Master(
 	nRemCons_(0),
 	nAddVars_(0),
 	nRemVars_(0),
-	nNewRoot_(0)
+	nNewRoot_(0),
+	nThreads_(1),
+	treeLock_(0),
+	treeChanged_(0),
+	nBusy_(0),
+	stopThreads_(false),
+	threadFailed_(false),
+	threadFailure_(ogdf::afcUnknown)
 {
 	_createLpMasters();
 	// Master::Master(): allocate some members
@@ -310,17 +322,30 @@ Master::STATUS Master::optimize()
 	*   If the optimization of a subproblem fails we quit the optimization
 	*   immediately..
 	*/
-	Sub *current;
+	if (nThreads_ > 1)
+		_optimizeParallel();
+	else {
+		Sub *current;
 
-	while ((current = select())) {
-		++nSubSelected_;
+		while ((current = select())) {
+			++nSubSelected_;
 
-		if (current->optimize()) {
-			status_ = Error;
-			break;
+			if (current->optimize()) {
+				status_ = Error;
+				break;
+			}
 		}
 	}
 
+	// fathom the remaining tree after an early termination
+	/* If one of the criteria for early termination is satisfied then
+	*   we fathom all subproblems of the tree, in order to perform a
+	*   correct cleaning up.
+	*/
+	if (status_ == Guaranteed || status_ == MaxCpuTime ||
+		status_ == MaxCowTime || status_ == MaxNSub)
+		root_->fathomTheSubTree();
+
 	if (status_ == Processing) status_ = Optimal;
 
 	// output history and statistics
@@ -487,8 +512,11 @@ void Master::initializePools(
 	*   the pool is automatically increased if it is full and an insertion
 	*   is performed.
 	*/
-	if (cutPoolSize > 0)
+	if (cutPoolSize > 0) {
 		cutPool_ = new StandardPool<Constraint, Variable>(this, cutPoolSize, dynamicCutPool);
+		cutPool_->maxSize(cutPoolMaxSize_);
+		cutPool_->maxAge(cutPoolMaxAge_);
+	}
 }
 
 
@@ -524,8 +552,8 @@ Sub* Master::select()
 {
 	// check if we should terminate the optimization
 	/* If one of the criteria for early termination is satisfied then
-	*   we fathom all subproblems of the tree, in order to perform a
-	*   correct cleaning up.
+	*   the status is set accordingly and the remaining subproblems are
+	*   fathomed by optimize().
 	*
 	*   The maximal level of the enumeration tree is no termination criterion
 	*   in this sense, because it only prevents the generation of further
@@ -535,7 +563,6 @@ Sub* Master::select()
 	if (totalTime_.exceeds(maxCpuTime())) {
 		Logger::ilout(Logger::LL_DEFAULT) << "Maximal CPU time " << maxCpuTimeAsString() << " exceeded." << endl
 		 << "Stop optimization." << endl;
-		root_->fathomTheSubTree();
 		status_ = MaxCpuTime;
 		return 0;
 	}
@@ -543,7 +570,6 @@ Sub* Master::select()
 	if (totalCowTime_.exceeds(maxCowTime())) {
 		Logger::ilout(Logger::LL_DEFAULT) << "Maximal elapsed time " << maxCowTimeAsString() << " exceeded." << endl
 		 << "Stop optimization." << endl;
-		root_->fathomTheSubTree();
 		status_ = MaxCowTime;
 		return 0;
 	}
@@ -553,7 +579,6 @@ Sub* Master::select()
 		 << "Guarantee " << requiredGuarantee() << " % reached." << endl
 		 << "Terminate optimization." << endl;
 		status_ = Guaranteed;
-		root_->fathomTheSubTree();
 		return 0;
 	}
 
@@ -562,7 +587,6 @@ Sub* Master::select()
 		 << "Maximal number of subproblems reached: " << maxNSub() << endl
 		 << "Terminate optimization." << endl;
 		status_ = MaxNSub;
-		root_->fathomTheSubTree();
 		return 0;
 	}
 
@@ -570,6 +594,117 @@ Sub* Master::select()
 }
 
 
+//! Optimizes subproblems in the parallel mode (see Master::nThreads()).
+class Master::Worker : public ogdf::Thread {
+
+	Master *master_;
+	int id_;
+
+public:
+	Worker(Master *master, int id) : master_(master), id_(id) { }
+
+protected:
+	virtual void doWork() { master_->_processOpenSubs(id_); }
+};
+
+
+void Master::_optimizeParallel()
+{
+	ogdf::CriticalSection treeLock;
+	ogdf::ConditionVariable treeChanged;
+
+	treeLock_ = &treeLock;
+	treeChanged_ = &treeChanged;
+	runningSub_.init(nThreads_);
+	runningSub_.fill(0);
+	nBusy_ = 0;
+	stopThreads_  = false;
+	threadFailed_ = false;
+
+	// the calling thread is the first one processing subproblems
+	ogdf::Array<Worker*> thread(1, nThreads_-1);
+	for (int i = 1; i < nThreads_; i++) {
+		thread[i] = new Worker(this, i);
+		thread[i]->start();
+	}
+
+	_processOpenSubs(0);
+
+	for (int i = 1; i < nThreads_; i++) {
+		thread[i]->join();
+		delete thread[i];
+	}
+
+	treeLock_ = 0;
+	treeChanged_ = 0;
+	runningSub_.init();
+
+	if (threadFailed_)
+		OGDF_THROW_PARAM(AlgorithmFailureException, threadFailure_);
+}
+
+
+void Master::_processOpenSubs(int id)
+{
+	treeLock_->enter();
+
+	while (!stopThreads_) {
+		Sub *current = select();
+
+		// no open subproblem available
+		/* We stop all threads if the optimization terminates early or
+		*   if no other thread is busy, i.e., the tree is processed completely.
+		*   Otherwise, the busy threads might still generate new subproblems.
+		*/
+		if (current == 0) {
+			if (nBusy_ == 0 || (status_ != Processing && status_ != MaxLevel)) {
+				stopThreads_ = true;
+				break;
+			}
+
+			// wait until a busy thread adds a subproblem or finishes
+			treeChanged_->wait(*treeLock_);
+			continue;
+		}
+
+		++nSubSelected_;
+		++nBusy_;
+		runningSub_[id] = current;
+
+		// exceptions cannot leave the thread, hence optimize() rethrows them after all threads are finished
+		int error;
+		try {
+			error = current->optimize();
+		}
+		catch (AlgorithmFailureException &e) {
+			threadFailed_  = true;
+			threadFailure_ = e.exceptionCode();
+			error = 1;
+		}
+		catch (...) {
+			threadFailed_  = true;
+			threadFailure_ = ogdf::afcUnknown;
+			error = 1;
+		}
+
+		runningSub_[id] = 0;
+		--nBusy_;
+
+		if (error) {
+			status_ = Error;
+			stopThreads_ = true;
+		}
+
+		// waiting threads have to check whether the optimization is finished
+		_treeChanged();
+	}
+
+	// wake up the threads still waiting for open subproblems
+	_treeChanged();
+	treeLock_->leave();
+}
+
+
 int Master::enumerationStrategy(const Sub *s1, const Sub *s2)
 {
 	switch (enumerationStrategy_) {
@@ -778,7 +913,7 @@ void Master::rRoot(Sub *newRoot, bool /* reoptimize */)
 	Logger::ilout(Logger::LL_DEFAULT) << "\t" << "subproblem " << newRoot->id() << " is now root of remaining tree" << endl;
 
 	if ((newRoot->status() == Sub::Processed ||
-		newRoot->status() == Sub::Dormant     ) && newRootReOptimize_)
+		newRoot->status() == Sub::Dormant     ) && newRootReOptimize_ && treeLock_ == 0)
 		newRoot->reoptimize();
 
 	++nNewRoot_;
@@ -1158,6 +1293,15 @@ void Master::assignParameters()
 	*/
 	getParameter("OptimumFileName", optimumFileName_);
 
+	// get the number of threads processing subproblems concurrently
+	/* This parameter is optional, too. Without thread-safe memory pools
+	*   the subproblems are always processed sequentially.
+	*/
+#ifndef OGDF_MEMORY_POOL_NTS
+	if (getParameter("NThreads", nThreads_) == 0 && nThreads_ < 1)
+		nThreads_ = 1;
+#endif
+
 	// should the average distance of the cuts per iteration be output?
 	assignParameter(showAverageCutDistance_, "ShowAverageCutDistance");
 
@@ -1179,6 +1323,14 @@ void Master::assignParameters()
 	// get the age for variable elimination
 	assignParameter(varElimAge_, "VarElimAge", 1, numeric_limits<int>::max());
 
+	// get the aging and the maximal size of the cut pools
+	/* These parameters are optional, the values set before the optimization
+	*   are kept if they are missing.
+	*/
+	getParameter("CutPoolMaxAge", cutPoolMaxAge_);
+	getParameter("CutPoolMaxSize", cutPoolMaxSize_);
+	getParameter("PoolSlackEps", poolSlackEps_);
+
 	// should a log-file of the enumeration tree be generated?
 	VbcLog_ = (VBCMODE) findParameter("VbcLog", 3, VBCMODE_);
 
@@ -1255,6 +1407,8 @@ void Master::printParameters() const
 	 << onOff(eliminateFixedSet_) << endl
 	 << "  Reoptimization after a root change     : "
 	 << onOff(newRootReOptimize_) << endl
+	 << "  Number of threads                      : "
+	 << nThreads_ << endl
 	 << "  File storing optimum solutions         : "
 	 << optimumFileName_ << endl
 	 << "  Show average distance of added cuts    : "
@@ -1271,6 +1425,12 @@ void Master::printParameters() const
 	 << conElimAge_ << endl
 	 << "  Age for variable elimination           : "
 	 << varElimAge_ << endl
+	 << "  Age for cut pool elimination           : "
+	 << cutPoolMaxAge_ << endl
+	 << "  Maximal size of cut pools              : "
+	 << cutPoolMaxSize_ << endl
+	 << "  Tolerance for pool elimination         : "
+	 << poolSlackEps_ << endl
 	 << "  Default LP-solver                      : "
 	 << OSISOLVER_[defaultLpSolver_] << endl
 	 << "  Usage of approximate solver            : "
@@ -274,16 +274,32 @@ int Sub::optimize()
 	*   dual bound of the subproblem and the dual bounds of the
 	*   subproblems which still have to be processed if this
 	*   is a maximization (minimization) problem.
+	*
+	*   In the parallel mode, the subproblems optimized by the other threads
+	*   are not open, but have to be taken into account as well.
 	*/
 	double newDual = dualBound_;
+	double openDual = master_->openSub()->dualBound();
+
+	for (int i = 0; i < master_->runningSub_.size(); i++) {
+		Sub *s = master_->runningSub_[i];
+		if (s == 0) continue;
+		if (master_->optSense()->max()) {
+			if (s->dualBound() > openDual)
+				openDual = s->dualBound();
+		}
+		else
+			if (s->dualBound() < openDual)
+				openDual = s->dualBound();
+	}
 
 	if (master_->optSense()->max()) {
-		if (master_->openSub()->dualBound() > newDual)
-			newDual = master_->openSub()->dualBound();
+		if (openDual > newDual)
+			newDual = openDual;
 	}
 	else
-		if (master_->openSub()->dualBound() < newDual)
-			newDual = master_->openSub()->dualBound();
+		if (openDual < newDual)
+			newDual = openDual;
 
 	if (master_->betterDual(newDual)) master_->dualBound(newDual);
 
@@ -1133,7 +1149,16 @@ int Sub::solveLp ()
 
 	localTimer_.start(true);
 
-	status = lp_->optimize(lpMethod_);
+	// in the parallel mode, other threads may continue while the LP is solved
+	master_->_unlockTree();
+	try {
+		status = lp_->optimize(lpMethod_);
+	}
+	catch (...) {
+		master_->_lockTree();
+		throw;
+	}
+	master_->_lockTree();
 	lastLP_ = lpMethod_;
 
 	master_->lpSolverTime_.addCentiSeconds( lp_->lpSolverTime_.centiSeconds() );
@@ -1552,6 +1577,10 @@ int Sub::addCons(
 			lastInserted = i - 1;
 			break;
 		}
+		else if (slot->conVar()->locked()) {
+			// a NonDuplPool returns the slot of an equal constraint, which may be buffered already
+			continue;
+		}
 		else {
 			if (keepInPool)
 				keepIt = (*keepInPool)[i];
@@ -1655,6 +1684,10 @@ int Sub::addVars(
 			lastInserted = i - 1;
 			break;
 		}
+		else if (slot->conVar()->locked()) {
+			// a NonDuplPool returns the slot of an equal variable, which may be buffered already
+			continue;
+		}
 		else {
 			if (keepInPool)
 				keepIt = (*keepInPool)[i];
@@ -1805,6 +1838,7 @@ Sub::PHASE Sub::branching()
 		if (!master_->openSub()->empty()) {
 			Logger::ilout(Logger::LL_MEDIUM) << "making node dormant" << endl;
 			master_->openSub()->insert(this);
+			master_->_treeChanged();
 			status_ = Dormant;
 			nDormantRounds_ = 0;
 			return Done;
@@ -1839,6 +1873,7 @@ Sub::PHASE Sub::branching()
 		for (int i = 0; i < nRules; i++) {
 			newSub = generateSon(rules[i]);
 			master_->openSub()->insert(newSub);
+			master_->_treeChanged();
 			sons_->push(newSub);
 			master_->treeInterfaceNewNode(newSub);
 		}
@@ -2914,6 +2949,15 @@ int Sub::fix(int i, FSVarStat *newStat, bool &newValue)
 
 	v->fsVarStat()->status(newStat);
 
+	// a contradiction fathoms the subproblem anyway
+	/* In this case the bounds derived from the local status must neither
+	*   be used for the subproblem nor for the globally fixed variable.
+	*/
+	if (contra) {
+		newValue = false;
+		return 1;
+	}
+
 	// is variable fixed to a new value
 	double x = xVal_[i];
 	if ((newStat->status() == FSVarStat::FixedToLowerBound
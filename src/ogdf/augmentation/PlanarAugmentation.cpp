@@ -46,6 +46,7 @@
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/basic/extended_graph_alg.h>
 #include <ogdf/decomposition/DynamicBCTree.h>
+#include <ogdf/planarity/IncrementalPlanarityTest.h>
 
 
 // for debug-outputs
@@ -118,6 +119,7 @@ void PlanarAugmentation::doCall(Graph& g, List<edge>& L)
 		}
 
 		m_pBCTree = new DynamicBCTree(*m_pGraph);
+		m_pPlanarityTest = new IncrementalPlanarityTest(*m_pGraph);
 
 		// init the m_adjNonChildren-NodeArray with all adjEntries of the bc-tree
 		m_adjNonChildren.init(m_pBCTree->m_B);
@@ -430,6 +432,7 @@ void PlanarAugmentation::reduceChain(node p, pa_label labelOld)
 
 		// update the bc-Tree with new edge
 		m_pBCTree->updateInsertedEdge(e);
+		m_pPlanarityTest->updateInsertedEdge(e);
 
 		// find the new arised pendant
 		node newPendant = m_pBCTree->find(p);
@@ -617,16 +620,9 @@ bool PlanarAugmentation::planarityCheck(node v1, node v2)
 	}
 
 	// test planarity for edge (v1, v2)
-	edge e = m_pGraph->newEdge(v1, v2);
-
 	m_nPlanarityTests++;
 
-	bool planar = planarEmbed(*m_pGraph);
-
-	// finally delete the edge
-	m_pGraph->delEdge(e);
-
-	return planar;
+	return m_pPlanarityTest->canInsertEdge(v1, v2);
 }
 
 
@@ -1403,6 +1399,7 @@ void PlanarAugmentation::updateNewEdges(const SList<edge> &newEdges)
 		SList<node>& path = m_pBCTree->findPath((*edgeIt)->source(), (*edgeIt)->target());
 
 		m_pBCTree->updateInsertedEdge(*edgeIt);
+		m_pPlanarityTest->updateInsertedEdge(*edgeIt);
 		node newBlock = m_pBCTree->DynamicBCTree::bcproper(*edgeIt);
 
 		updateAdjNonChildren(newBlock, path);
@@ -1441,6 +1438,7 @@ void PlanarAugmentation::terminate()
 		m_adjNonChildren[v].clear();
 
 	delete(m_pBCTree);
+	delete(m_pPlanarityTest);
 }
 
 } // end namespace ogdf
@@ -0,0 +1,213 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class SparseLinearSolver.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/basic/SparseLinearSolver.h>
+#include <ogdf/basic/System.h>
+
+
+namespace ogdf {
+
+
+SparseLinearSolver::SparseLinearSolver()
+{
+	m_method        = lsConjugateGradient;
+	m_tolerance     = 1e-8;
+	m_maxIterations = 10000;
+	m_relaxation    = 1.0;
+
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = System::numberOfProcessors();
+#endif
+
+	m_numIterations = 0;
+	m_residual      = 0.0;
+}
+
+
+// returns the Euclidean norm of v
+static double norm(const Array<double> &v)
+{
+	double sum = 0.0;
+	for(int i = v.low(); i <= v.high(); ++i)
+		sum += v[i] * v[i];
+	return sqrt(sum);
+}
+
+
+// returns the scalar product of u and v
+static double dot(const Array<double> &u, const Array<double> &v)
+{
+	double sum = 0.0;
+	for(int i = u.low(); i <= u.high(); ++i)
+		sum += u[i] * v[i];
+	return sum;
+}
+
+
+bool SparseLinearSolver::solve(const SparseMatrix &A, const Array<double> &b, Array<double> &x)
+{
+	OGDF_ASSERT(A.finalized());
+	OGDF_ASSERT(A.numberOfRows() == A.numberOfColumns());
+	OGDF_ASSERT(b.size() == A.numberOfRows());
+
+	const int n = A.numberOfRows();
+	if(x.size() != n) {
+		x.init(n);
+		x.fill(0.0);
+	}
+
+	m_numIterations = 0;
+	m_residual      = 0.0;
+
+	// the zero vector solves a homogeneous system
+	if(norm(b) == 0.0) {
+		x.fill(0.0);
+		return true;
+	}
+
+	return (m_method == lsSOR) ? solveSOR(A, b, x) : solveCG(A, b, x);
+}
+
+
+bool SparseLinearSolver::solveCG(const SparseMatrix &A, const Array<double> &b, Array<double> &x)
+{
+	const int n = A.numberOfRows();
+	const double bNorm = norm(b);
+
+	// Jacobi preconditioner
+	Array<double> invDiag(n);
+	int i;
+	for(i = 0; i < n; ++i) {
+		double d = A(i,i);
+		invDiag[i] = (d != 0.0) ? 1.0 / d : 1.0;
+	}
+
+	Array<double> r(n), z(n), p(n), q(n);
+
+	// r = b - A x
+	A.multiply(x, q, m_maxThreads);
+	for(i = 0; i < n; ++i) {
+		r[i] = b[i] - q[i];
+		p[i] = z[i] = invDiag[i] * r[i];
+	}
+	double rz = dot(r, z);
+
+	m_residual = norm(r) / bNorm;
+	while(m_residual > m_tolerance && m_numIterations < m_maxIterations)
+	{
+		// q = A p
+		A.multiply(p, q, m_maxThreads);
+
+		double pq = dot(p, q);
+		if(pq <= 0.0)
+			break; // A is not positive definite (or we are done numerically)
+
+		// update x, r and z = M^-1 r in a single pass
+		double alpha = rz / pq;
+		double rr = 0.0, rzNew = 0.0;
+		for(i = 0; i < n; ++i) {
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+			z[i]  = invDiag[i] * r[i];
+			rr    += r[i] * r[i];
+			rzNew += r[i] * z[i];
+		}
+
+		double beta = rzNew / rz;
+		rz = rzNew;
+		for(i = 0; i < n; ++i)
+			p[i] = z[i] + beta * p[i];
+
+		++m_numIterations;
+		m_residual = sqrt(rr) / bNorm;
+	}
+
+	return m_residual <= m_tolerance;
+}
+
+
+bool SparseLinearSolver::solveSOR(const SparseMatrix &A, const Array<double> &b, Array<double> &x)
+{
+	const int n = A.numberOfRows();
+	const double bNorm = norm(b);
+	const double omega = m_relaxation;
+
+	Array<double> diag(n);
+	int i;
+	for(i = 0; i < n; ++i) {
+		diag[i] = A(i,i);
+		if(diag[i] == 0.0)
+			return false; // SOR requires non-zero diagonal entries
+	}
+
+	Array<double> r(n);
+	for(;;)
+	{
+		// check the residual b - A x
+		A.multiply(x, r, m_maxThreads);
+		for(i = 0; i < n; ++i)
+			r[i] = b[i] - r[i];
+		m_residual = norm(r) / bNorm;
+
+		if(m_residual <= m_tolerance || m_numIterations >= m_maxIterations)
+			break;
+
+		// one sweep over all rows, using the values already updated
+		for(i = 0; i < n; ++i) {
+			double sigma = 0.0;
+			for(int k = A.rowBegin(i); k < A.rowEnd(i); ++k) {
+				int j = A.column(k);
+				if(j != i)
+					sigma += A.value(k) * x[j];
+			}
+			x[i] = (1.0 - omega) * x[i] + omega * (b[i] - sigma) / diag[i];
+		}
+
+		++m_numIterations;
+	}
+
+	return m_residual <= m_tolerance;
+}
+
+
+} // end namespace ogdf
@@ -0,0 +1,225 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class SparseMatrix.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/basic/SparseMatrix.h>
+#include <ogdf/basic/ParallelRange.h>
+
+
+namespace ogdf {
+
+
+void SparseMatrix::init(int rows, int cols)
+{
+	OGDF_ASSERT(rows >= 0 && cols >= 0);
+
+	m_rows = rows;
+	m_cols = cols;
+
+	m_rowStart.init(rows+1);
+	for(int i = 0; i <= rows; ++i)
+		m_rowStart[i] = 0;
+	m_column.init();
+	m_value .init();
+
+	m_tripletRow  .clear();
+	m_tripletCol  .clear();
+	m_tripletValue.clear();
+}
+
+
+void SparseMatrix::finalize()
+{
+	if(finalized())
+		return;
+
+	// entries already stored are treated like newly added ones
+	for(int i = 0; i < m_rows; ++i) {
+		for(int k = m_rowStart[i]; k < m_rowStart[i+1]; ++k) {
+			m_tripletRow  .push(i);
+			m_tripletCol  .push(m_column[k]);
+			m_tripletValue.push(m_value[k]);
+		}
+	}
+
+	const int nnz = m_tripletRow.size();
+
+	// sort the entries by column (counting sort) ...
+	Array<int> count(0, max(m_rows, m_cols), 0);
+	int k;
+	for(k = 0; k < nnz; ++k)
+		++count[m_tripletCol[k]+1];
+	for(int j = 1; j <= m_cols; ++j)
+		count[j] += count[j-1];
+
+	Array<int> byColumn(max(1,nnz));
+	for(k = 0; k < nnz; ++k)
+		byColumn[count[m_tripletCol[k]]++] = k;
+
+	// ... and stably by row, so that the entries of each row are sorted by column
+	for(int i = 0; i <= m_rows; ++i)
+		count[i] = 0;
+	for(k = 0; k < nnz; ++k)
+		++count[m_tripletRow[k]+1];
+	for(int i = 1; i <= m_rows; ++i)
+		count[i] += count[i-1];
+
+	Array<int> sorted(max(1,nnz));
+	for(int l = 0; l < nnz; ++l) {
+		k = byColumn[l];
+		sorted[count[m_tripletRow[k]]++] = k;
+	}
+
+	// build the compressed rows and sum up duplicate entries
+	m_column.init(max(1,nnz));
+	m_value .init(max(1,nnz));
+
+	int pos = 0;
+	int l = 0;
+	for(int i = 0; i < m_rows; ++i) {
+		m_rowStart[i] = pos;
+		for(; l < nnz && m_tripletRow[sorted[l]] == i; ++l) {
+			k = sorted[l];
+			if(pos > m_rowStart[i] && m_column[pos-1] == m_tripletCol[k])
+				m_value[pos-1] += m_tripletValue[k];
+			else {
+				m_column[pos] = m_tripletCol[k];
+				m_value [pos] = m_tripletValue[k];
+				++pos;
+			}
+		}
+	}
+	m_rowStart[m_rows] = pos;
+
+	m_tripletRow  .clear();
+	m_tripletCol  .clear();
+	m_tripletValue.clear();
+}
+
+
+double SparseMatrix::operator()(int i, int j) const
+{
+	OGDF_ASSERT(0 <= i && i < m_rows && 0 <= j && j < m_cols);
+
+	// binary search in row i
+	int lo = m_rowStart[i], hi = m_rowStart[i+1];
+	while(lo < hi) {
+		int mid = (lo + hi) / 2;
+		if(m_column[mid] < j)
+			lo = mid+1;
+		else
+			hi = mid;
+	}
+
+	return (lo < m_rowStart[i+1] && m_column[lo] == j) ? m_value[lo] : 0.0;
+}
+
+
+void SparseMatrix::multiplyRows(const double *x, double *y, int begin, int end) const
+{
+	const int    *col = m_column.begin();
+	const double *val = m_value .begin();
+
+	for(int i = begin; i < end; ++i) {
+		double sum = 0.0;
+		for(int k = m_rowStart[i]; k < m_rowStart[i+1]; ++k)
+			sum += val[k] * x[col[k]];
+		y[i] = sum;
+	}
+}
+
+
+//! Computes a block of rows of a matrix-vector product (called by parallelBlocks()).
+class SparseMatrix::RowMultiplication
+{
+	const SparseMatrix &m_A;
+	const double *m_x;
+	double *m_y;
+
+public:
+	RowMultiplication(const SparseMatrix &A, const double *x, double *y)
+		: m_A(A), m_x(x), m_y(y) { }
+
+	int operator()(int begin, int end) const {
+		m_A.multiplyRows(m_x, m_y, begin, end);
+		return end - begin;
+	}
+};
+
+
+void SparseMatrix::multiply(const Array<double> &x, Array<double> &y, int nThreads) const
+{
+	OGDF_ASSERT(finalized());
+	OGDF_ASSERT(x.size() == m_cols);
+
+	if(y.size() != m_rows)
+		y.init(m_rows);
+	if(m_rows == 0)
+		return;
+
+	// the threads are created for each product (and iterative solvers compute
+	// one product per iteration), so each thread must get enough entries to
+	// make the time for creating it negligible
+	const int minEntriesPerThread = 1 << 18;
+	const int nnz = numberOfNonzeros();
+	nThreads = max(1, min(nThreads, nnz / minEntriesPerThread));
+
+	if(nThreads == 1) {
+		multiplyRows(x.begin(), y.begin(), 0, m_rows);
+		return;
+	}
+
+	// distribute the rows in blocks with roughly the same number of entries
+	Array<int> bound(nThreads+1);
+	bound[0] = 0;
+	for(int t = 1; t < nThreads; ++t) {
+		const int target = (int)((double)nnz * t / nThreads);
+		int end = bound[t-1];
+		while(end < m_rows && m_rowStart[end] < target)
+			++end;
+		bound[t] = end;
+	}
+	bound[nThreads] = m_rows;
+
+	parallelBlocks(bound, RowMultiplication(*this, x.begin(), y.begin()));
+}
+
+
+} // end namespace ogdf
@@ -132,6 +132,11 @@ CP_MasterBase::CP_MasterBase(
 	m_nKuratowskiIterations = kuratowskiIterations;
 	m_nSubdivisions = subdivisions;
 	m_nKuratowskiSupportGraphs = kSupportGraphs;
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_nKuratowskiThreads = 1;
+#else
+	m_nKuratowskiThreads = System::numberOfProcessors();
+#endif
 	m_heuristicLevel = heuristicLevel;
 	m_nHeuristicRuns = heuristicRuns;
 	m_usePerturbation = perturbation;
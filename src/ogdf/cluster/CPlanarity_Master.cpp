@@ -53,6 +53,7 @@
 #include <ogdf/internal/cluster/CPlanarity_Master.h>
 #include <ogdf/internal/cluster/CPlanarity_Sub.h>
 #include <ogdf/internal/cluster/Cluster_ChunkConnection.h>
+#include <ogdf/abacus/nonduplpool.h>
 #include <ogdf/internal/cluster/Cluster_MaxPlanarEdges.h>
 #include <ogdf/planarity/BoyerMyrvold.h>
 #include <ogdf/basic/simple_graph_alg.h>
@@ -1096,8 +1097,13 @@ Logger::slout() << "Starting shrinking\n";
 	{
 		initializePools(initConstraints, edgeVariables, m_nMaxVars, 0, false);
 		//TODO: How many of them?
-		m_cutConnPool = new StandardPool<Constraint, Variable>(this, poolsize, true);
-		m_cutKuraPool = new StandardPool<Constraint, Variable>(this, poolsize, true);
+		// the cuts carry signatures, hence regenerated cuts are detected as duplicates
+		m_cutConnPool = new NonDuplPool<Constraint, Variable>(this, poolsize, true);
+		m_cutKuraPool = new NonDuplPool<Constraint, Variable>(this, poolsize, true);
+		m_cutConnPool->maxSize(cutPoolMaxSize());
+		m_cutConnPool->maxAge(cutPoolMaxAge());
+		m_cutKuraPool->maxSize(cutPoolMaxSize());
+		m_cutKuraPool->maxAge(cutPoolMaxAge());
 	}
 
 
@@ -1381,7 +1381,7 @@ forall_nodes(vw, support)
 			}
 			OGDF_ASSERT( bufferedForCreation.size()==0 );
 			nGenerated = addCutCons(cons);
-			OGDF_ASSERT( nGenerated == count );
+			OGDF_ASSERT( nGenerated <= count ); // duplicates in the cut pool are not added twice
 			master()->updateAddedCCons(nGenerated);
 #ifdef OGDF_DEBUG
 			cout << "Added "<<count<<" cuts\n";
@@ -1408,9 +1408,8 @@ forall_nodes(vw, support)
 	// the algorithm behaves like "no constraints have been found".
 
 	GraphCopy *kSupport;
-	SList<KuratowskiWrapper> kuratowskis;
-	BoyerMyrvold *bm2;
 	bool violatedFound = false;
+	const int nThreads = ((CPlanarityMaster*)master_)->getNKuratowskiThreads();
 
 	// The Kuratowski support graph is created randomized  with probability xVal (1-xVal) to 0 (1).
 	// Because of this, Kuratowski-constraints might not be found in the current support graph.
@@ -1433,28 +1432,34 @@ forall_nodes(vw, support)
 
 		int iteration = 1;
 		while(((CPlanarityMaster*)master_)->getKIterations() >= iteration) {
-			OGDF_ASSERT(isSimpleUndirected(*kSupport)); // Graph has to be simple
-			// Testing support graph for planarity.
-			bm2 = new BoyerMyrvold();
-			bm2->planarEmbedDestructive(*kSupport, kuratowskis, ((CPlanarityMaster*)master_)->getNSubdivisions(),false,false,true);
-			delete bm2;
-
-			// Checking if first subdivision is violated by current solution
-			// Performance should be improved somehow!!!
-			// KK Todo Why is this code divided into first kura and the remainder?
-			SListConstIterator<KuratowskiWrapper> kw = kuratowskis.begin();
-			SListConstIterator<KuratowskiWrapper> succ;
-
-			SListPure<nodePair> subDivOrig; //stores nodepairs for contained connection edges
-
-			KuraSize ks = subdivisionLefthandSide(kw, kSupport, subDivOrig);
-			double leftHandSide = ks.lhs;
-			OGDF_ASSERT(subDivOrig.size() == ks.varnum); //just a remainder of incremental code completion, may remove varnum again
-			// Only violated constraints are created and added
-			// if \a leftHandSide is greater than the number of edges in subdivision -1, the constraint is violated by current solution.
-			if (leftHandSide > ks.varnum-(1-master()->eps()-minViolate)) {
+			// Extracting subdivisions of the support graph, one randomized run per thread.
+			int runs = min(nThreads, ((CPlanarityMaster*)master_)->getKIterations() - iteration + 1);
+			Array<SList<KuratowskiWrapper> > kuratowskis;
+			BoyerMyrvold bm;
+			bm.extractRandomizedKuratowskis(*kSupport, kuratowskis, runs, ((CPlanarityMaster*)master_)->getNSubdivisions(),false,false,true,nThreads);
+
+			// Buffer for new Kuratowski constraints, at most one per extracted subdivision
+			int numSubdivisions = 0;
+			for (int r = 0; r < runs; ++r)
+				numSubdivisions += kuratowskis[r].size();
+			ArrayBuffer<Constraint *> kConstraints(numSubdivisions,false);
+
+			for (int r = 0; r < runs; ++r) {
+
+				// Checking if first subdivision of the run is violated by current solution
+				// Performance should be improved somehow!!!
+				SListConstIterator<KuratowskiWrapper> kw = kuratowskis[r].begin();
+				if (!kw.valid())
+					continue;
 
-				violatedFound = true;
+				SListPure<nodePair> subDivOrig; //stores nodepairs for contained connection edges
+
+				KuraSize ks = subdivisionLefthandSide(kw, kSupport, subDivOrig);
+				OGDF_ASSERT(subDivOrig.size() == ks.varnum); //just a remainder of incremental code completion, may remove varnum again
+				// Only violated constraints are created and added
+				// if \a leftHandSide is greater than the number of edges in subdivision -1, the constraint is violated by current solution.
+				if (ks.lhs <= ks.varnum-(1-master()->eps()-minViolate))
+					continue;
 			#ifdef OGDF_DEBUG
 cout << "Violated Kura found \n";
 cout << "K5?  "<<(*kw).isK5()<<"\n";
@@ -1479,27 +1484,30 @@ forall_nodes(v, support){
 cout << "Additional potential degree of: "<<v->index()<< " is "<<potDeg[v]<<"\n";
 }
 #endif
-				// Buffer for new Kuratowski constraints
-				ArrayBuffer<Constraint *> kConstraints(kuratowskis.size(),false);
-
 				// Adding first Kuratowski constraint to the buffer.
 				kConstraints.push(new ClusterKuratowskiConstraint ((CPlanarityMaster*)master(), subDivOrig.size(), subDivOrig));
-				count++;
 
 				// Checking further extracted subdivisions for violation.
 				kw++;
 				while(kw.valid()) {
-					KuraSize ks = subdivisionLefthandSide(kw, kSupport, subDivOrig);
-					leftHandSide = ks.lhs;
+					ks = subdivisionLefthandSide(kw, kSupport, subDivOrig);
 
-					if (leftHandSide > ks.varnum-(1-master()->eps()-minViolate)) {
+					if (ks.lhs > ks.varnum-(1-master()->eps()-minViolate)) {
 
 						// Adding Kuratowski constraint to the buffer.
 						kConstraints.push(new ClusterKuratowskiConstraint ((CPlanarityMaster*)master(), subDivOrig.size(), subDivOrig) );
-						count++;
 					}
 					kw++;
 				}
+			}
+
+			if (!kConstraints.empty()) {
+
+				violatedFound = true;
+
+				// Different runs may extract the same subdivision.
+				removeDuplicates(kConstraints);
+				count += kConstraints.size();
 
 				// Adding constraints to the pool.
 				for(int i=0; i<kConstraints.size(); ++i) {
@@ -1511,8 +1519,7 @@ cout << "Additional potential degree of: "<<v->index()<< " is "<<potDeg[v]<<"\n"
 				break;
 
 			} else {
-				kuratowskis.clear();
-				iteration++;
+				iteration += runs;
 			}
 		}
 		delete kSupport;
@@ -324,6 +324,7 @@ bool ClusterPlanarity::doTest(const ClusterGraph &G,
 	cplanMaster->setTimeLimit(m_time.c_str());
 	cplanMaster->setPortaFile(m_portaOutput);
 	cplanMaster->useDefaultCutPool() = m_defaultCutPool;
+	cplanMaster->setNKuratowskiThreads(m_kuratowskiThreads);
 #ifdef OGDF_DEBUG
 	cout << "Starting Optimization\n";
 #endif
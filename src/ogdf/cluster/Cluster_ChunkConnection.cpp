@@ -63,12 +63,36 @@ ChunkConnection::ChunkConnection(Master *master, const ArrayBuffer<node>& chunk,
 {
 	chunk.compactMemcpy(m_chunk);
 	cochunk.compactMemcpy(m_cochunk);
+
+	// sort both node sets for a canonical signature
+	m_chunk.quicksort(NodeIndexComparer());
+	m_cochunk.quicksort(NodeIndexComparer());
+	m_hashKey = m_chunk.size();
+	int i;
+	forall_arrayindices(i,m_chunk)
+		m_hashKey = 31 * m_hashKey + m_chunk[i]->index();
+	forall_arrayindices(i,m_cochunk)
+		m_hashKey = 37 * m_hashKey + m_cochunk[i]->index();
 }
 
 
 ChunkConnection::~ChunkConnection() {}
 
 
+bool ChunkConnection::equal(const ConVar *cv) const {
+	const ChunkConnection *c = dynamic_cast<const ChunkConnection*>(cv);
+	if (c == 0 || c->m_hashKey != m_hashKey
+		|| c->m_chunk.size() != m_chunk.size() || c->m_cochunk.size() != m_cochunk.size())
+		return false;
+	int i;
+	forall_arrayindices(i,m_chunk)
+		if (c->m_chunk[i] != m_chunk[i]) return false;
+	forall_arrayindices(i,m_cochunk)
+		if (c->m_cochunk[i] != m_cochunk[i]) return false;
+	return true;
+}
+
+
 int ChunkConnection::coeff(node n1, node n2) const {
 	//TODO: speedup
 	int i,j;
@@ -60,12 +60,19 @@ CutConstraint::CutConstraint(Master *master, Sub *sub, List<nodePair> &edges) :
 	for (it = edges.begin(); it.valid(); ++it) {
 		m_cutEdges.pushBack(*it);
 	}
+	m_hashKey = normalizeNodePairs(m_cutEdges);
 }
 
 
 CutConstraint::~CutConstraint() {}
 
 
+bool CutConstraint::equal(const ConVar *cv) const {
+	const CutConstraint *c = dynamic_cast<const CutConstraint*>(cv);
+	return c != 0 && c->m_hashKey == m_hashKey && equalNodePairs(c->m_cutEdges, m_cutEdges);
+}
+
+
 int CutConstraint::coeff(node n1, node n2) const {
 	ListConstIterator<nodePair> it;
 	for (it = m_cutEdges.begin(); it.valid(); ++it) {
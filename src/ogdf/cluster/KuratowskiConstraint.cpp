@@ -61,12 +61,20 @@ ClusterKuratowskiConstraint::ClusterKuratowskiConstraint(Master *master, int nEd
 	for (it = ks.begin(); it.valid(); ++it) {
 		m_subdivision.pushBack(*it);
 	}
+	m_hashKey = normalizeNodePairs(m_subdivision);
 }
 
 
 ClusterKuratowskiConstraint::~ClusterKuratowskiConstraint() {}
 
 
+bool ClusterKuratowskiConstraint::equal(const ConVar *cv) const {
+	const ClusterKuratowskiConstraint *c = dynamic_cast<const ClusterKuratowskiConstraint*>(cv);
+	return c != 0 && c->m_hashKey == m_hashKey && c->rhs() == rhs()
+		&& equalNodePairs(c->m_subdivision, m_subdivision);
+}
+
+
 double ClusterKuratowskiConstraint::coeff(const Variable *v) const {
 	const EdgeVar *e = (const EdgeVar*)v;
 	for (ListConstIterator<nodePair> it = m_subdivision.begin(); it.valid(); ++it) {
@@ -53,6 +53,7 @@
 #include <ogdf/internal/cluster/MaxCPlanar_Master.h>
 #include <ogdf/internal/cluster/MaxCPlanar_Sub.h>
 #include <ogdf/internal/cluster/Cluster_ChunkConnection.h>
+#include <ogdf/abacus/nonduplpool.h>
 //#include <ogdf/internal/cluster/MaxCPlanar_MinimalClusterConnection.h> // not used
 #include <ogdf/internal/cluster/Cluster_MaxPlanarEdges.h>
 #include <ogdf/planarity/BoyerMyrvold.h>
@@ -143,6 +144,11 @@ MaxCPlanarMaster::MaxCPlanarMaster(
 	m_nKuratowskiIterations = kuratowskiIterations;
 	m_nSubdivisions = subdivisions;
 	m_nKuratowskiSupportGraphs = kSupportGraphs;
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_nKuratowskiThreads = 1;
+#else
+	m_nKuratowskiThreads = System::numberOfProcessors();
+#endif
 	m_heuristicLevel = heuristicLevel;
 	m_nHeuristicRuns = heuristicRuns;
 	m_usePerturbation = perturbation;
@@ -862,8 +868,13 @@ void MaxCPlanarMaster::initializeOptimization() {
 	{
 		initializePools(initConstraints, edgeVariables, m_nMaxVars, 0, false);
 		//TODO: How many of them?
-		m_cutConnPool = new StandardPool<Constraint, Variable>(this, poolsize, true);
-		m_cutKuraPool = new StandardPool<Constraint, Variable>(this, poolsize, true);
+		// the cuts carry signatures, hence regenerated cuts are detected as duplicates
+		m_cutConnPool = new NonDuplPool<Constraint, Variable>(this, poolsize, true);
+		m_cutKuraPool = new NonDuplPool<Constraint, Variable>(this, poolsize, true);
+		m_cutConnPool->maxSize(cutPoolMaxSize());
+		m_cutConnPool->maxAge(cutPoolMaxAge());
+		m_cutKuraPool->maxSize(cutPoolMaxSize());
+		m_cutKuraPool->maxAge(cutPoolMaxAge());
 	}
 
 
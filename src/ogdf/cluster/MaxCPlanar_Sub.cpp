@@ -2124,7 +2124,7 @@ int MaxCPlanarSub::separateReal(double minViolate) {
 				}
 				OGDF_ASSERT( bufferedForCreation.size()==0 );
 				nGenerated = addCutCons(cons);
-				OGDF_ASSERT( nGenerated == count );
+				OGDF_ASSERT( nGenerated <= count ); // duplicates in the cut pool are not added twice
 				master()->updateAddedCCons(nGenerated);
 			}
 			m_constraintsFound = true;
@@ -2148,10 +2148,8 @@ int MaxCPlanarSub::separateReal(double minViolate) {
 	// the algorithm behaves like "no constraints have been found".
 
 	GraphCopy *kSupport;
-	SList<KuratowskiWrapper> kuratowskis;
-	//BoyerMyrvold *bm1;
-	BoyerMyrvold *bm2;
 	bool violatedFound = false;
+	const int nThreads = ((MaxCPlanarMaster*)master_)->getNKuratowskiThreads();
 
 	// The Kuratowski support graph is created randomized  with probability xVal (1-xVal) to 0 (1).
 	// Because of this, Kuratowski-constraints might not be found in the current support graph.
@@ -2173,74 +2171,61 @@ int MaxCPlanarSub::separateReal(double minViolate) {
 		int iteration = 1;
 		while(((MaxCPlanarMaster*)master_)->getKIterations() >= iteration) {
 
-			// Testing support graph for planarity.
-			bm2 = new BoyerMyrvold();
-			/* bool planar = */ bm2->planarEmbedDestructive(*kSupport, kuratowskis, ((MaxCPlanarMaster*)master_)->getNSubdivisions(),false,false,true);
-			delete bm2;
+			// Extracting subdivisions of the support graph, one randomized run per thread.
+			int runs = min(nThreads, ((MaxCPlanarMaster*)master_)->getKIterations() - iteration + 1);
+			Array<SList<KuratowskiWrapper> > kuratowskis;
+			BoyerMyrvold bm;
+			bm.extractRandomizedKuratowskis(*kSupport, kuratowskis, runs, ((MaxCPlanarMaster*)master_)->getNSubdivisions(),false,false,true,nThreads);
 
-			// Checking if first subdivision is violated by current solution
-			// Performance should be improved somehow!!!
-			SListConstIterator<KuratowskiWrapper> kw = kuratowskis.begin();
-			SListConstIterator<KuratowskiWrapper> succ;
-			double leftHandSide = subdivisionLefthandSide(kw,kSupport);
+			// Buffer for new Kuratowski constraints, at most one per extracted subdivision
+			int numSubdivisions = 0;
+			for (int r = 0; r < runs; ++r)
+				numSubdivisions += kuratowskis[r].size();
+			ArrayBuffer<Constraint *> kConstraints(numSubdivisions,false);
 
-			// Only violated constraints are created and added
-			// if \a leftHandSide is greater than the number of edges in subdivision -1, the constraint is violated by current solution.
-			if (leftHandSide > (*kw).edgeList.size()-(1-master()->eps()-minViolate)) {
+			for (int r = 0; r < runs; ++r) {
 
-				violatedFound = true;
+				// Checking if first subdivision of the run is violated by current solution
+				// Performance should be improved somehow!!!
+				SListConstIterator<KuratowskiWrapper> kw = kuratowskis[r].begin();
+				if (!kw.valid())
+					continue;
+				double leftHandSide = subdivisionLefthandSide(kw,kSupport);
 
-				// Buffer for new Kuratowski constraints
-				ArrayBuffer<Constraint *> kConstraints(kuratowskis.size(),false);
+				// Only violated constraints are created and added
+				// if \a leftHandSide is greater than the number of edges in subdivision -1, the constraint is violated by current solution.
+				if (leftHandSide <= (*kw).edgeList.size()-(1-master()->eps()-minViolate))
+					continue;
 
-				SListPure<edge> subdiv;
 				SListPure<nodePair> subdivOrig;
-				SListConstIterator<edge> eit;
 				nodePair np;
-				node v,w;
 
-				for (eit = (*kw).edgeList.begin(); eit.valid(); ++eit) {
-					subdiv.pushBack(*eit);
-				}
-				for (SListConstIterator<edge> sit = subdiv.begin(); sit.valid(); ++sit) {
-					v = (*sit)->source();
-					w = (*sit)->target();
-					np.v1 = kSupport->original(v);
-					np.v2 = kSupport->original(w);
-					subdivOrig.pushBack(np);
-				}
+				// Checking the subdivisions of the run for violation, the first one is violated.
+				for (bool first = true; kw.valid(); kw++, first = false) {
+					if (!first) {
+						leftHandSide = subdivisionLefthandSide(kw,kSupport);
+						if (leftHandSide <= (*kw).edgeList.size()-(1-master()->eps()-minViolate))
+							continue;
+					}
+					for (SListConstIterator<edge> sit = (*kw).edgeList.begin(); sit.valid(); ++sit) {
+						np.v1 = kSupport->original((*sit)->source());
+						np.v2 = kSupport->original((*sit)->target());
+						subdivOrig.pushBack(np);
+					}
 
-				// Adding first Kuratowski constraint to the buffer.
-				kConstraints.push(new ClusterKuratowskiConstraint ((MaxCPlanarMaster*)master(), subdivOrig.size(), subdivOrig));
-				count++;
-				subdiv.clear();
-				subdivOrig.clear();
+					// Adding Kuratowski constraint to the buffer.
+					kConstraints.push(new ClusterKuratowskiConstraint ((MaxCPlanarMaster*)master(), subdivOrig.size(), subdivOrig));
+					subdivOrig.clear();
+				}
+			}
 
-				// Checking further extracted subdivisions for violation.
-				kw++;
-				while(kw.valid()) {
-					leftHandSide = subdivisionLefthandSide(kw,kSupport);
-					if (leftHandSide > (*kw).edgeList.size()-(1-master()->eps()-minViolate)) {
+			if (!kConstraints.empty()) {
 
-						for (eit = (*kw).edgeList.begin(); eit.valid(); ++eit) {
-							subdiv.pushBack(*eit);
-						}
-						for (SListConstIterator<edge> sit = subdiv.begin(); sit.valid(); ++sit) {
-							v = (*sit)->source();
-							w = (*sit)->target();
-							np.v1 = kSupport->original(v);
-							np.v2 = kSupport->original(w);
-							subdivOrig.pushBack(np);
-						}
+				violatedFound = true;
 
-						// Adding Kuratowski constraint to the buffer.
-						kConstraints.push(new ClusterKuratowskiConstraint ((MaxCPlanarMaster*)master(), subdivOrig.size(), subdivOrig) );
-						count++;
-						subdiv.clear();
-						subdivOrig.clear();
-					}
-					kw++;
-				}
+				// Different runs may extract the same subdivision.
+				removeDuplicates(kConstraints);
+				count += kConstraints.size();
 
 				// Adding constraints to the pool.
 				for(int i=0; i<kConstraints.size(); ++i) {
@@ -2252,8 +2237,7 @@ int MaxCPlanarSub::separateReal(double minViolate) {
 				break;
 
 			} else {
-				kuratowskis.clear();
-				iteration++;
+				iteration += runs;
 			}
 		}
 		delete kSupport;
@@ -88,6 +88,9 @@ Module::ReturnType MaximumCPlanarSubgraph::doCall(const ClusterGraph &G,
 
 	cplanMaster->setPortaFile(m_portaOutput);
 	cplanMaster->useDefaultCutPool() = m_defaultCutPool;
+	cplanMaster->setNKuratowskiThreads(m_kuratowskiThreads);
+	cplanMaster->cutPoolMaxAge(m_cutPoolMaxAge);
+	cplanMaster->cutPoolMaxSize(m_cutPoolMaxSize);
 #ifdef OGDF_DEBUG
 	cout << "Starting Optimization\n";
 #endif
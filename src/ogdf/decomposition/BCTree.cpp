@@ -72,6 +72,7 @@ void BCTree::init (node vG)
 	m_number.init(m_G,0);
 	m_lowpt.init(m_G);
 	m_gtoh.init(m_G);
+	m_dfsAdj.init(m_G.numberOfNodes());
 
 	biComp(0,vG);
 
@@ -79,6 +80,7 @@ void BCTree::init (node vG)
 	m_lowpt.init();
 	m_eStack.clear();
 	m_gtoh.init();
+	m_dfsAdj.init();
 
 	node uB;
 	forall_nodes (uB,m_B) {
@@ -113,6 +115,7 @@ void BCTree::initNotConnected (node vG)
 	m_number.init(m_G,0);
 	m_lowpt.init(m_G);
 	m_gtoh.init(m_G);
+	m_dfsAdj.init(m_G.numberOfNodes());
 
 	biComp(0,vG);
 	// cout << m_count << endl << flush;
@@ -130,6 +133,7 @@ void BCTree::initNotConnected (node vG)
 	m_lowpt.init();
 	m_eStack.clear();
 	m_gtoh.init();
+	m_dfsAdj.init();
 
 	node uB;
 	forall_nodes (uB,m_B) {
@@ -141,18 +145,27 @@ void BCTree::initNotConnected (node vG)
 
 void BCTree::biComp (adjEntry adjuG, node vG)
 {
+	// The DFS is performed iteratively: m_dfsAdj[i] is the current adjacency
+	// entry of the vertex at depth i of the DFS path (i.e., the tree edge
+	// leading to the vertex at depth i+1 while that one is visited).
+	const node rootG = vG;
+	int depth = 0;
 	m_lowpt[vG] = m_number[vG] = ++m_count;
-
-	adjEntry adj;
-	forall_adj (adj,vG) {
-		//edge eG = adj->theEdge();
-		node wG = adj->twinNode();
-		if ((adjuG != 0) && (adj == adjuG->twin())) continue;
-		if (m_number[wG]==0) {
-			m_eStack.push(adj);
-			biComp(adj,wG);
-			if (m_lowpt[wG]<m_lowpt[vG]) m_lowpt[vG] = m_lowpt[wG];
-			if (m_lowpt[wG]>=m_number[vG]) {
+	m_dfsAdj[0] = vG->firstAdj();
+
+	while (depth >= 0) {
+		adjEntry adjInG = (depth > 0) ? m_dfsAdj[depth-1] : adjuG;
+		node uG = (depth > 0) ? adjInG->twinNode() : rootG;
+		adjEntry adj = m_dfsAdj[depth];
+
+		if (adj == 0) {
+			// uG is finished; return to its parent
+			if (--depth < 0) break;
+			node wG = uG;
+			node pG = adjInG->theNode();
+			adj = adjInG;
+			if (m_lowpt[wG]<m_lowpt[pG]) m_lowpt[pG] = m_lowpt[wG];
+			if (m_lowpt[wG]>=m_number[pG]) {
 				node bB = m_B.newNode();
 				m_bNode_type[bB] = BComp;
 				m_bNode_isMarked[bB] = false;
@@ -210,11 +223,26 @@ void BCTree::biComp (adjEntry adjuG, node vG)
 				} while (adj!=adjfG);
 				while (!m_nodes.empty()) m_gNode_isMarked[m_nodes.popFrontRet()] = false;
 			}
+			m_dfsAdj[depth] = adj->succ();
+			continue;
+		}
+
+		node wG = adj->twinNode();
+		if ((adjInG != 0) && (adj == adjInG->twin())) {
+			m_dfsAdj[depth] = adj->succ();
+			continue;
+		}
+		if (m_number[wG]==0) {
+			m_eStack.push(adj);
+			m_lowpt[wG] = m_number[wG] = ++m_count;
+			m_dfsAdj[++depth] = wG->firstAdj();
+			continue;
 		}
-		else if (m_number[wG]<m_number[vG]) {
+		else if (m_number[wG]<m_number[uG]) {
 			m_eStack.push(adj);
-			if (m_number[wG]<m_lowpt[vG]) m_lowpt[vG] = m_number[wG];
+			if (m_number[wG]<m_lowpt[uG]) m_lowpt[uG] = m_number[wG];
 		}
+		m_dfsAdj[depth] = adj->succ();
 	}
 }
 
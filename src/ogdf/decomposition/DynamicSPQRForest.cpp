@@ -309,8 +309,8 @@ edge DynamicSPQRForest::updateInsertedEdgeSPQR (node vB, edge eG)
 		}
 		node wT = spqrproper(gH);
 		if (m_tNode_type[wT]==PComp) {
-			m_hEdge_position[eH] = m_tNode_hEdges[vT].pushBack(eH);
-			m_hEdge_tNode[eH] = vT;
+			m_hEdge_position[eH] = m_tNode_hEdges[wT].pushBack(eH);
+			m_hEdge_tNode[eH] = wT;
 		}
 		else {
 			m_bNode_numP[vB]++;
@@ -111,10 +111,12 @@ TricComp::TricComp (const Graph& G) :
 	m_ND    .init(GC);   m_DEGREE.init(GC);
 	m_TREE_ARC.init(GC,0);
 	m_NODEAT = Array<node>(1,n);
+	m_dfsAdj.init(1,n);
 
 	m_numCount = 0;
 	m_start = GC.firstNode();
-	DFS1(GC,m_start,0);
+	DFS1(m_start,0);
+	m_dfsAdj.init();
 
 	edge e;
 	forall_edges(e,GC) {
@@ -177,7 +179,8 @@ TricComp::TricComp (const Graph& G) :
 	m_TSTACK_b = new int[2*m+1];
 	m_TSTACK_a[m_top = 0] = -1; // start with EOS
 
-	pathSearch(G,m_start);
+	m_psStack.init(n);
+	pathSearch(m_start);
 
 	// last split component
 	CompStruct &C = newComp();
@@ -202,7 +205,7 @@ TricComp::TricComp (const Graph& G) :
 	m_HIGHPT.init(); m_START .init();
 	m_DEGREE.init(); m_TREE_ARC.init();
 	m_IN_ADJ.init(); m_IN_HIGH.init();
-	m_NODEAT.init();
+	m_NODEAT.init(); m_psStack.init();
 	m_ESTACK.clear();
 
 	assembleTriconnectedComponents();
@@ -261,12 +264,14 @@ TricComp::TricComp(const Graph &G, bool &isTric, node &s1, node &s2)
 	m_LOWPT2.init(GC);   m_FATHER.init(GC,0);
 	m_ND    .init(GC);   m_DEGREE.init(GC);
 	m_NODEAT.init(1,n);
+	m_dfsAdj.init(1,n);
 
 	m_TREE_ARC.init(GC,0); // probably not required
 
 	m_numCount = 0;
 	m_start = GC.firstNode();
-	DFS1(GC,m_start,0,s1);
+	DFS1(m_start,0,s1);
+	m_dfsAdj.init();
 
 	// graph not even connected?
 	if(m_numCount < n) {
@@ -299,7 +304,8 @@ TricComp::TricComp(const Graph &G, bool &isTric, node &s1, node &s2)
 	m_TSTACK_b = new int[m];
 	m_TSTACK_a[m_top = 0] = -1; // start with EOS
 
-	isTric = pathSearch(G,m_start,s1,s2);
+	m_psStack.init(n);
+	isTric = pathSearch(m_start,s1,s2);
 	if(s1) {
 		s1 = GC.original(s1);
 		s2 = GC.original(s2);
@@ -317,7 +323,7 @@ TricComp::TricComp(const Graph &G, bool &isTric, node &s1, node &s2)
 	m_HIGHPT.init(); m_START .init();
 	m_DEGREE.init(); m_TREE_ARC.init();
 	m_IN_ADJ.init(); m_IN_HIGH.init();
-	m_NODEAT.init();
+	m_NODEAT.init(); m_psStack.init();
 }
 
 
@@ -597,30 +603,34 @@ void TricComp::assembleTriconnectedComponents()
 //           ND[v], TYPE[e], DEGREE[v]
 //----------------------------------------------------------
 
-void TricComp::DFS1 (const Graph& G, node v, node u)
+void TricComp::DFS1 (node v, node u, node &s1)
 {
-	edge e;
+	// The dfs is performed iteratively. For each node on the current dfs path,
+	// the next adjacency entry to be processed is stored in m_dfsAdj (indexed
+	// by dfs-number); we return to the father of a finished node using m_FATHER.
+	const node vRoot = v;
 
 	m_NUMBER[v] = ++m_numCount;
 	m_FATHER[v] = u;
 	m_DEGREE[v] = v->degree();
-
 	m_LOWPT1[v] = m_LOWPT2[v] = m_NUMBER[v];
 	m_ND[v] = 1;
+	m_dfsAdj[m_NUMBER[v]] = v->firstAdj();
 
-	forall_adj_edges (e,v) {
-
-		if (m_TYPE[e] != unseen)
-			continue;
-
-		node w = e->opposite(v);
+	while (true) {
+		adjEntry adj = m_dfsAdj[m_NUMBER[v]];
 
-		if (m_NUMBER[w] == 0) {
-			m_TYPE[e] = tree;
+		if (adj == 0) {
+			// v is finished; go back to its father
+			if (v == vRoot)
+				break;
 
-			m_TREE_ARC[w] = e;
+			node w = v;
+			v = m_FATHER[w];
 
-			DFS1(G,w,v);
+			// check for cut vertex (the first son of v has dfs-number NUMBER[v]+1)
+			if(m_LOWPT1[w] >= m_NUMBER[v] && (m_NUMBER[w] != m_NUMBER[v]+1 || m_FATHER[v] != 0))
+				s1 = v;
 
 			if (m_LOWPT1[w] < m_LOWPT1[v]) {
 				m_LOWPT2[v] = min(m_LOWPT1[v],m_LOWPT2[w]);
@@ -634,36 +644,12 @@ void TricComp::DFS1 (const Graph& G, node v, node u)
 			}
 
 			m_ND[v] += m_ND[w];
-
-		} else {
-
-			m_TYPE[e] = frond;
-
-			if (m_NUMBER[w] < m_LOWPT1[v]) {
-				m_LOWPT2[v] = m_LOWPT1[v];
-				m_LOWPT1[v] = m_NUMBER[w];
-
-			} else if (m_NUMBER[w] > m_LOWPT1[v]) {
-				m_LOWPT2[v] = min(m_LOWPT2[v],m_NUMBER[w]);
-			}
+			continue;
 		}
-	}
-}
-
-void TricComp::DFS1 (const Graph& G, node v, node u, node &s1)
-{
-	node firstSon = 0;
-	edge e;
 
-	m_NUMBER[v] = ++m_numCount;
-	m_FATHER[v] = u;
-	m_DEGREE[v] = v->degree();
-
-	m_LOWPT1[v] = m_LOWPT2[v] = m_NUMBER[v];
-	m_ND[v] = 1;
-
-	forall_adj_edges (e,v) {
+		m_dfsAdj[m_NUMBER[v]] = adj->succ();
 
+		edge e = adj->theEdge();
 		if (m_TYPE[e] != unseen)
 			continue;
 
@@ -671,28 +657,18 @@ void TricComp::DFS1 (const Graph& G, node v, node u, node &s1)
 
 		if (m_NUMBER[w] == 0) {
 			m_TYPE[e] = tree;
-			if(firstSon == 0) firstSon = w;
 
 			m_TREE_ARC[w] = e;
 
-			DFS1(G,w,v,s1);
+			// descend to w
+			m_NUMBER[w] = ++m_numCount;
+			m_FATHER[w] = v;
+			m_DEGREE[w] = w->degree();
+			m_LOWPT1[w] = m_LOWPT2[w] = m_NUMBER[w];
+			m_ND[w] = 1;
+			m_dfsAdj[m_NUMBER[w]] = w->firstAdj();
 
-			// check for cut vertex
-			if(m_LOWPT1[w] >= m_NUMBER[v] && (w != firstSon || u != 0))
-				s1 = v;
-
-			if (m_LOWPT1[w] < m_LOWPT1[v]) {
-				m_LOWPT2[v] = min(m_LOWPT1[v],m_LOWPT2[w]);
-				m_LOWPT1[v] = m_LOWPT1[w];
-
-			} else if (m_LOWPT1[w] == m_LOWPT1[v]) {
-				m_LOWPT2[v] = min(m_LOWPT2[v],m_LOWPT2[w]);
-
-			} else {
-				m_LOWPT2[v] = min(m_LOWPT2[v],m_LOWPT1[w]);
-			}
-
-			m_ND[v] += m_ND[w];
+			v = w;
 
 		} else {
 
@@ -745,13 +721,31 @@ void TricComp::buildAcceptableAdjStruct(const Graph& G)
 //                   The second dfs-search
 //----------------------------------------------------------
 
-void TricComp::pathFinder(const Graph& G, node v)
+void TricComp::pathFinder(node v)
 {
+	// The dfs is performed iteratively. For each node on the current dfs path,
+	// the position in its adjacency list is stored in m_dfsIt (indexed by
+	// (first) dfs-number); we return to the father of a finished node using m_FATHER.
+	const node vRoot = v;
+
 	m_NEWNUM[v] = m_numCount - m_ND[v] + 1;
+	m_dfsIt[m_NUMBER[v]] = m_A[v].begin();
+
+	while (true) {
+		ListIterator<edge> &it = m_dfsIt[m_NUMBER[v]];
+
+		if (!it.valid()) {
+			// v is finished; go back to its father
+			if (v == vRoot)
+				break;
+
+			v = m_FATHER[v];
+			m_numCount--;
+			continue;
+		}
 
-	ListConstIterator<edge> it;
-	for(it = m_A[v].begin(); it.valid(); ++it) {
 		edge e = *it;
+		++it;
 		node w = e->opposite(v);
 
 		if (m_newPath) {
@@ -760,8 +754,10 @@ void TricComp::pathFinder(const Graph& G, node v)
 		}
 
 		if (m_TYPE[e] == tree) {
-			pathFinder(G,w);
-			m_numCount--;
+			// descend to w
+			m_NEWNUM[w] = m_numCount - m_ND[w] + 1;
+			m_dfsIt[m_NUMBER[w]] = m_A[w].begin();
+			v = w;
 
 		} else {
 			m_IN_HIGH[e] = m_HIGHPT[w].pushBack(m_NEWNUM[v]);
@@ -780,7 +776,9 @@ void TricComp::DFS2 (const Graph& G)
 	m_numCount = G.numberOfNodes();
 	m_newPath = true;
 
-	pathFinder(G,m_start);
+	m_dfsIt.init(1,G.numberOfNodes());
+	pathFinder(m_start);
+	m_dfsIt.init();
 
 	node v;
 	Array<int> old2new(1,G.numberOfNodes());
@@ -802,40 +800,34 @@ void TricComp::DFS2 (const Graph& G)
 // recognition of split components
 //----------------------------------------------------------
 
-void TricComp::pathSearch (const Graph& G, node v)
+void TricComp::pathSearch (node v)
 {
-	node w;
-	edge e;
-	int y, vnum = m_NEWNUM[v], wnum;
-	int a, b;
-
-	List<edge> &Adj = m_A[v];
-	int outv = Adj.size();
-
-	ListIterator<edge> it, itNext;
-	for(it = Adj.begin(); it.valid(); it=itNext)
+	// The path search is performed iteratively. The state of each node on the
+	// current dfs path (in particular the position in its adjacency list) is
+	// stored in m_psStack (indexed by depth). The father of a node cannot be
+	// used for returning since it is changed by the creation of virtual edges.
+	int top = 0;
+	m_psStack[0].init(v, m_A[v]);
+
+	while (top >= 0)
 	{
-		itNext = it.succ();
-		e = *it;
-		w = e->target(); wnum = m_NEWNUM[w];
+		PathSearchState &S = m_psStack[top];
 
-		if (m_TYPE[e] == tree) {
+		v = S.m_v;
+		node &w = S.m_w;
+		edge &e = S.m_e;
+		int &outv = S.m_outv;
+		ListIterator<edge> &it = S.m_it;
 
-			if (m_START[e]) {
-				y = 0;
-				if (m_TSTACK_a[m_top] > m_LOWPT1[w]) {
-					do {
-						y = max(y,m_TSTACK_h[m_top]);
-						b = m_TSTACK_b[m_top--];
-					} while (m_TSTACK_a[m_top] > m_LOWPT1[w]);
-					TSTACK_push(y,m_LOWPT1[w],b);
-				} else {
-					TSTACK_push(wnum+m_ND[w]-1,m_LOWPT1[w],vnum);
-				}
-				TSTACK_pushEOS();
-			}
+		int y, vnum = m_NEWNUM[v], wnum;
+		int a, b;
 
-			pathSearch(G,w);
+		List<edge> &Adj = m_A[v];
+
+		if (S.m_returned) {
+			// we returned from the recursive search at w = e->target()
+			S.m_returned = false;
+			wnum = m_NEWNUM[w];
 
 			m_ESTACK.push(m_TREE_ARC[w]);  // add (v,w) to ESTACK (can differ from e!)
 
@@ -1031,6 +1023,38 @@ void TricComp::pathSearch (const Graph& G, node v)
 			}
 
 			outv--;
+			it = S.m_itNext;
+		}
+
+		if (!it.valid()) {
+			// v is finished; return to its father
+			if (--top >= 0)
+				m_psStack[top].m_returned = true;
+			continue;
+		}
+
+		S.m_itNext = it.succ();
+		e = *it;
+		w = e->target(); wnum = m_NEWNUM[w];
+
+		if (m_TYPE[e] == tree) {
+
+			if (m_START[e]) {
+				y = 0;
+				if (m_TSTACK_a[m_top] > m_LOWPT1[w]) {
+					do {
+						y = max(y,m_TSTACK_h[m_top]);
+						b = m_TSTACK_b[m_top--];
+					} while (m_TSTACK_a[m_top] > m_LOWPT1[w]);
+					TSTACK_push(y,m_LOWPT1[w],b);
+				} else {
+					TSTACK_push(wnum+m_ND[w]-1,m_LOWPT1[w],vnum);
+				}
+				TSTACK_pushEOS();
+			}
+
+			// descend to w
+			m_psStack[++top].init(w, m_A[w]);
 
 		} else { // frond arc
 			if (m_START[e]) {
@@ -1047,46 +1071,34 @@ void TricComp::pathSearch (const Graph& G, node v)
 			}
 
 			m_ESTACK.push(e);  // add (v,w) to ESTACK
+			it = S.m_itNext;
 		}
 	}
 }
 
 // simplified path search for triconnectivity test
-bool TricComp::pathSearch (const Graph &G, node v, node &s1, node &s2)
+bool TricComp::pathSearch (node v, node &s1, node &s2)
 {
-	node w;
-	edge e;
-	int y, vnum = m_NEWNUM[v], wnum;
-	int a, b;
+	int top = 0;
+	m_psStack[0].init(v, m_A[v]);
 
-	List<edge> &Adj = m_A[v];
-	int outv = Adj.size();
-
-	ListIterator<edge> it, itNext;
-	for(it = Adj.begin(); it.valid(); it=itNext)
+	while (top >= 0)
 	{
-		itNext = it.succ();
-		e = *it;
-		w = e->target(); wnum = m_NEWNUM[w];
+		PathSearchState &S = m_psStack[top];
 
-		if (m_TYPE[e] == tree) {
+		v = S.m_v;
+		node &w = S.m_w;
+		edge &e = S.m_e;
+		int &outv = S.m_outv;
+		ListIterator<edge> &it = S.m_it;
 
-			if (m_START[e]) {
-				y = 0;
-				if (m_TSTACK_a[m_top] > m_LOWPT1[w]) {
-					do {
-						y = max(y,m_TSTACK_h[m_top]);
-						b = m_TSTACK_b[m_top--];
-					} while (m_TSTACK_a[m_top] > m_LOWPT1[w]);
-					TSTACK_push(y,m_LOWPT1[w],b);
-				} else {
-					TSTACK_push(wnum+m_ND[w]-1,m_LOWPT1[w],vnum);
-				}
-				TSTACK_pushEOS();
-			}
+		int y, vnum = m_NEWNUM[v], wnum;
+		int a, b;
 
-			if(pathSearch(G,w,s1,s2) == false)
-				return false;
+		if (S.m_returned) {
+			// we returned from the recursive search at w = e->target()
+			S.m_returned = false;
+			wnum = m_NEWNUM[w];
 
 			while (vnum != 1 && ((m_TSTACK_a[m_top] == vnum) ||
 				(m_DEGREE[w] == 2 && m_NEWNUM[m_A[w].front()->target()] > wnum)))
@@ -1130,6 +1142,38 @@ bool TricComp::pathSearch (const Graph &G, node v, node &s1, node &s2)
 			}
 
 			outv--;
+			it = S.m_itNext;
+		}
+
+		if (!it.valid()) {
+			// v is finished; return to its father
+			if (--top >= 0)
+				m_psStack[top].m_returned = true;
+			continue;
+		}
+
+		S.m_itNext = it.succ();
+		e = *it;
+		w = e->target(); wnum = m_NEWNUM[w];
+
+		if (m_TYPE[e] == tree) {
+
+			if (m_START[e]) {
+				y = 0;
+				if (m_TSTACK_a[m_top] > m_LOWPT1[w]) {
+					do {
+						y = max(y,m_TSTACK_h[m_top]);
+						b = m_TSTACK_b[m_top--];
+					} while (m_TSTACK_a[m_top] > m_LOWPT1[w]);
+					TSTACK_push(y,m_LOWPT1[w],b);
+				} else {
+					TSTACK_push(wnum+m_ND[w]-1,m_LOWPT1[w],vnum);
+				}
+				TSTACK_pushEOS();
+			}
+
+			// descend to w
+			m_psStack[++top].init(w, m_A[w]);
 
 		} else { // frond arc
 			if (m_START[e]) {
@@ -1144,6 +1188,7 @@ bool TricComp::pathSearch (const Graph &G, node v, node &s1, node &s2)
 					TSTACK_push(vnum,wnum,vnum);
 				}
 			}
+			it = S.m_itNext;
 		}
 	}
 
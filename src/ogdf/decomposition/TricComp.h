@@ -152,20 +152,40 @@ private:
 	enum edgeType { unseen, tree, frond, removed };
 
 	// first dfs traversal
-	void DFS1 (const Graph& G, node v, node u);
-	// special version for triconnectivity tes
-	void DFS1 (const Graph& G, node v, node u, node &s1);
+	void DFS1 (node v, node u) {
+		node s1;
+		DFS1(v,u,s1);
+	}
+	// special version for triconnectivity test (also returns a cut vertex in s1)
+	void DFS1 (node v, node u, node &s1);
 
 	// constructs ordered adjaceny lists
 	void buildAcceptableAdjStruct (const Graph& G);
 	// the second dfs traversal
 	void DFS2 (const Graph& G);
-	void pathFinder(const Graph& G, node v);
+	void pathFinder(node v);
+
+	// state of a node on the dfs path in pathSearch()
+	struct PathSearchState {
+		node m_v;     // the node
+		node m_w;     // target of the current edge
+		edge m_e;     // the current edge
+		int  m_outv;  // number of unprocessed tree arcs leaving m_v
+		bool m_returned; // true iff we returned from m_w
+		ListIterator<edge> m_it, m_itNext; // current and next position in adjacency list
+
+		void init(node v, List<edge> &adj) {
+			m_v = v;
+			m_outv = adj.size();
+			m_returned = false;
+			m_it = adj.begin();
+		}
+	};
 
 	// finding of split components
-	void pathSearch (const Graph& G, node v);
+	void pathSearch (node v);
 
-	bool pathSearch (const Graph &G, node v, node &s1, node &s2);
+	bool pathSearch (node v, node &s1, node &s2);
 
 	// merges split-components into triconnected components
 	void assembleTriconnectedComponents();
@@ -204,6 +224,11 @@ private:
 	EdgeArray<ListIterator<int> >  m_IN_HIGH;	// pointer to element in HIGHPT list containing e
 	BoundedStack<edge> m_ESTACK; // stack of currently active edges
 
+	// buffers for the iterative dfs traversals
+	Array<adjEntry>           m_dfsAdj;  // DFS1: current adjEntry of node with (first) dfs-number i
+	Array<ListIterator<edge> > m_dfsIt;  // pathFinder: current position in m_A of node with (first) dfs-number i
+	Array<PathSearchState>    m_psStack; // pathSearch: state of the node at depth i
+
 	node m_start;     // start node of dfs traversal
 	int  m_numCount;  // counter for dfs-traversal
 	bool m_newPath;   // true iff we start a new path
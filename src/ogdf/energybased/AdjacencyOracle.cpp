@@ -50,42 +50,70 @@
 
 namespace ogdf {
 
-	//! Builds a 2D-array indexed by the numbers of vertices.
+	//! Builds the sorted neighbor lists of all vertices.
 	/**
-	* It uses only the part
-	* of the matrix left of the diagonal (where the first index is smaller than the
-	* second. For each pair of vertices, the corresponding entry in the matrix is set true
-	* if and only if the two vertices are adjacent.
+	* The lists are stored consecutively in one array. Self-loops are
+	* ignored and multiple edges yield only one entry. Since the vertices
+	* w are processed by increasing index and w is appended to the list of
+	* each neighbor, all lists are sorted and duplicates are consecutive.
 	*/
-	AdjacencyOracle::AdjacencyOracle(const Graph &G) : m_nodeNum(G)
+	AdjacencyOracle::AdjacencyOracle(const Graph &G)
 	{
-		int i = 1;
+		const int n = G.maxNodeIndex()+1;
+
+		Array<node> byIndex(0,n-1,0);
 		node v;
-		forall_nodes(v,G) m_nodeNum[v] = i++;
-		int nodeNum = i-1;
-		m_adjacencyMatrix = new Array2D<bool> (1,i,1,i);
-		for(i = 1; i < nodeNum; i++)
-			for(int j = i+1; j <= nodeNum; j++)
-				(*m_adjacencyMatrix)(i,j) = false;
-		edge e;
-		forall_edges(e,G) {
-			int num1 = m_nodeNum[e->source()];
-			int num2 = m_nodeNum[e->target()];
-			(*m_adjacencyMatrix)(min(num1,num2),max(num1,num2)) = true;
+		forall_nodes(v,G) byIndex[v->index()] = v;
+
+		m_start.init(0,n,0);
+		m_neighbor.init(max(1,2*G.numberOfEdges()));
+
+		Array<node> last(0,n-1,0); // the node last appended to each list
+		int i;
+		for(int pass = 0; pass < 2; ++pass) {
+			// pass 0 counts the neighbors, pass 1 stores them
+			Array<int> pos(0,n-1,0);
+			if(pass == 1) {
+				for(i = 1; i <= n; ++i)
+					m_start[i] += m_start[i-1];
+				for(i = 0; i < n; ++i)
+					pos[i] = m_start[i];
+				last.fill(0);
+			}
+
+			for(i = 0; i < n; ++i) {
+				node w = byIndex[i];
+				if(w == 0) continue;
+				adjEntry adj;
+				forall_adj(adj,w) {
+					node u = adj->twinNode();
+					if(u == w || last[u->index()] == w) continue;
+					last[u->index()] = w;
+					if(pass == 0)
+						++m_start[u->index()+1];
+					else
+						m_neighbor[pos[u->index()]++] = w;
+				}
+			}
 		}
 	}
 
 
 	//! Returns true if two vertices are adjacent.
 	/**
-	* Note that only the entries in the 2D matrix where the first
-	* index is smaller than the second is used and so wehave to
-	* pay attention that the first index is smaller than the second.
+	* Performs a binary search in the neighbor list of \a v.
 	*/
 	bool AdjacencyOracle::adjacent(const node v, const node w) const
 	{
-		int num1 = m_nodeNum[v];
-		int num2 = m_nodeNum[w];
-		return (*m_adjacencyMatrix)(min(num1,num2),max(num1,num2));
+		int lo = m_start[v->index()], hi = m_start[v->index()+1];
+		const int key = w->index();
+		while(lo < hi) {
+			int mid = (lo + hi) / 2;
+			if(m_neighbor[mid]->index() < key)
+				lo = mid+1;
+			else
+				hi = mid;
+		}
+		return lo < m_start[v->index()+1] && m_neighbor[lo] == w;
 	}
 }
@@ -42,6 +42,7 @@
 
 #include "ArrayGraph.h"
 #include "FastUtils.h"
+#include "EdgeListFile.h"
 
 namespace ogdf {
 
@@ -53,7 +54,8 @@ ArrayGraph::ArrayGraph():   m_numNodes(0),
 							m_nodeMoveRadius(0),
 							m_desiredEdgeLength(0),
 							m_nodeAdj(0),
-							m_edgeAdj(0)
+							m_edgeAdj(0),
+							m_edgeList(0)
 {
 }
 
@@ -66,7 +68,8 @@ ArrayGraph::ArrayGraph(__uint32 maxNumNodes, __uint32 maxNumEdges) :
 							m_nodeMoveRadius(0),
 							m_desiredEdgeLength(0),
 							m_nodeAdj(0),
-							m_edgeAdj(0)
+							m_edgeAdj(0),
+							m_edgeList(0)
 {
 	allocate(maxNumNodes, maxNumEdges);
 }
@@ -80,7 +83,8 @@ ArrayGraph::ArrayGraph(const GraphAttributes& GA, const EdgeArray<float>& edgeLe
 							m_nodeMoveRadius(0),
 							m_desiredEdgeLength(0),
 							m_nodeAdj(0),
-							m_edgeAdj(0)
+							m_edgeAdj(0),
+							m_edgeList(0)
 {
 	allocate(GA.constGraph().numberOfNodes(), GA.constGraph().numberOfEdges());
 	readFrom(GA, edgeLength, nodeSize);
@@ -184,6 +188,7 @@ void ArrayGraph::readFrom(const GraphAttributes& GA, const EdgeArray<float>& edg
 	m_numEdges = 0;
 	m_avgNodeSize = 0;
 	m_desiredAvgEdgeLength = 0;
+	m_edgeList = 0;
 	forall_nodes(v, G)
 	{
 		m_nodeXPos[m_numNodes] = (float)GA.x(v);
@@ -203,6 +208,63 @@ void ArrayGraph::readFrom(const GraphAttributes& GA, const EdgeArray<float>& edg
 	m_desiredAvgEdgeLength = m_desiredAvgEdgeLength / (double)m_numEdges;
 }
 
+void ArrayGraph::readFrom(__uint32 numNodes, const float* nodeSize, __uint32 numEdges,
+	const int* source, const int* target, const float* edgeLength, float edgeLengthFactor)
+{
+	m_numNodes = 0;
+	m_numEdges = 0;
+	m_avgNodeSize = 0;
+	m_desiredAvgEdgeLength = 0;
+	m_edgeList = 0;
+	for (__uint32 i = 0; i < numNodes; i++)
+	{
+		m_nodeXPos[m_numNodes] = 0.0f;
+		m_nodeYPos[m_numNodes] = 0.0f;
+		m_nodeSize[m_numNodes] = nodeSize[i];
+		m_avgNodeSize += nodeSize[i];
+		m_numNodes++;
+	}
+	m_avgNodeSize = m_avgNodeSize / (double)m_numNodes;
+
+	for (__uint32 i = 0; i < numEdges; i++)
+	{
+		pushBackEdge(source[i], target[i], edgeLength[i]*edgeLengthFactor);
+	}
+	m_desiredAvgEdgeLength = m_desiredAvgEdgeLength / (double)m_numEdges;
+}
+
+void ArrayGraph::readFrom(EdgeListFile& edges, float nodeSize, float edgeLength)
+{
+	m_numNodes = edges.numNodes();
+	m_numEdges = edges.numEdges();
+	m_edgeList = &edges;
+	m_avgNodeSize = nodeSize;
+	m_desiredAvgEdgeLength = edgeLength;
+	for (__uint32 i = 0; i < m_numNodes; i++)
+	{
+		m_nodeXPos[i] = 0.0f;
+		m_nodeYPos[i] = 0.0f;
+		m_nodeSize[i] = nodeSize;
+		nodeInfo(i).degree = 0;
+	}
+
+	// only the degrees are needed, the edges are streamed by the kernel
+	for (__uint32 first = 0; first < m_numEdges; first += EdgeListFile::blockSize)
+	{
+		__uint32 n = min(EdgeListFile::blockSize, m_numEdges - first);
+		const __uint32* e = edges.edges(first);
+		for (__uint32 i = 0; i < n; i++)
+		{
+			if (e[2*i] != e[2*i+1])
+			{
+				nodeInfo(e[2*i]).degree++;
+				nodeInfo(e[2*i+1]).degree++;
+			}
+		}
+		edges.release(first, n);
+	}
+}
+
 void ArrayGraph::writeTo(GraphAttributes& GA)
 {
 	const Graph& G = GA.constGraph();
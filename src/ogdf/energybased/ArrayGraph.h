@@ -47,6 +47,8 @@
 
 namespace ogdf {
 
+class EdgeListFile;
+
 //! struct which keeps information aboout incident edges (16 bytes)
 struct NodeAdjInfo
 {
@@ -114,6 +116,7 @@ public:
 		m_numEdges = 0;
 		m_desiredAvgEdgeLength = 0;
 		m_avgNodeSize = 0;
+		m_edgeList = 0;
 		forall_nodes(v, G)
 		{
 			m_nodeXPos[m_numNodes] = (float)xPos[v];
@@ -133,6 +136,36 @@ public:
 		m_desiredAvgEdgeLength = m_desiredAvgEdgeLength / (double)m_numEdges;
 	}
 
+	//! updates an array graph from flat arrays and creates the edges
+	/**
+	 * All nodes are placed at the origin. This is used for the levels of
+	 * FastMultipoleMultilevelEmbedder, which are not stored as Graph instances.
+	 * @param numNodes the number of nodes
+	 * @param nodeSize the size of each node
+	 * @param numEdges the number of edges
+	 * @param source the source of each edge
+	 * @param target the target of each edge
+	 * @param edgeLength the desired edge length of each edge
+	 * @param edgeLengthFactor the factor each edge length is multiplied with
+	 */
+	void readFrom(__uint32 numNodes, const float* nodeSize, __uint32 numEdges,
+		const int* source, const int* target, const float* edgeLength, float edgeLengthFactor);
+
+	//! updates an array graph whose edges are kept in an edge list file
+	/**
+	 * Only the nodes and their degrees are stored, the edges are read from
+	 * \a edges whenever the edge forces are computed (see edgeList()).
+	 * Self-loops are ignored. All nodes are placed at the origin.
+	 * The array graph has to be allocated for edges.numNodes() nodes and no edges.
+	 * @param edges the edge list file, which must stay open while the array graph is used
+	 * @param nodeSize the size of each node
+	 * @param edgeLength the desired edge length of each edge
+	 */
+	void readFrom(EdgeListFile& edges, float nodeSize, float edgeLength);
+
+	//! returns the edge list file the edges are read from, or 0 if the edges are stored in the array graph
+	inline EdgeListFile* edgeList() const { return m_edgeList; }
+
 	//! writes the data back to GraphAttributes
 	/**
 	 * The function does not require to be the same Graph, only the order of nodes and edges
@@ -344,6 +377,9 @@ private:
 
 	//! information about adjacent nodes
 	EdgeAdjInfo* m_edgeAdj;
+
+	//! the edge list file if the edges are not stored in memory
+	EdgeListFile* m_edgeList;
 };
 
 } // end of namespace ogdf
@@ -54,6 +54,14 @@ Attraction::Attraction(GraphAttributes &AG) : NodePairEnergy("Attraction", AG) {
 }
 
 
+EnergyFunction *Attraction::clone(GraphAttributes &AG) const
+{
+	Attraction *pAttraction = new Attraction(AG);
+	pAttraction->setPreferredEdgelength(m_preferredEdgeLength);
+	return pAttraction;
+}
+
+
 //computes preferred edge length as the average of all widths and heights of the vertices
 //multiplied by the multiplier
 void Attraction::reinitializeEdgeLength(double multi)
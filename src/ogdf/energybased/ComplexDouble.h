@@ -319,7 +319,7 @@ public:
 		reg[1] = y;
 	}
 
-	inline ComplexDouble(double* ptr)
+	inline ComplexDouble(const double* ptr)
 	{
 		reg[0] = ptr[0];
 		reg[1] = ptr[1];
@@ -49,6 +49,8 @@
 
 #include <ogdf/energybased/DavidsonHarel.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/Thread.h>
 #include <time.h>
 
 //TODO: in addition to the layout size, node sizes should be used in
@@ -66,15 +68,119 @@ namespace ogdf {
 	const double DavidsonHarel::m_coolingFactor = 0.80;  //0.75;ori
 	const double DavidsonHarel::m_shrinkFactor = 0.8;
 
-	//initializes internal data and the random number generator
+	//! Minimal standard random number generator (Park and Miller).
+	/**
+	 * Each replica uses its own generator, so that replicas can run concurrently
+	 * and the result only depends on the random seed.
+	 */
+	class DavidsonHarel::RandomGenerator
+	{
+		__uint32 m_state;
+
+		static const __uint32 s_modulus = 2147483647; // 2^31 - 1
+
+	public:
+		explicit RandomGenerator(int seed) {
+			m_state = (__uint32)(((__int64)seed % s_modulus + s_modulus) % s_modulus);
+			if(m_state == 0) m_state = 1;
+		}
+
+		//! Returns a random number between 1 and 2^31 - 2.
+		__uint32 next() {
+			m_state = (__uint32)((__uint64)m_state * 48271 % s_modulus);
+			return m_state;
+		}
+
+		//! Returns a random number between zero and one.
+		double randNum() { return double(next() - 1) / double(s_modulus - 2); }
+
+		//! Returns a random integer between \a low and \a high (including).
+		int randomNumber(int low, int high) {
+			return low + (int)(next() % (__uint32)(high - low + 1));
+		}
+	};
+
+
+	//! An annealing chain working on its own layout and energy functions.
+	class DavidsonHarel::Replica
+	{
+	public:
+		//! Creates a replica for layout \a AG and its energy functions; if \a owner is true, they are deleted with the replica.
+		Replica(GraphAttributes &AG, const List<EnergyFunction*> &functions, double energy, int seed, bool owner)
+			: m_AG(AG), m_energyFunctions(functions), m_energy(energy),
+			  m_temperature(0.0), m_diskRadius(0.0), m_rng(seed), m_owner(owner) { }
+
+		~Replica() {
+			if(m_owner) {
+				ListIterator<EnergyFunction*> it;
+				for(it = m_energyFunctions.begin(); it.valid(); ++it)
+					delete *it;
+				delete &m_AG;
+			}
+		}
+
+		//! Performs \a iterations annealing steps at the current temperature and disk radius.
+		void anneal(const Array<node> &nonIsolated, const List<double> &weights, int iterations);
+
+		GraphAttributes &m_AG;                   //!< The layout of this replica.
+		List<EnergyFunction*> m_energyFunctions; //!< The energy functions working on m_AG.
+		double m_energy;                         //!< The current energy of m_AG.
+		double m_temperature;                    //!< The current temperature.
+		double m_diskRadius;                     //!< The current disk radius.
+		RandomGenerator m_rng;                   //!< The random number generator of this replica.
+
+	private:
+		bool m_owner; //!< True iff m_AG and m_energyFunctions are owned by the replica.
+
+		//! Randomly computes a node and a new position for that node.
+		node computeCandidateLayout(const Array<node> &nonIsolated, DPoint &newPos);
+
+		//! Tests if new energy value satisfies annealing property.
+		bool testEnergyValue(double newVal);
+	};
+
+
+	//! Runs the replicas \a first, \a first + \a step, ... for one temperature step in a separate thread.
+	class DavidsonHarel::Worker : public Thread
+	{
+		Array<Replica *> &m_replica;
+		const Array<node> &m_nonIsolated;
+		const List<double> &m_weights;
+		int m_iterations;
+		int m_first;
+		int m_step;
+
+	public:
+		Worker(Array<Replica *> &replica, const Array<node> &nonIsolated, const List<double> &weights,
+			int iterations, int first, int step)
+			: m_replica(replica), m_nonIsolated(nonIsolated), m_weights(weights),
+			  m_iterations(iterations), m_first(first), m_step(step) { }
+
+		void run() {
+			for(int r = m_first; r < m_replica.size(); r += m_step)
+				m_replica[r]->anneal(m_nonIsolated, m_weights, m_iterations);
+		}
+
+	protected:
+		virtual void doWork() { run(); }
+	};
+
+
+	//initializes internal data and the random seed
 	DavidsonHarel::DavidsonHarel():
 	m_temperature(m_defaultTemp),
 	m_shrinkingFactor(m_shrinkFactor),
 	m_diskRadius(m_defaultRadius),
 	m_energy(0.0),
-	m_numberOfIterations(0)
+	m_numberOfIterations(0),
+	m_numberOfReplicas(1),
+	m_randomSeed((int)time(NULL))
 	{
-		srand((unsigned)time(NULL));
+#ifdef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = 1;
+#else
+		m_maxThreads = System::numberOfProcessors();
+#endif
 	}
 
 
@@ -101,6 +207,12 @@ namespace ogdf {
 		m_numberOfIterations = steps;
 	}
 
+	void DavidsonHarel::setNumberOfReplicas(int n)
+	{
+		OGDF_ASSERT(n >= 1);
+		m_numberOfReplicas = n;
+	}
+
 	//whenever an energy function is added, the initial energy of the new function
 	//is computed and added to the initial energy of the layout
 	void DavidsonHarel::addEnergyFunction(EnergyFunction *F, double weight)
@@ -131,17 +243,16 @@ namespace ogdf {
 	}
 
 	//newVal is the energy value of a candidate layout. It is accepted if it is lower
-	//than the previous energy of the layout or if m_fineTune is not tpFine and
-	//the difference to the old energy divided by the temperature is smaller than a
-	//random number between zero and one
-	bool DavidsonHarel::testEnergyValue(double newVal)
+	//than the previous energy of the layout or if the difference to the old energy
+	//divided by the temperature is smaller than a random number between zero and one
+	bool DavidsonHarel::Replica::testEnergyValue(double newVal)
 	{
 		bool accepted = true;
 		if(newVal > m_energy) {
 			accepted = false;
 
 			double testval = exp((m_energy-newVal)/ m_temperature);
-			double compareVal = randNum(); // number between 0 and 1
+			double compareVal = m_rng.randNum(); // number between 0 and 1
 
 			if(compareVal < testval)
 				accepted = true;
@@ -150,25 +261,17 @@ namespace ogdf {
 		return accepted;
 	}
 
-	//divides number returned by rand by RAND_MAX to get number between zero and one
-	inline double DavidsonHarel::randNum() const
-	{
-		double val = rand();
-		val /= RAND_MAX;
-		return val;
-	}
-
 	//chooses random vertex and a new random position for it on a circle with radius m_diskRadius
 	//around its previous position
-	node DavidsonHarel::computeCandidateLayout(
-	const GraphAttributes &AG,
-	DPoint &newPos) const
+	node DavidsonHarel::Replica::computeCandidateLayout(
+	const Array<node> &nonIsolated,
+	DPoint &newPos)
 	{
-		int randomPos = randomNumber(0,m_nonIsolatedNodes.size()-1);
-		node v = *(m_nonIsolatedNodes.get(randomPos));
-		double oldx = AG.x(v);
-		double oldy = AG.y(v);
-		double randomAngle = randNum() * 2.0 * Math::pi;
+		int randomPos = m_rng.randomNumber(0,nonIsolated.size()-1);
+		node v = nonIsolated[randomPos];
+		double oldx = m_AG.x(v);
+		double oldy = m_AG.y(v);
+		double randomAngle = m_rng.randNum() * 2.0 * Math::pi;
 		newPos.m_y = oldy+sin(randomAngle)*m_diskRadius;
 		newPos.m_x = oldx+cos(randomAngle)*m_diskRadius;
 #ifdef OGDF_DEBUG
@@ -178,6 +281,92 @@ namespace ogdf {
 		return v;
 	}
 
+	//for each iteration, a new position for a random vertex is tried
+	void DavidsonHarel::Replica::anneal(const Array<node> &nonIsolated, const List<double> &weights, int iterations)
+	{
+		for(int ic = 1; ic <= iterations; ic ++) {
+			DPoint newPos;
+			//choose random vertex and new position for vertex
+			node v = computeCandidateLayout(nonIsolated,newPos);
+			//compute candidate energy and decide if new layout is chosen
+			ListIterator<EnergyFunction*> it;
+			ListConstIterator<double> it2 = weights.begin();
+			double newEnergy = 0.0;
+			for(it = m_energyFunctions.begin(); it.valid(); it = it.succ()) {
+				newEnergy += (*it)->computeCandidateEnergy(v,newPos) * (*it2);
+				it2 = it2.succ();
+			}
+			OGDF_ASSERT(newEnergy >= 0.0);
+			//this tests if the new layout is accepted. If this is the case,
+			//all energy functions are informed that the new layout is accepted
+			if(testEnergyValue(newEnergy)) {
+				for(it = m_energyFunctions.begin(); it.valid(); it = it.succ())
+					(*it)->candidateTaken();
+				m_AG.x(v) = newPos.m_x;
+				m_AG.y(v) = newPos.m_y;
+				m_energy = newEnergy;
+			}
+		}
+	}
+
+	//replica 0 works on AG and the given energy functions, all other replicas on copies
+	//of AG and clones of the energy functions
+	bool DavidsonHarel::createReplicas(GraphAttributes &AG, Array<Replica *> &replica) const
+	{
+		const Graph &G = AG.constGraph();
+
+		replica.init(m_numberOfReplicas);
+		replica[0] = new Replica(AG, m_energyFunctions, m_energy, m_randomSeed, false);
+
+		for(int r = 1; r < m_numberOfReplicas; ++r) {
+			GraphAttributes *pAG = new GraphAttributes(G, AG.attributes());
+			node v;
+			forall_nodes(v,G) {
+				pAG->x(v)      = AG.x(v);
+				pAG->y(v)      = AG.y(v);
+				pAG->width(v)  = AG.width(v);
+				pAG->height(v) = AG.height(v);
+			}
+
+			List<EnergyFunction*> functions;
+			ListConstIterator<EnergyFunction*> it;
+			for(it = m_energyFunctions.begin(); it.valid(); ++it) {
+				EnergyFunction *F = (*it)->clone(*pAG);
+				if(F == 0)
+					break;
+				F->computeEnergy();
+				functions.pushBack(F);
+			}
+
+			replica[r] = new Replica(*pAG, functions, m_energy, m_randomSeed + r, true);
+
+			if(it.valid()) {
+				// some energy function cannot be cloned
+				for(int i = 0; i <= r; ++i)
+					delete replica[i];
+				replica.init();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//the replicas in slots i and i+1 (i = parity, parity+2, ...) are exchanged with
+	//probability min(1, exp((1/T_i - 1/T_i+1) * (E_i - E_i+1)))
+	void DavidsonHarel::exchangeReplicas(Array<Replica *> &slot, int parity, RandomGenerator &rng) const
+	{
+		for(int i = parity; i+1 < slot.size(); i += 2) {
+			Replica *r1 = slot[i];
+			Replica *r2 = slot[i+1];
+			double delta = (1.0/r1->m_temperature - 1.0/r2->m_temperature) * (r1->m_energy - r2->m_energy);
+			if(delta >= 0.0 || rng.randNum() < exp(delta)) {
+				slot[i]   = r2;
+				slot[i+1] = r1;
+			}
+		}
+	}
+
 	//chooses the initial radius of the disk as half the maximum of width and height of
 	//the initial layout or depending on the value of m_fineTune
 	void DavidsonHarel::computeFirstRadius(const GraphAttributes &AG)
@@ -326,36 +515,87 @@ namespace ogdf {
 			computeInitialEnergy();
 			if(m_numberOfIterations == 0)
 				m_numberOfIterations = m_nonIsolatedNodes.size() * m_iterationMultiplier;
+			//the non-isolated vertices in an array for fast random access
+			Array<node> nonIsolated(m_nonIsolatedNodes.size());
+			int i = 0;
+			for(it = m_nonIsolatedNodes.begin(); it.valid(); ++it)
+				nonIsolated[i++] = *it;
+
+			Array<Replica *> replica;
+			if(m_numberOfReplicas < 2 || !createReplicas(AG, replica)) {
+				replica.init(1);
+				replica[0] = new Replica(AG, m_energyFunctions, m_energy, m_randomSeed, false);
+			}
+			const int numReplicas = replica.size();
+			const int nThreads = max(1, min(m_maxThreads, numReplicas));
+
+			//slot[k] is the replica running at the k-th highest temperature
+			Array<Replica *> slot(replica);
+			RandomGenerator rng(m_randomSeed - 1);
+			int parity = 0;
+
 			//this is the main optimization loop
 			while(m_temperature > 0) {
+				double temperature = m_temperature;
+				double diskRadius = m_diskRadius;
+				for(int k = 0; k < numReplicas; ++k) {
+					slot[k]->m_temperature = temperature;
+					slot[k]->m_diskRadius = diskRadius;
+					temperature *= m_coolingFactor;
+					diskRadius *= m_shrinkingFactor;
+				}
+
 				//iteration loop for each temperature
-				for(int ic = 1; ic <= m_numberOfIterations; ic ++) {
-					DPoint newPos;
-					//choose random vertex and new position for vertex
-					node v = computeCandidateLayout(AG,newPos);
-					//compute candidate energy and decide if new layout is chosen
-					ListIterator<EnergyFunction*> it;
-					ListIterator<double> it2 = m_weightsOfEnergyFunctions.begin();
-					double newEnergy = 0.0;
-					for(it = m_energyFunctions.begin(); it.valid(); it = it.succ()) {
-						newEnergy += (*it)->computeCandidateEnergy(v,newPos) * (*it2);
-						it2 = it2.succ();
-					}
-					OGDF_ASSERT(newEnergy >= 0.0);
-					//this tests if the new layout is accepted. If this is the case,
-					//all energy functions are informed that the new layout is accepted
-					if(testEnergyValue(newEnergy)) {
-						for(it = m_energyFunctions.begin(); it.valid(); it = it.succ())
-							(*it)->candidateTaken();
-						AG.x(v) = newPos.m_x;
-						AG.y(v) = newPos.m_y;
-						m_energy = newEnergy;
-					}
+				if(nThreads == 1) {
+					for(int r = 0; r < numReplicas; ++r)
+						replica[r]->anneal(nonIsolated, m_weightsOfEnergyFunctions, m_numberOfIterations);
+
+				} else {
+					Array<Worker *> worker(nThreads);
+					for(int t = 0; t < nThreads; ++t)
+						worker[t] = new Worker(replica, nonIsolated, m_weightsOfEnergyFunctions, m_numberOfIterations, t, nThreads);
+
+					for(int t = 1; t < nThreads; ++t)
+						worker[t]->start();
+					worker[0]->run();
+
+					for(int t = 1; t < nThreads; ++t)
+						worker[t]->join();
+					for(int t = 0; t < nThreads; ++t)
+						delete worker[t];
+				}
+
+				if(numReplicas > 1) {
+					exchangeReplicas(slot, parity, rng);
+					parity = 1 - parity;
 				}
+
 				//lower the temperature and decrease the disk radius
 				m_temperature = (int)floor(m_temperature*m_coolingFactor);
 				m_diskRadius *= m_shrinkingFactor;
 			}
+
+			//return the layout of the replica with the lowest energy
+			Replica *best = replica[0];
+			for(int r = 1; r < numReplicas; ++r)
+				if(replica[r]->m_energy < best->m_energy)
+					best = replica[r];
+
+			if(best != replica[0]) {
+				node v;
+				forall_nodes(v,G) {
+					AG.x(v) = best->m_AG.x(v);
+					AG.y(v) = best->m_AG.y(v);
+				}
+				//update the energy functions working on AG
+				ListIterator<EnergyFunction*> itF;
+				for(itF = m_energyFunctions.begin(); itF.valid(); ++itF)
+					(*itF)->computeEnergy();
+			}
+			m_energy = best->m_energy;
+
+			for(int r = 0; r < numReplicas; ++r)
+				delete replica[r];
 		}
 		//if there are zero degree vertices, they are placed using placeIsolatedNodes
 		if(m_nonIsolatedNodes.size() != G.numberOfNodes())
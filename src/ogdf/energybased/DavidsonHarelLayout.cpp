@@ -52,6 +52,7 @@
 #include <ogdf/internal/energybased/Overlap.h>
 #include <ogdf/internal/energybased/Planarity.h>
 #include <ogdf/internal/energybased/PlanarityGrid.h>
+#include <time.h>
 
 
 #define DEFAULT_REPULSION_WEIGHT 1e6
@@ -71,6 +72,8 @@ struct IterationsNonPositive : InputValueInvalid { };
 
 struct TemperatureNonPositive : InputValueInvalid { };
 
+struct ReplicasNonPositive : InputValueInvalid { };
+
 
 DavidsonHarelLayout::DavidsonHarelLayout()
 {
@@ -85,6 +88,8 @@ DavidsonHarelLayout::DavidsonHarelLayout()
 	m_multiplier = 2.0;
 	m_prefEdgeLength = 0.0;
 	m_crossings = false;
+	m_numberOfReplicas = 1;
+	m_randomSeed = (int)time(NULL);
 }
 
 
@@ -160,6 +165,13 @@ void DavidsonHarelLayout::setStartTemperature (int w)
 }
 
 
+void DavidsonHarelLayout::setNumberOfReplicas(int n)
+{
+	if(n < 1) throw ReplicasNonPositive();
+	else m_numberOfReplicas = n;
+}
+
+
 //this sets the parameters of the class DavidsonHarel, adds the energy functions and
 //starts the optimization process
 void DavidsonHarelLayout::call(GraphAttributes &AG)
@@ -223,6 +235,8 @@ void DavidsonHarelLayout::call(GraphAttributes &AG)
 			dh.setNumberOfIterations(m_numberOfIterations);
 	}
 	dh.setStartTemperature(m_startTemperature);
+	dh.setNumberOfReplicas(m_numberOfReplicas);
+	dh.setRandomSeed(m_randomSeed);
 	dh.call(AG);
 }
 
@@ -0,0 +1,207 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class EdgeListFile.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include "EdgeListFile.h"
+#include <ogdf/basic/System.h>
+
+#if !defined(OGDF_SYSTEM_WINDOWS) && !defined(__CYGWIN__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ogdf {
+
+const __uint32 EdgeListFile::blockSize;
+
+EdgeListFile::EdgeListFile() :
+	m_edges(0),
+	m_size(0),
+	m_numEdges(0),
+	m_numNodes(0)
+{
+	m_pageSize = System::pageSize() > 0 ? System::pageSize() : 4096;
+#if defined(OGDF_SYSTEM_WINDOWS) || defined(__CYGWIN__)
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = 0;
+#endif
+}
+
+EdgeListFile::~EdgeListFile()
+{
+	close();
+}
+
+bool EdgeListFile::open(const char *fileName)
+{
+	close();
+
+#if defined(OGDF_SYSTEM_WINDOWS) || defined(__CYGWIN__)
+	m_file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if (m_file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || (__uint64)size.QuadPart / 8 > 0xffffffffULL || (__uint64)size.QuadPart > (size_t)-1) {
+		close();
+		return false;
+	}
+	m_size = (size_t)size.QuadPart;
+
+	if (m_size > 0) {
+		m_mapping = CreateFileMapping(m_file, 0, PAGE_READONLY, 0, 0, 0);
+		if (m_mapping == 0) {
+			close();
+			return false;
+		}
+		m_edges = (const __uint32 *)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+		if (m_edges == 0) {
+			close();
+			return false;
+		}
+	}
+#else
+	int file = ::open(fileName, O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(file, &info) != 0 || (__uint64)info.st_size / 8 > 0xffffffffULL || (__uint64)info.st_size > (size_t)-1) {
+		::close(file);
+		return false;
+	}
+	m_size = (size_t)info.st_size;
+
+	if (m_size > 0) {
+		void *data = mmap(0, m_size, PROT_READ, MAP_SHARED, file, 0);
+		if (data == MAP_FAILED) {
+			::close(file);
+			m_size = 0;
+			return false;
+		}
+		m_edges = (const __uint32 *)data;
+		madvise(data, m_size, MADV_SEQUENTIAL);
+	}
+	// the mapping stays valid after closing the file
+	::close(file);
+#endif
+
+	// a trailing incomplete edge is ignored
+	m_numEdges = (__uint32)(m_size / (2*sizeof(__uint32)));
+
+	// the number of nodes is given by the largest index
+	__uint32 maxIndex = 0;
+	bool hasNodes = false;
+	for (__uint32 first = 0; first < m_numEdges; first += blockSize) {
+		__uint32 n = min(blockSize, m_numEdges - first);
+		const __uint32 *e = edges(first);
+		for (__uint32 i = 0; i < 2*n; i++)
+			maxIndex = max(maxIndex, e[i]);
+		hasNodes = true;
+		release(first, n);
+	}
+	if (hasNodes && maxIndex == 0xffffffff) {
+		close();
+		return false;
+	}
+	m_numNodes = hasNodes ? maxIndex + 1 : 0;
+	return true;
+}
+
+void EdgeListFile::close()
+{
+#if defined(OGDF_SYSTEM_WINDOWS) || defined(__CYGWIN__)
+	if (m_edges)
+		UnmapViewOfFile(m_edges);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = 0;
+#else
+	if (m_edges)
+		munmap((void *)m_edges, m_size);
+#endif
+	m_edges = 0;
+	m_size = 0;
+	m_numEdges = 0;
+	m_numNodes = 0;
+}
+
+void EdgeListFile::pageRange(__uint32 first, __uint32 n, char *&begin, size_t &length) const
+{
+	size_t offset = 2*sizeof(__uint32)*(size_t)first;
+	size_t end = offset + 2*sizeof(__uint32)*(size_t)n;
+	offset -= offset % m_pageSize;
+	begin = (char *)m_edges + offset;
+	length = end - offset;
+}
+
+void EdgeListFile::prefetch(__uint32 first, __uint32 n)
+{
+	if (n == 0)
+		return;
+	char *begin;
+	size_t length;
+	pageRange(first, n, begin, length);
+#if !defined(OGDF_SYSTEM_WINDOWS) && !defined(__CYGWIN__)
+	madvise(begin, length, MADV_WILLNEED);
+#endif
+}
+
+void EdgeListFile::release(__uint32 first, __uint32 n)
+{
+	if (n == 0)
+		return;
+	char *begin;
+	size_t length;
+	pageRange(first, n, begin, length);
+#if defined(OGDF_SYSTEM_WINDOWS) || defined(__CYGWIN__)
+	// unlocking pages which are not locked removes them from the working set
+	VirtualUnlock(begin, length);
+#else
+	// the pages are read again from the file if they are needed later
+	madvise(begin, length, MADV_DONTNEED);
+#endif
+}
+
+} // end of namespace ogdf
@@ -0,0 +1,114 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class EdgeListFile.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_EDGE_LIST_FILE_H
+#define OGDF_EDGE_LIST_FILE_H
+
+#include <ogdf/basic/basic.h>
+
+namespace ogdf {
+
+//! A binary edge list file which is mapped into memory.
+/**
+ * The file consists of one pair of 32-bit unsigned integers (the indices of the
+ * source and the target node) per edge in native byte order. The number of nodes
+ * is the largest node index plus one.
+ *
+ * The file is mapped read-only and is meant to be traversed block by block.
+ * Blocks which have been processed can be released again, hence the file does
+ * not have to fit into main memory.
+ */
+class EdgeListFile
+{
+public:
+	//! the number of edges in a block
+	static const __uint32 blockSize = 1 << 20;
+
+	EdgeListFile();
+	~EdgeListFile();
+
+	//! maps the file into memory and determines the number of nodes
+	/**
+	 * @param fileName the name of the edge list file
+	 * \return false if the file cannot be mapped or has too many edges
+	 */
+	bool open(const char *fileName);
+
+	//! unmaps the file
+	void close();
+
+	//! returns the number of edges
+	inline __uint32 numEdges() const { return m_numEdges; }
+
+	//! returns the number of nodes
+	inline __uint32 numNodes() const { return m_numNodes; }
+
+	//! returns the source and target of edge \a i and its successors
+	inline const __uint32 *edges(__uint32 i) const { return m_edges + 2*(size_t)i; }
+
+	//! tells the system that the edges [\a first, \a first + \a n) will be needed soon
+	void prefetch(__uint32 first, __uint32 n);
+
+	//! tells the system that the edges [\a first, \a first + \a n) are not needed any more
+	void release(__uint32 first, __uint32 n);
+
+private:
+	//! returns the address range of the given edges, enlarged to whole pages
+	void pageRange(__uint32 first, __uint32 n, char *&begin, size_t &length) const;
+
+	const __uint32 *m_edges; //!< the mapped file
+	size_t m_size;           //!< the size of the mapped file in bytes
+	__uint32 m_numEdges;     //!< the number of edges
+	__uint32 m_numNodes;     //!< the number of nodes
+	size_t m_pageSize;       //!< the page size of the system
+
+#if defined(OGDF_SYSTEM_WINDOWS) || defined(__CYGWIN__)
+	HANDLE m_file;
+	HANDLE m_mapping;
+#endif
+};
+
+} // end of namespace ogdf
+
+#endif
@@ -820,6 +820,78 @@ static inline EdgeForceFunctor<FLAGS> edge_force_function( FMELocalContext* pLoc
 }
 
 
+//! the edge force functor for a block of an edge list file, all edges have the same desired length
+template<unsigned int FLAGS>
+class EdgeListForceFunctor
+{
+public:
+	inline EdgeListForceFunctor( FMELocalContext* pLocalContext, const __uint32* edges )
+	{
+		pGraph = pLocalContext->pGlobalContext->pGraph;
+		x = pGraph->nodeXPos();
+		y = pGraph->nodeYPos();
+		this->edges = edges;
+		nodeInfo = pGraph->nodeInfo();
+		logDesiredEdgeLength = logf(pGraph->avgDesiredEdgeLength());
+		nodeSize = pGraph->nodeSize();
+		forceArrayX = pLocalContext->forceX;
+		forceArrayY = pLocalContext->forceY;
+	}
+
+	inline void operator()(__uint32 i)
+	{
+		__uint32 a = edges[2*i];
+		__uint32 b = edges[2*i+1];
+		if (a == b)
+			return;
+
+		float d_x = x[a] - x[b];
+		float d_y = y[a] - y[b];
+		float d_sq = d_x*d_x + d_y*d_y;
+
+		float f = (float)(logf(d_sq)*0.5f-logDesiredEdgeLength);
+
+		float fa = f*0.25f;
+		float fb = f*0.25f;
+
+		if (FLAGS & EDGE_FORCE_DIV_DEGREE)
+		{
+			fa = (float)(fa/((float)nodeInfo[a].degree));
+			fb = (float)(fb/((float)nodeInfo[b].degree));
+		}
+
+		if (FLAGS & EDGE_FORCE_SUB_REP)
+		{
+			fa += (nodeSize[b] / d_sq);
+			fb += (nodeSize[a] / d_sq);
+		}
+		forceArrayX[a] -= fa*d_x;
+		forceArrayY[a] -= fa*d_y;
+		forceArrayX[b] += fb*d_x;
+		forceArrayY[b] += fb*d_y;
+	}
+
+private:
+	float* x;
+	float* y;
+	const __uint32* edges;
+	NodeAdjInfo* nodeInfo;
+
+	ArrayGraph* pGraph;
+	float logDesiredEdgeLength;
+	float* nodeSize;
+	float* forceArrayX;
+	float* forceArrayY;
+};
+
+
+template<unsigned int FLAGS>
+static inline EdgeListForceFunctor<FLAGS> edge_list_force_function( FMELocalContext* pLocalContext, const __uint32* edges )
+{
+	return EdgeListForceFunctor<FLAGS>( pLocalContext, edges );
+}
+
+
 enum
 {
 	COLLECT_NO_FACTOR			= 0x00,
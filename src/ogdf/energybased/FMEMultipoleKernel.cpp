@@ -46,6 +46,7 @@
 #include "LinearQuadtreeBuilder.h"
 #include "LinearQuadtreeExpansion.h"
 #include "WSPD.h"
+#include "EdgeListFile.h"
 
 namespace ogdf {
 
@@ -490,6 +491,32 @@ void FMEMultipoleKernel::multipoleApproxFinal(ArrayPartition& nodePointPartition
 
 
 
+template<unsigned int FLAGS>
+void FMEMultipoleKernel::edgeForces(ArrayPartition& edgePartition)
+{
+	ArrayGraph& graph = *m_pGlobalContext->pGraph;
+	EdgeListFile* edgeList = graph.edgeList();
+	if (!edgeList)
+	{
+		for_loop(edgePartition, edge_force_function< FLAGS >(m_pLocalContext));
+		return;
+	}
+
+	// stream the edge list file, only one block is needed at a time
+	for (__uint32 first = 0; first < graph.numEdges(); first += EdgeListFile::blockSize)
+	{
+		__uint32 n = min(EdgeListFile::blockSize, graph.numEdges() - first);
+		if (isMainThread())
+			edgeList->prefetch(first + n, min(EdgeListFile::blockSize, graph.numEdges() - first - n));
+		for_loop(arrayPartition(n), edge_list_force_function< FLAGS >(m_pLocalContext, edgeList->edges(first)));
+		// wait until the block is done
+		sync();
+		if (isMainThread())
+			edgeList->release(first, n);
+	}
+}
+
+
 void FMEMultipoleKernel::operator()(FMEGlobalContext* globalContext)
 {
 	__uint32					maxNumIterations    =  globalContext->pOptions->maxNumIterations;
@@ -527,9 +554,7 @@ void FMEMultipoleKernel::operator()(FMEGlobalContext* globalContext)
 	for (__uint32 currNumIteration = 0; ((currNumIteration < maxNumIt) ); currNumIteration++)
 	{
 		// iterate over all edges and store the resulting forces in the threads array
-		for_loop(edgePartition,
-			edge_force_function< EDGE_FORCE_DIV_DEGREE > (localContext)	// divide the forces by degree of the node to avoid oscilation
-			);
+		edgeForces< EDGE_FORCE_DIV_DEGREE >(edgePartition);	// divide the forces by degree of the node to avoid oscilation
 		// wait until all edges are done
 		sync();
 		// now collect the forces in parallel and put the sum into the global array and move the nodes accordingly
@@ -567,10 +592,8 @@ void FMEMultipoleKernel::operator()(FMEGlobalContext* globalContext)
 		// now wait until all forces are summed up in the global array and mapped to graph node order
 		sync();
 
-		// run the edge forces
-		for_loop(edgePartition,							// iterate over all edges and sum up the forces in the threads array
-			edge_force_function< EDGE_FORCE_DIV_DEGREE >(localContext)	// divide the forces by degree of the node to avoid oscilation
-		);
+		// run the edge forces, iterate over all edges and sum up the forces in the threads array
+		edgeForces< EDGE_FORCE_DIV_DEGREE >(edgePartition);	// divide the forces by degree of the node to avoid oscilation
 		// wait until edges are finished
 		sync();
 
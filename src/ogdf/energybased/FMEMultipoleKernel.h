@@ -92,6 +92,13 @@ public:
 	//! the final version, the wspd structure is only used for the top of the tree
 	void multipoleApproxFinal(ArrayPartition& nodePointPartition);
 
+	//! computes the edge forces and sums them up in the threads force array
+	/**
+	 * If the edges are kept in an edge list file, the file is streamed block by block.
+	 */
+	template<unsigned int FLAGS>
+	void edgeForces(ArrayPartition& edgePartition);
+
 	//! main function of the kernel
 	void operator()(FMEGlobalContext* globalContext);
 
@@ -49,6 +49,8 @@
 #include "FMEThread.h"
 #include "GalaxyMultilevel.h"
 #include "FMEMultipoleKernel.h"
+#include "EdgeListFile.h"
+#include <fstream>
 
 
 namespace ogdf {
@@ -101,6 +103,16 @@ void FastMultipoleEmbedder::call(const Graph& G, NodeArray<float>& nodeXPosition
 	deallocate();
 }
 
+void FastMultipoleEmbedder::call(ArrayGraph& G)
+{
+	// G is owned by the caller
+	m_pGraph = &G;
+	allocateSimulation(G.numNodes());
+	run(m_numIterations);
+	deallocateSimulation();
+	m_pGraph = 0;
+}
+
 void FastMultipoleEmbedder::call(GraphAttributes &GA)
 {
 	EdgeArray<float> edgeLength(GA.constGraph());
@@ -134,6 +146,37 @@ void FastMultipoleEmbedder::call(GraphAttributes &GA, const EdgeArray<float>& ed
 	}
 }
 
+bool FastMultipoleEmbedder::callOutOfCore(const char *edgeListFile, const char *positionFile)
+{
+	EdgeListFile edges;
+	if (!edges.open(edgeListFile))
+		return false;
+
+	ArrayGraph G(edges.numNodes(), 0);
+	G.readFrom(edges, m_defaultNodeSize, m_defaultEdgeLength);
+	call(G);
+
+	std::ofstream os(positionFile, std::ios::out | std::ios::binary);
+	if (!os)
+		return false;
+
+	// write the positions in blocks
+	const __uint32 blockSize = 1 << 16;
+	Array<float> buffer(2*blockSize);
+	for (__uint32 first = 0; first < G.numNodes(); first += blockSize)
+	{
+		__uint32 n = min(blockSize, G.numNodes() - first);
+		for (__uint32 i = 0; i < n; i++)
+		{
+			buffer[2*i] = G.nodeXPos()[first + i];
+			buffer[2*i+1] = G.nodeYPos()[first + i];
+		}
+		os.write((const char *)&buffer[0], 2*sizeof(float)*n);
+	}
+	os.close();
+	return !os.fail();
+}
+
 void FastMultipoleEmbedder::run(__uint32 numIterations)
 {
 	if (m_pGraph->numNodes() == 0) return;
@@ -162,7 +205,8 @@ void FastMultipoleEmbedder::run(__uint32 numIterations)
 
 	m_pOptions->maxNumIterations = numIterations;
 	m_pOptions->stopCritForce = (((float)m_pGraph->numNodes())*((float)m_pGraph->numNodes())*m_pGraph->avgNodeSize()) / m_pOptions->stopCritConstSq;
-	if (m_pGraph->numNodes() < 100)
+	// the single kernel needs the edges in memory
+	if (m_pGraph->numNodes() < 100 && !m_pGraph->edgeList())
 		runSingle();
 	else
 		runMultipole();
@@ -186,8 +230,14 @@ void FastMultipoleEmbedder::runSingle()
 
 void FastMultipoleEmbedder::allocate(__uint32 numNodes, __uint32 numEdges)
 {
-	m_pOptions = new FMEGlobalOptions();
 	m_pGraph = new ArrayGraph(numNodes, numEdges);
+	allocateSimulation(numNodes);
+}
+
+
+void FastMultipoleEmbedder::allocateSimulation(__uint32 numNodes)
+{
+	m_pOptions = new FMEGlobalOptions();
 	initOptions();
 	if (!m_maxNumberOfThreads)
 	{
@@ -210,8 +260,14 @@ void FastMultipoleEmbedder::allocate(__uint32 numNodes, __uint32 numEdges)
 
 void FastMultipoleEmbedder::deallocate()
 {
-	delete m_threadPool;
+	deallocateSimulation();
 	delete m_pGraph;
+}
+
+
+void FastMultipoleEmbedder::deallocateSimulation()
+{
+	delete m_threadPool;
 	delete m_pOptions;
 }
 
@@ -219,15 +275,21 @@ void FastMultipoleEmbedder::deallocate()
 
 void FastMultipoleMultilevelEmbedder::dumpCurrentLevel(const char *filename)
 {
-	const Graph& G = *(m_pCurrentLevel->m_pGraph);
+	const GalaxyMultilevel& L = *m_pCurrentLevel;
+	Graph G;
+	Array<node> toNode(L.numberOfNodes());
+	for (int i = 0; i < L.numberOfNodes(); i++)
+		toNode[i] = G.newNode();
+	for (int i = 0; i < L.numberOfEdges(); i++)
+		G.newEdge(toNode[L.m_edgeSource[i]], toNode[L.m_edgeTarget[i]]);
+
 	GraphAttributes GA(G);
-	node v = 0;
-	forall_nodes(v, G)
+	for (int i = 0; i < L.numberOfNodes(); i++)
 	{
-		GalaxyMultilevel::LevelNodeInfo& nodeInfo = (*(m_pCurrentLevel->m_pNodeInfo))[v];
-		GA.x(v) = (*m_pCurrentNodeXPos)[v];
-		GA.y(v) = (*m_pCurrentNodeYPos)[v];
-		GA.width(v) = GA.height(v)= nodeInfo.radius / sqrt(2.0);
+		node v = toNode[i];
+		GA.x(v) = m_pCurrentGraph->nodeXPos()[i];
+		GA.y(v) = m_pCurrentGraph->nodeYPos()[i];
+		GA.width(v) = GA.height(v)= L.m_radius[i] / sqrt(2.0);
 	}
 	GraphIO::writeGML(GA, filename);
 }
@@ -277,24 +339,11 @@ void FastMultipoleMultilevelEmbedder::computeAutoEdgeLength(const GraphAttribute
 
 void FastMultipoleMultilevelEmbedder::run(GraphAttributes& GA, const EdgeArray<float>& edgeLength)
 {
-	// too lazy for new, delete
-	NodeArray<float> nodeXPos1;
-	NodeArray<float> nodeYPos1;
-	NodeArray<float> nodeXPos2;
-	NodeArray<float> nodeYPos2;
-	EdgeArray<float> edgeLength1;
-	NodeArray<float> nodeSize1;
-
-	m_pCurrentNodeXPos	= &nodeXPos1;
-	m_pCurrentNodeYPos	= &nodeYPos1;
-	m_pLastNodeXPos		= &nodeXPos2;
-	m_pLastNodeYPos		= &nodeYPos2;
-	m_pCurrentEdgeLength= &edgeLength1;
-	m_pCurrentNodeSize	= &nodeSize1;
-	Graph* pGraph = const_cast<Graph*>(&(GA.constGraph()));
+	m_pCurrentGraph = 0;
+	m_pLastGraph = 0;
 
 	// create all multilevels
-	this->createMultiLevelGraphs(pGraph, GA, edgeLength);
+	this->createMultiLevelGraphs(GA, edgeLength);
 	// init the coarsest level
 	initCurrentLevel();
 
@@ -317,113 +366,97 @@ void FastMultipoleMultilevelEmbedder::run(GraphAttributes& GA, const EdgeArray<f
 		layoutCurrentLevel();
 	}
 	// the finest level is processed
-	// assumes m_pCurrentGraph == GA.constGraph
+	// assumes the nodes of the finest level are ordered like in GA.constGraph
 	writeCurrentToGraphAttributes(GA);
+	delete m_pLastGraph;
+	delete m_pCurrentGraph;
 	// clean up multilevels
 	deleteMultiLevelGraphs();
 }
 
-void FastMultipoleMultilevelEmbedder::createMultiLevelGraphs(Graph* pGraph, GraphAttributes& GA, const EdgeArray<float>& finestLevelEdgeLength)
+void FastMultipoleMultilevelEmbedder::createMultiLevelGraphs(GraphAttributes& GA, const EdgeArray<float>& finestLevelEdgeLength)
 {
-	m_pCurrentLevel = new GalaxyMultilevel(pGraph);
+	m_pCurrentLevel = new GalaxyMultilevel(GA.constGraph());
 	m_pFinestLevel = m_pCurrentLevel;
 	initFinestLevel(GA, finestLevelEdgeLength);
 	m_iNumLevels = 1;
 	m_iCurrentLevelNr = 0;
 
-	GalaxyMultilevelBuilder builder;
-	while (m_pCurrentLevel->m_pGraph->numberOfNodes() > m_multiLevelNumNodesBound)
+	GalaxyMultilevelBuilder builder(m_iMaxNumThreads > 0 ? m_iMaxNumThreads : System::numberOfProcessors());
+	while (m_pCurrentLevel->numberOfNodes() > m_multiLevelNumNodesBound)
 	{
 		GalaxyMultilevel* newLevel = builder.build(m_pCurrentLevel);
+		// stop if the level cannot be coarsened any further (e.g. isolated nodes only)
+		if (newLevel->numberOfNodes() == m_pCurrentLevel->numberOfNodes())
+		{
+			m_pCurrentLevel->m_pCoarserMultiLevel = 0;
+			delete newLevel;
+			break;
+		}
 		m_pCurrentLevel = newLevel;
 		m_iNumLevels++;
 		m_iCurrentLevelNr++;
 	}
 	m_pCoarsestLevel = m_pCurrentLevel;
-	m_pCurrentGraph = m_pCurrentLevel->m_pGraph;
 }
 
 
 void FastMultipoleMultilevelEmbedder::writeCurrentToGraphAttributes(GraphAttributes& GA)
 {
-	node v;
-	forall_nodes(v, (*m_pCurrentGraph))
-	{
-		GA.x(v) = (*m_pCurrentNodeXPos)[v];
-		GA.y(v) = (*m_pCurrentNodeYPos)[v];
-	}
+	m_pCurrentGraph->writeTo(GA);
 }
 
 void FastMultipoleMultilevelEmbedder::nextLevel()
 {
 	m_pCurrentLevel = m_pCurrentLevel->m_pFinerMultiLevel;
-	std::swap(m_pLastNodeXPos, m_pCurrentNodeXPos);
-	std::swap(m_pLastNodeYPos, m_pCurrentNodeYPos);
+	delete m_pLastGraph;
+	m_pLastGraph = m_pCurrentGraph;
+	m_pCurrentGraph = 0;
 	m_iCurrentLevelNr--;
 }
 
 void FastMultipoleMultilevelEmbedder::initFinestLevel(GraphAttributes &GA, const EdgeArray<float>& edgeLength)
 {
+	GalaxyMultilevel& L = *m_pFinestLevel;
 	node v = 0;
-	node w = 0;
-	edge e = 0;
-	//NodeArray<float> perimeter(GA.constGraph(), 0.0);
+	int i = 0;
 	forall_nodes(v, GA.constGraph())
 	{
-		GalaxyMultilevel::LevelNodeInfo& nodeInfo = (*(m_pFinestLevel->m_pNodeInfo))[v];
-		nodeInfo.mass = 1.0;
-		float r = (float)sqrt(GA.width(v)*GA.width(v) + GA.height(v)*GA.height(v)) * 0.5f;
-		nodeInfo.radius = r;
+		L.m_mass[i] = 1.0;
+		L.m_radius[i] = (float)sqrt(GA.width(v)*GA.width(v) + GA.height(v)*GA.height(v)) * 0.5f;
+		i++;
 	}
 
+	edge e = 0;
+	i = 0;
 	forall_edges(e, GA.constGraph())
 	{
-		GalaxyMultilevel::LevelEdgeInfo& edgeInfo = (*(m_pFinestLevel->m_pEdgeInfo))[e];
-		v = e->source();
-		w = e->target();
-		GalaxyMultilevel::LevelNodeInfo& vNodeInfo = (*(m_pFinestLevel->m_pNodeInfo))[v];
-		GalaxyMultilevel::LevelNodeInfo& wNodeInfo = (*(m_pFinestLevel->m_pNodeInfo))[w];
-		edgeInfo.length = (vNodeInfo.radius +  wNodeInfo.radius) + edgeLength[e];
+		L.m_edgeLength[i] = (L.m_radius[L.m_edgeSource[i]] + L.m_radius[L.m_edgeTarget[i]]) + edgeLength[e];
+		i++;
 	}
 }
 
 void FastMultipoleMultilevelEmbedder::initCurrentLevel()
 {
-	m_pCurrentGraph = m_pCurrentLevel->m_pGraph;
-	m_pCurrentNodeXPos->init(*m_pCurrentGraph, 0.0f);
-	m_pCurrentNodeYPos->init(*m_pCurrentGraph, 0.0f);
-	m_pCurrentEdgeLength->init(*m_pCurrentGraph, 1.0f);
-	m_pCurrentNodeSize->init(*m_pCurrentGraph, 1.0f);
-	const Graph& G = *(m_pCurrentLevel->m_pGraph);
-	node v = 0;
-
-	forall_nodes(v, G)
-	{
-		GalaxyMultilevel::LevelNodeInfo& nodeInfo = (*(m_pCurrentLevel->m_pNodeInfo))[v];
-		(*m_pCurrentNodeSize)[v] = ((float)nodeInfo.radius);//(((float)nodeInfo.radius));
-	}
-
-	edge e = 0;
-	forall_edges(e, G)
-	{
-		GalaxyMultilevel::LevelEdgeInfo& edgeInfo = (*(m_pCurrentLevel->m_pEdgeInfo))[e];
-		(*m_pCurrentEdgeLength)[e] = edgeInfo.length*0.25f;
-	}
+	const GalaxyMultilevel& L = *m_pCurrentLevel;
+	const int n = L.numberOfNodes();
+	const int m = L.numberOfEdges();
+	m_pCurrentGraph = new ArrayGraph(n, m);
+	m_pCurrentGraph->readFrom(n, L.m_radius.begin(), m, L.m_edgeSource.begin(), L.m_edgeTarget.begin(), L.m_edgeLength.begin(), 0.25f);
 }
 
 void FastMultipoleMultilevelEmbedder::assignPositionsFromPrevLevel()
 {
 	float scaleFactor = 1.4f;// 1.4f;//1.4f; //1.4f
 	// init m_pCurrent Pos from m_pLast Pos
-	const Graph& G = *(m_pCurrentLevel->m_pGraph);
-	node v = 0;
-	forall_nodes(v, G)
+	const GalaxyMultilevel& L = *m_pCurrentLevel;
+	for (int i = 0; i < L.numberOfNodes(); i++)
 	{
-		GalaxyMultilevel::LevelNodeInfo& nodeInfo = (*(m_pCurrentLevel->m_pNodeInfo))[v];
-		float x = (float)((*m_pLastNodeXPos)[nodeInfo.parent] + (float)randomDouble(-1.0, 1.0));
-		float y = (float)((*m_pLastNodeYPos)[nodeInfo.parent] + (float)randomDouble(-1.0, 1.0));
-		(*m_pCurrentNodeXPos)[v] = x*scaleFactor;
-		(*m_pCurrentNodeYPos)[v] = y*scaleFactor;
+		int parent = L.m_parent[i];
+		float x = (float)(m_pLastGraph->nodeXPos()[parent] + (float)randomDouble(-1.0, 1.0));
+		float y = (float)(m_pLastGraph->nodeYPos()[parent] + (float)randomDouble(-1.0, 1.0));
+		m_pCurrentGraph->nodeXPos()[i] = x*scaleFactor;
+		m_pCurrentGraph->nodeYPos()[i] = y*scaleFactor;
 	}
 }
 
@@ -433,7 +466,7 @@ void FastMultipoleMultilevelEmbedder::layoutCurrentLevel()
 	fme.setNumberOfThreads(this->m_iMaxNumThreads);
 	fme.setRandomize(m_iCurrentLevelNr == (m_iNumLevels-1));
 	fme.setNumIterations(numberOfIterationsByLevelNr(m_iCurrentLevelNr));
-	fme.call((*m_pCurrentGraph), (*m_pCurrentNodeXPos), (*m_pCurrentNodeYPos), (*m_pCurrentEdgeLength), (*m_pCurrentNodeSize));
+	fme.call(*m_pCurrentGraph);
 }
 
 void FastMultipoleMultilevelEmbedder::deleteMultiLevelGraphs()
@@ -444,10 +477,6 @@ void FastMultipoleMultilevelEmbedder::deleteMultiLevelGraphs()
 	{
 		toDelete = l;
 		l = l->m_pFinerMultiLevel;
-		delete (toDelete->m_pNodeInfo);
-		delete (toDelete->m_pEdgeInfo);
-		if (toDelete != m_pFinestLevel)
-			delete (toDelete->m_pGraph);
 		delete toDelete;
 	}
 }
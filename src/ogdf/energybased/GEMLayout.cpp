@@ -65,7 +65,9 @@ GEMLayout::GEMLayout() :
 	m_oscillationSensitivity(0.3),
 	m_attractionFormula(1),
 	m_minDistCC(LayoutStandards::defaultCCSeparation()),
-	m_pageRatio(1.0)
+	m_pageRatio(1.0),
+	m_repulsionMethod(RepulsiveForces::rfExact),
+	m_repulsion(0)
 { }
 
 GEMLayout::GEMLayout(const GEMLayout &fl) :
@@ -81,7 +83,9 @@ GEMLayout::GEMLayout(const GEMLayout &fl) :
 	m_oscillationSensitivity(fl.m_oscillationSensitivity),
 	m_attractionFormula(fl.m_attractionFormula),
 	m_minDistCC(fl.m_minDistCC),
-	m_pageRatio(fl.m_pageRatio)
+	m_pageRatio(fl.m_pageRatio),
+	m_repulsionMethod(fl.m_repulsionMethod),
+	m_repulsion(0)
 { }
 
 
@@ -101,6 +105,7 @@ GEMLayout &GEMLayout::operator=(const GEMLayout &fl)
 	m_rotationSensitivity = fl.m_rotationSensitivity;
 	m_oscillationSensitivity = fl.m_oscillationSensitivity;
 	m_attractionFormula = fl.m_attractionFormula;
+	m_repulsionMethod = fl.m_repulsionMethod;
 	return *this;
 }
 
@@ -164,6 +169,21 @@ void GEMLayout::call(GraphAttributes &AG)
 		m_cos = cos(m_oscillationAngle / 2.0);
 		m_sin = sin(Math::pi / 2 + m_rotationAngle / 2.0);
 
+		// approximated repulsive forces
+		RepulsiveForces repulsion(m_repulsionMethod);
+		if(m_repulsionMethod != RepulsiveForces::rfExact) {
+			m_repulsion = &repulsion;
+			m_repulsionIndex.init(GC);
+
+			double maxDesiredLength = 0;
+			int k = 0;
+			forall_nodes(v,GC) {
+				m_repulsionIndex[v] = k++;
+				maxDesiredLength = max(maxDesiredLength, m_desiredLength + length(AGC.getHeight(v),AGC.getWidth(v)));
+			}
+			repulsion.cutoff(2 * maxDesiredLength);
+		}
+
 		// main loop
 		int counter = m_numberOfRounds;
 		while(DIsGreater(m_globalTemperature,m_minimalTemperature) && counter--) {
@@ -173,6 +193,16 @@ void GEMLayout::call(GraphAttributes &AG)
 				forall_nodes(v,GC)
 					permutation.pushBack(v);
 				permutation.permute();
+
+				// rebuild the data structures for the current layout
+				if(m_repulsion != 0) {
+					Array<double> x(GC.numberOfNodes()), y(GC.numberOfNodes());
+					forall_nodes(v,GC) {
+						x[m_repulsionIndex[v]] = AGC.x(v);
+						y[m_repulsionIndex[v]] = AGC.y(v);
+					}
+					m_repulsion->init(x,y);
+				}
 			}
 			v = permutation.popFrontRet();
 
@@ -182,7 +212,10 @@ void GEMLayout::call(GraphAttributes &AG)
 			// update node v
 			updateNode(GC,AGC,v);
 
+			if(m_repulsion != 0)
+				m_repulsion->move(m_repulsionIndex[v], AGC.x(v), AGC.y(v));
 		}
+		m_repulsion = 0;
 
 		node vFirst = GC.firstNode();
 		double minX = AGC.x(vFirst), maxX = AGC.x(vFirst),
@@ -243,6 +276,7 @@ void GEMLayout::call(GraphAttributes &AG)
 	m_impulseY.init();
 	m_skewGauge.init();
 	m_localTemperature.init();
+	m_repulsionIndex.init();
 }
 
 void GEMLayout::computeImpulse(GraphCopy &G, GraphCopyAttributes &AG,node v) {
@@ -270,7 +304,13 @@ void GEMLayout::computeImpulse(GraphCopy &G, GraphCopyAttributes &AG,node v) {
 		(double)(randomNumber(-maxIntDisturbance,maxIntDisturbance) / 10000);
 
 	// compute repulsive forces
-	forall_nodes(u,G)
+	if(m_repulsion != 0) {
+		double fx, fy;
+		m_repulsion->force(m_repulsionIndex[v], fx, fy);
+		m_newImpulseX += fx * desiredSqu;
+		m_newImpulseY += fy * desiredSqu;
+
+	} else forall_nodes(u,G)
 		if(u != v ) {
 			deltaX = AG.x(v) - AG.x(u);
 			deltaY = AG.y(v) - AG.y(u);
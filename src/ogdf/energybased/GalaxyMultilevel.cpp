@@ -41,131 +41,306 @@
  ***************************************************************/
 
 #include "GalaxyMultilevel.h"
-#include "FastUtils.h"
-#include <ogdf/basic/Array.h>
+#include <ogdf/basic/ParallelRange.h>
+#include <algorithm>
 
 namespace ogdf {
 
 
-void GalaxyMultilevelBuilder::computeSystemMass()
+//! A node together with its position in the order for selecting suns (used for sorting).
+struct GalaxySunOrder
 {
-	node v = 0;
-	forall_nodes(v, *m_pGraph)
+	double sysMass;
+	__uint32 key;
+	int v;
+
+	bool operator<(const GalaxySunOrder &other) const {
+		if (sysMass != other.sysMass) return sysMass < other.sysMass;
+		if (key != other.key) return key < other.key;
+		return v < other.v;
+	}
+};
+
+
+static const int minNodesPerThread = 10000;
+
+// selecting suns in rounds is stopped after this many rounds
+static const int maxSunRounds = 32;
+
+
+// returns a pseudo-random key for x (used for breaking ties between equal system masses)
+static inline __uint32 randomKey(__uint32 x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352dU;
+	x ^= x >> 15;
+	x *= 0x846ca68bU;
+	x ^= x >> 16;
+	return x;
+}
+
+
+GalaxyMultilevelBuilder::GalaxyMultilevelBuilder(int numThreads)
+{
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_numThreads = 1;
+#else
+	m_numThreads = max(1, numThreads);
+#endif
+	m_pLevel = 0;
+	m_seed = 0;
+}
+
+
+int GalaxyMultilevelBuilder::runPhase(Phase phase)
+{
+	return parallelRange(m_pLevel->numberOfNodes(), m_numThreads, minNodesPerThread, *this, phase);
+}
+
+
+int GalaxyMultilevelBuilder::computeSystemMass(int begin, int end)
+{
+	const GalaxyMultilevel &L = *m_pLevel;
+	for (int v = begin; v < end; v++)
 	{
-		m_nodeState[v].sysMass = (*m_pNodeInfo)[v].mass;
-		m_nodeState[v].label = 0;
-		m_nodeState[v].lastVisitor = v;
+		double sysMass = L.m_mass[v];
+		for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1]; i++)
+			sysMass += L.m_mass[L.m_adjTwin[i]];
+
+		if (L.degree(v) == 1)
+			sysMass *= L.numberOfNodes();
+
+		m_sysMass[v] = sysMass;
+		m_key[v] = randomKey((__uint32)v ^ m_seed);
+		m_state[v] = undecided;
 	}
+	return 0;
+}
 
-	forall_nodes(v, *m_pGraph)
+
+int GalaxyMultilevelBuilder::computeFirstUndecided(int begin, int end)
+{
+	const GalaxyMultilevel &L = *m_pLevel;
+	for (int v = begin; v < end; v++)
 	{
-		adjEntry adj;
-		forall_adj(adj, v)
-		{
-			m_nodeState[v].sysMass += (*m_pNodeInfo)[adj->twinNode()].mass;
+		int f = (m_state[v] == undecided) ? v : -1;
+		for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1]; i++) {
+			int u = L.m_adjTwin[i];
+			if (m_state[u] == undecided)
+				f = first(f, u);
 		}
-
-		if (v->degree()==1)
-			m_nodeState[v].sysMass *= m_pGraph->numberOfNodes() ;
+		m_first[v] = f;
 	}
+	return 0;
 }
 
 
-void swap(ogdf::GalaxyMultilevelBuilder::NodeOrderInfo& a, ogdf::GalaxyMultilevelBuilder::NodeOrderInfo& b)
+int GalaxyMultilevelBuilder::selectSuns(int begin, int end)
 {
-	ogdf::GalaxyMultilevelBuilder::NodeOrderInfo t = a;
-	a = b;
-	b = t;
+	// v becomes a sun if it is the first undecided node within distance two
+	const GalaxyMultilevel &L = *m_pLevel;
+	int numSuns = 0;
+	for (int v = begin; v < end; v++)
+	{
+		if (m_state[v] != undecided)
+			continue;
+		int f = m_first[v];
+		for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1]; i++)
+			f = first(f, m_first[L.m_adjTwin[i]]);
+		if (f == v) {
+			m_state[v] = sun;
+			numSuns++;
+		}
+	}
+	return numSuns;
 }
 
 
-void GalaxyMultilevelBuilder::sortNodesBySystemMass()
+int GalaxyMultilevelBuilder::computeNearSun(int begin, int end)
 {
-	int i = 0;
-	node v = 0;
-	m_pRandomSet = new RandomNodeSet(*m_pGraph);
-	for (i=0;i<m_pGraph->numberOfNodes();i++)
+	const GalaxyMultilevel &L = *m_pLevel;
+	for (int v = begin; v < end; v++)
 	{
-		v = m_pRandomSet->chooseNode();
-		m_pRandomSet->removeNode(v);
-		m_nodeMassOrder[i].theNode = v;
+		bool nearSun = (m_state[v] == sun);
+		for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1] && !nearSun; i++)
+			nearSun = (m_state[L.m_adjTwin[i]] == sun);
+		m_nearSun[v] = nearSun;
 	}
+	return 0;
+}
 
-	delete m_pRandomSet;
-	std::sort(m_nodeMassOrder, m_nodeMassOrder+(m_pGraph->numberOfNodes()), NodeMassComparer( m_nodeState ));
+
+int GalaxyMultilevelBuilder::coverNodes(int begin, int end)
+{
+	// undecided nodes within distance two of a sun become planets
+	const GalaxyMultilevel &L = *m_pLevel;
+	int numUndecided = 0;
+	for (int v = begin; v < end; v++)
+	{
+		if (m_state[v] != undecided)
+			continue;
+		bool covered = m_nearSun[v];
+		for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1] && !covered; i++)
+			covered = m_nearSun[L.m_adjTwin[i]];
+		if (covered)
+			m_state[v] = planet;
+		else
+			numUndecided++;
+	}
+	return numUndecided;
 }
 
 
-void GalaxyMultilevelBuilder::labelSystem(node u, node v, int d, float df)
+void GalaxyMultilevelBuilder::selectSunsSequential()
 {
-	if (d>0)
+	const GalaxyMultilevel &L = *m_pLevel;
+	const int n = L.numberOfNodes();
+
+	int numUndecided = 0;
+	for (int v = 0; v < n; v++)
+		if (m_state[v] == undecided)
+			numUndecided++;
+	if (numUndecided == 0)
+		return;
+
+	Array<GalaxySunOrder> order(numUndecided);
+	int k = 0;
+	for (int v = 0; v < n; v++) {
+		if (m_state[v] == undecided) {
+			order[k].sysMass = m_sysMass[v];
+			order[k].key = m_key[v];
+			order[k].v = v;
+			k++;
+		}
+	}
+	std::sort(order.begin(), order.begin() + numUndecided);
+
+	for (k = 0; k < numUndecided; k++)
 	{
-		adjEntry adj;
-		forall_adj(adj, v)
-		{
-			node w = adj->twinNode();
-			// this node may have been labeled before but its closer to the current sun
-			if (m_nodeState[w].label < d)
-			{
-				float currDistFromSun = (*m_pEdgeInfo)[adj->theEdge()].length + df /*+ (*m_pNodeInfo)[w].radius*/;
-				// check if we relabeling by a new sun
-				if (m_nodeState[w].lastVisitor != u)
-				{
-					// maybe this node has never been labeled
-					m_nodeState[w].lastVisitor = u;
-					m_nodeState[w].edgeLengthFromSun = currDistFromSun;
-				}
-				// finally relabel it
-				m_nodeState[w].edgeLengthFromSun = min(m_nodeState[w].edgeLengthFromSun, currDistFromSun);
-				m_nodeState[w].label = d;
-				labelSystem(u, w, d-1, currDistFromSun /*+(*m_pNodeInfo)[w].radius*/);
+		int v = order[k].v;
+		if (m_state[v] != undecided)
+			continue;
+
+		m_state[v] = sun;
+		for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1]; i++) {
+			int u = L.m_adjTwin[i];
+			if (m_state[u] == undecided)
+				m_state[u] = planet;
+			for (int j = L.m_adjBegin[u]; j < L.m_adjBegin[u+1]; j++) {
+				int w = L.m_adjTwin[j];
+				if (m_state[w] == undecided)
+					m_state[w] = planet;
 			}
 		}
 	}
 }
 
 
-void GalaxyMultilevelBuilder::labelSystem()
+int GalaxyMultilevelBuilder::computeAdjacentSun(int begin, int end)
 {
-	m_sunNodeList.clear();
-	node v = 0;
-	forall_nodes(v, *m_pGraph)
+	const GalaxyMultilevel &L = *m_pLevel;
+	for (int v = begin; v < end; v++)
 	{
-		m_nodeState[v].sysMass = 0;
-		m_nodeState[v].label = 0;
-		m_nodeState[v].lastVisitor = v;
+		int s = -1;
+		float length = 0.0f;
+		if (m_state[v] == sun) {
+			s = v;
+		} else {
+			for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1]; i++) {
+				int u = L.m_adjTwin[i];
+				if (m_state[u] != sun)
+					continue;
+				float l = L.m_edgeLength[L.m_adjEdge[i]];
+				if (s < 0 || before(u, s)) {
+					s = u;
+					length = l;
+				} else if (u == s)
+					length = min(length, l);
+			}
+		}
+		m_sun1[v] = s;
+		m_length1[v] = length;
 	}
+	return 0;
+}
 
-	for (int i=0; i < m_pGraph->numberOfNodes(); i++)
+
+int GalaxyMultilevelBuilder::labelNodes(int begin, int end)
+{
+	// nodes without an adjacent sun join the first sun at distance two
+	const GalaxyMultilevel &L = *m_pLevel;
+	for (int v = begin; v < end; v++)
 	{
-		v = m_nodeMassOrder[i].theNode;
-		if (m_nodeState[v].label == 0)
-		{
-			m_sunNodeList.pushBack(v);
-			m_nodeState[v].label = (m_dist+1);
-			m_nodeState[v].edgeLengthFromSun = 0.0;//(*m_pNodeInfo)[v].radius;
-			labelSystem(v, v, m_dist, m_nodeState[v].edgeLengthFromSun);
+		int s = m_sun1[v];
+		float length = m_length1[v];
+		if (s < 0) {
+			for (int i = L.m_adjBegin[v]; i < L.m_adjBegin[v+1]; i++) {
+				int u = L.m_adjTwin[i];
+				int t = m_sun1[u];
+				if (t < 0)
+					continue;
+				float l = L.m_edgeLength[L.m_adjEdge[i]] + m_length1[u];
+				if (s < 0 || before(t, s)) {
+					s = t;
+					length = l;
+				} else if (t == s)
+					length = min(length, l);
+			}
 		}
+		OGDF_ASSERT(s >= 0);
+		m_sun[v] = s;
+		m_edgeLengthFromSun[v] = length;
 	}
+	return 0;
 }
 
 
 GalaxyMultilevel* GalaxyMultilevelBuilder::build(GalaxyMultilevel* pMultiLevel)
 {
-	m_dist = 2;
-	m_pGraph = pMultiLevel->m_pGraph;
-	m_pNodeInfo = pMultiLevel->m_pNodeInfo;
-	m_pEdgeInfo = pMultiLevel->m_pEdgeInfo;
-	m_nodeMassOrder = (NodeOrderInfo*)MALLOC_16(sizeof(NodeOrderInfo)*m_pGraph->numberOfNodes());
-	m_nodeState.init(*m_pGraph);
-
-	this->computeSystemMass();
-	this->sortNodesBySystemMass();
-	this->labelSystem();
+	m_pLevel = pMultiLevel;
+	const int n = m_pLevel->numberOfNodes();
+	m_seed = (__uint32)randomNumber(0, 1 << 30);
+
+	m_sysMass.init(n);
+	m_key.init(n);
+	m_state.init(n);
+	runPhase(&GalaxyMultilevelBuilder::computeSystemMass);
+
+	// select suns in parallel rounds as long as there is enough work left
+	if (min(m_numThreads, n / minNodesPerThread) > 1)
+	{
+		m_first.init(n);
+		m_nearSun.init(n);
+		int numUndecided = n;
+		for (int round = 0; round < maxSunRounds && numUndecided >= minNodesPerThread; round++)
+		{
+			runPhase(&GalaxyMultilevelBuilder::computeFirstUndecided);
+			runPhase(&GalaxyMultilevelBuilder::selectSuns);
+			runPhase(&GalaxyMultilevelBuilder::computeNearSun);
+			numUndecided = runPhase(&GalaxyMultilevelBuilder::coverNodes);
+		}
+		m_first.init();
+		m_nearSun.init();
+	}
+	selectSunsSequential();
+
+	m_sun1.init(n);
+	m_length1.init(n);
+	m_sun.init(n);
+	m_edgeLengthFromSun.init(n);
+	runPhase(&GalaxyMultilevelBuilder::computeAdjacentSun);
+	runPhase(&GalaxyMultilevelBuilder::labelNodes);
+	m_sun1.init();
+	m_length1.init();
+
 	GalaxyMultilevel* pMultiLevelResult = new GalaxyMultilevel(pMultiLevel);
-	this->createResult(pMultiLevelResult);;
+	createResult(pMultiLevelResult);
 
-	FREE_16(m_nodeMassOrder);
+	m_sysMass.init();
+	m_key.init();
+	m_state.init();
+	m_sun.init();
+	m_edgeLengthFromSun.init();
 
 	return pMultiLevelResult;
 }
@@ -173,76 +348,84 @@ GalaxyMultilevel* GalaxyMultilevelBuilder::build(GalaxyMultilevel* pMultiLevel)
 
 void GalaxyMultilevelBuilder::createResult(GalaxyMultilevel* pMultiLevelResult)
 {
-	pMultiLevelResult->m_pGraph = new Graph();
-	m_pGraphResult = pMultiLevelResult->m_pGraph;
+	GalaxyMultilevel &L = *m_pLevel;
+	GalaxyMultilevel &R = *pMultiLevelResult;
+	const int n = L.numberOfNodes();
+	const int m = L.numberOfEdges();
+
+	// the suns become the nodes of the result
+	Array<int> toResultNode(n);
+	int numSuns = 0;
+	for (int v = 0; v < n; v++)
+		toResultNode[v] = (m_state[v] == sun) ? numSuns++ : -1;
+
+	// edges between different systems; the first of several parallel edges is kept
+	Array<int> candidate(m);
+	int numCandidates = 0;
+	for (int e = 0; e < m; e++)
+		if (m_sun[L.m_edgeSource[e]] != m_sun[L.m_edgeTarget[e]])
+			candidate[numCandidates++] = e;
+
+	Array<int> bucketBegin(0, numSuns, 0);
+	Array<int> sorted(max(1, numCandidates));
+	for (int k = 0; k < numCandidates; k++) {
+		int e = candidate[k];
+		int a = toResultNode[m_sun[L.m_edgeSource[e]]], b = toResultNode[m_sun[L.m_edgeTarget[e]]];
+		bucketBegin[min(a,b)+1]++;
+	}
+	for (int a = 0; a < numSuns; a++)
+		bucketBegin[a+1] += bucketBegin[a];
+	Array<int> pos(max(1, numSuns));
+	for (int a = 0; a < numSuns; a++)
+		pos[a] = bucketBegin[a];
+	for (int k = 0; k < numCandidates; k++) {
+		int e = candidate[k];
+		int a = toResultNode[m_sun[L.m_edgeSource[e]]], b = toResultNode[m_sun[L.m_edgeTarget[e]]];
+		sorted[pos[min(a,b)]++] = k;
+	}
 
-	NodeArray<node> toResultNode(*m_pGraph, 0);
-	// create all sun nodes
-	for(List<node>::iterator it = m_sunNodeList.begin(); it.valid(); it++)
-	{
-		node v = *it;
-		node vResult = m_pGraphResult->newNode();
-		toResultNode[v] = vResult;
+	Array<bool> keep(0, max(1, numCandidates) - 1, false);
+	Array<int> lastVisit(0, max(1, numSuns) - 1, -1);
+	int numResultEdges = 0;
+	for (int a = 0; a < numSuns; a++) {
+		for (int i = bucketBegin[a]; i < bucketBegin[a+1]; i++) {
+			int e = candidate[sorted[i]];
+			int b = toResultNode[m_sun[L.m_edgeSource[e]]] + toResultNode[m_sun[L.m_edgeTarget[e]]] - a;
+			if (lastVisit[b] != a) {
+				lastVisit[b] = a;
+				keep[sorted[i]] = true;
+				numResultEdges++;
+			}
+		}
 	}
 
-	pMultiLevelResult->m_pNodeInfo = new NodeArray<GalaxyMultilevel::LevelNodeInfo>(*m_pGraphResult);
-	m_pNodeInfoResult = pMultiLevelResult->m_pNodeInfo;
+	R.init(numSuns, numResultEdges);
 
 	// calculate the real system mass. this may not be the same as calculated before
-	node u;
-	forall_nodes(u, *m_pGraphResult)
-	{
-		(*m_pNodeInfoResult)[u].radius = 0.0f;
-		(*m_pNodeInfoResult)[u].mass = 0.0f;
-	}
-	forall_nodes(u, *m_pGraph)
+	for (int a = 0; a < numSuns; a++)
+		R.m_mass[a] = 0.0f;
+	for (int v = 0; v < n; v++)
 	{
-		node uSun = m_nodeState[u].lastVisitor;
-		node uSunResult = toResultNode[uSun];
-		(*m_pNodeInfo)[u].parent = uSunResult;
-		(*m_pNodeInfoResult)[uSunResult].mass +=((*m_pNodeInfo)[u].mass);
-		(*m_pNodeInfoResult)[uSunResult].radius = max( (*m_pNodeInfoResult)[uSunResult].radius, m_nodeState[u].edgeLengthFromSun);//m_nodeState[u].edgeLengthFromSun;//m_nodeState[u].edgeLengthFromSun;// max( (*m_pNodeInfoResult)[uSunResult].radius, m_nodeState[u].edgeLengthFromSun);
+		int a = toResultNode[m_sun[v]];
+		L.m_parent[v] = a;
+		R.m_mass[a] += L.m_mass[v];
+		R.m_radius[a] = max(R.m_radius[a], m_edgeLengthFromSun[v]);
 	}
 
-	pMultiLevelResult->m_pEdgeInfo = new EdgeArray<GalaxyMultilevel::LevelEdgeInfo>(*m_pGraphResult);
-	m_pEdgeInfoResult = pMultiLevelResult->m_pEdgeInfo;
-
-	edge e;
-	forall_edges(e, *m_pGraph)
+	int j = 0;
+	for (int k = 0; k < numCandidates; k++)
 	{
-		node v = e->source();
-		node w = e->target();
-		node vSun = m_nodeState[v].lastVisitor;
-		node wSun = m_nodeState[w].lastVisitor;
-		if (vSun != wSun)
-		{
-			node vSunResult = toResultNode[vSun];
-			node wSunResult = toResultNode[wSun];
-			edge eResult = m_pGraphResult->newEdge(vSunResult, wSunResult);
-			(*m_pEdgeInfoResult)[eResult].length = m_nodeState[v].edgeLengthFromSun + (*m_pEdgeInfo)[e].length + m_nodeState[w].edgeLengthFromSun;
-		}
+		if (!keep[k])
+			continue;
+		int e = candidate[k];
+		int v = L.m_edgeSource[e], w = L.m_edgeTarget[e];
+		R.m_edgeSource[j] = toResultNode[m_sun[v]];
+		R.m_edgeTarget[j] = toResultNode[m_sun[w]];
+		R.m_edgeLength[j] = m_edgeLengthFromSun[v] + L.m_edgeLength[e] + m_edgeLengthFromSun[w];
+		j++;
 	}
 
-	// make fast parallel free
-	NodeArray<node> lastVisit(*m_pGraphResult, 0);
-	node v;
-	forall_nodes(v, *m_pGraphResult)
-	{
-		if (v->degree()>1)
-		{
-			adjEntry adj = v->firstAdj();
-			do{
-				node w = adj->twinNode();
-				edge e = adj->theEdge();
-				adj = adj->cyclicSucc();
-				if (lastVisit[w] ==v)
-					m_pGraphResult->delEdge(e);
-				else
-					lastVisit[w] = v;
-			} while (adj !=v->firstAdj());
-		}
-	}
+	R.initAdjacency();
 }
 
 } // end of namespace
-
@@ -47,121 +47,206 @@
 #ifndef OGDF_GALAXY_MULTILEVEL_H
 #define OGDF_GALAXY_MULTILEVEL_H
 
-#include <ogdf/basic/GraphAttributes.h>
-#include <ogdf/basic/tuples.h>
-#include <ogdf/basic/simple_graph_alg.h>
-#include "ArrayGraph.h"
+#include <ogdf/basic/Graph.h>
 #include "FastUtils.h"
 
 
 namespace ogdf {
 
+//! One level of the multilevel hierarchy of FastMultipoleMultilevelEmbedder.
+/**
+ * The nodes of a level are 0,...,\a n - 1 and its edges 0,...,\a m - 1; both
+ * are stored in flat arrays. The adjacency of node \a v consists of the entries
+ * m_adjBegin[\a v],...,m_adjBegin[\a v + 1] - 1 of m_adjTwin (the adjacent
+ * node) and m_adjEdge (the edge). The nodes and edges of the finest level are
+ * numbered in the order of the original graph.
+ */
 class GalaxyMultilevel
 {
 public:
-	typedef List<Tuple2< node, int > > NearSunList;
-
-	struct LevelNodeInfo
-	{
-		float mass;
-		float radius;
-		node parent;
-		NearSunList nearSuns;
-	};
-
-	struct LevelEdgeInfo
-	{
-		float length;
-	};
-
-	GalaxyMultilevel(Graph* pGraph)
+	//! Creates the finest level for \a G with unit node masses.
+	GalaxyMultilevel(const Graph &G)
 	{
 		m_pFinerMultiLevel = 0;
 		m_pCoarserMultiLevel = 0;
-		m_pGraph = pGraph;
-		m_pNodeInfo = new NodeArray<LevelNodeInfo>(*m_pGraph);
-		m_pEdgeInfo = new EdgeArray<LevelEdgeInfo>(*m_pGraph);
+		levelNumber = 0;
+
+		NodeArray<int> index(G);
+		int n = 0;
 		node v;
-		forall_nodes(v, *m_pGraph)
+		forall_nodes(v, G)
+			index[v] = n++;
+
+		init(n, G.numberOfEdges());
+		int i = 0;
+		edge e;
+		forall_edges(e, G)
 		{
-			(*m_pNodeInfo)[v].mass = 1.0;
+			m_edgeSource[i] = index[e->source()];
+			m_edgeTarget[i] = index[e->target()];
+			m_edgeLength[i] = 1.0f;
+			i++;
 		}
-		levelNumber = 0;
+		for (i = 0; i < n; i++)
+			m_mass[i] = 1.0f;
+		initAdjacency();
 	}
 
+	//! Creates an empty level that is coarser than \a prev.
 	GalaxyMultilevel(GalaxyMultilevel* prev)
 	{
 		m_pCoarserMultiLevel = 0;
 		m_pFinerMultiLevel = prev;
 		m_pFinerMultiLevel->m_pCoarserMultiLevel = this;
-		m_pGraph = 0;
-		m_pNodeInfo = 0;
 		levelNumber = prev->levelNumber + 1;
 	}
 
 	~GalaxyMultilevel() { }
 
+	//! Allocates the node and edge arrays for \a numNodes nodes and \a numEdges edges.
+	void init(int numNodes, int numEdges)
+	{
+		m_mass.init(numNodes);
+		m_radius.init(0, numNodes-1, 0.0f);
+		m_parent.init(numNodes);
+		m_edgeSource.init(numEdges);
+		m_edgeTarget.init(numEdges);
+		m_edgeLength.init(numEdges);
+	}
+
+	//! Builds the adjacency arrays from the edge arrays.
+	void initAdjacency()
+	{
+		const int n = numberOfNodes();
+		const int m = numberOfEdges();
+		m_adjBegin.init(0, n, 0);
+		m_adjTwin.init(2*m);
+		m_adjEdge.init(2*m);
+
+		for (int e = 0; e < m; e++) {
+			m_adjBegin[m_edgeSource[e]+1]++;
+			m_adjBegin[m_edgeTarget[e]+1]++;
+		}
+		for (int v = 0; v < n; v++)
+			m_adjBegin[v+1] += m_adjBegin[v];
+
+		Array<int> pos(n);
+		for (int v = 0; v < n; v++)
+			pos[v] = m_adjBegin[v];
+		for (int e = 0; e < m; e++) {
+			int s = m_edgeSource[e], t = m_edgeTarget[e];
+			m_adjTwin[pos[s]] = t; m_adjEdge[pos[s]++] = e;
+			m_adjTwin[pos[t]] = s; m_adjEdge[pos[t]++] = e;
+		}
+	}
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return m_mass.size(); }
+
+	//! Returns the number of edges.
+	int numberOfEdges() const { return m_edgeLength.size(); }
+
+	//! Returns the degree of node \a v.
+	int degree(int v) const { return m_adjBegin[v+1] - m_adjBegin[v]; }
+
 	GalaxyMultilevel* m_pFinerMultiLevel;
 	GalaxyMultilevel* m_pCoarserMultiLevel;
-	Graph* m_pGraph;
-	NodeArray<LevelNodeInfo>* m_pNodeInfo;
-	EdgeArray<LevelEdgeInfo>* m_pEdgeInfo;
 	int levelNumber;
+
+	Array<float> m_mass;       //!< The mass of each node.
+	Array<float> m_radius;     //!< The radius of each node.
+	Array<int>   m_parent;     //!< The node in the coarser level each node is merged into.
+
+	Array<int>   m_edgeSource; //!< The source of each edge.
+	Array<int>   m_edgeTarget; //!< The target of each edge.
+	Array<float> m_edgeLength; //!< The length of each edge.
+
+	Array<int>   m_adjBegin;   //!< The first adjacency entry of each node (and the end of the last one).
+	Array<int>   m_adjTwin;    //!< The adjacent node of each adjacency entry.
+	Array<int>   m_adjEdge;    //!< The edge of each adjacency entry.
+
+private:
+	// avoid automatic creation of copy constructor and assignment operator
+	GalaxyMultilevel(const GalaxyMultilevel &);
+	GalaxyMultilevel &operator=(const GalaxyMultilevel &);
 };
 
 
+//! Builds the next coarser level of a GalaxyMultilevel.
+/**
+ * The nodes are ordered by their system mass (the mass of a node and its
+ * neighbors; nodes of degree one come last), ties are broken randomly. Going
+ * through this order, a node becomes a sun if no sun has been chosen within
+ * distance two. Every other node joins the first sun among the closest ones.
+ * The suns become the nodes of the coarser level, the edges between different
+ * systems its edges (without parallel edges).
+ *
+ * With more than one thread, the suns are selected in rounds: an undecided
+ * node becomes a sun if it comes first among the undecided nodes within
+ * distance two. This selects exactly the same suns as going through the order
+ * sequentially, so the result does not depend on the number of threads.
+ */
 class GalaxyMultilevelBuilder
 {
 public:
-	struct LevelNodeState
-	{
-		node lastVisitor;
-		double sysMass;
-		int label;
-		float edgeLengthFromSun;
-	};
-
-	struct NodeOrderInfo
-	{
-		node theNode;
-	};
+	//! Creates a builder that uses up to \a numThreads threads.
+	explicit GalaxyMultilevelBuilder(int numThreads = 1);
 
+	//! Builds and returns the next coarser level of \a pMultiLevel.
 	GalaxyMultilevel* build(GalaxyMultilevel* pMultiLevel);
 
 private:
-	void computeSystemMass();
-	void sortNodesBySystemMass();
-	void createResult(GalaxyMultilevel* pMultiLevelResult);
-	void labelSystem(node u, node v, int d, float df);
-	void labelSystem();
-	Graph* m_pGraph;
-	Graph* m_pGraphResult;
-	List<node> m_sunNodeList;
-	List<edge> m_interSystemEdges;
-	NodeArray<GalaxyMultilevel::LevelNodeInfo>* m_pNodeInfo;
-	EdgeArray<GalaxyMultilevel::LevelEdgeInfo>* m_pEdgeInfo;
-	NodeArray<GalaxyMultilevel::LevelNodeInfo>* m_pNodeInfoResult;
-	EdgeArray<GalaxyMultilevel::LevelEdgeInfo>* m_pEdgeInfoResult;
-	NodeArray<LevelNodeState> m_nodeState;
-	NodeOrderInfo* m_nodeMassOrder;
-	RandomNodeSet* m_pRandomSet;
-	int m_dist;
-};
+	//! A phase working on the nodes in [\a begin, \a end); returns a count that is summed up over all threads.
+	typedef int (GalaxyMultilevelBuilder::*Phase)(int begin, int end);
 
+	//! Runs \a phase for all nodes, in parallel if the level is large enough, and returns the sum of the counts.
+	int runPhase(Phase phase);
 
-class NodeMassComparer
-{
-public:
-	NodeMassComparer(const NodeArray< GalaxyMultilevelBuilder::LevelNodeState>& nodeState) : m_nodeState(nodeState) { }
+	//! Returns true iff node \a v comes before node \a w in the order for selecting suns.
+	bool before(int v, int w) const {
+		if (m_sysMass[v] != m_sysMass[w]) return m_sysMass[v] < m_sysMass[w];
+		if (m_key[v] != m_key[w]) return m_key[v] < m_key[w];
+		return v < w;
+	}
 
-	// used for std::sort
-	inline bool operator()(const GalaxyMultilevelBuilder::NodeOrderInfo& a, const GalaxyMultilevelBuilder::NodeOrderInfo& b) const
-	{
-		return m_nodeState[a.theNode].sysMass < m_nodeState[b.theNode].sysMass;
+	//! Returns the first of \a v and \a w (either may be -1).
+	int first(int v, int w) const {
+		if (v < 0) return w;
+		if (w < 0) return v;
+		return before(v, w) ? v : w;
 	}
 
-private:
-	const NodeArray< GalaxyMultilevelBuilder::LevelNodeState >& m_nodeState;
+	int computeSystemMass(int begin, int end);
+	int computeFirstUndecided(int begin, int end);
+	int selectSuns(int begin, int end);
+	int computeNearSun(int begin, int end);
+	int coverNodes(int begin, int end);
+	int computeAdjacentSun(int begin, int end);
+	int labelNodes(int begin, int end);
+
+	void selectSunsSequential();
+	void createResult(GalaxyMultilevel* pMultiLevelResult);
+
+	//! The state of a node during sun selection.
+	enum State { undecided, sun, planet };
+
+	int m_numThreads;           //!< The maximal number of threads.
+	GalaxyMultilevel* m_pLevel; //!< The level being coarsened.
+	__uint32 m_seed;            //!< The seed for the random keys.
+
+	Array<double>   m_sysMass;  //!< The system mass of each node.
+	Array<__uint32> m_key;      //!< The random key of each node.
+	Array<State>    m_state;    //!< The state of each node.
+	Array<int>      m_first;    //!< The first undecided node in the closed neighborhood of each node.
+	Array<bool>     m_nearSun;  //!< True iff a sun is in the closed neighborhood of a node.
+	Array<int>      m_sun1;     //!< The first adjacent sun of each node (the node itself for a sun, -1 if none).
+	Array<float>    m_length1;  //!< The edge length to m_sun1.
+	Array<int>      m_sun;      //!< The sun of the system of each node.
+	Array<float>    m_edgeLengthFromSun; //!< The distance of each node from its sun.
+
+	// avoid automatic creation of copy constructor and assignment operator
+	GalaxyMultilevelBuilder(const GalaxyMultilevelBuilder &);
+	GalaxyMultilevelBuilder &operator=(const GalaxyMultilevelBuilder &);
 };
 
 } // end of namespace ogdf
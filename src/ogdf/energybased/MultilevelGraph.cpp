@@ -68,6 +68,7 @@ void MultilevelGraph::initInternal()
 {
 	OGDF_ASSERT(m_G != 0);
 	m_GA = new GraphAttributes(*m_G);
+	m_stamp = 0;
 }
 
 MultilevelGraph::MultilevelGraph()
@@ -547,7 +548,7 @@ bool MultilevelGraph::postMerge(NodeMerge * NM, node merged)
 	int index = merged->index();
 	if (merged->degree() == 0 && NM->m_changedNodes.size() > 0) {
 		NM->m_mergedNode = index;
-		NM->m_radius[index] = m_radius[index];
+		NM->m_mergedRadius = m_radius[index];
 		m_changes.push_back(NM);
 		m_G->delNode(merged);
 		m_reverseNodeIndex[index] = 0;
@@ -569,7 +570,7 @@ bool MultilevelGraph::changeNode(NodeMerge * NM, node theNode, double newRadius,
 
 	if (pos == NM->m_changedNodes.end()) {
 		NM->m_changedNodes.push_back(index);
-		NM->m_radius[index] = m_radius[index];
+		NM->m_changedRadius.push_back(m_radius[index]);
 	}
 	m_radius[index] = newRadius;
 
@@ -580,16 +581,17 @@ bool MultilevelGraph::changeNode(NodeMerge * NM, node theNode, double newRadius,
 bool MultilevelGraph::changeEdge(NodeMerge * NM, edge theEdge, double newWeight, node newSource, node newTarget)
 {
 	int index = theEdge->index();
-	std::vector<int>::iterator pos = find(NM->m_changedEdges.begin(), NM->m_changedEdges.end(), index);
 
-	if (pos == NM->m_changedEdges.end()) {
-		NM->m_changedEdges.push_back(index);
-		NM->m_doubleWeight[index] = m_weight[index];
-		NM->m_source[index] = theEdge->source()->index();
-		NM->m_target[index] = theEdge->target()->index();
+	// no lookup for earlier entries, undo processes the changes in reverse order
+	NM->m_changedEdges.push_back(NodeMerge::EdgeState(index,
+		theEdge->source()->index(), theEdge->target()->index(), m_weight[index]));
+
+	if (theEdge->source() != newSource) {
+		m_G->moveSource(theEdge, newSource);
+	}
+	if (theEdge->target() != newTarget) {
+		m_G->moveTarget(theEdge, newTarget);
 	}
-	m_G->delEdge(theEdge);
-	m_reverseEdgeIndex[index] = m_G->newEdge(newSource, newTarget, index);
 	m_weight[index] = newWeight;
 
 	return true;
@@ -600,10 +602,8 @@ bool MultilevelGraph::deleteEdge(NodeMerge * NM, edge theEdge)
 {
 	int index = theEdge->index();
 
-	NM->m_deletedEdges.push_back(index);
-	NM->m_doubleWeight[index] = m_weight[index];
-	NM->m_source[index] = theEdge->source()->index();
-	NM->m_target[index] = theEdge->target()->index();
+	NM->m_deletedEdges.push_back(NodeMerge::EdgeState(index,
+		theEdge->source()->index(), theEdge->target()->index(), m_weight[index]));
 
 	m_G->delEdge(theEdge);
 	m_reverseEdgeIndex[index] = 0;
@@ -612,12 +612,40 @@ bool MultilevelGraph::deleteEdge(NodeMerge * NM, edge theEdge)
 }
 
 
+void MultilevelGraph::markParent(node parent)
+{
+	if ((int)m_markStamp.size() <= m_G->maxNodeIndex()) {
+		m_markStamp.resize(m_G->maxNodeIndex()+1, 0);
+		m_parentEdge.resize(m_G->maxNodeIndex()+1, 0);
+	}
+	m_stamp++;
+
+	adjEntry adj;
+	forall_adj(adj, parent) {
+		int w = adj->twinNode()->index();
+		if (adj->twinNode() != parent && m_markStamp[w] != m_stamp) {
+			m_markStamp[w] = m_stamp;
+			m_parentEdge[w] = adj->theEdge();
+		}
+	}
+}
+
+
 std::vector<edge> MultilevelGraph::moveEdgesToParent(NodeMerge * NM, node theNode, node parent, bool deleteDoubleEdges, int adjustEdgeLengths)
 {
 	OGDF_ASSERT(theNode != parent);
 
+	markParent(parent);
+	return moveEdgesToMarkedParent(NM, theNode, parent, deleteDoubleEdges, adjustEdgeLengths);
+}
+
+
+// requires that the neighbors of parent are marked, see markParent()
+std::vector<edge> MultilevelGraph::moveEdgesToMarkedParent(NodeMerge * NM, node theNode, node parent, bool deleteDoubleEdges, int adjustEdgeLengths)
+{
 	std::vector<edge> doubleEdges;
 	std::vector<edge> adjEdges;
+	adjEdges.reserve(theNode->degree());
 	edge e;
 	forall_adj_edges(e, theNode) {
 		adjEdges.push_back(e);
@@ -627,10 +655,7 @@ std::vector<edge> MultilevelGraph::moveEdgesToParent(NodeMerge * NM, node theNod
 	for (std::vector<edge>::iterator i = adjEdges.begin(); i != adjEdges.end(); i++)
 	{
 		e = *i;
-		node newSource = e->source();
-		node newTarget = e->target();
-		if ((newSource == theNode && newTarget == parent)
-		|| (newSource == parent && newTarget == theNode)){
+		if (e->opposite(theNode) == parent) {
 			nodeToParentLen = m_weight[e->index()];
 			break;
 		}
@@ -649,27 +674,25 @@ std::vector<edge> MultilevelGraph::moveEdgesToParent(NodeMerge * NM, node theNod
 			newTarget = parent;
 		}
 
-		bool exists = false;
-		edge twinEdge = 0;
-		adjEntry adj;
-		forall_adj(adj, parent) {
-			if (adj->twinNode() != parent && (adj->twinNode() == newSource || adj->twinNode() == newTarget)) {
-				exists = true;
-				twinEdge = adj->theEdge();
-				double extraLength = 0.0;
-				if(adjustEdgeLengths != 0) {
-					extraLength = m_weight[twinEdge->index()] + adjustEdgeLengths * nodeToParentLen;
-				}
-				changeEdge(NM, twinEdge, (m_weight[twinEdge->index()] + m_weight[e->index()] + extraLength) * 0.5f, twinEdge->source(), twinEdge->target());
-				break;
-			}
+		// has this edge already
+		if (newSource == newTarget) {
+			doubleEdges.push_back(e);
+			continue;
 		}
 
-		// has this edge already
-		if (exists || newSource == newTarget) {
+		int w = (newSource == parent ? newTarget : newSource)->index();
+		if (m_markStamp[w] == m_stamp) {
+			edge twinEdge = m_parentEdge[w];
+			double extraLength = 0.0;
+			if(adjustEdgeLengths != 0) {
+				extraLength = m_weight[twinEdge->index()] + adjustEdgeLengths * nodeToParentLen;
+			}
+			changeEdge(NM, twinEdge, (m_weight[twinEdge->index()] + m_weight[e->index()] + extraLength) * 0.5f, twinEdge->source(), twinEdge->target());
 			doubleEdges.push_back(e);
 		} else {
 			changeEdge(NM, e, m_weight[e->index()], newSource, newTarget);
+			m_markStamp[w] = m_stamp;
+			m_parentEdge[w] = e;
 		}
 	}
 
@@ -687,6 +710,36 @@ std::vector<edge> MultilevelGraph::moveEdgesToParent(NodeMerge * NM, node theNod
 }
 
 
+int MultilevelGraph::mergeLevel(int level, const std::vector< std::pair<node, node> > &merges, bool deleteDoubleEdges, int adjustEdgeLengths)
+{
+	int numMerges = 0;
+	node markedParent = 0;
+
+	for (std::vector< std::pair<node, node> >::const_iterator i = merges.begin(); i != merges.end(); i++) {
+		node mergeNode = i->first;
+		node parent = i->second;
+		OGDF_ASSERT(mergeNode != parent);
+
+		// the marks stay valid while merging into the same parent
+		if (parent != markedParent) {
+			markParent(parent);
+			markedParent = parent;
+		}
+
+		NodeMerge * NM = new NodeMerge(level);
+		changeNode(NM, parent, m_radius[parent], mergeNode);
+		moveEdgesToMarkedParent(NM, mergeNode, parent, deleteDoubleEdges, adjustEdgeLengths);
+		if (postMerge(NM, mergeNode)) {
+			numMerges++;
+		} else {
+			delete NM;
+		}
+	}
+
+	return numMerges;
+}
+
+
 NodeMerge * MultilevelGraph::getLastMerge()
 {
 	return m_changes.back();
@@ -705,28 +758,36 @@ node MultilevelGraph::undoLastMerge()
 	int index = merge->m_mergedNode;
 	node merged = m_G->newNode(index);
 	m_reverseNodeIndex[index] = merged;
-	m_radius[index] = merge->m_radius[index];
+	m_radius[index] = merge->m_mergedRadius;
 
-	std::vector<int>::iterator it;
 	// add deleted edges
+	std::vector<NodeMerge::EdgeState>::const_iterator it;
 	for (it = merge->m_deletedEdges.begin(); it != merge->m_deletedEdges.end(); it++) {
-		index = *it;
-		m_reverseEdgeIndex[index] = m_G->newEdge(m_reverseNodeIndex[merge->m_source[index]], m_reverseNodeIndex[merge->m_target[index]], index);
-		m_weight[index] = merge->m_doubleWeight[index];
-	}
-
-	// undo edge changes
-	for (it = merge->m_changedEdges.begin(); it != merge->m_changedEdges.end(); it++) {
-		index = *it;
-		m_G->delEdge(m_reverseEdgeIndex[index]);
-		m_reverseEdgeIndex[index] = m_G->newEdge(m_reverseNodeIndex[merge->m_source[index]], m_reverseNodeIndex[merge->m_target[index]], index);
-		m_weight[index] = merge->m_doubleWeight[index];
+		index = it->m_index;
+		m_reverseEdgeIndex[index] = m_G->newEdge(m_reverseNodeIndex[it->m_source], m_reverseNodeIndex[it->m_target], index);
+		m_weight[index] = it->m_weight;
+	}
+
+	// undo edge changes, latest change first
+	std::vector<NodeMerge::EdgeState>::const_reverse_iterator rit;
+	for (rit = merge->m_changedEdges.rbegin(); rit != merge->m_changedEdges.rend(); rit++) {
+		index = rit->m_index;
+		edge e = m_reverseEdgeIndex[index];
+		node source = m_reverseNodeIndex[rit->m_source];
+		node target = m_reverseNodeIndex[rit->m_target];
+		if (e->source() != source) {
+			m_G->moveSource(e, source);
+		}
+		if (e->target() != target) {
+			m_G->moveTarget(e, target);
+		}
+		m_weight[index] = rit->m_weight;
 	}
 
 	// undo node changes
-	for (it = merge->m_changedNodes.begin(); it != merge->m_changedNodes.end(); it++) {
-		index = *it;
-		m_radius[index] = merge->m_radius[index];
+	for (unsigned int i = 0; i < merge->m_changedNodes.size(); i++) {
+		index = merge->m_changedNodes[i];
+		m_radius[index] = merge->m_changedRadius[i];
 		m_reverseNodeMergeWeight[index] -= m_reverseNodeMergeWeight[merged->index()];
 	}
 
@@ -47,11 +47,12 @@
 namespace ogdf {
 
 
-NodePairEnergy::NodePairEnergy(const string energyname, GraphAttributes &AG) :
+NodePairEnergy::NodePairEnergy(const string energyname, GraphAttributes &AG, double range) :
 	EnergyFunction(energyname,AG),
-	m_candPairEnergy(m_G),
 	m_shape(m_G),
-	m_adjacentOracle(m_G)
+	m_adjacentOracle(m_G),
+	m_range(range),
+	m_grid(0)
 {
 	node v;
 	double lengthSum = 0;
@@ -67,35 +68,51 @@ NodePairEnergy::NodePairEnergy(const string energyname, GraphAttributes &AG) :
 		itSucc = it.succ();
 		if((*it)->degree() == 0) m_nonIsolated.del(it);
 	}
-	m_nodeNums = OGDF_NEW NodeArray<int>(m_G,0);
-	int n_num = 1;
-	for(it = m_nonIsolated.begin(); it.valid(); ++it) {
-		(*m_nodeNums)[*it] = n_num;
-		n_num++;
+
+	if(m_range >= 0.0) {
+		// a cell should be about as large as a vertex and the range,
+		// so that a query only inspects a few cells
+		double cellSize = m_range;
+		if(m_G.numberOfNodes() > 0)
+			cellSize = max(cellSize, lengthSum / (2*m_G.numberOfNodes()));
+		if(cellSize <= 0.0) cellSize = 1.0;
+
+		m_grid = new SpatialGrid(m_G.maxNodeIndex()+1, cellSize);
+		m_indexToNode.init(0,m_G.maxNodeIndex(),0);
+		forall_nodes(v,m_G)
+			m_indexToNode[v->index()] = v;
 	}
-	n_num--;
-	m_pairEnergy = new Array2D<double> (1,n_num,1,n_num);
+}
+
+
+void NodePairEnergy::insertIntoGrid(node v)
+{
+	IntersectionRectangle r(m_shape[v]);
+	r.move(currentPos(v));
+	m_grid->insert(v->index(),
+		min(r.p1().m_x,r.p2().m_x), min(r.p1().m_y,r.p2().m_y),
+		max(r.p1().m_x,r.p2().m_x), max(r.p1().m_y,r.p2().m_y));
 }
 
 
 void NodePairEnergy::computeEnergy()
 {
-	int n_num = m_nonIsolated.size();
 	double energySum = 0.0;
-	Array<node> numNodes(1,n_num);
 
-	ListIterator<node> it;
-	for(it = m_nonIsolated.begin(); it.valid(); ++it) {
-		numNodes[(*m_nodeNums)[*it]] = *it;
-	}
-	for(int i = 1; i <= n_num-1 ; i++) {
-		for(int j = i+1; j <= n_num; j++) {
-			double E = computePairEnergy(numNodes[i],numNodes[j]);
-			(*m_pairEnergy)(i,j) = E;
-			energySum += E;
-		}
+	ListConstIterator<node> it;
+	if(m_grid != 0) {
+		for(it = m_nonIsolated.begin(); it.valid(); ++it)
+			if(m_grid->contains((*it)->index()))
+				m_grid->remove((*it)->index());
+		for(it = m_nonIsolated.begin(); it.valid(); ++it)
+			insertIntoGrid(*it);
 	}
-	m_energy = energySum;
+
+	// each pair is counted twice
+	for(it = m_nonIsolated.begin(); it.valid(); ++it)
+		energySum += nodeEnergy(*it,currentPos(*it));
+
+	m_energy = energySum / 2.0;
 }
 
 
@@ -104,16 +121,41 @@ double NodePairEnergy::computePairEnergy(const node v, const node w) const {
 }
 
 
+double NodePairEnergy::nodeEnergy(node v, const DPoint &p) const
+{
+	double energySum = 0.0;
+
+	if(m_grid == 0) {
+		for(int i = 0; i < m_adjacentOracle.numberOfNeighbors(v); ++i) {
+			node w = m_adjacentOracle.neighbor(v,i);
+			energySum += computeCoordEnergy(v,w,p,currentPos(w));
+		}
+
+	} else {
+		IntersectionRectangle r(m_shape[v]);
+		r.move(p);
+		m_near.clear();
+		m_grid->query(
+			min(r.p1().m_x,r.p2().m_x) - m_range, min(r.p1().m_y,r.p2().m_y) - m_range,
+			max(r.p1().m_x,r.p2().m_x) + m_range, max(r.p1().m_y,r.p2().m_y) + m_range,
+			m_near);
+
+		for(int i = 0; i < m_near.size(); ++i) {
+			node w = m_indexToNode[m_near[i]];
+			if(w != v)
+				energySum += computeCoordEnergy(v,w,p,currentPos(w));
+		}
+	}
+
+	return energySum;
+}
+
+
 void NodePairEnergy::internalCandidateTaken() {
 	node v = testNode();
-	int candNum = (*m_nodeNums)[v];
-	ListIterator<node> it;
-	for(it = m_nonIsolated.begin(); it.valid(); ++ it) {
-		if((*it) != v) {
-			int numit = (*m_nodeNums)[*it];
-			(*m_pairEnergy)(min(numit,candNum),max(numit,candNum)) = m_candPairEnergy[*it];
-			m_candPairEnergy[*it] = 0.0;
-		}
+	if(m_grid != 0 && m_grid->contains(v->index())) {
+		m_grid->remove(v->index());
+		insertIntoGrid(v);
 	}
 }
 
@@ -121,23 +163,18 @@ void NodePairEnergy::internalCandidateTaken() {
 void NodePairEnergy::compCandEnergy()
 {
 	node v = testNode();
-	int numv = (*m_nodeNums)[v];
 	m_candidateEnergy = energy();
-	ListIterator<node> it;
-	for(it = m_nonIsolated.begin(); it.valid(); ++ it) {
-		if(*it != v) {
-			int j = (*m_nodeNums)[*it];
-			m_candidateEnergy -= (*m_pairEnergy)(min(j,numv),max(j,numv));
-			m_candPairEnergy[*it] = computeCoordEnergy(v,*it,testPos(),currentPos(*it));
-			m_candidateEnergy += m_candPairEnergy[*it];
-			if(m_candidateEnergy < 0.0) {
-				OGDF_ASSERT(m_candidateEnergy > -0.00001);
-				m_candidateEnergy = 0.0;
-			}
-		}
-		else m_candPairEnergy[*it] = 0.0;
+
+	// isolated vertices do not contribute to the energy
+	if(v->degree() == 0)
+		return;
+
+	m_candidateEnergy -= nodeEnergy(v,currentPos(v));
+	m_candidateEnergy += nodeEnergy(v,testPos());
+	if(m_candidateEnergy < 0.0) {
+		OGDF_ASSERT(m_candidateEnergy > -0.00001);
+		m_candidateEnergy = 0.0;
 	}
-	OGDF_ASSERT(m_candidateEnergy >= -0.0001);
 }
 
 
@@ -145,14 +182,11 @@ void NodePairEnergy::compCandEnergy()
 void NodePairEnergy::printInternalData() const {
 	ListConstIterator<node> it;
 	for(it = m_nonIsolated.begin(); it.valid(); ++it) {
-		cout << "\nNode: " << (*m_nodeNums)[*it];
-		cout << " CandidatePairEnergy: " << m_candPairEnergy[*it];
+		cout << "\nNode: " << (*it)->index();
+		cout << " Energy: " << nodeEnergy(*it,currentPos(*it));
 	}
-	cout << "\nPair energies:";
-	for(int i=1; i< m_nonIsolated.size(); i++)
-		for(int j=i+1; j <= m_nonIsolated.size(); j++)
-			if((*m_pairEnergy)(i,j) != 0.0)
-				cout << "\nEnergy(" << i << ',' << j << ") = " << (*m_pairEnergy)(i,j);
+	if(m_grid != 0)
+		cout << "\nGrid cell size: " << m_grid->cellSize();
 }
 #endif
 
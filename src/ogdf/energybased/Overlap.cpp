@@ -45,7 +45,7 @@
 
 namespace ogdf {
 
-	Overlap::Overlap(GraphAttributes &AG) : NodePairEnergy("Overlap",AG){}
+	Overlap::Overlap(GraphAttributes &AG) : NodePairEnergy("Overlap",AG,0.0){}
 
 	double Overlap::computeCoordEnergy(node v1, node v2, const DPoint &p1, const DPoint &p2)
 		const
@@ -40,7 +40,13 @@
  * \see  http://www.gnu.org/copyleft/gpl.html
  ***************************************************************/
 
+
 #include <ogdf/energybased/PivotMDS.h>
+#include <ogdf/basic/BinaryHeap2.h>
+#include <ogdf/basic/Barrier.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/ParallelRange.h>
+#include <ogdf/internal/basic/intrinsics.h>
 
 
 namespace ogdf {
@@ -48,12 +54,676 @@ namespace ogdf {
 const double PivotMDS::EPSILON = 1 - 1e-10;
 const double PivotMDS::FACTOR = -0.5;
 
+// the pivot matrix is processed in blocks of this many rows (nodes)
+static const int blockSize = 256;
 
-void PivotMDS::call(GraphAttributes& GA)
+// minimal number of nodes per thread
+static const int minNodesPerThread = 1024;
+
+
+// Computes y[begin..end) += a * x[begin..end).
+static void axpy(double a, const double *x, double *y, int begin, int end, bool useSSE2)
+{
+	int j = begin;
+
+#ifdef OGDF_SSE2_EXTENSIONS
+	if (useSSE2)
+	{
+		__m128d mm_a = _mm_set1_pd(a);
+		for (; j+1 < end; j += 2)
+			_mm_storeu_pd(y+j, _mm_add_pd(_mm_loadu_pd(y+j), _mm_mul_pd(mm_a, _mm_loadu_pd(x+j))));
+	}
+#endif
+
+	for (; j < end; ++j)
+		y[j] += a * x[j];
+}
+
+
+// Adds the scalar products of the columns a0, a1 with the columns b0, b1,
+// restricted to the rows [begin,end), to s = (a0*b0, a0*b1, a1*b0, a1*b1).
+static void dot2x2(
+	const double *a0, const double *a1, const double *b0, const double *b1,
+	int begin, int end, double *s, bool useSSE2)
+{
+	double s00 = 0, s01 = 0, s10 = 0, s11 = 0;
+	int j = begin;
+
+#ifdef OGDF_SSE2_EXTENSIONS
+	if (useSSE2)
+	{
+		__m128d mm_s00 = _mm_setzero_pd();
+		__m128d mm_s01 = _mm_setzero_pd();
+		__m128d mm_s10 = _mm_setzero_pd();
+		__m128d mm_s11 = _mm_setzero_pd();
+
+		for (; j+1 < end; j += 2)
+		{
+			__m128d mm_a0 = _mm_loadu_pd(a0+j);
+			__m128d mm_a1 = _mm_loadu_pd(a1+j);
+			__m128d mm_b0 = _mm_loadu_pd(b0+j);
+			__m128d mm_b1 = _mm_loadu_pd(b1+j);
+			mm_s00 = _mm_add_pd(mm_s00, _mm_mul_pd(mm_a0, mm_b0));
+			mm_s01 = _mm_add_pd(mm_s01, _mm_mul_pd(mm_a0, mm_b1));
+			mm_s10 = _mm_add_pd(mm_s10, _mm_mul_pd(mm_a1, mm_b0));
+			mm_s11 = _mm_add_pd(mm_s11, _mm_mul_pd(mm_a1, mm_b1));
+		}
+
+		double t[2];
+		_mm_storeu_pd(t, mm_s00); s00 = t[0] + t[1];
+		_mm_storeu_pd(t, mm_s01); s01 = t[0] + t[1];
+		_mm_storeu_pd(t, mm_s10); s10 = t[0] + t[1];
+		_mm_storeu_pd(t, mm_s11); s11 = t[0] + t[1];
+	}
+#endif
+
+	for (; j < end; ++j)
+	{
+		s00 += a0[j] * b0[j];
+		s01 += a0[j] * b1[j];
+		s10 += a1[j] * b0[j];
+		s11 += a1[j] * b1[j];
+	}
+
+	s[0] += s00;
+	s[1] += s01;
+	s[2] += s10;
+	s[3] += s11;
+}
+
+
+//! Computes the columns of the pivot matrix.
+/**
+ * The pivots are chosen by the maxmin strategy, hence the searches are
+ * performed one after the other. With uniform edge costs, each search is a
+ * level-synchronous BFS: levels with a small frontier are expanded top-down
+ * by the calling thread, levels with a large frontier bottom-up by all
+ * threads, each of which checks the unvisited nodes of its own range of
+ * nodes for a neighbour in the frontier. The update of the minimal
+ * distances and the selection of the next pivot are done by all threads.
+ */
+class PivotMDS::PivotSearch
+{
+public:
+	PivotSearch(
+		const Array<int> &adjStart,
+		const Array<int> &adjTarget,
+		const Array<double> *adjLength,
+		double edgeCosts,
+		Array<double> &C,
+		int l,
+		int nThreads);
+
+	//! Computes the \a l columns of the pivot matrix.
+	void run();
+
+private:
+	class Worker;
+
+	enum Command { cmdBottomUp, cmdUpdate, cmdExit };
+
+	const Array<int>    &m_adjStart;  //!< The adjacency list of node i is [m_adjStart[i], m_adjStart[i+1]).
+	const Array<int>    &m_adjTarget; //!< The adjacent nodes.
+	const Array<double> *m_adjLength; //!< The edge lengths, or 0 if BFS is used.
+	double m_edgeCosts;               //!< The uniform edge costs used by BFS.
+
+	Array<double> &m_C; //!< The pivot matrix.
+	int m_n;            //!< The number of nodes.
+	int m_l;            //!< The number of pivots.
+	int m_nThreads;     //!< The number of threads.
+
+	Array<int> m_rangeBegin; //!< Thread t is responsible for the nodes [m_rangeBegin[t], m_rangeBegin[t+1]).
+	Array<double> m_minDist; //!< The minimal distance of each node to a pivot.
+
+	//! m_stamp[L%2][v] == L iff v is in the frontier of level L.
+	Array<int> m_stamp[2];
+
+	//! The frontier of level L consists of the lists m_frontier[L%2][t].
+	Array<Array<int> > m_frontier[2];
+	Array<int> m_frontierSize[2];
+
+	Array<int> m_degreeSum; //!< The sum of the degrees of the nodes found by thread t.
+	Array<int> m_best;      //!< The node of maximal minimal distance found by thread t (or -1).
+
+	Command m_command;     //!< The current command.
+	int m_level;           //!< The level expanded by cmdBottomUp.
+	double *m_column;      //!< The column of the current search.
+	double *m_nextColumn;  //!< The column of the next search, or 0.
+
+	Barrier *m_barrier;
+
+	//! Lets all threads perform \a cmd.
+	void execute(Command cmd);
+
+	//! Performs \a cmd for the range of thread \a t.
+	void perform(Command cmd, int t);
+
+	//! Computes the distances from \a s by BFS.
+	void bfs(int s);
+
+	//! Computes the distances from \a s by Dijkstra's algorithm.
+	void dijkstra(int s, BinaryHeap2<double,int> &queue, Array<int> &qpos);
+
+	//! Expands the level \a L top-down; returns the size of the new frontier.
+	int topDown(int L, int &degreeSum);
+
+	//! Expands the level m_level bottom-up within the range of thread \a t.
+	void bottomUp(int t);
+
+	//! Updates the minimal distances within the range of thread \a t.
+	void update(int t);
+
+	int degree(int v) const { return m_adjStart[v+1] - m_adjStart[v]; }
+};
+
+
+//! Performs the commands of a PivotSearch in a separate thread.
+class PivotMDS::PivotSearch::Worker : public Thread
+{
+	PivotSearch &m_search;
+	int m_t;
+
+public:
+	Worker(PivotSearch &search, int t) : m_search(search), m_t(t) { }
+
+protected:
+	virtual void doWork() {
+		for (;;) {
+			m_search.m_barrier->threadSync();
+			if (m_search.m_command == cmdExit)
+				break;
+			m_search.perform(m_search.m_command, m_t);
+			m_search.m_barrier->threadSync();
+		}
+	}
+};
+
+
+PivotMDS::PivotSearch::PivotSearch(
+	const Array<int> &adjStart,
+	const Array<int> &adjTarget,
+	const Array<double> *adjLength,
+	double edgeCosts,
+	Array<double> &C,
+	int l,
+	int nThreads)
+	: m_adjStart(adjStart), m_adjTarget(adjTarget), m_adjLength(adjLength),
+	  m_edgeCosts(edgeCosts), m_C(C), m_n(adjStart.size() - 1), m_l(l),
+	  m_nThreads(nThreads), m_rangeBegin(nThreads+1), m_minDist(m_n),
+	  m_degreeSum(nThreads), m_best(nThreads), m_column(0), m_nextColumn(0), m_barrier(0)
+{
+	for (int t = 0; t <= m_nThreads; ++t)
+		m_rangeBegin[t] = (int)(((__int64)m_n * t) / m_nThreads);
+
+	for (int i = 0; i < 2; ++i) {
+		m_stamp[i].init(m_n);
+		m_stamp[i].fill(-1);
+
+		// thread 0 also collects the frontiers expanded top-down
+		m_frontier[i].init(m_nThreads);
+		m_frontier[i][0].init(m_n);
+		for (int t = 1; t < m_nThreads; ++t)
+			m_frontier[i][t].init(max(1, m_rangeBegin[t+1] - m_rangeBegin[t]));
+		m_frontierSize[i].init(m_nThreads);
+		m_frontierSize[i].fill(0);
+	}
+}
+
+
+void PivotMDS::PivotSearch::run()
+{
+	const double infinity = numeric_limits<double>::infinity();
+	m_minDist.fill(infinity);
+	for (int v = 0; v < m_n; ++v)
+		m_C[v] = infinity;
+
+	Array<Worker *> worker(m_nThreads);
+	if (m_nThreads > 1) {
+		m_barrier = new Barrier(m_nThreads);
+		for (int t = 1; t < m_nThreads; ++t) {
+			worker[t] = new Worker(*this, t);
+			worker[t]->start();
+		}
+	}
+
+	BinaryHeap2<double,int> queue(m_adjLength != 0 ? m_n+1 : 1);
+	Array<int> qpos(m_adjLength != 0 ? m_n : 1);
+
+	// the current pivot node
+	int pivot = 0;
+	for (int i = 0; i < m_l; i++) {
+		m_column = &m_C[i*m_n];
+		m_nextColumn = (i+1 < m_l) ? &m_C[(i+1)*m_n] : 0;
+
+		// get the shortest path from the currently processed pivot node to
+		// all other nodes in the graph
+		if (m_adjLength != 0)
+			dijkstra(pivot, queue, qpos);
+		else
+			bfs(pivot);
+
+		// update the pivot and the minDistances array ... to ensure the
+		// correctness set minDistance of the pivot node to zero; on ties,
+		// the first node is chosen
+		m_minDist[pivot] = 0;
+		execute(cmdUpdate);
+
+		double maxDist = 0;
+		for (int t = 0; t < m_nThreads; ++t) {
+			if (m_best[t] >= 0 && m_minDist[m_best[t]] > maxDist) {
+				pivot = m_best[t];
+				maxDist = m_minDist[pivot];
+			}
+		}
+	}
+
+	if (m_nThreads > 1) {
+		m_command = cmdExit;
+		m_barrier->threadSync();
+		for (int t = 1; t < m_nThreads; ++t) {
+			worker[t]->join();
+			delete worker[t];
+		}
+		delete m_barrier;
+		m_barrier = 0;
+	}
+}
+
+
+void PivotMDS::PivotSearch::execute(Command cmd)
+{
+	m_command = cmd;
+	if (m_nThreads > 1)
+		m_barrier->threadSync();
+	perform(cmd, 0);
+	if (m_nThreads > 1)
+		m_barrier->threadSync();
+}
+
+
+void PivotMDS::PivotSearch::perform(Command cmd, int t)
+{
+	switch (cmd) {
+	case cmdBottomUp:
+		bottomUp(t);
+		break;
+	case cmdUpdate:
+		update(t);
+		break;
+	default:
+		break;
+	}
+}
+
+
+void PivotMDS::PivotSearch::bfs(int s)
+{
+	// thresholds for switching between top-down and bottom-up expansion
+	const double alpha = 14, beta = 24;
+
+	m_column[s] = 0;
+	m_stamp[0][s] = 0;
+	m_frontier[0][0][0] = s;
+	m_frontierSize[0].fill(0);
+	m_frontierSize[0][0] = 1;
+
+	int frontierSize = 1;
+	int frontierDegree = degree(s);
+	int unexploredDegree = m_adjStart[m_n] - frontierDegree;
+	bool bottomUp = false;
+
+	for (int L = 0; frontierSize > 0; ++L)
+	{
+		if (m_nThreads > 1) {
+			if (!bottomUp)
+				bottomUp = frontierDegree * alpha > unexploredDegree;
+			else
+				bottomUp = frontierSize * beta >= m_n;
+		}
+
+		if (bottomUp) {
+			m_level = L;
+			execute(cmdBottomUp);
+
+			const int next = (L+1) & 1;
+			frontierSize = frontierDegree = 0;
+			for (int t = 0; t < m_nThreads; ++t) {
+				frontierSize += m_frontierSize[next][t];
+				frontierDegree += m_degreeSum[t];
+			}
+		} else
+			frontierSize = topDown(L, frontierDegree);
+
+		unexploredDegree -= frontierDegree;
+	}
+}
+
+
+int PivotMDS::PivotSearch::topDown(int L, int &degreeSum)
+{
+	const int cur = L & 1, next = cur ^ 1;
+	int *stamp = &m_stamp[next][0];
+	int *frontier = &m_frontier[next][0][0];
+	int size = 0;
+	degreeSum = 0;
+
+	for (int t = 0; t < m_nThreads; ++t) {
+		const int *list = &m_frontier[cur][t][0];
+		for (int k = 0; k < m_frontierSize[cur][t]; ++k) {
+			const int w = list[k];
+			const double d = m_column[w] + m_edgeCosts;
+			for (int i = m_adjStart[w]; i < m_adjStart[w+1]; ++i) {
+				const int u = m_adjTarget[i];
+				if (m_column[u] == numeric_limits<double>::infinity()) {
+					m_column[u] = d;
+					stamp[u] = L+1;
+					frontier[size++] = u;
+					degreeSum += degree(u);
+				}
+			}
+		}
+	}
+
+	m_frontierSize[next].fill(0);
+	m_frontierSize[next][0] = size;
+	return size;
+}
+
+
+void PivotMDS::PivotSearch::bottomUp(int t)
+{
+	const int L = m_level;
+	const int *stamp = &m_stamp[L & 1][0];
+	int *nextStamp = &m_stamp[(L+1) & 1][0];
+	int *frontier = &m_frontier[(L+1) & 1][t][0];
+	int size = 0, degreeSum = 0;
+
+	// only the entries of the own range are written
+	for (int v = m_rangeBegin[t]; v < m_rangeBegin[t+1]; ++v) {
+		if (m_column[v] != numeric_limits<double>::infinity())
+			continue;
+		for (int i = m_adjStart[v]; i < m_adjStart[v+1]; ++i) {
+			const int w = m_adjTarget[i];
+			if (stamp[w] == L) {
+				m_column[v] = m_column[w] + m_edgeCosts;
+				nextStamp[v] = L+1;
+				frontier[size++] = v;
+				degreeSum += degree(v);
+				break;
+			}
+		}
+	}
+
+	m_frontierSize[(L+1) & 1][t] = size;
+	m_degreeSum[t] = degreeSum;
+}
+
+
+void PivotMDS::PivotSearch::update(int t)
+{
+	const double infinity = numeric_limits<double>::infinity();
+	double maxDist = 0;
+	int best = -1;
+
+	for (int v = m_rangeBegin[t]; v < m_rangeBegin[t+1]; ++v) {
+		const double d = min(m_minDist[v], m_column[v]);
+		m_minDist[v] = d;
+		if (d > maxDist) {
+			maxDist = d;
+			best = v;
+		}
+
+		// prepare the next search
+		m_stamp[0][v] = m_stamp[1][v] = -1;
+		if (m_nextColumn != 0)
+			m_nextColumn[v] = infinity;
+	}
+
+	m_best[t] = best;
+}
+
+
+void PivotMDS::PivotSearch::dijkstra(int s, BinaryHeap2<double,int> &queue, Array<int> &qpos)
+{
+	const double infinity = numeric_limits<double>::infinity();
+	double *dist = m_column;
+	dist[s] = 0.0;
+
+	// nodes are inserted into the queue when they are reached for the first time
+	queue.insert(s, dist[s], &qpos[s]);
+	while (!queue.empty())
+	{
+		int w = queue.extractMin();
+		for (int i = m_adjStart[w]; i < m_adjStart[w+1]; ++i)
+		{
+			int u = m_adjTarget[i];
+			double d = dist[w] + (*m_adjLength)[i];
+			if (dist[u] == infinity) {
+				dist[u] = d;
+				queue.insert(u, d, &qpos[u]);
+			} else if (d < dist[u]) {
+				queue.decreaseKey(qpos[u], (dist[u] = d));
+			}
+		}
+	}
+}
+
+
+//! Performs a part of a matrix operation on the pivot matrix.
+/**
+ * The pivot matrix C is stored column-major, i.e., the entry of node j and
+ * pivot k is C[k*n + j]. The work is split into parts, which are either
+ * columns of C, blocks of rows of C or pairs of rows of K = C^T C; a call
+ * handles a contiguous range of parts.
+ */
+class PivotMDS::MatrixOperation
+{
+public:
+	enum Operation {
+		opColumnSums,  //!< sums of squares of the columns of C
+		opCenter,      //!< double centering of the squared entries of C
+		opSelfProduct, //!< lower triangle of K = C^T C
+		opProject      //!< y_i = C x_i
+	};
+
+	//! The operands shared by all threads.
+	struct Operands {
+		Operands(Array<double> &C, int n, int l, bool useSSE2)
+			: m_C(&C[0]), m_n(n), m_l(l), m_useSSE2(useSSE2), m_normFactor(0),
+			  m_K(0), m_x(0), m_y(0) { }
+
+		double *m_C;
+		int m_n;
+		int m_l;
+		bool m_useSSE2;
+
+		Array<double> m_colSum;   //!< opColumnSums: the sums; opCenter: the column normalization.
+		double m_normFactor;      //!< opCenter: the overall normalization.
+		Array<double> *m_K;       //!< opSelfProduct: the l x l result.
+		const Array<Array<double> > *m_x; //!< opProject: the vectors of length l.
+		Array<Array<double> > *m_y;       //!< opProject: the results of length n.
+	};
+
+	MatrixOperation(Operation op, Operands &operands) : m_op(op), m_operands(operands) { }
+
+	//! Performs the operation for the parts [\a begin, \a end).
+	int operator()(int begin, int end) const {
+		switch (m_op) {
+		case opColumnSums:
+			columnSums(begin, end);
+			break;
+		case opCenter:
+			center(begin, end);
+			break;
+		case opSelfProduct:
+			selfProduct(begin, end);
+			break;
+		case opProject:
+			project(begin, end);
+			break;
+		}
+		return 0;
+	}
+
+	//! Performs \a op with up to \a nThreads threads.
+	static void execute(Operation op, Operands &operands, int nThreads);
+
+private:
+	Operation m_op;
+	Operands &m_operands;
+
+	void columnSums(int begin, int end) const;
+	void center(int begin, int end) const;
+	void selfProduct(int begin, int end) const;
+	void project(int begin, int end) const;
+};
+
+
+void PivotMDS::MatrixOperation::execute(Operation op, Operands &operands, int nThreads)
+{
+	MatrixOperation operation(op, operands);
+	const int numBlocks = (operands.m_n + blockSize - 1) / blockSize;
+
+	switch (op) {
+	case opColumnSums:
+		parallelRange(operands.m_l, nThreads, 1, operation);
+		break;
+
+	case opCenter:
+	case opProject:
+		parallelRange(numBlocks, nThreads, 1, operation);
+		break;
+
+	case opSelfProduct:
+		{
+			// pair p computes p+1 blocks of K, so the pairs are split such
+			// that all threads compute about the same number of blocks
+			const int nPairs = (operands.m_l + 1) / 2;
+			const int numThreads = max(1, min(nThreads, nPairs));
+			Array<int> bound(numThreads+1);
+			for (int t = 0; t <= numThreads; ++t)
+				bound[t] = (int)(nPairs * sqrt(double(t) / numThreads) + 0.5);
+			bound[numThreads] = nPairs;
+			parallelBlocks(bound, operation);
+		}
+		break;
+	}
+}
+
+
+void PivotMDS::MatrixOperation::columnSums(int begin, int end) const
+{
+	const int n = m_operands.m_n;
+
+	for (int k = begin; k < end; k++) {
+		const double *col = m_operands.m_C + k*n;
+		double sum = 0;
+		for (int j = 0; j < n; j++)
+			sum += col[j] * col[j];
+		m_operands.m_colSum[k] = sum;
+	}
+}
+
+
+void PivotMDS::MatrixOperation::center(int begin, int end) const
+{
+	const int n = m_operands.m_n, l = m_operands.m_l;
+	const double normalizationFactor = m_operands.m_normFactor;
+	Array<double> rowColNormalizer(blockSize);
+
+	for (int j0 = begin * blockSize; j0 < min(n, end * blockSize); j0 += blockSize) {
+		const int j1 = min(n, j0 + blockSize);
+		rowColNormalizer.fill(0);
+
+		for (int k = 0; k < l; k++) {
+			double *col = m_operands.m_C + k*n;
+			const double colNormalization = m_operands.m_colSum[k];
+			for (int j = j0; j < j1; j++) {
+				double square = col[j] * col[j];
+				col[j] = square + normalizationFactor - colNormalization;
+				rowColNormalizer[j-j0] += square;
+			}
+		}
+
+		for (int j = j0; j < j1; j++)
+			rowColNormalizer[j-j0] /= l;
+
+		for (int k = 0; k < l; k++) {
+			double *col = m_operands.m_C + k*n;
+			for (int j = j0; j < j1; j++)
+				col[j] = FACTOR * (col[j] - rowColNormalizer[j-j0]);
+		}
+	}
+}
+
+
+void PivotMDS::MatrixOperation::selfProduct(int begin, int end) const
 {
-	if (DIMENSION_COUNT > 2) {
-		OGDF_ASSERT(GA.attributes() & GraphAttributes::threeD);
+	const int n = m_operands.m_n, l = m_operands.m_l;
+	const double *C = m_operands.m_C;
+	double *K = &(*m_operands.m_K)[0];
+
+	// the rows of K are handled in pairs; the matrix is traversed in blocks
+	// of rows such that the block of all columns stays in the cache
+	for (int j0 = 0; j0 < n; j0 += blockSize) {
+		const int j1 = min(n, j0 + blockSize);
+
+		for (int p = begin; p < end; ++p) {
+			const int a0 = 2*p, a1 = min(a0+1, l-1);
+
+			for (int q = 0; q <= p; ++q) {
+				const int b0 = 2*q, b1 = min(b0+1, l-1);
+				double s[4] = { 0, 0, 0, 0 };
+				dot2x2(C + a0*n, C + a1*n, C + b0*n, C + b1*n, j0, j1, s, m_operands.m_useSSE2);
+
+				K[a0*l + b0] += s[0];
+				if (b1 != b0 && b1 <= a0)
+					K[a0*l + b1] += s[1];
+				if (a1 != a0) {
+					K[a1*l + b0] += s[2];
+					if (b1 != b0)
+						K[a1*l + b1] += s[3];
+				}
+			}
+		}
+	}
+}
+
+
+void PivotMDS::MatrixOperation::project(int begin, int end) const
+{
+	const int n = m_operands.m_n, l = m_operands.m_l;
+	const Array<Array<double> > &x = *m_operands.m_x;
+	Array<Array<double> > &y = *m_operands.m_y;
+
+	for (int j0 = begin * blockSize; j0 < min(n, end * blockSize); j0 += blockSize) {
+		const int j1 = min(n, j0 + blockSize);
+
+		for (int i = 0; i < y.size(); i++)
+			for (int j = j0; j < j1; j++)
+				y[i][j] = 0;
+
+		for (int k = 0; k < l; k++) {
+			const double *col = m_operands.m_C + k*n;
+			for (int i = 0; i < y.size(); i++)
+				axpy(x[i][k], col, &y[i][0], j0, j1, m_operands.m_useSSE2);
+		}
 	}
+}
+
+
+PivotMDS::PivotMDS() : m_numberOfPivots(250), m_edgeCosts(100), m_hasEdgeCostsAttribute(false)
+{
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = System::numberOfProcessors();
+#endif
+}
+
+
+void PivotMDS::call(GraphAttributes& GA)
+{
 	if (!isConnected(GA.constGraph())) {
 		OGDF_THROW_PARAM(PreconditionViolatedException,pvcConnected);
 		return;
@@ -67,44 +737,28 @@ void PivotMDS::call(GraphAttributes& GA)
 }
 
 
-void PivotMDS::centerPivotmatrix(Array<Array<double> >& pivotMatrix)
+void PivotMDS::centerPivotmatrix(Array<double>& C, int n, int l, int nThreads)
 {
-	int numberOfPivots = pivotMatrix.size();
-	// this is ensured since the graph size is at least 2!
-	int nodeCount = pivotMatrix[0].size();
+	MatrixOperation::Operands operands(C, n, l, false);
+	operands.m_colSum.init(l);
+	MatrixOperation::execute(MatrixOperation::opColumnSums, operands, nThreads);
 
 	double normalizationFactor = 0;
-	double rowColNormalizer;
-	Array<double> colNormalization(numberOfPivots);
-
-	for (int i = 0; i < numberOfPivots; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < nodeCount; j++) {
-			rowColNormalizer += pivotMatrix[i][j] * pivotMatrix[i][j];
-		}
-		normalizationFactor += rowColNormalizer;
-		colNormalization[i] = rowColNormalizer / nodeCount;
-	}
-	normalizationFactor = normalizationFactor / (nodeCount * numberOfPivots);
-	for (int i = 0; i < nodeCount; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < numberOfPivots; j++) {
-			double square = pivotMatrix[j][i] * pivotMatrix[j][i];
-			pivotMatrix[j][i] = square + normalizationFactor
-					- colNormalization[j];
-			rowColNormalizer += square;
-		}
-		rowColNormalizer /= numberOfPivots;
-		for (int j = 0; j < numberOfPivots; j++) {
-			pivotMatrix[j][i] = FACTOR * (pivotMatrix[j][i] - rowColNormalizer);
-		}
+	for (int k = 0; k < l; k++) {
+		normalizationFactor += operands.m_colSum[k];
+		operands.m_colSum[k] /= n;
 	}
+	operands.m_normFactor = normalizationFactor / ((double)n * l);
+
+	MatrixOperation::execute(MatrixOperation::opCenter, operands, nThreads);
 }
 
 
 void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 {
 	const Graph& G = GA.constGraph();
+	const bool threeD = (GA.attributes() & GraphAttributes::threeD) != 0;
+
 	if (G.numberOfNodes() <= 1) {
 		// make it exception save
 		node v;
@@ -112,7 +766,7 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 		{
 			GA.x(v) = 0.0;
 			GA.y(v) = 0.0;
-			if (DIMENSION_COUNT > 2)
+			if (threeD)
 				GA.z(v) = 0.0;
 		}
 		return;
@@ -122,23 +776,36 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 	if (head != 0) {
 		doPathLayout(GA, head);
 	} else {
-		Array<Array<double> > pivDistMatrix;
+		const int n = G.numberOfNodes();
+		// lower the number of pivots if necessary; the entries of the
+		// pivot matrix must be indexable
+		const int l = min(min(n, m_numberOfPivots), numeric_limits<int>::max() / n);
+		const int nThreads = max(1, min(m_maxThreads, n / minNodesPerThread));
+
+#ifdef OGDF_SSE2_EXTENSIONS
+		const bool useSSE2 = System::cpuSupports(cpufSSE2);
+#else
+		const bool useSSE2 = false;
+#endif
+
+		// column-major n times l matrix used to store the graph distances
+		Array<double> pivDistMatrix(n*l);
 		// compute the pivot matrix
-		getPivotDistanceMatrix(GA, pivDistMatrix);
+		getPivotDistanceMatrix(GA, pivDistMatrix, l, nThreads);
 		// center the pivot matrix
-		centerPivotmatrix(pivDistMatrix);
+		centerPivotmatrix(pivDistMatrix, n, l, nThreads);
 		// init the coordinate matrix
-		Array<Array<double> > coord(DIMENSION_COUNT);
+		Array<Array<double> > coord(threeD ? DIMENSION_COUNT : 2);
 		for (int i = 0; i < coord.size(); i++) {
-			coord[i].init(G.numberOfNodes());
+			coord[i].init(n);
 		}
 		// init the eigen values array
-		Array<double> eVals(DIMENSION_COUNT);
-		singularValueDecomposition(pivDistMatrix, coord, eVals);
+		Array<double> eVals(coord.size());
+		singularValueDecomposition(pivDistMatrix, n, l, coord, eVals, nThreads, useSSE2);
 		// compute the correct aspect ratio
 		for (int i = 0; i < coord.size(); i++) {
 			eVals[i] = sqrt(eVals[i]);
-			for (int j = 0; j < G.numberOfNodes(); j++) {
+			for (int j = 0; j < n; j++) {
 				coord[i][j] *= eVals[i];
 			}
 		}
@@ -149,8 +816,8 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 		{
 			GA.x(v) = coord[0][i];
 			GA.y(v) = coord[1][i];
-			if (DIMENSION_COUNT > 2){
-				GA.z(v) = coord[2][i];//cout << coord[2][i] << "\n";
+			if (threeD) {
+				GA.z(v) = coord[2][i];
 			}
 			++i;
 		}
@@ -160,6 +827,7 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 
 void PivotMDS::doPathLayout(GraphAttributes& GA, const node& v)
 {
+	const bool threeD = (GA.attributes() & GraphAttributes::threeD) != 0;
 	double xPos = 0;
 	node prev = v;
 	node cur = v;
@@ -170,6 +838,8 @@ void PivotMDS::doPathLayout(GraphAttributes& GA, const node& v)
 	do {
 		GA.x(cur) = xPos;
 		GA.y(cur) = 0;
+		if (threeD)
+			GA.z(cur) = 0;
 		node adj;
 		forall_adj_edges(e,cur) {
 			adj = e->opposite(cur);
@@ -190,16 +860,23 @@ void PivotMDS::doPathLayout(GraphAttributes& GA, const node& v)
 
 
 void PivotMDS::eigenValueDecomposition(
-	Array<Array<double> >& K,
+	const Array<double>& K,
+	int l,
 	Array<Array<double> >& eVecs,
-	Array<double>& eValues)
+	Array<double>& eValues,
+	bool useSSE2)
 {
 	randomize(eVecs);
-	const int p = K.size();
+	const int dim = eVecs.size();
 	double r = 0;
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	for (int i = 0; i < dim; i++) {
 		eValues[i] = normalize(eVecs[i]);
 	}
+	// prev values
+	Array<Array<double> > tmpOld(dim);
+	for (int i = 0; i < dim; i++) {
+		tmpOld[i].init(l);
+	}
 	while (r < EPSILON) {
 		if (isnan(r) || isinf(r)) {
 			// Throw arithmetic exception (Shouldn't occur
@@ -208,38 +885,34 @@ void PivotMDS::eigenValueDecomposition(
 			return;
 		}
 		// remember prev values
-		Array<Array<double> > tmpOld(DIMENSION_COUNT);
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
-			tmpOld[i].init(p);
-			for (int j = 0; j < p; j++) {
+		for (int i = 0; i < dim; i++) {
+			for (int j = 0; j < l; j++) {
 				tmpOld[i][j] = eVecs[i][j];
 				eVecs[i][j] = 0;
 			}
 		}
 		// multiply matrices
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
-			for (int j = 0; j < p; j++) {
-				for (int k = 0; k < p; k++) {
-					eVecs[i][k] += K[j][k] * tmpOld[i][j];
-				}
+		for (int i = 0; i < dim; i++) {
+			for (int j = 0; j < l; j++) {
+				axpy(tmpOld[i][j], &K[j*l], &eVecs[i][0], 0, l, useSSE2);
 			}
 		}
 		// orthogonalize
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
+		for (int i = 0; i < dim; i++) {
 			for (int j = 0; j < i; j++) {
 				double fac = prod(eVecs[j], eVecs[i])
 						/ prod(eVecs[j], eVecs[j]);
-				for (int k = 0; k < p; k++) {
+				for (int k = 0; k < l; k++) {
 					eVecs[i][k] -= fac * eVecs[j][k];
 				}
 			}
 		}
 		// normalize
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
+		for (int i = 0; i < dim; i++) {
 			eValues[i] = normalize(eVecs[i]);
 		}
 		r = 1;
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
+		for (int i = 0; i < dim; i++) {
 			// get absolute value (abs only defined for int)
 			double tmp = prod(eVecs[i], tmpOld[i]);
 			if (tmp < 0) {
@@ -253,64 +926,46 @@ void PivotMDS::eigenValueDecomposition(
 
 void PivotMDS::getPivotDistanceMatrix(
 	const GraphAttributes& GA,
-	Array<Array<double> >& pivDistMatrix)
+	Array<double>& C,
+	int l,
+	int nThreads)
 {
 	const Graph& G = GA.constGraph();
-	// lower the number of pivots if necessary
-	int numberOfPivots = min(G.numberOfNodes(), m_numberOfPivots);
-	// number of pivots times n matrix used to store the graph distances
-	pivDistMatrix.init(numberOfPivots);
-	for (int i = 0; i < numberOfPivots; i++) {
-		pivDistMatrix[i].init(G.numberOfNodes());
-	}
-	// edges costs array
-	EdgeArray<double> edgeCosts;
-	bool hasEdgeCosts = false;
-	// already checked whether this attribute exists or not (see call method)
-	if (m_hasEdgeCostsAttribute) {
-		edgeCosts.init(G);
-		edge e;
-		forall_edges(e, G)
-		{
-			edgeCosts[e] = GA.doubleWeight(e);
-		}
-		hasEdgeCosts = true;
-	}
-	// used for min-max strategy
-	NodeArray<double> minDistances(G, std::numeric_limits<double>::infinity());
-	NodeArray<double> shortestPathSingleSource(G);
-	// the current pivot node
-	node pivNode = G.firstNode();
-	for (int i = 0; i < numberOfPivots; i++) {
-		// get the shortest path from the currently processed pivot node to
-		// all other nodes in the graph
-		shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
-		if (hasEdgeCosts) {
-			dijkstra_SPSS(pivNode, G, shortestPathSingleSource, edgeCosts);
-		} else {
-			bfs_SPSS(pivNode, G, shortestPathSingleSource, m_edgeCosts);
-		}
-		copySPSS(pivDistMatrix[i], shortestPathSingleSource);
-		// update the pivot and the minDistances array ... to ensure the
-		// correctness set minDistance of the pivot node to zero
-		minDistances[pivNode] = 0;
-		node v;
-		forall_nodes(v,G)
+	const int n = G.numberOfNodes();
+
+	// compact adjacency lists of G
+	NodeArray<int> index(G);
+	node v;
+	int i = 0;
+	forall_nodes(v, G)
+		index[v] = i++;
+
+	Array<int> adjStart(n+1), adjTarget(max(1, 2*G.numberOfEdges()));
+	// edges costs array; already checked whether this attribute exists
+	// or not (see call method)
+	Array<double> adjLength;
+	if (m_hasEdgeCostsAttribute)
+		adjLength.init(max(1, 2*G.numberOfEdges()));
+
+	i = 0;
+	forall_nodes(v, G)
+	{
+		adjStart[index[v]] = i;
+		adjEntry adj;
+		forall_adj(adj, v)
 		{
-			minDistances[v] = min(minDistances[v], shortestPathSingleSource[v]);
-			if (minDistances[v] > minDistances[pivNode]) {
-				pivNode = v;
-			}
+			if (adj->theEdge()->isSelfLoop()) continue;
+			adjTarget[i] = index[adj->twinNode()];
+			if (m_hasEdgeCostsAttribute)
+				adjLength[i] = GA.doubleWeight(adj->theEdge());
+			++i;
 		}
 	}
-}
+	adjStart[n] = i;
 
-
-void PivotMDS::copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom)
-{
-	for (int i = 0; i < copyTo.size(); i++) {
-		copyTo[i] = copyFrom[i];
-	}
+	PivotSearch search(adjStart, adjTarget, m_hasEdgeCostsAttribute ? &adjLength : 0,
+		m_edgeCosts, C, l, nThreads);
+	search.run();
 }
 
 
@@ -388,54 +1043,53 @@ void PivotMDS::randomize(Array<Array<double> >& matrix)
 }
 
 
-void PivotMDS::selfProduct(const Array<Array<double> >& d, Array<Array<double> >& result)
+void PivotMDS::selfProduct(Array<double>& C, int n, int l, Array<double>& K, int nThreads, bool useSSE2)
 {
-	double sum;
-	for (int i = 0; i < d.size(); i++) {
-		for (int j = 0; j <= i; j++) {
-			sum = 0;
-			for (int k = 0; k < d[0].size(); k++) {
-				sum += d[i][k] * d[j][k];
-			}
-			result[i][j] = sum;
-			result[j][i] = sum;
+	MatrixOperation::Operands operands(C, n, l, useSSE2);
+	K.fill(0);
+	operands.m_K = &K;
+	MatrixOperation::execute(MatrixOperation::opSelfProduct, operands, nThreads);
+
+	// K is symmetric
+	for (int a = 0; a < l; a++) {
+		for (int b = 0; b < a; b++) {
+			K[b*l + a] = K[a*l + b];
 		}
 	}
 }
 
 
 void PivotMDS::singularValueDecomposition(
-	Array<Array<double> >& pivDistMatrix,
+	Array<double>& C,
+	int n,
+	int l,
 	Array<Array<double> >& eVecs,
-	Array<double>& eVals)
+	Array<double>& eVals,
+	int nThreads,
+	bool useSSE2)
 {
-	const int l = pivDistMatrix.size();
-	const int n = pivDistMatrix[0].size();
-	Array<Array<double> > K(l);
-	for (int i = 0; i < l; i++) {
-		K[i].init(l);
-	}
+	const int dim = eVecs.size();
+	Array<double> K(l*l);
 	// calc C^TC
-	selfProduct(pivDistMatrix, K);
+	selfProduct(C, n, l, K, nThreads, useSSE2);
 
-	Array<Array<double> > tmp(DIMENSION_COUNT);
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	Array<Array<double> > tmp(dim);
+	for (int i = 0; i < dim; i++) {
 		tmp[i].init(l);
 	}
 
-	eigenValueDecomposition(K, tmp, eVals);
+	eigenValueDecomposition(K, l, tmp, eVals, useSSE2);
 
 	// C^Tx
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	for (int i = 0; i < dim; i++) {
 		eVals[i] = sqrt(eVals[i]);
-		for (int j = 0; j < n; j++) { // node j
-			eVecs[i][j] = 0;
-			for (int k = 0; k < l; k++) { // pivot k
-				eVecs[i][j] += pivDistMatrix[k][j] * tmp[i][k];
-			}
-		}
 	}
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	MatrixOperation::Operands operands(C, n, l, useSSE2);
+	operands.m_x = &tmp;
+	operands.m_y = &eVecs;
+	MatrixOperation::execute(MatrixOperation::opProject, operands, nThreads);
+
+	for (int i = 0; i < dim; i++) {
 		normalize(eVecs[i]);
 	}
 }
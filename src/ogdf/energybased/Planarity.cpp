@@ -46,49 +46,63 @@ namespace ogdf {
 
 	Planarity::~Planarity()
 	{
-		delete m_edgeNums;
-		delete m_crossingMatrix;
+		delete m_grid;
 	}
 
 
-	// intializes number of edges and allocates memory for  crossingMatrix
+	// collects the edges that are not self loops and allocates the grid
 	Planarity::Planarity(GraphAttributes &AG):
 	EnergyFunction("Planarity",AG)
 	{
-		m_edgeNums = OGDF_NEW EdgeArray<int>(m_G,0);
 		m_G.allEdges(m_nonSelfLoops);
 		ListIterator<edge> it, itSucc;
 		for(it = m_nonSelfLoops.begin(); it.valid(); it = itSucc) {
 			itSucc = it.succ();
 			if((*it)->isSelfLoop()) m_nonSelfLoops.del(it);
 		}
-		int e_num = 1;
-		for(it = m_nonSelfLoops.begin(); it.valid(); ++it) (*m_edgeNums)[*it] = e_num ++;
-		e_num --;
-		m_crossingMatrix = new Array2D<bool> (1,e_num,1,e_num);
+
+		m_indexToEdge.init(0,max(0,m_G.maxEdgeIndex()),0);
+		double lengthSum = 0.0;
+		for(it = m_nonSelfLoops.begin(); it.valid(); ++it) {
+			edge e = *it;
+			m_indexToEdge[e->index()] = e;
+			lengthSum += currentPos(e->source()).distance(currentPos(e->target()));
+		}
+
+		// the cells should be about as large as an average edge
+		double cellSize = 1.0;
+		if(!m_nonSelfLoops.empty() && lengthSum > 0.0)
+			cellSize = lengthSum / m_nonSelfLoops.size();
+		m_grid = new SpatialGrid(m_G.maxEdgeIndex()+1, cellSize);
+	}
+
+
+	void Planarity::insertIntoGrid(const edge e)
+	{
+		DPoint p1 = currentPos(e->source());
+		DPoint p2 = currentPos(e->target());
+		m_grid->insertSegment(e->index(), p1.m_x, p1.m_y, p2.m_x, p2.m_y);
 	}
 
 
-	// computes energy of layout, stores it and sets the crossingMatrix
+	// computes energy of layout, stores it and fills the grid
 	void Planarity::computeEnergy()
 	{
-		int e_num = m_nonSelfLoops.size();
 		int energySum = 0;
-		Array<edge> numEdge(1,e_num);
-		edge e;
-		ListIterator<edge> it;
+		ListConstIterator<edge> it;
 
 		for(it = m_nonSelfLoops.begin(); it.valid(); ++it)
-			numEdge[(*m_edgeNums)[*it]] = *it;
-		for(int i = 1; i < e_num; i++) {
-			e = numEdge[i];
-			for(int j = i+1; j <= e_num ; j++) {
-				bool cross = intersect(e,numEdge[j]);
-				(*m_crossingMatrix)(i,j) = cross;
-				if(cross) energySum += 1;
-			}
+			if(m_grid->contains((*it)->index()))
+				m_grid->remove((*it)->index());
+		for(it = m_nonSelfLoops.begin(); it.valid(); ++it)
+			insertIntoGrid(*it);
+
+		// each crossing is counted twice
+		for(it = m_nonSelfLoops.begin(); it.valid(); ++it) {
+			edge e = *it;
+			energySum += countCrossings(e,currentPos(e->source()),currentPos(e->target()));
 		}
-		m_energy = energySum;
+		m_energy = energySum / 2;
 	}
 
 
@@ -107,6 +121,29 @@ namespace ogdf {
 	}
 
 
+	// counts the edges crossing e if e is drawn from p1 to p2
+	int Planarity::countCrossings(const edge e, const DPoint &p1, const DPoint &p2) const
+	{
+		node s = e->source();
+		node t = e->target();
+
+		m_near.clear();
+		m_grid->query(min(p1.m_x,p2.m_x), min(p1.m_y,p2.m_y),
+			max(p1.m_x,p2.m_x), max(p1.m_y,p2.m_y), m_near);
+
+		int crossings = 0;
+		for(int i = 0; i < m_near.size(); ++i) {
+			edge f = m_indexToEdge[m_near[i]];
+			node s2 = f->source();
+			node t2 = f->target();
+			if(s2 != s && s2 != t && t2 != s && t2 != t
+				&& lowLevelIntersect(p1,p2,currentPos(s2),currentPos(t2)))
+				++crossings;
+		}
+		return crossings;
+	}
+
+
 	// tests if two lines given by four points cross
 	bool Planarity::lowLevelIntersect(
 		const DPoint &e1s,
@@ -128,69 +165,38 @@ namespace ogdf {
 		node v = testNode();
 		m_candidateEnergy = energy();
 		edge e;
-		m_crossingChanges.clear();
 
+		// edges sharing v with e cannot cross e, hence each changed
+		// crossing is counted exactly once
 		forall_adj_edges(e,v) if(!e->isSelfLoop()) {
-			// first we compute the two endpoints of e if v is on its new position
-			node s = e->source();
-			node t = e->target();
-			DPoint p1 = testPos();
-			DPoint p2 = (s==v)? currentPos(t) : currentPos(s);
-			int e_num = (*m_edgeNums)[e];
-			edge f;
-			// now we compute the crossings of all other edges with e
-			ListIterator<edge> it;
-			for(it = m_nonSelfLoops.begin(); it.valid(); ++it) if(*it != e) {
-				f = *it;
-				node s2 = f->source();
-				node t2 = f->target();
-				if(s2 != s && s2 != t && t2 != s && t2 != t) {
-					bool cross = lowLevelIntersect(p1,p2,currentPos(s2),currentPos(t2));
-					int f_num = (*m_edgeNums)[f];
-					bool priorIntersect = (*m_crossingMatrix)(min(e_num,f_num),max(e_num,f_num));
-					if(priorIntersect != cross) {
-						if(priorIntersect) m_candidateEnergy --; // this intersection was saved
-						else m_candidateEnergy ++; // produced a new intersection
-						ChangedCrossing cc;
-						cc.edgeNum1 = min(e_num,f_num);
-						cc.edgeNum2 = max(e_num,f_num);
-						cc.cross = cross;
-						m_crossingChanges.pushBack(cc);
-					}
-				}
-			}
+			node w = e->opposite(v);
+			m_candidateEnergy -= countCrossings(e,currentPos(v),currentPos(w));
+			m_candidateEnergy += countCrossings(e,testPos(),currentPos(w));
 		}
 	}
 
 
-	// this functions sets the crossingMatrix according to candidateCrossings
+	// moves the edges incident to the test node to their new position in the grid
 	void Planarity::internalCandidateTaken() {
-		ListIterator<ChangedCrossing> it;
-		for(it = m_crossingChanges.begin(); it.valid(); ++ it) {
-			ChangedCrossing cc = *(it);
-			(*m_crossingMatrix)(cc.edgeNum1,cc.edgeNum2) = cc.cross;
+		node v = testNode();
+		edge e;
+		forall_adj_edges(e,v) if(!e->isSelfLoop()) {
+			m_grid->remove(e->index());
+			insertIntoGrid(e);
 		}
 	}
 
 
 #ifdef OGDF_DEBUG
 void Planarity::printInternalData() const {
-	cout << "\nCrossing Matrix:";
-	int e_num = m_nonSelfLoops.size();
-	for(int i = 1; i < e_num; i++) {
-		cout << "\n Edge " << i << " crosses: ";
-		for(int j = i+1; j <= e_num; j++)
-			if((*m_crossingMatrix)(i,j)) cout << j << " ";
-	}
-	cout << "\nChanged crossings:";
-	if(testNode() == NULL) cout << " None.";
-	else {
-		ListConstIterator<ChangedCrossing> it;
-		for(it = m_crossingChanges.begin(); it.valid(); ++it) {
-			ChangedCrossing cc = *(it);
-			cout << " (" << cc.edgeNum1 << "," << cc.edgeNum2 << ")" << cc.cross;
-		}
+	cout << "\nCrossings:";
+	ListConstIterator<edge> it;
+	for(it = m_nonSelfLoops.begin(); it.valid(); ++it) {
+		edge e = *it;
+		cout << "\n Edge " << e->index() << " crosses "
+			<< countCrossings(e,currentPos(e->source()),currentPos(e->target())) << " edges";
 	}
+	cout << "\nGrid cell size: " << m_grid->cellSize();
 }
 #endif
 
@@ -45,7 +45,11 @@
 
 namespace ogdf {
 
-	Repulsion::Repulsion(GraphAttributes &AG) : NodePairEnergy("Repulsion",AG) { }
+	// for larger distances, the energy of a pair is below 1e-4 and neglected
+	const double Repulsion::CUTOFF = 99.0;
+
+
+	Repulsion::Repulsion(GraphAttributes &AG) : NodePairEnergy("Repulsion",AG,CUTOFF) { }
 
 
 	double Repulsion::computeCoordEnergy(
@@ -63,6 +67,8 @@ namespace ogdf {
 			i2.move(p2);
 			double dist = i1.distance(i2);
 			OGDF_ASSERT(dist >= 0.0);
+			if(dist > CUTOFF)
+				return 0.0;
 			double div = (dist+1.0)*(dist+1.0);
 			energy = 1.0/div;
 		}
@@ -0,0 +1,656 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class RepulsiveForces.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/internal/energybased/RepulsiveForces.h>
+#include <ogdf/internal/energybased/SpatialGrid.h>
+#include "FMEFunc.h"
+#include "ComplexDouble.h"
+#include <algorithm>
+#include <string.h>
+
+
+namespace ogdf {
+
+
+// Points with fewer points are not worth building a quadtree.
+static const int minPointsForTree = 16;
+
+// Quadtree nodes with at most this many points are evaluated directly by rfBarnesHut.
+static const __uint32 barnesHutLeafSize = 8;
+
+
+//! Computes the position and size of a quadtree node.
+struct RepulsiveForcesCoordsFunctor
+{
+	LinearQuadtree &tree;
+
+	RepulsiveForcesCoordsFunctor(LinearQuadtree &t) : tree(t) { }
+
+	inline void operator()(LinearQuadtree::NodeID u) { tree.computeCoords(u); }
+};
+
+
+//! Sums up the coordinates of the points of a quadtree node (bottom-up).
+struct RepulsiveForcesSumFunctor
+{
+	const LinearQuadtree &tree;
+	const Array<double> &x, &y;
+	Array<double> &sumX, &sumY;
+
+	RepulsiveForcesSumFunctor(const LinearQuadtree &t, const Array<double> &px, const Array<double> &py,
+		Array<double> &sx, Array<double> &sy) : tree(t), x(px), y(py), sumX(sx), sumY(sy) { }
+
+	inline void operator()(LinearQuadtree::NodeID u)
+	{
+		double sx = 0.0, sy = 0.0;
+		if(tree.isLeaf(u)) {
+			const __uint32 first = tree.firstPoint(u);
+			for(__uint32 p = first; p < first + tree.numberOfPoints(u); ++p) {
+				__uint32 j = tree.refOfPoint(p);
+				sx += x[j];
+				sy += y[j];
+			}
+		} else {
+			for(__uint32 k = 0; k < tree.numberOfChilds(u); ++k) {
+				LinearQuadtree::NodeID c = tree.child(u,k);
+				sx += sumX[c];
+				sy += sumY[c];
+			}
+		}
+		sumX[u] = sx;
+		sumY[u] = sy;
+	}
+};
+
+
+// The multipole expansion of a node with center z_s represents the potential
+// a_0 log(z - z_s) + sum_k a_k / (z - z_s)^k of its points (with unit charges);
+// P2M and M2M of LinearQuadtreeExpansion compute it. A local expansion with
+// center z_r represents the potential of far away points as sum_l b_l (z - z_r)^l.
+// The force at z is the conjugate of the derivative of the potential.
+// Translations into local expansions follow Greengard and Rokhlin.
+
+//! Converts the multipole expansion of \a source into a local expansion at \a receiver and adds it.
+static void translateM2L(const LinearQuadtree &tree, LinearQuadtreeExpansion &exp,
+	LinearQuadtree::NodeID source, LinearQuadtree::NodeID receiver)
+{
+	using sse::ComplexDouble;
+
+	const __uint32 numCoeff = exp.numCoeff();
+	const double *sourceCoeff = exp.multiExp() + source*(numCoeff << 1);
+	double *receivCoeff = exp.localExp() + receiver*(numCoeff << 1);
+
+	// z0 = z_s - z_r
+	ComplexDouble z0(
+		(double)tree.nodeX(source) - (double)tree.nodeX(receiver),
+		(double)tree.nodeY(source) - (double)tree.nodeY(receiver));
+	ComplexDouble invZ0 = ComplexDouble(1.0, 0.0) / z0;
+
+	ComplexDouble a0(sourceCoeff);
+	ComplexDouble invZ0_l(invZ0);
+	for(__uint32 l = 1; l < numCoeff; ++l) {
+		// b_l = 1/z0^l (-a_0/l + sum_k (-1)^k binom(l+k-1,k-1) a_k / z0^k)
+		ComplexDouble sum = a0 * (-1.0 / (double)l);
+		ComplexDouble invZ0_k = -invZ0;
+		for(__uint32 k = 1; k < numCoeff; ++k) {
+			ComplexDouble a(sourceCoeff + (k << 1));
+			sum += a * invZ0_k * exp.binCoef.value(l+k-1, k-1);
+			invZ0_k *= -invZ0;
+		}
+		ComplexDouble b(receivCoeff + (l << 1));
+		b += sum * invZ0_l;
+		b.store(receivCoeff + (l << 1));
+		invZ0_l *= invZ0;
+	}
+}
+
+
+//! Adds the force at (\a x,\a y) due to the local expansion of \a node to (\a fx,\a fy).
+static void evaluateL2P(const LinearQuadtree &tree, const LinearQuadtreeExpansion &exp,
+	LinearQuadtree::NodeID node, double x, double y, double &fx, double &fy)
+{
+	using sse::ComplexDouble;
+
+	const __uint32 numCoeff = exp.numCoeff();
+	const double *coeff = exp.localExp() + node*(numCoeff << 1);
+
+	ComplexDouble delta(x - (double)tree.nodeX(node), y - (double)tree.nodeY(node));
+	ComplexDouble delta_k(1.0, 0.0);
+	ComplexDouble derivative;
+	for(__uint32 k = 1; k < numCoeff; ++k) {
+		ComplexDouble b(coeff + (k << 1));
+		derivative += b * delta_k * (double)k;
+		delta_k *= delta;
+	}
+
+	double res[2];
+	derivative.store_unaligned(res);
+	fx += res[0];
+	fy -= res[1];
+}
+
+
+//! Local-to-local translation for rfMultipole.
+/**
+ * Shifts the local expansion of a node to the center of a child, i.e.,
+ * b'_l = sum_{k >= l} b_k binom(k,l) (z_r - z_s)^(k-l).
+ */
+struct RepulsiveForcesL2LFunctor
+{
+	const LinearQuadtree &tree;
+	LinearQuadtreeExpansion &exp;
+
+	RepulsiveForcesL2LFunctor(const LinearQuadtree &t, LinearQuadtreeExpansion &e) : tree(t), exp(e) { }
+
+	inline void operator()(LinearQuadtree::NodeID source, LinearQuadtree::NodeID receiver)
+	{
+		const __uint32 numCoeff = exp.numCoeff();
+		const double *sourceCoeff = exp.localExp() + source*(numCoeff << 1);
+		double *receivCoeff = exp.localExp() + receiver*(numCoeff << 1);
+
+		sse::ComplexDouble delta(
+			(double)tree.nodeX(receiver) - (double)tree.nodeX(source),
+			(double)tree.nodeY(receiver) - (double)tree.nodeY(source));
+
+		for(__uint32 l = 0; l < numCoeff; ++l) {
+			sse::ComplexDouble b(receivCoeff + (l << 1));
+			sse::ComplexDouble delta_k(1.0, 0.0);
+			for(__uint32 k = l; k < numCoeff; ++k) {
+				sse::ComplexDouble a(sourceCoeff + (k << 1));
+				b += a * delta_k * exp.binCoef.value(k, l);
+				delta_k *= delta;
+			}
+			b.store(receivCoeff + (l << 1));
+		}
+	}
+
+	inline void operator()(LinearQuadtree::NodeID u)
+	{
+		tree.forall_children(pair_call(*this, u))(u);
+	}
+};
+
+
+//! Well-separated pair decomposition for rfMultipole.
+/**
+ * Follows the traversal of LinearQuadtree::forall_well_separated_pairs, but
+ * two nodes are only well-separated if their distance is at least twice the
+ * sum of their radii. The looser criterion of FastMultipoleEmbedder lets the
+ * expansions converge so slowly that the error does not decrease with the
+ * precision. Multipole-to-local translations are applied immediately, direct
+ * pairs and nodes are collected.
+ */
+struct RepulsiveForcesDecomposition
+{
+	const LinearQuadtree &tree;
+	LinearQuadtreeExpansion &exp;
+	ArrayBuffer<int> pairA, pairB; //!< The pairs of nodes whose points interact directly.
+	ArrayBuffer<int> self;         //!< The nodes whose points interact directly with each other.
+
+	RepulsiveForcesDecomposition(const LinearQuadtree &t, LinearQuadtreeExpansion &e) : tree(t), exp(e) { }
+
+	bool wellSeparated(LinearQuadtree::NodeID u, LinearQuadtree::NodeID v) const
+	{
+		double dx = tree.nodeX(u) - tree.nodeX(v);
+		double dy = tree.nodeY(u) - tree.nodeY(v);
+		// the radius of a node is its size divided by sqrt(2)
+		double r = tree.nodeSize(u) + tree.nodeSize(v);
+		return dx*dx + dy*dy > 2.0 * r*r;
+	}
+
+	void operator()(LinearQuadtree::NodeID u)
+	{
+		if(tree.isLeaf(u) || tree.numberOfPoints(u) <= WSPD_BOUND) {
+			if(tree.numberOfPoints(u) > 1)
+				self.push(u);
+			return;
+		}
+		const __uint32 numChilds = tree.numberOfChilds(u);
+		for(__uint32 i = 0; i < numChilds; ++i) {
+			(*this)(tree.child(u,i));
+			for(__uint32 j = i+1; j < numChilds; ++j)
+				(*this)(tree.child(u,i), tree.child(u,j));
+		}
+	}
+
+	void operator()(LinearQuadtree::NodeID u, LinearQuadtree::NodeID v)
+	{
+		const __uint32 numU = tree.numberOfPoints(u);
+		const __uint32 numV = tree.numberOfPoints(v);
+
+		if(wellSeparated(u,v) && (numU >= M2L_MIN_BOUND || numV >= M2L_MIN_BOUND)) {
+			translateM2L(tree, exp, u, v);
+			translateM2L(tree, exp, v, u);
+
+		} else if((numU <= WSPD_BRANCH_BOUND && numV <= WSPD_BRANCH_BOUND) || tree.isLeaf(u) || tree.isLeaf(v)) {
+			pairA.push(u);
+			pairB.push(v);
+
+		} else if(tree.level(u) >= tree.level(v)) {
+			for(__uint32 i = 0; i < tree.numberOfChilds(u); ++i)
+				(*this)(tree.child(u,i), v);
+		} else {
+			for(__uint32 i = 0; i < tree.numberOfChilds(v); ++i)
+				(*this)(u, tree.child(v,i));
+		}
+	}
+};
+
+
+RepulsiveForces::RepulsiveForces(Method m) :
+	m_method(m),
+	m_cutoff(1.0),
+	m_theta(0.5),
+	m_precision(4),
+	m_minDist(1e-3),
+	m_builtFor(rfExact),
+	m_n(0),
+	m_grid(0),
+	m_tree(0),
+	m_expansion(0),
+	m_treeX(0), m_treeY(0), m_treeSize(0)
+{ }
+
+
+RepulsiveForces::~RepulsiveForces()
+{
+	freeAll();
+}
+
+
+void RepulsiveForces::freeAll()
+{
+	delete m_grid;
+	delete m_expansion;
+	delete m_tree;
+	delete [] m_treeX;
+	delete [] m_treeY;
+	delete [] m_treeSize;
+
+	m_grid = 0;
+	m_expansion = 0;
+	m_tree = 0;
+	m_treeX = m_treeY = m_treeSize = 0;
+}
+
+
+void RepulsiveForces::init(const Array<double> &x, const Array<double> &y)
+{
+	OGDF_ASSERT(x.low() == 0 && y.low() == 0 && x.size() == y.size());
+
+	freeAll();
+
+	m_n = x.size();
+	m_x = x;
+	m_y = y;
+
+	m_builtFor = m_method;
+	if(m_builtFor != rfExact && m_builtFor != rfGrid && m_n < minPointsForTree)
+		m_builtFor = rfExact;
+
+	switch(m_builtFor) {
+	case rfGrid:
+		initGrid();
+		break;
+	case rfBarnesHut:
+		initTree();
+		break;
+	case rfMultipole:
+		initTree();
+		if(m_builtFor == rfMultipole)
+			initMultipole();
+		break;
+	default:
+		break;
+	}
+}
+
+
+void RepulsiveForces::initGrid()
+{
+	m_grid = new SpatialGrid(m_n, m_cutoff);
+	for(int i = 0; i < m_n; ++i)
+		m_grid->insert(i, m_x[i], m_y[i], m_x[i], m_y[i]);
+}
+
+
+void RepulsiveForces::initTree()
+{
+	double minX = m_x[0], maxX = m_x[0];
+	double minY = m_y[0], maxY = m_y[0];
+	int i;
+	for(i = 1; i < m_n; ++i) {
+		minX = min(minX, m_x[i]); maxX = max(maxX, m_x[i]);
+		minY = min(minY, m_y[i]); maxY = max(maxY, m_y[i]);
+	}
+
+	// all points coincide (the quadtree cannot be scaled) or the layout is broken
+	if(!(maxX - minX > 0.0 || maxY - minY > 0.0) || !(maxX - minX < 1e30 && maxY - minY < 1e30)) {
+		m_builtFor = rfExact;
+		return;
+	}
+
+	m_treeX    = new float[m_n];
+	m_treeY    = new float[m_n];
+	m_treeSize = new float[m_n];
+	for(i = 0; i < m_n; ++i) {
+		m_treeX[i] = (float)m_x[i];
+		m_treeY[i] = (float)m_y[i];
+		m_treeSize[i] = 1.0f; // unit charges
+	}
+
+	m_tree = new LinearQuadtree(m_n, m_treeX, m_treeY, m_treeSize);
+	LinearQuadtree &tree = *m_tree;
+	tree.init((float)minX, (float)minY, (float)maxX, (float)maxY);
+
+	// sort the points by Morton number and build the tree upon this order
+	const float translateX = -tree.minX();
+	const float translateY = -tree.minY();
+	const double scale = tree.scaleInv();
+	LinearQuadtree::LQPoint *points = tree.pointArray();
+	for(i = 0; i < m_n; ++i) {
+		__uint32 j = points[i].ref;
+		points[i].mortonNr = mortonNumber<__uint64, __uint32>(
+			(__uint32)((m_treeX[j] + translateX)*scale), (__uint32)((m_treeY[j] + translateY)*scale));
+	}
+	std::sort(points, points + m_n, LQPointComparer);
+
+	LinearQuadtreeBuilder builder(tree);
+	builder.prepareTree();
+	builder.build();
+
+	m_treePos.init(m_n);
+	for(i = 0; i < m_n; ++i) {
+		tree.updatePointPositionSize(i);
+		m_treePos[tree.refOfPoint(i)] = i;
+	}
+
+	tree.forall_tree_nodes(RepulsiveForcesCoordsFunctor(tree), tree.firstInnerNode(), tree.numberOfInnerNodes())();
+	tree.forall_tree_nodes(RepulsiveForcesCoordsFunctor(tree), tree.firstLeaf(), tree.numberOfLeaves())();
+
+	// parents are needed for walking up from a leaf
+	m_parent.init(0, tree.maxNumberOfNodes()-1, -1);
+	LinearQuadtree::NodeID u = tree.firstInnerNode();
+	for(__uint32 k = 0; k < tree.numberOfInnerNodes(); ++k) {
+		for(__uint32 l = 0; l < tree.numberOfChilds(u); ++l)
+			m_parent[tree.child(u,l)] = u;
+		u = tree.nextNode(u);
+	}
+
+	if(m_builtFor == rfBarnesHut) {
+		m_sumX.init(tree.maxNumberOfNodes());
+		m_sumY.init(tree.maxNumberOfNodes());
+		tree.bottom_up_traversal(RepulsiveForcesSumFunctor(tree, m_x, m_y, m_sumX, m_sumY))(tree.root());
+	}
+}
+
+
+void RepulsiveForces::initMultipole()
+{
+	LinearQuadtree &tree = *m_tree;
+
+	m_expansion = new LinearQuadtreeExpansion(m_precision, tree);
+	LinearQuadtreeExpansion &exp = *m_expansion;
+	const size_t numDoubles = exp.m_numExp*(exp.m_numCoeff << 1);
+	memset(exp.m_multiExp, 0, numDoubles*sizeof(double));
+	memset(exp.m_localExp, 0, numDoubles*sizeof(double));
+
+	// the multipole pass of FastMultipoleEmbedder with a stricter separation
+	// criterion; the direct pairs are only stored, since they are evaluated
+	// with the current positions
+	tree.bottom_up_traversal(
+		if_then_else(tree.is_leaf_condition(),
+			p2m_functor(tree, exp),
+			m2m_functor(tree, exp)
+		)
+	)(tree.root());
+
+	RepulsiveForcesDecomposition decomp(tree, exp);
+	decomp(tree.root());
+
+	tree.top_down_traversal(
+		if_then_else(tree.is_leaf_condition(),
+			do_nothing(),
+			RepulsiveForcesL2LFunctor(tree, exp)
+		)
+	)(tree.root());
+
+	// adjacency lists of the direct pairs
+	const int numNodes = tree.maxNumberOfNodes();
+	m_directBegin.init(0, numNodes, 0);
+	int k;
+	for(k = 0; k < decomp.pairA.size(); ++k) {
+		++m_directBegin[decomp.pairA[k]+1];
+		++m_directBegin[decomp.pairB[k]+1];
+	}
+	for(int u = 1; u <= numNodes; ++u)
+		m_directBegin[u] += m_directBegin[u-1];
+
+	m_direct.init(max(1, m_directBegin[numNodes]));
+	Array<int> pos(numNodes);
+	for(int u = 0; u < numNodes; ++u)
+		pos[u] = m_directBegin[u];
+	for(k = 0; k < decomp.pairA.size(); ++k) {
+		int a = decomp.pairA[k], b = decomp.pairB[k];
+		m_direct[pos[a]++] = b;
+		m_direct[pos[b]++] = a;
+	}
+
+	m_directSelf.init(0, numNodes-1, false);
+	for(k = 0; k < decomp.self.size(); ++k)
+		m_directSelf[decomp.self[k]] = true;
+}
+
+
+void RepulsiveForces::move(int i, double x, double y)
+{
+	const double dx = x - m_x[i];
+	const double dy = y - m_y[i];
+	m_x[i] = x;
+	m_y[i] = y;
+
+	switch(m_builtFor) {
+	case rfGrid:
+		m_grid->update(i, x, y, x, y);
+		break;
+
+	case rfBarnesHut:
+		// the point stays in its quadtree node, so only the sums change
+		for(int u = m_tree->pointLeaf(m_treePos[i]); u >= 0; u = m_parent[u]) {
+			m_sumX[u] += dx;
+			m_sumY[u] += dy;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+inline void RepulsiveForces::addDirect(int first, int last, int i, double x, double y, double &fx, double &fy) const
+{
+	const double minDistSq = m_minDist * m_minDist;
+	for(int p = first; p < last; ++p) {
+		int j = m_tree->refOfPoint(p);
+		if(j == i) continue;
+		double dx = x - m_x[j];
+		double dy = y - m_y[j];
+		double d = max(dx*dx + dy*dy, minDistSq);
+		fx += dx / d;
+		fy += dy / d;
+	}
+}
+
+
+void RepulsiveForces::force(int i, double &fx, double &fy) const
+{
+	OGDF_ASSERT(0 <= i && i < m_n);
+
+	fx = fy = 0.0;
+
+	switch(m_builtFor) {
+	case rfGrid:
+		forceGrid(i, fx, fy);
+		break;
+
+	case rfBarnesHut:
+		forceBarnesHut(i, fx, fy);
+		break;
+
+	case rfMultipole:
+		forceMultipole(i, fx, fy);
+		break;
+
+	default: {
+		const double minDistSq = m_minDist * m_minDist;
+		const double x = m_x[i], y = m_y[i];
+		for(int j = 0; j < m_n; ++j) {
+			if(j == i) continue;
+			double dx = x - m_x[j];
+			double dy = y - m_y[j];
+			double d = max(dx*dx + dy*dy, minDistSq);
+			fx += dx / d;
+			fy += dy / d;
+		}
+		}
+	}
+}
+
+
+void RepulsiveForces::forceGrid(int i, double &fx, double &fy) const
+{
+	const double minDistSq = m_minDist * m_minDist;
+	const double cutoffSq  = m_cutoff * m_cutoff;
+	const double x = m_x[i], y = m_y[i];
+
+	ArrayBuffer<int> near;
+	m_grid->query(x - m_cutoff, y - m_cutoff, x + m_cutoff, y + m_cutoff, near);
+
+	for(int k = 0; k < near.size(); ++k) {
+		int j = near[k];
+		if(j == i) continue;
+		double dx = x - m_x[j];
+		double dy = y - m_y[j];
+		double d = dx*dx + dy*dy;
+		if(d >= cutoffSq) continue;
+		d = max(d, minDistSq);
+		fx += dx / d;
+		fy += dy / d;
+	}
+}
+
+
+void RepulsiveForces::forceBarnesHut(int i, double &fx, double &fy) const
+{
+	const LinearQuadtree &tree = *m_tree;
+	const double minDistSq = m_minDist * m_minDist;
+	const double thetaSq   = m_theta * m_theta;
+	const double x = m_x[i], y = m_y[i];
+	const __uint32 pos = m_treePos[i];
+
+	// the depth of the tree is bounded by the number of bits of a coordinate
+	LinearQuadtree::NodeID stack[128];
+	int top = 0;
+	stack[top++] = tree.root();
+
+	while(top > 0) {
+		LinearQuadtree::NodeID u = stack[--top];
+		const __uint32 first = tree.firstPoint(u);
+		const __uint32 num   = tree.numberOfPoints(u);
+
+		if(pos < first || pos >= first + num) {
+			double dx = x - m_sumX[u] / num;
+			double dy = y - m_sumY[u] / num;
+			double d = dx*dx + dy*dy;
+			double s = tree.nodeSize(u);
+			if(s*s < thetaSq * d) {
+				d = max(d, minDistSq) / num;
+				fx += dx / d;
+				fy += dy / d;
+				continue;
+			}
+		}
+
+		if(tree.isLeaf(u) || num <= barnesHutLeafSize) {
+			addDirect(first, first + num, i, x, y, fx, fy);
+		} else {
+			for(__uint32 k = 0; k < tree.numberOfChilds(u); ++k) {
+				OGDF_ASSERT(top < 128);
+				stack[top++] = tree.child(u,k);
+			}
+		}
+	}
+}
+
+
+void RepulsiveForces::forceMultipole(int i, double &fx, double &fy) const
+{
+	const LinearQuadtree &tree = *m_tree;
+	const double x = m_x[i], y = m_y[i];
+	const __uint32 pos = m_treePos[i];
+
+	// far field: the local expansion of the leaf
+	LinearQuadtree::NodeID leaf = tree.pointLeaf(pos);
+	evaluateL2P(tree, *m_expansion, leaf, x, y, fx, fy);
+
+	// near field: all nodes paired directly with the leaf or one of its ancestors
+	for(int u = leaf; u >= 0; u = m_parent[u]) {
+		for(int k = m_directBegin[u]; k < m_directBegin[u+1]; ++k) {
+			int v = m_direct[k];
+			addDirect(tree.firstPoint(v), tree.firstPoint(v) + tree.numberOfPoints(v), i, x, y, fx, fy);
+		}
+		if(m_directSelf[u])
+			addDirect(tree.firstPoint(u), tree.firstPoint(u) + tree.numberOfPoints(u), i, x, y, fx, fy);
+	}
+}
+
+
+void RepulsiveForces::forces(Array<double> &fx, Array<double> &fy) const
+{
+	fx.init(m_n);
+	fy.init(m_n);
+	for(int i = 0; i < m_n; ++i)
+		force(i, fx[i], fy[i]);
+}
+
+
+} // end namespace ogdf
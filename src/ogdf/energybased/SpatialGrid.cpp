@@ -0,0 +1,275 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class SpatialGrid.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/internal/energybased/SpatialGrid.h>
+
+
+namespace ogdf {
+
+
+const int SpatialGrid::maxCell = 1 << 28;
+
+
+SpatialGrid::SpatialGrid(int numElements, double cellSize) :
+	m_cellSize(cellSize),
+	m_cells(ArrayBuffer<int>()),
+	m_x1(max(1,numElements)), m_y1(max(1,numElements)),
+	m_x2(max(1,numElements)), m_y2(max(1,numElements)),
+	m_contained(0,max(1,numElements)-1,false),
+	m_isSegment(0,max(1,numElements)-1,false),
+	m_segment(max(1,numElements)),
+	m_rows(max(1,numElements))
+{
+	OGDF_ASSERT(cellSize > 0.0);
+	OGDF_ASSERT(numElements <= (1 << 30)); // see cellEntry()
+}
+
+
+void SpatialGrid::insert(int i, double x1, double y1, double x2, double y2)
+{
+	OGDF_ASSERT(!m_contained[i]);
+	OGDF_ASSERT(x1 <= x2 && y1 <= y2);
+
+	m_x1[i] = cell(x1); m_y1[i] = cell(y1);
+	m_x2[i] = cell(x2); m_y2[i] = cell(y2);
+	m_contained[i] = true;
+	m_isSegment[i] = false;
+
+	for(int cx = m_x1[i]; cx <= m_x2[i]; ++cx)
+		for(int cy = m_y1[i]; cy <= m_y2[i]; ++cy)
+			m_cells(cx,cy).push(i);
+}
+
+
+void SpatialGrid::insertSegment(int i, double x1, double y1, double x2, double y2)
+{
+	OGDF_ASSERT(!m_contained[i]);
+
+	if(x2 < x1) {
+		swap(x1,x2);
+		swap(y1,y2);
+	}
+	Segment &s = m_segment[i];
+	s.m_x1 = x1; s.m_y1 = y1;
+	s.m_x2 = x2; s.m_y2 = y2;
+
+	m_x1[i] = cell(x1); m_y1[i] = cell(min(y1,y2));
+	m_x2[i] = cell(x2); m_y2[i] = cell(max(y1,y2));
+	m_contained[i] = true;
+	m_isSegment[i] = true;
+
+	ArrayBuffer<int> &rows = m_rows[i];
+	rows.clear();
+	for(int cx = m_x1[i]; cx <= m_x2[i]; ++cx) {
+		int cy1, cy2;
+		segmentCells(i, cx, cy1, cy2);
+		rows.push(cy1);
+		rows.push(cy2);
+		for(int cy = cy1; cy <= cy2; ++cy)
+			m_cells(cx,cy).push(cellEntry(i, cy == cy1));
+	}
+}
+
+
+void SpatialGrid::columnCells(int i, int cx, int &cy1, int &cy2) const
+{
+	if(!m_isSegment[i]) {
+		cy1 = m_y1[i];
+		cy2 = m_y2[i];
+	} else {
+		const int k = 2*(cx - m_x1[i]);
+		cy1 = m_rows[i][k];
+		cy2 = m_rows[i][k+1];
+	}
+}
+
+
+void SpatialGrid::segmentCells(int i, int cx, int &cy1, int &cy2) const
+{
+	if(fillsBox(i)) {
+		cy1 = m_y1[i];
+		cy2 = m_y2[i];
+		return;
+	}
+
+	// the y-range of the segment within the column; the column is enlarged slightly,
+	// since points on its boundaries may belong to either column due to rounding
+	const Segment &s = m_segment[i];
+	const double slope = (s.m_y2 - s.m_y1) / (s.m_x2 - s.m_x1);
+	double ya, yb;
+	if(cx == m_x1[i])
+		ya = s.m_y1;
+	else {
+		double xa = cx * m_cellSize;
+		xa -= 1e-9 * max(m_cellSize, fabs(xa));
+		ya = s.m_y1 + (xa - s.m_x1) * slope;
+	}
+	if(cx == m_x2[i])
+		yb = s.m_y2;
+	else {
+		double xb = (cx+1) * m_cellSize;
+		xb += 1e-9 * max(m_cellSize, fabs(xb));
+		yb = s.m_y1 + (xb - s.m_x1) * slope;
+	}
+
+	// enlarge the y-range as well and restrict it to the bounding box
+	double y1 = min(ya,yb), y2 = max(ya,yb);
+	y1 -= 1e-9 * max(m_cellSize, fabs(y1));
+	y2 += 1e-9 * max(m_cellSize, fabs(y2));
+	cy1 = max(m_y1[i], cell(y1));
+	cy2 = min(m_y2[i], cell(y2));
+}
+
+
+// the cells of a segment in a column form an interval, and the columns in which
+// it shares cells with a query range are consecutive
+bool SpatialGrid::firstSegmentColumn(int i, int cx, int cx1, int cy1, int cy2) const
+{
+	if(cx == max(cx1, m_x1[i]))
+		return true;
+
+	int lo, hi;
+	columnCells(i, cx-1, lo, hi);
+	return lo > cy2 || hi < cy1;
+}
+
+
+void SpatialGrid::remove(int i)
+{
+	OGDF_ASSERT(m_contained[i]);
+
+	for(int cx = m_x1[i]; cx <= m_x2[i]; ++cx) {
+		int cy1, cy2;
+		columnCells(i, cx, cy1, cy2);
+		for(int cy = cy1; cy <= cy2; ++cy) {
+			const int entry = cellEntry(i, cy == cy1);
+			ArrayBuffer<int> &c = m_cells(cx,cy);
+			for(int k = 0; k < c.size(); ++k) {
+				if(c[k] == entry) {
+					c[k] = c.top();
+					c.pop();
+					break;
+				}
+			}
+			if(c.empty())
+				m_cells.undefine(cx,cy);
+		}
+	}
+
+	m_contained[i] = false;
+}
+
+
+void SpatialGrid::update(int i, double x1, double y1, double x2, double y2)
+{
+	OGDF_ASSERT(m_contained[i] && !m_isSegment[i]);
+	OGDF_ASSERT(x1 <= x2 && y1 <= y2);
+
+	if(cell(x1) == m_x1[i] && cell(y1) == m_y1[i] && cell(x2) == m_x2[i] && cell(y2) == m_y2[i])
+		return;
+
+	remove(i);
+	insert(i, x1, y1, x2, y2);
+}
+
+
+void SpatialGrid::updateSegment(int i, double x1, double y1, double x2, double y2)
+{
+	OGDF_ASSERT(m_contained[i] && m_isSegment[i]);
+
+	if(x2 < x1) {
+		swap(x1,x2);
+		swap(y1,y2);
+	}
+	Segment &s = m_segment[i];
+	if(s.m_x1 == x1 && s.m_y1 == y1 && s.m_x2 == x2 && s.m_y2 == y2)
+		return;
+
+	// keep the element in its cells if it still crosses the same cells in each column
+	if(cell(x1) == m_x1[i] && cell(min(y1,y2)) == m_y1[i] && cell(x2) == m_x2[i] && cell(max(y1,y2)) == m_y2[i]) {
+		const Segment old = s;
+		s.m_x1 = x1; s.m_y1 = y1;
+		s.m_x2 = x2; s.m_y2 = y2;
+		bool sameCells = true;
+		for(int cx = m_x1[i]; sameCells && cx <= m_x2[i]; ++cx) {
+			int oldCy1, oldCy2, cy1, cy2;
+			columnCells(i, cx, oldCy1, oldCy2);
+			segmentCells(i, cx, cy1, cy2);
+			sameCells = (cy1 == oldCy1 && cy2 == oldCy2);
+		}
+		if(sameCells)
+			return;
+		s = old;
+	}
+
+	remove(i);
+	insertSegment(i, x1, y1, x2, y2);
+}
+
+
+void SpatialGrid::query(double x1, double y1, double x2, double y2, ArrayBuffer<int> &result) const
+{
+	const int cx1 = cell(x1), cx2 = cell(x2);
+	const int cy1 = cell(y1), cy2 = cell(y2);
+
+	for(int cx = cx1; cx <= cx2; ++cx) {
+		for(int cy = cy1; cy <= cy2; ++cy) {
+			// undefined cells yield the (empty) default value;
+			// report each element only in the first cell it shares with the query
+			const ArrayBuffer<int> &c = m_cells(cx,cy);
+			for(int k = 0; k < c.size(); ++k) {
+				int j = c[k];
+				if(j >= 0) {
+					if(cx == max(cx1, m_x1[j]) && cy == max(cy1, m_y1[j]))
+						result.push(j);
+				} else {
+					// the first cell of the segment in this column is its lowest one or the lowest row of the query
+					j = ~j;
+					if(((j & 1) || cy == cy1) && firstSegmentColumn(j >> 1, cx, cx1, cy1, cy2))
+						result.push(j >> 1);
+				}
+			}
+		}
+	}
+}
+
+
+} // end namespace ogdf
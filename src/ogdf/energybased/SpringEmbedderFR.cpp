@@ -70,6 +70,8 @@ SpringEmbedderFR::SpringEmbedderFR()
 
 	m_minDistCC = LayoutStandards::defaultCCSeparation();
 	m_pageRatio = 1.0;
+
+	m_repulsionMethod = RepulsiveForces::rfGrid;
 }
 
 
@@ -287,6 +289,36 @@ bool SpringEmbedderFR::initialize(GraphCopy &G, GraphCopyAttributes &AG)
 }
 
 
+void SpringEmbedderFR::allPairsRepulsion(
+	GraphCopy &G,
+	GraphCopyAttributes &AG,
+	NodeArray<double> &xdisp,
+	NodeArray<double> &ydisp)
+{
+	NodeArray<int> index(G);
+	Array<double> x(G.numberOfNodes()), y(G.numberOfNodes());
+
+	int i = 0;
+	node v;
+	forall_nodes(v,G) {
+		index[v] = i;
+		x[i] = AG.x(v);
+		y[i] = AG.y(v);
+		++i;
+	}
+
+	RepulsiveForces repulsion(m_repulsionMethod);
+	repulsion.init(x,y);
+
+	forall_nodes(v,G) {
+		double fx, fy;
+		repulsion.force(index[v], fx, fy);
+		xdisp[v] += m_kk * fx;
+		ydisp[v] += m_kk * fy;
+	}
+}
+
+
 #define FREPULSE(d) ((m_k2 > (d)) ? m_kk/(d) : 0)
 
 
@@ -301,7 +333,10 @@ void SpringEmbedderFR::mainStep(GraphCopy &G, GraphCopyAttributes &AG)
 	NodeArray<double> ydisp(G,0);
 
 	// repulsive forces
-	forall_nodes(v,G)
+	if(m_repulsionMethod != RepulsiveForces::rfGrid)
+		allPairsRepulsion(G, AG, xdisp, ydisp);
+
+	else forall_nodes(v,G)
 	{
 		double xv = AG.x(v);
 		double yv = AG.y(v);
@@ -41,7 +41,9 @@
  ***************************************************************/
 
 #include <ogdf/energybased/SpringEmbedderKK.h>
-#include <ogdf/basic/SList.h>
+#include <ogdf/basic/BinaryHeap2.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/internal/basic/intrinsics.h>
 
 #ifdef OGDF_DEBUG
 #include <ogdf/basic/simple_graph_alg.h>
@@ -53,17 +55,34 @@ const double SpringEmbedderKK::minVal = DBL_MIN;
 const double SpringEmbedderKK::desMinLength = 0.0001;
 const int SpringEmbedderKK::maxVal = numeric_limits<int>::max();
 
+
+SpringEmbedderKK::SpringEmbedderKK() : m_tolerance(0.001), m_ltolerance(0.0001), m_computeMaxIt(true),
+	m_K(5.0), m_desLength(0.0), m_distFactor(2.0), m_useLayout(true),
+	m_gItBaseVal(50), m_gItFactor(16), m_useSSE2(false)
+{
+	m_maxLocalIt = m_maxGlobalIt = maxVal;
+
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = System::numberOfProcessors();
+#endif
+}
+
+
 void SpringEmbedderKK::initialize(
 	GraphAttributes& GA,
-	NodeArray<dpair>& partialDer,
 	const EdgeArray<double>& eLength,
-	NodeArray< NodeArray<double> >& oLength,
-	NodeArray< NodeArray<double> >& sstrength,
+	Array<double>& x,
+	Array<double>& y,
+	Array<double,__int64>& dist,
 	double & maxDist,
+	double & L,
 	bool simpleBFS)
 {
 	node v;
 	const Graph &G = GA.constGraph();
+	const int n = G.numberOfNodes();
 	m_prevEnergy =  startVal;
 	m_prevLEnergy =  startVal;
 
@@ -72,35 +91,24 @@ void SpringEmbedderKK::initialize(
 	if (!m_useLayout)
 		shufflePositions(GA);
 
-	//the shortest path lengths
-	forall_nodes (v, G) oLength[v].init(G, DBL_MAX);
-
 	//-------------------------------------
 	//computes shortest path distances d_ij
 	//-------------------------------------
+	// the matrix has n^2 entries, which exceeds the range of int for n > 46340
+	dist.init(__int64(n)*n);
 	if (simpleBFS)
 	{
 		//we use simply BFS n times
-		//TODO experimentally compare speed, also with bintree dijkstra
-//#ifdef OGDF_DEBUG
-//		double timeUsed;
-//		usedTime(timeUsed);
-//#endif
-		maxDist = allpairsspBFS(G, oLength);
-
-//#ifdef OGDF_DEBUG
-//		timeUsed = usedTime(timeUsed);
-//		cout << "\n******APSP BFS runtime: \n";
-//#endif
+		maxDist = allpairssp(G, 0, dist);
 	}
 	else
 	{
 		EdgeArray<double> adaptedLength(G);
 		adaptLengths(G, GA, eLength, adaptedLength);
-		//we use simply the BFM n times or Floyd instead, leading to cubic runtime
-		//TODO experimentally compare speed, also with bintree dijkstra
-		maxDist = allpairssp(G, adaptedLength, oLength, DBL_MAX);
+		//we use Dijkstra n times
+		maxDist = allpairssp(G, &adaptedLength, dist);
 	}
+
 	//------------------------------------
 	//computes original spring length l_ij
 	//------------------------------------
@@ -109,7 +117,7 @@ void SpringEmbedderKK::initialize(
 	//nodes sizes may be non-uniform, we approximate the display size (grid)
 	//this part relies on the fact that node sizes are set != zero
 	//TODO check later if this is a good choice
-	double L = m_desLength; //desirable length
+	L = m_desLength; //desirable length
 	double Lzero; //Todo check with m_zeroLength
 	if (L < desMinLength)
 	{
@@ -149,60 +157,50 @@ void SpringEmbedderKK::initialize(
 //		cout << "Desirable edge length computed: "<<L<<"\n";
 //#endif
 	}//set L != 0
+
 	//--------------------------------------------------
-	// Having L we can compute the original lengths l_ij
-	// Computes spring strengths k_ij
+	// The original lengths l_ij = L * d_ij and the spring
+	// strengths k_ij = K / d_ij^2 are computed on the fly
+	// from the distance matrix. Pairs of nodes in different
+	// components (violating the precondition) are treated as
+	// being far apart.
 	//--------------------------------------------------
-	node w;
-	double dij;
-	forall_nodes(v, G)
-	{
-		sstrength[v].init(G);
-		forall_nodes(w, G)
-		{
-			dij = oLength[v][w];
-			if (dij == DBL_MAX)
-			{
-				sstrength[v][w] = minVal;
-			}
-			else
-			{
-				oLength[v][w] = L * dij;
-				if (v==w) sstrength[v][w] = 1.0;
-				else
-				sstrength[v][w] = m_K / (dij * dij);
-
-
-
-			}
-		}
+	for (__int64 i = 0; i < __int64(n)*n; ++i)
+		if (dist[i] == DBL_MAX)
+			dist[i] = maxDist + 1.0;
+
+	// the coordinates are stored in contiguous arrays
+	x.init(n);
+	y.init(n);
+	int i = 0;
+	forall_nodes(v, G) {
+		x[i] = GA.x(v);
+		y[i] = GA.y(v);
+		++i;
 	}
 }//initialize
 
 
-void SpringEmbedderKK::mainStep(GraphAttributes& GA,
-								NodeArray<dpair>& partialDer,
-								NodeArray< NodeArray<double> >& oLength,
-								NodeArray< NodeArray<double> >& sstrength,
-								const double maxDist)
+void SpringEmbedderKK::mainStep(Array<double>& x,
+								Array<double>& y,
+								const Array<double,__int64>& dist,
+								const double L)
 {
-	const Graph &G = GA.constGraph();
-	node v;
+	const int n = x.size();
+	int v;
 
-#ifdef OGDF_DEBUG
-	NodeArray<int> nodeCounts(G, 0);
-	int nodeCount = 0; //number of moved nodes
-#endif
 	// Now we compute delta_m, we search for the node with max value
 	double delta_m = 0.0f;
 	double delta_v;
-	node best_m = G.firstNode();
+	int best_m = 0;
 
 	// Compute the partial derivatives first
-	forall_nodes (v, G)
+	Array<double> parDerX(n), parDerY(n);
+	for (v = 0; v < n; ++v)
 	{
-		dpair parder = computeParDers(v, GA, sstrength, oLength);
-		partialDer[v] = parder;
+		dpair parder = computeParDers(v, x, y, dist, L);
+		parDerX[v] = parder.x1();
+		parDerY[v] = parder.x2();
 		//delta_m is sqrt of squares of partial derivatives
 		delta_v = sqrt(parder.x1()*parder.x1() + parder.x2()*parder.x2());
 
@@ -216,8 +214,8 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 	int globalItCount, localItCount;
 	if (m_computeMaxIt)
 	{
-		globalItCount = m_gItBaseVal+m_gItFactor*G.numberOfNodes();
-		localItCount = 2*G.numberOfNodes();
+		globalItCount = m_gItBaseVal+m_gItFactor*n;
+		localItCount = 2*n;
 	}
 	else
 	{
@@ -225,51 +223,27 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 		localItCount = m_maxLocalIt;
 	}
 
+	// The contribution of best_m to the partial derivatives of each
+	// vertex before and after moving best_m.
+	Array<double> oldPartialX(n), oldPartialY(n);
+	Array<double> newPartialX(n), newPartialY(n);
 
 	while (globalItCount-- > 0 && !finished(delta_m))
 	{
-#ifdef OGDF_DEBUG
-//		cout <<"G: "<<globalItCount <<"\n";
-//		cout <<"New iteration on "<<best_m->index()<<"\n";
-		nodeCount++;
-		nodeCounts[best_m]++;
-#endif
-		// The contribution best_m makes to the partial derivatives of
-		// each vertex.
-		NodeArray<dpair> p_partials(G);
-		forall_nodes(v, G)
-		{
-			p_partials[v] = computeParDer(v, best_m, GA, sstrength, oLength);
-		}
+		parDerContributions(best_m, n, &x[0], &y[0], &dist[__int64(best_m)*n], L,
+			&oldPartialX[0], &oldPartialY[0]);
 
 		localItCount = 0;
 		do {
-#ifdef OGDF_DEBUG
-//			cout <<"  New local iteration\n";
-//			cout <<"   L: "<<localItCount <<"\n";
-#endif
 			// Compute the 4 elements of the Jacobian
-			double dE_dx_dx = 0.0f, dE_dx_dy = 0.0f, dE_dy_dx = 0.0f, dE_dy_dy = 0.0f;
-			forall_nodes(v, G)
-			{
-				if (v != best_m) {
-					double x_diff = GA.x(best_m) - GA.x(v);
-					double y_diff = GA.y(best_m) - GA.y(v);
-					double dist = sqrt(x_diff * x_diff + y_diff * y_diff);
-					double dist3 = dist * dist * dist;
-					OGDF_ASSERT(dist3 != 0.0);
-					double k_mi = sstrength[best_m][v];
-					double l_mi = oLength[best_m][v];
-					dE_dx_dx += k_mi * (1 - (l_mi * y_diff * y_diff)/dist3);
-					dE_dx_dy += k_mi * l_mi * x_diff * y_diff / dist3;
-					dE_dy_dx += k_mi * l_mi * x_diff * y_diff / dist3;
-					dE_dy_dy += k_mi * (1 - (l_mi * x_diff * x_diff)/dist3);
-				}
-			}
+			double dE_dx_dx = 0.0, dE_dx_dy = 0.0, dE_dy_dy = 0.0;
+			addJacobian(best_m, 0, n, &x[0], &y[0], &dist[__int64(best_m)*n], L,
+				dE_dx_dx, dE_dx_dy, dE_dy_dy);
+			double dE_dy_dx = dE_dx_dy;
 
 			// Solve for delta_x and delta_y
-			double dE_dx = partialDer[best_m].x1();
-			double dE_dy = partialDer[best_m].x2();
+			double dE_dx = parDerX[best_m];
+			double dE_dy = parDerY[best_m];
 
 			double delta_x =
 				(dE_dx_dy * dE_dy - dE_dy_dy * dE_dx)
@@ -279,70 +253,71 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 				(dE_dx_dx * dE_dy - dE_dy_dx * dE_dx)
 				/ (dE_dy_dx * dE_dx_dy - dE_dx_dx * dE_dy_dy);
 
-
 			// Move p by (delta_x, delta_y)
-#ifdef OGDF_DEBUG
-			// cout <<"   x"<< delta_x<<"\n";
-			// cout <<"   y" <<delta_y<<"\n";
-#endif
-			GA.x(best_m) += delta_x;
-			GA.y(best_m) += delta_y;
+			x[best_m] += delta_x;
+			y[best_m] += delta_y;
 
 			// Recompute partial derivatives and delta_p
-			dpair deriv = computeParDers(best_m, GA, sstrength, oLength);
-			partialDer[best_m] = deriv;
+			dpair deriv = computeParDers(best_m, x, y, dist, L);
+			parDerX[best_m] = deriv.x1();
+			parDerY[best_m] = deriv.x2();
 
 			delta_m =
 				sqrt(deriv.x1()*deriv.x1() + deriv.x2()*deriv.x2());
 		} while (localItCount-- > 0 && !finishedNode(delta_m));
 
 		// Select new best_m by updating each partial derivative and delta
-		node old_p = best_m;
-		forall_nodes(v, G)
-		{
-			dpair old_deriv_p = p_partials[v];
-			dpair old_p_partial =
-				computeParDer(v, old_p, GA, sstrength, oLength);
-			dpair deriv = partialDer[v];
-
-			deriv.x1() += old_p_partial.x1() - old_deriv_p.x1();
-			deriv.x2() += old_p_partial.x2() - old_deriv_p.x2();
+		int old_p = best_m;
+		parDerContributions(old_p, n, &x[0], &y[0], &dist[__int64(old_p)*n], L,
+			&newPartialX[0], &newPartialY[0]);
 
-			partialDer[v] = deriv;
-			double delta = sqrt(deriv.x1()*deriv.x1() + deriv.x2()*deriv.x2());
+		for (v = 0; v < n; ++v)
+		{
+			double dx = parDerX[v] + newPartialX[v] - oldPartialX[v];
+			double dy = parDerY[v] + newPartialY[v] - oldPartialY[v];
+			parDerX[v] = dx;
+			parDerY[v] = dy;
 
+			double delta = sqrt(dx*dx + dy*dy);
 			if (delta > delta_m) {
 				best_m = v;
 				delta_m = delta;
 			}
 		}
 	}//while
-#ifdef OGDF_DEBUG
-//  cout << "NodeCount: "<<nodeCount<<"\n";
-//  forall_nodes(v, G)
-//  {
-//   	cout<<"Counts "<<v->index()<<": "<<nodeCounts[v]<<"\n";
-//  }
-#endif
 }//mainStep
 
 
 void SpringEmbedderKK::doCall(GraphAttributes& GA, const EdgeArray<double>& eLength, bool simpleBFS)
 {
 	const Graph& G = GA.constGraph();
-	NodeArray<dpair> partialDer(G); //stores the partial derivative per node
 	double maxDist; //maximum distance between nodes
-	NodeArray< NodeArray<double> > oLength(G);//first distance, then original length
-	NodeArray< NodeArray<double> > sstrength(G);//the spring strength
+	double L;       //desirable edge length
+	Array<double> x, y; //the node coordinates
+	Array<double,__int64> dist; //the graph theoretic distances
 
 	//only for debugging
 	OGDF_ASSERT(isConnected(G));
 
+#ifdef OGDF_SSE2_EXTENSIONS
+	m_useSSE2 = System::cpuSupports(cpufSSE2);
+#else
+	m_useSSE2 = false;
+#endif
+
 	//compute relevant values
-	initialize(GA, partialDer, eLength, oLength, sstrength, maxDist, simpleBFS);
+	initialize(GA, eLength, x, y, dist, maxDist, L, simpleBFS);
 
 	//main loop with node movement
-	mainStep(GA, partialDer, oLength, sstrength, maxDist);
+	mainStep(x, y, dist, L);
+
+	node v;
+	int i = 0;
+	forall_nodes(v, G) {
+		GA.x(v) = x[i];
+		GA.y(v) = y[i];
+		++i;
+	}
 
 	if (simpleBFS) scale(GA);
 }
@@ -397,182 +372,385 @@ void SpringEmbedderKK::shufflePositions(GraphAttributes& GA)
 }//shufflePositions
 
 
-
-// Compute contribution of vertex u to the first partial
-// derivatives (dE/dx_m, dE/dy_m) (for vertex m) (eq. 7 and 8 in paper)
-SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(
-	node m,
-	node u,
-	GraphAttributes& GA,
-	NodeArray< NodeArray<double> >& ss,
-	NodeArray< NodeArray<double> >& dist)
+//compute partial derivative for v
+SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(int v,
+	const Array<double>& x,
+	const Array<double>& y,
+	const Array<double,__int64>& dist,
+	double L) const
 {
+	const int n = x.size();
+	const double *row = &dist[__int64(v)*n];
+
 	dpair result(0.0, 0.0);
-	if (m != u)
-	{
-		double x_diff = GA.x(m) - GA.x(u);
-		double y_diff = GA.y(m) - GA.y(u);
-		double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
-		result.x1() = (ss[m][u]) * (x_diff - (dist[m][u])*x_diff/distance);
-		result.x2() = (ss[m][u]) * (y_diff - (dist[m][u])*y_diff/distance);
-	}
+	addParDers(v, 0, v, &x[0], &y[0], row, L, result.x1(), result.x2());
+	addParDers(v, v+1, n, &x[0], &y[0], row, L, result.x1(), result.x2());
 
 	return result;
 }
 
 
-//compute partial derivative for v
-SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v,
-	GraphAttributes& GA,
-	NodeArray< NodeArray<double> >& ss,
-	NodeArray< NodeArray<double> >& dist)
+// The following three functions implement the inner loops of the
+// optimization. They work on contiguous arrays; dist is the row
+// of the distance matrix belonging to node m (resp. u). If SSE2
+// is available, two nodes are processed at once.
+
+void SpringEmbedderKK::addParDers(int m, int begin, int end,
+	const double *x, const double *y, const double *dist, double L,
+	double &dx, double &dy) const
 {
-	node u;
-	dpair result(0.0, 0.0);
-	forall_nodes(u, GA.constGraph())
+	const double xm = x[m], ym = y[m];
+	int u = begin;
+
+#ifdef OGDF_SSE2_EXTENSIONS
+	if (m_useSSE2)
 	{
-		dpair deriv = computeParDer(v, u, GA, ss, dist);
-		result.x1() += deriv.x1();
-		result.x2() += deriv.x2();
+		__m128d mm_xm = _mm_set1_pd(xm);
+		__m128d mm_ym = _mm_set1_pd(ym);
+		__m128d mm_K  = _mm_set1_pd(m_K);
+		__m128d mm_L  = _mm_set1_pd(L);
+		__m128d mm_one = _mm_set1_pd(1.0);
+		__m128d mm_dx = _mm_setzero_pd();
+		__m128d mm_dy = _mm_setzero_pd();
+
+		for(; u+1 < end; u += 2)
+		{
+			__m128d mm_x_diff = _mm_sub_pd(mm_xm, _mm_loadu_pd(x+u));
+			__m128d mm_y_diff = _mm_sub_pd(mm_ym, _mm_loadu_pd(y+u));
+			__m128d mm_d      = _mm_loadu_pd(dist+u);
+
+			__m128d mm_distance = _mm_sqrt_pd(_mm_add_pd(
+				_mm_mul_pd(mm_x_diff, mm_x_diff), _mm_mul_pd(mm_y_diff, mm_y_diff)));
+
+			// k_mu * (1 - l_mu / |p_m - p_u|)
+			__m128d mm_f = _mm_mul_pd(
+				_mm_div_pd(mm_K, _mm_mul_pd(mm_d, mm_d)),
+				_mm_sub_pd(mm_one, _mm_div_pd(_mm_mul_pd(mm_L, mm_d), mm_distance)));
+
+			mm_dx = _mm_add_pd(mm_dx, _mm_mul_pd(mm_f, mm_x_diff));
+			mm_dy = _mm_add_pd(mm_dy, _mm_mul_pd(mm_f, mm_y_diff));
+		}
+
+		double sx[2], sy[2];
+		_mm_storeu_pd(sx, mm_dx);
+		_mm_storeu_pd(sy, mm_dy);
+		dx += sx[0] + sx[1];
+		dy += sy[0] + sy[1];
 	}
+#endif
 
-	return result;
+	for(; u < end; ++u)
+	{
+		double d = dist[u];
+		double x_diff = xm - x[u];
+		double y_diff = ym - y[u];
+		double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
+		double f = (m_K / (d * d)) * (1.0 - (L * d) / distance);
+		dx += f * x_diff;
+		dy += f * y_diff;
+	}
 }
 
 
-/**
- * Initialise the original estimates from nodes and edges.
- */
+void SpringEmbedderKK::addJacobian(int m, int begin, int end,
+	const double *x, const double *y, const double *dist, double L,
+	double &dxdx, double &dxdy, double &dydy) const
+{
+	const double xm = x[m], ym = y[m];
+
+	for(int u = begin; u < end; )
+	{
+		// skip m itself
+		int uEnd = (u <= m && m < end) ? m : end;
+
+#ifdef OGDF_SSE2_EXTENSIONS
+		if (m_useSSE2)
+		{
+			__m128d mm_xm = _mm_set1_pd(xm);
+			__m128d mm_ym = _mm_set1_pd(ym);
+			__m128d mm_K  = _mm_set1_pd(m_K);
+			__m128d mm_L  = _mm_set1_pd(L);
+			__m128d mm_dxdx = _mm_setzero_pd();
+			__m128d mm_dxdy = _mm_setzero_pd();
+			__m128d mm_dydy = _mm_setzero_pd();
+
+			for(; u+1 < uEnd; u += 2)
+			{
+				__m128d mm_x_diff = _mm_sub_pd(mm_xm, _mm_loadu_pd(x+u));
+				__m128d mm_y_diff = _mm_sub_pd(mm_ym, _mm_loadu_pd(y+u));
+				__m128d mm_d      = _mm_loadu_pd(dist+u);
+
+				__m128d mm_distance = _mm_sqrt_pd(_mm_add_pd(
+					_mm_mul_pd(mm_x_diff, mm_x_diff), _mm_mul_pd(mm_y_diff, mm_y_diff)));
+				__m128d mm_dist3 = _mm_mul_pd(mm_distance, _mm_mul_pd(mm_distance, mm_distance));
+
+				__m128d mm_k = _mm_div_pd(mm_K, _mm_mul_pd(mm_d, mm_d));
+				// k_mu * l_mu / |p_m - p_u|^3
+				__m128d mm_kl = _mm_div_pd(_mm_mul_pd(mm_k, _mm_mul_pd(mm_L, mm_d)), mm_dist3);
+
+				mm_dxdx = _mm_add_pd(mm_dxdx, _mm_sub_pd(mm_k,
+					_mm_mul_pd(mm_kl, _mm_mul_pd(mm_y_diff, mm_y_diff))));
+				mm_dxdy = _mm_add_pd(mm_dxdy,
+					_mm_mul_pd(mm_kl, _mm_mul_pd(mm_x_diff, mm_y_diff)));
+				mm_dydy = _mm_add_pd(mm_dydy, _mm_sub_pd(mm_k,
+					_mm_mul_pd(mm_kl, _mm_mul_pd(mm_x_diff, mm_x_diff))));
+			}
+
+			double s[2];
+			_mm_storeu_pd(s, mm_dxdx);
+			dxdx += s[0] + s[1];
+			_mm_storeu_pd(s, mm_dxdy);
+			dxdy += s[0] + s[1];
+			_mm_storeu_pd(s, mm_dydy);
+			dydy += s[0] + s[1];
+		}
+#endif
+
+		for(; u < uEnd; ++u)
+		{
+			double d = dist[u];
+			double x_diff = xm - x[u];
+			double y_diff = ym - y[u];
+			double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
+			double dist3 = distance * distance * distance;
+			OGDF_ASSERT(dist3 != 0.0);
+			double k_mi = m_K / (d * d);
+			double l_mi = L * d;
+			dxdx += k_mi * (1 - (l_mi * y_diff * y_diff)/dist3);
+			dxdy += k_mi * l_mi * x_diff * y_diff / dist3;
+			dydy += k_mi * (1 - (l_mi * x_diff * x_diff)/dist3);
+		}
+
+		if (u == m) ++u;
+	}
+}
+
 
-//we could speed this up by not using nested NodeArrays and
-//by not doing the fully symmetrical computation on undirected graphs
-//All Pairs Shortest Path Floyd, initializes the whole matrix
-//returns maximum distance. Does not detect negative cycles (lead to neg. values on diagonal)
-//threshold is the value for the distance of non-adjacent nodes, distance has to be
-//initialized with
-double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>& eLengths, NodeArray< NodeArray<double> >& distance,
-	const double threshold)
+void SpringEmbedderKK::parDerContributions(int u, int n,
+	const double *x, const double *y, const double *dist, double L,
+	double *cx, double *cy) const
 {
-	node v;
-	edge e;
-	double maxDist = -threshold;
+	// the distance matrix is symmetric, hence the row of u
+	// contains the distances d_vu for all v
+	const double xu = x[u], yu = y[u];
+	int v = 0;
 
-	forall_nodes(v, G)
+#ifdef OGDF_SSE2_EXTENSIONS
+	if (m_useSSE2)
 	{
-		distance[v][v] = 0.0f;
+		__m128d mm_xu = _mm_set1_pd(xu);
+		__m128d mm_yu = _mm_set1_pd(yu);
+		__m128d mm_K  = _mm_set1_pd(m_K);
+		__m128d mm_L  = _mm_set1_pd(L);
+		__m128d mm_one = _mm_set1_pd(1.0);
+
+		for(; v+1 < n; v += 2)
+		{
+			__m128d mm_x_diff = _mm_sub_pd(_mm_loadu_pd(x+v), mm_xu);
+			__m128d mm_y_diff = _mm_sub_pd(_mm_loadu_pd(y+v), mm_yu);
+			__m128d mm_d      = _mm_loadu_pd(dist+v);
+
+			__m128d mm_distance = _mm_sqrt_pd(_mm_add_pd(
+				_mm_mul_pd(mm_x_diff, mm_x_diff), _mm_mul_pd(mm_y_diff, mm_y_diff)));
+
+			__m128d mm_f = _mm_mul_pd(
+				_mm_div_pd(mm_K, _mm_mul_pd(mm_d, mm_d)),
+				_mm_sub_pd(mm_one, _mm_div_pd(_mm_mul_pd(mm_L, mm_d), mm_distance)));
+
+			_mm_storeu_pd(cx+v, _mm_mul_pd(mm_f, mm_x_diff));
+			_mm_storeu_pd(cy+v, _mm_mul_pd(mm_f, mm_y_diff));
+		}
 	}
+#endif
 
-	//TODO: Experimentally compare this against
-	// all nodes and incident edges (memory access) on huge graphs
-	forall_edges(e, G)
+	for(; v < n; ++v)
 	{
-		distance[e->source()][e->target()] = eLengths[e];
-		distance[e->target()][e->source()] = eLengths[e];
+		double d = dist[v];
+		double x_diff = x[v] - xu;
+		double y_diff = y[v] - yu;
+		double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
+		double f = (m_K / (d * d)) * (1.0 - (L * d) / distance);
+		cx[v] = f * x_diff;
+		cy[v] = f * y_diff;
 	}
 
-///**
-// * And run the main loop of the algorithm.
-// */
-	node u, w;
-	forall_nodes(v, G)
+	// u does not contribute to its own derivatives
+	cx[u] = cy[u] = 0.0;
+}
+
+
+//! Computes the rows of the distance matrix for a subset of the sources in a separate thread.
+class SpringEmbedderKK::ShortestPathWorker : public Thread
+{
+	const Array<int>    &m_adjStart;  //!< The adjacency list of node i is [m_adjStart[i], m_adjStart[i+1]).
+	const Array<int>    &m_adjTarget; //!< The adjacent nodes.
+	const Array<double> *m_adjLength; //!< The edge lengths, or 0 if BFS is used.
+
+	Array<double,__int64> &m_distance; //!< The flat distance matrix.
+
+	int m_first; //!< The first source handled by this thread.
+	int m_step;  //!< The increment for the next source handled by this thread.
+
+	double m_maxDist; //!< The maximum distance found by this thread.
+
+public:
+	ShortestPathWorker(
+		const Array<int> &adjStart,
+		const Array<int> &adjTarget,
+		const Array<double> *adjLength,
+		Array<double,__int64> &distance,
+		int first,
+		int step)
+		: m_adjStart(adjStart), m_adjTarget(adjTarget), m_adjLength(adjLength),
+		  m_distance(distance), m_first(first), m_step(step), m_maxDist(0.0) { }
+
+	//! Returns the maximum distance found by this thread.
+	double maxDist() const { return m_maxDist; }
+
+	//! Computes the rows \a m_first, \a m_first + \a m_step, ...
+	void run() {
+		const int n = m_adjStart.size() - 1;
+		if (m_adjLength == 0)
+			bfs(n);
+		else
+			dijkstra(n);
+	}
+
+protected:
+	virtual void doWork() { run(); }
+
+private:
+	void bfs(int n)
 	{
-		forall_nodes(u, G)
+		Array<int> queue(n);
+
+		for (int s = m_first; s < n; s += m_step)
 		{
-			forall_nodes(w, G)
+			double *row = &m_distance[__int64(s)*n];
+			for (int v = 0; v < n; ++v)
+				row[v] = DBL_MAX;
+			row[s] = 0.0;
+
+			int head = 0, tail = 0;
+			queue[tail++] = s;
+			while (head < tail)
 			{
-				if ((distance[u][v] < threshold) && (distance[v][w] < threshold))
+				int w = queue[head++];
+				double d = row[w] + 1.0;
+				for (int i = m_adjStart[w]; i < m_adjStart[w+1]; ++i)
 				{
-					distance[u][w] = min( distance[u][w], distance[u][v] + distance[v][w] );
-					//distance[w][u] = distance[u][w]; //is done anyway afterwards
+					int u = m_adjTarget[i];
+					if (row[u] == DBL_MAX)
+					{
+						row[u] = d;
+						queue[tail++] = u;
+					}
 				}
-				if (distance[u][w] < threshold)
-					maxDist = max(maxDist,distance[u][w]);
 			}
+
+			// the last node in the queue has maximum distance
+			m_maxDist = max(m_maxDist, row[queue[tail-1]]);
 		}
 	}
-	//debug output
-//#ifdef OGDF_DEBUG
-//	forall_nodes(v, G)
-//	{
-//		if (distance[v][v] < 0.0) cerr << "\n###Error in shortest path computation###\n\n";
-//	}
-//	cout << "Maxdist: "<<maxDist<<"\n";
-//	forall_nodes(u, G)
-//	{
-//	forall_nodes(w, G)
-//	{
-////		cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-//	}
-//	}
-//#endif
-	return maxDist;
-}//allpairssp
+
+	void dijkstra(int n)
+	{
+		BinaryHeap2<double,int> queue(n+1);
+		Array<int> qpos(n);
+
+		for (int s = m_first; s < n; s += m_step)
+		{
+			double *row = &m_distance[__int64(s)*n];
+			for (int v = 0; v < n; ++v)
+				row[v] = DBL_MAX;
+			row[s] = 0.0;
+
+			// nodes are inserted into the queue when they are reached for the first time
+			queue.insert(s, row[s], &qpos[s]);
+			while (!queue.empty())
+			{
+				int w = queue.extractMin();
+				m_maxDist = max(m_maxDist, row[w]);
+
+				for (int i = m_adjStart[w]; i < m_adjStart[w+1]; ++i)
+				{
+					int u = m_adjTarget[i];
+					double d = row[w] + (*m_adjLength)[i];
+					if (row[u] == DBL_MAX) {
+						row[u] = d;
+						queue.insert(u, d, &qpos[u]);
+					} else if (d < row[u]) {
+						queue.decreaseKey(qpos[u], (row[u] = d));
+					}
+				}
+			}
+		}
+	}
+};
 
 
-//the same without weights, i.e. all pairs shortest paths with BFS
-//Runs in time |V|²
-//for compatibility, distances are double
-double SpringEmbedderKK::allpairsspBFS(const Graph& G, NodeArray< NodeArray<double> >& distance)
+//All pairs shortest paths, initializes the whole (flat) matrix
+//distance, where distance[i*n+j] is the distance between the i-th and
+//the j-th node of G. Uses BFS if eLengths is 0 and Dijkstra's algorithm
+//otherwise, starting from each node once; the single source computations
+//are distributed among several threads.
+//Returns the maximum distance.
+double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>* eLengths,
+	Array<double,__int64>& distance)
 {
+	const int n = G.numberOfNodes();
+
+	// compact adjacency lists of G
+	NodeArray<int> index(G);
 	node v;
-	double maxDist = 0;
+	int i = 0;
+	forall_nodes(v, G)
+		index[v] = i++;
+
+	Array<int> adjStart(n+1), adjTarget(max(1, 2*G.numberOfEdges()));
+	Array<double> adjLength;
+	if (eLengths != 0)
+		adjLength.init(max(1, 2*G.numberOfEdges()));
 
+	i = 0;
 	forall_nodes(v, G)
 	{
-		distance[v][v] = 0.0f;
+		adjStart[index[v]] = i;
+		adjEntry adj;
+		forall_adj(adj, v)
+		{
+			if (adj->theEdge()->isSelfLoop()) continue;
+			adjTarget[i] = index[adj->twinNode()];
+			if (eLengths != 0)
+				adjLength[i] = (*eLengths)[adj->theEdge()];
+			++i;
+		}
 	}
+	adjStart[n] = i;
 
-	v = G.firstNode();
+	// start in each node once
+	const int nThreads = max(1, min(m_maxThreads, n / 64));
 
-	//start in each node once
-	while (v != 0)
-	{
-		//do a bfs
-		NodeArray<bool> mark(G, true);
-		SListPure<node> bfs;
-		bfs.pushBack(v);
-		mark[v] = false;
+	Array<ShortestPathWorker *> worker(nThreads);
+	for (int t = 0; t < nThreads; ++t)
+		worker[t] = new ShortestPathWorker(adjStart, adjTarget,
+			(eLengths != 0) ? &adjLength : 0, distance, t, nThreads);
 
-		while (!bfs.empty())
-		{
-			node w = bfs.popFrontRet();
-			edge e;
-			double d = distance[v][w]+1.0f;
-			forall_adj_edges(e,w)
-			{
-				node u = e->opposite(w);
-				if (mark[u])
-				{
-					mark[u] = false;
-					bfs.pushBack(u);
-					distance[v][u] = d;
-					maxDist = max(maxDist,d);
-				}
-			}
-		}//while
+	for (int t = 1; t < nThreads; ++t)
+		worker[t]->start();
+	worker[0]->run();
 
-		v = v->succ();
-	}//while
-	//check for negative cycles
-	forall_nodes(v, G)
-	{
-		if (distance[v][v] < 0.0) cerr << "\n###Error in shortest path computation###\n\n";
+	for (int t = 1; t < nThreads; ++t)
+		worker[t]->join();
+
+	double maxDist = 0.0;
+	for (int t = 0; t < nThreads; ++t) {
+		maxDist = max(maxDist, worker[t]->maxDist());
+		delete worker[t];
 	}
 
-//debug output
-//#ifdef OGDF_DEBUG
-//	node u, w;
-//	cout << "Maxdist: "<<maxDist<<"\n";
-//	forall_nodes(u, G)
-//	{
-//	forall_nodes(w, G)
-//	{
-////		cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-//	}
-//	}
-//#endif
 	return maxDist;
-}//allpairsspBFS
+}//allpairssp
 
 
 void SpringEmbedderKK::scale(GraphAttributes& GA)
@@ -41,58 +41,15 @@
  ***************************************************************/
 
 #include <ogdf/energybased/TutteLayout.h>
-
-
-#ifdef USE_COIN
-
 #include <ogdf/basic/Math.h>
 #include <ogdf/basic/GraphCopyAttributes.h>
 #include <ogdf/basic/extended_graph_alg.h>
+#include <ogdf/basic/SparseLinearSolver.h>
 
 
 namespace ogdf {
 
 
-// solves a system of linear equations with a linear solver for optimization problems.
-// I'm sorry but there is no Gauss-Algorithm (or some numerical stuff) in OGDF...
-bool TutteLayout::solveLP(
-	int cols,
-	const CoinPackedMatrix &Matrix,
-	const Array<double> &rightHandSide,
-	Array<double> &x)
-{
-	int i;
-
-	OsiSolverInterface *osi = CoinManager::createCorrectOsiSolverInterface();
-
-	// constructs a dummy optimization problem.
-	// The given system of equations is used as constraint.
-	osi->setObjSense(-1);                        // maximize...
-	Array<double> obj(0,cols-1,1);               // ...the sum of variables
-	Array<double> lowerBound(0,cols-1,-1*(osi->getInfinity()));
-	Array<double> upperBound(0,cols-1,osi->getInfinity());
-
-	// loads the problem to Coin-Osi
-	osi->loadProblem(Matrix, &lowerBound[0], &upperBound[0], &obj[0], &rightHandSide[0], &rightHandSide[0]);
-
-	// solves the linear program
-	osi->initialSolve();
-
-	// gets the solution and returns true if it is optimal
-	const double *sol = osi->getColSolution();
-	for(i=0; i<cols; i++) x[i] = sol[i];
-
-	if(osi->isProvenOptimal()) {
-		delete osi;
-		return true;
-	}
-	else {
-		delete osi;
-		return false;
-	}
-}
-
-
 TutteLayout::TutteLayout()
 {
 	m_bbox = DRect (0.0, 0.0, 250.0, 250.0);
@@ -318,54 +275,51 @@ bool TutteLayout::doCall(
 		forall_listiterators(node, it, otherNodes) ind[*it] = i++;
 
 		int n = otherNodes.size();           // #other nodes
-		Array<double> coord(n);              // coordinates (first x then y)
-		Array<double> rhs(n);                // right hand side
-		double oneOverD = 0.0;
-
-		CoinPackedMatrix A(false,0,0);       // equations
-		A.setDimensions(n,n);
-
-		// initialize non-zero entries in matrix A
-		forall_listiterators(node, it, otherNodes) {
-			oneOverD = (double)(1.0/((*it)->degree()));
-			forall_adj_edges(e,*it) {
-			// get second node of e
-			w = (*it == e->source()) ? e->target() : e->source();
-			if(!fixed[w]) {
-				A.modifyCoefficient(ind[*it],ind[w],oneOverD);
-			}
-		}
-		A.modifyCoefficient(ind[*it],ind[*it],-1);
-	}
 
-	// compute right hand side for x coordinates
+	// The barycenter conditions x_v = 1/deg(v) * sum_{w adjacent to v} x_w
+	// of the free nodes yield the system A x = b, where A is the Laplacian
+	// of G restricted to the free nodes (symmetric and positive definite if
+	// each connected component of free nodes is adjacent to a fixed node)
+	// and b contains the sums of the coordinates of fixed neighbors.
+	SparseMatrix A(n,n);                 // equations
+	Array<double> rhsX(n), rhsY(n);      // right hand sides
+
 	forall_listiterators(node, it, otherNodes) {
-		rhs[ind[*it]] = 0;
-		oneOverD = (double)(1.0/((*it)->degree()));
-		forall_adj_edges(e,*it) {
-			// get second node of e
-			w = (*it == e->source()) ? e->target() : e->source();
-			if(fixed[w]) rhs[ind[*it]] -= (oneOverD*AGC.x(w));
+		v = *it;
+		i = ind[v];
+		rhsX[i] = rhsY[i] = 0;
+
+		int deg = 0;
+		forall_adj_edges(e,v) {
+			// get second node of e; self-loops do not matter
+			w = e->opposite(v);
+			if(w == v) continue;
+
+			++deg;
+			if(fixed[w]) {
+				rhsX[i] += AGC.x(w);
+				rhsY[i] += AGC.y(w);
+			} else
+				A.addEntry(i,ind[w],-1);
 		}
+		// isolated free nodes are placed in the center
+		A.addEntry(i,i,max(deg,1));
 	}
+	A.finalize();
+
+	// if the iteration does not reach the required accuracy (e.g., within the
+	// maximal number of iterations), its approximate result is used anyway
+	SparseLinearSolver solver;
+	Array<double> coord;                 // coordinates
+	bool accurate = true;
 
 	// compute x coordinates
-	if(!(solveLP(n, A, rhs, coord))) return false;
+	accurate &= solver.solve(A, rhsX, coord);
 	forall_listiterators(node, it, otherNodes) AGC.x(*it) = coord[ind[*it]];
 
-	// compute right hand side for y coordinates
-	forall_listiterators(node, it, otherNodes) {
-		rhs[ind[*it]] = 0;
-		oneOverD = (double)(1.0/((*it)->degree()));
-		forall_adj_edges(e,*it) {
-			// get second node of e
-			w = (*it == e->source()) ? e->target() : e->source();
-			if(fixed[w]) rhs[ind[*it]] -= (oneOverD*AGC.y(w));
-		}
-	}
-
 	// compute y coordinates
-	if(!(solveLP(n, A, rhs, coord))) return false;
+	coord.init();
+	accurate &= solver.solve(A, rhsY, coord);
 	forall_listiterators(node, it, otherNodes) AGC.y(*it) = coord[ind[*it]];
 
 	// translate coordinates, such that the center lies in
@@ -382,8 +336,6 @@ bool TutteLayout::doCall(
 		AG.y(GC.original(v)) = AGC.y(v);
 	}
 
-	return true;
+	return accurate;
 }
 } // end namespace ogdf
-
-#endif
@@ -46,10 +46,47 @@ namespace ogdf {
 
 void BarycenterPlacer::placeOneLevel(MultilevelGraph &MLG)
 {
-	int level = MLG.getLevel();
-	while (MLG.getLevel() == level && MLG.getLastMerge() != 0)
-	{
-		placeOneNode(MLG);
+	placeLevel(MLG);
+}
+
+
+// places each node at the barycenter of its neighbors of the coarser level
+void BarycenterPlacer::placeNodes(MultilevelGraph &MLG, int begin, int end)
+{
+	for (int k = begin; k < end; k++) {
+		node merged = m_levelNodes[k];
+		double x = 0.0;
+		double y = 0.0;
+		double i = 0.0;
+		adjEntry adj;
+		forall_adj(adj, merged) {
+			node w = adj->twinNode();
+			if (m_levelIndex[w->index()] >= 0) {
+				continue;
+			}
+			if(m_weightedPositions) {
+				double weight = 1.0 / MLG.weight(adj->theEdge());
+				i = i + weight;
+				x += MLG.x(w) * weight;
+				y += MLG.y(w) * weight;
+			} else {
+				i = i + 1.f;
+				x += MLG.x(w);
+				y += MLG.y(w);
+			}
+		}
+
+		// no neighbor in the coarser level
+		if (i == 0.0) {
+			i = 1.0;
+			x = MLG.x(m_levelAnchor[k]);
+			y = MLG.y(m_levelAnchor[k]);
+		}
+		x = x / i;
+		y = y / i;
+
+		MLG.x(merged, x + ((m_randomOffset)?(float)m_levelRandom[2*k]:0.f));
+		MLG.y(merged, y + ((m_randomOffset)?(float)m_levelRandom[2*k+1]:0.f));
 	}
 }
 
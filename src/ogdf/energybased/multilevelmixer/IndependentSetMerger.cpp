@@ -42,11 +42,112 @@
 
 #include <ogdf/energybased/multilevelmixer/IndependentSetMerger.h>
 
+#include <ogdf/basic/ParallelRange.h>
+#include <algorithm>
+
 namespace ogdf {
 
+
+static const int minNodesPerThread = 10000;
+
+// selecting in rounds is stopped after this many rounds
+static const int maxSelectionRounds = 32;
+
+
 IndependentSetMerger::IndependentSetMerger()
 :m_base(2.f)
 {
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = max(1, System::numberOfProcessors());
+#endif
+}
+
+
+int IndependentSetMerger::runPhase(Phase phase)
+{
+	return parallelRange(m_key.size(), m_maxThreads, minNodesPerThread, *this, phase);
+}
+
+
+// finds the undecided nodes that come first among their undecided neighbors
+int IndependentSetMerger::findFirstNodes(int begin, int end)
+{
+	for (int v = begin; v < end; v++) {
+		bool first = (m_state[v] == undecided);
+		for (int i = m_adjBegin[v]; first && i < m_adjBegin[v+1]; i++) {
+			int w = m_adjTwin[i];
+			if (w != v && m_state[w] == undecided && before(w, v))
+				first = false;
+		}
+		m_first[v] = first;
+	}
+	return 0;
+}
+
+
+// selects the first nodes and covers their neighbors; returns the number of undecided nodes
+int IndependentSetMerger::selectFirstNodes(int begin, int end)
+{
+	int numUndecided = 0;
+	for (int v = begin; v < end; v++) {
+		if (m_state[v] != undecided)
+			continue;
+		if (m_first[v]) {
+			m_state[v] = selected;
+			continue;
+		}
+		for (int i = m_adjBegin[v]; i < m_adjBegin[v+1]; i++) {
+			if (m_first[m_adjTwin[i]]) {
+				m_state[v] = covered;
+				break;
+			}
+		}
+		if (m_state[v] == undecided)
+			numUndecided++;
+	}
+	return numUndecided;
+}
+
+
+//! A node together with its position in the selection order (used for sorting).
+struct IndependentSetOrder
+{
+	int key;
+	int v;
+
+	bool operator<(const IndependentSetOrder &other) const {
+		if (key != other.key) return key < other.key;
+		return v < other.v;
+	}
+};
+
+
+// greedily selects the remaining undecided nodes in selection order
+void IndependentSetMerger::selectSequential()
+{
+	std::vector<IndependentSetOrder> order;
+	for (int v = 0; v < m_key.size(); v++) {
+		if (m_state[v] == undecided) {
+			IndependentSetOrder entry;
+			entry.key = m_key[v];
+			entry.v = v;
+			order.push_back(entry);
+		}
+	}
+	std::sort(order.begin(), order.end());
+
+	for (std::vector<IndependentSetOrder>::iterator it = order.begin(); it != order.end(); it++) {
+		int v = it->v;
+		if (m_state[v] != undecided)
+			continue;
+		m_state[v] = selected;
+		for (int i = m_adjBegin[v]; i < m_adjBegin[v+1]; i++) {
+			if (m_adjTwin[i] != v)
+				m_state[m_adjTwin[i]] = covered;
+		}
+	}
 }
 
 
@@ -58,27 +159,49 @@ void IndependentSetMerger::buildAllLevels(MultilevelGraph &MLG)
 	std::vector< std::vector<node> > levelNodes;
 	Graph &G = MLG.getGraph();
 
-	// calc MIS
-	NodeArray<bool> nodeMarks(G, false);
-	std::vector<node> IScandidates;
+	// copy the graph to adjacency arrays
+	const int n = G.numberOfNodes();
+	NodeArray<int> index(G);
+	Array<node> nodes(max(n, 1));
+	int k = 0;
 	node v;
 	forall_nodes(v, G) {
-		IScandidates.push_back(v);
+		nodes[k] = v;
+		index[v] = k++;
+	}
+	m_adjBegin.init(n+1);
+	m_adjTwin.init(2*G.numberOfEdges());
+	m_adjBegin[0] = 0;
+	k = 0;
+	for (int i = 0; i < n; i++) {
+		adjEntry adj;
+		forall_adj(adj, nodes[i]) {
+			m_adjTwin[k++] = index[adj->twinNode()];
+		}
+		m_adjBegin[i+1] = k;
+	}
+
+	// calc MIS
+	m_key.init(n);
+	for (int i = 0; i < n; i++) {
+		m_key[i] = randomNumber(0, 1 << 30);
+	}
+	m_state.init(n);
+	m_state.fill(undecided);
+	m_first.init(n);
+	if (min(m_maxThreads, n / minNodesPerThread) > 1) {
+		int numUndecided = n;
+		for (int round = 0; round < maxSelectionRounds && numUndecided >= minNodesPerThread; round++) {
+			runPhase(&IndependentSetMerger::findFirstNodes);
+			numUndecided = runPhase(&IndependentSetMerger::selectFirstNodes);
+		}
 	}
+	selectSequential();
+
 	levelNodes.push_back(std::vector<node>());
-	while(!IScandidates.empty()) {
-		// select random node
-		int index = randomNumber(0, (int)IScandidates.size()-1);
-		node ISnode = IScandidates[index];
-		IScandidates[index] = IScandidates.back();
-		IScandidates.pop_back();
-
-		if(!nodeMarks[ISnode]) {
-			adjEntry adj;
-			forall_adj(adj, ISnode) {
-				nodeMarks[adj->twinNode()] = true;
-			}
-			levelNodes[0].push_back(ISnode);
+	for (int i = 0; i < n; i++) {
+		if (m_state[i] == selected) {
+			levelNodes[0].push_back(nodes[i]);
 		}
 	}
 
@@ -108,13 +231,17 @@ void IndependentSetMerger::buildAllLevels(MultilevelGraph &MLG)
 std::vector<node> IndependentSetMerger::prebuildLevel(const Graph &G, const std::vector<node> &oldLevel, int level)
 {
 	std::vector<node> levelNodes;
-	std::vector<node> oldLevelNodes;
-	std::map<node, int> marks;
+	std::vector<node> oldLevelNodes(oldLevel);
+	NodeArray<int> marks(G, 0);
 	for (std::vector<node>::const_iterator i = oldLevel.begin(); i != oldLevel.end(); i++) {
 		marks[*i] = 1;
-		oldLevelNodes.push_back(*i);
 	}
 
+	// seen[v] is the number of the last BFS that visited v
+	NodeArray<int> seen(G, 0);
+	int bfsNumber = 0;
+	const double maxDepth = pow(m_base, level);
+
 	while (!oldLevelNodes.empty()) {
 		int index = randomNumber(0, (int)oldLevelNodes.size()-1);
 		node oldNode = oldLevelNodes[index];
@@ -122,7 +249,7 @@ std::vector<node> IndependentSetMerger::prebuildLevel(const Graph &G, const std:
 		oldLevelNodes.pop_back();
 
 		if (marks[oldNode] == 1) {
-			NodeArray<bool> seen(G, false);
+			bfsNumber++;
 			std::vector<node> stacks[2];
 			int one = 1;
 			int two = 0;
@@ -134,11 +261,11 @@ std::vector<node> IndependentSetMerger::prebuildLevel(const Graph &G, const std:
 				node bfsNode = stacks[one].back();
 				stacks[one].pop_back();
 
-				if (!seen[bfsNode]) {
+				if (seen[bfsNode] != bfsNumber) {
 					if (marks[bfsNode] == 1) {
 						marks[bfsNode] = 2;
 					}
-					seen[bfsNode] = true;
+					seen[bfsNode] = bfsNumber;
 					adjEntry adj;
 					forall_adj(adj, bfsNode) {
 						stacks[two].push_back(adj->twinNode());
@@ -149,7 +276,7 @@ std::vector<node> IndependentSetMerger::prebuildLevel(const Graph &G, const std:
 					int temp = one;
 					one = two;
 					two = temp;
-					if (depth > pow(m_base, level)) {
+					if (depth > maxDepth) {
 						break;
 					}
 				}
@@ -161,6 +288,21 @@ std::vector<node> IndependentSetMerger::prebuildLevel(const Graph &G, const std:
 }
 
 
+//! A merge into a root of the BFS forest (used for grouping the merges by root).
+struct IndependentSetMerge
+{
+	int rootIndex;
+	int position;
+	node mergeNode;
+	node root;
+
+	bool operator<(const IndependentSetMerge &other) const {
+		if (rootIndex != other.rootIndex) return rootIndex < other.rootIndex;
+		return position < other.position;
+	}
+};
+
+
 bool IndependentSetMerger::buildOneLevel(MultilevelGraph &MLG, std::vector<node> &levelNodes)
 {
 	Graph &G = MLG.getGraph();
@@ -172,12 +314,7 @@ bool IndependentSetMerger::buildOneLevel(MultilevelGraph &MLG, std::vector<node>
 		return false;
 	}
 
-	std::map<node, node> parents;
-	node v;
-	forall_nodes(v, G) {
-		parents[v] = 0;
-	}
-
+	NodeArray<node> parents(G, 0);
 	std::vector<node> mergeOrder;
 	NodeArray<bool> seen(G, false);
 	std::vector<node> stacks[2];
@@ -211,24 +348,26 @@ bool IndependentSetMerger::buildOneLevel(MultilevelGraph &MLG, std::vector<node>
 		}
 	}
 
-	for (std::vector<node>::iterator i = mergeOrder.begin(); i != mergeOrder.end(); i++) {
-		node mergeNode = *i;
+	// every node is merged into the root of its BFS tree, grouped by root
+	std::vector<IndependentSetMerge> rootMerges(mergeOrder.size());
+	for (unsigned int i = 0; i < mergeOrder.size(); i++) {
+		node mergeNode = mergeOrder[i];
 		node parent = mergeNode;
 		while(parents[parent] != parent) {
 			parent = parents[parent];
 		}
-
-		NodeMerge * NM = new NodeMerge(level);
-		bool ret = MLG.changeNode(NM, parent, MLG.radius(parent), mergeNode);
-		OGDF_ASSERT( ret );
-		MLG.moveEdgesToParent(NM, mergeNode, parent, true, m_adjustEdgeLengths);
-		ret = MLG.postMerge(NM, mergeNode);
-		if( !ret ) {
-			delete NM;
-		}
+		rootMerges[i].rootIndex = parent->index();
+		rootMerges[i].position = i;
+		rootMerges[i].mergeNode = mergeNode;
+		rootMerges[i].root = parent;
 	}
+	std::sort(rootMerges.begin(), rootMerges.end());
 
-	return true;
+	std::vector< std::pair<node, node> > merges(rootMerges.size());
+	for (unsigned int i = 0; i < rootMerges.size(); i++) {
+		merges[i] = std::pair<node, node>(rootMerges[i].mergeNode, rootMerges[i].root);
+	}
+	return MLG.mergeLevel(level, merges, true, m_adjustEdgeLengths) > 0;
 }
 
 void IndependentSetMerger::setSearchDepthBase( float base )
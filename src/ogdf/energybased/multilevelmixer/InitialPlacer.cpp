@@ -0,0 +1,112 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of InitialPlacer::placeLevel(), which places
+ *        the nodes of a level in parallel.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include <ogdf/energybased/multilevelmixer/InitialPlacer.h>
+#include <ogdf/basic/ParallelRange.h>
+
+namespace ogdf {
+
+
+//! Places a range of the reinserted nodes (called by parallelRange()).
+class InitialPlacer::RangePlacer
+{
+	InitialPlacer &m_placer;
+	MultilevelGraph &m_MLG;
+
+public:
+	RangePlacer(InitialPlacer &placer, MultilevelGraph &MLG) : m_placer(placer), m_MLG(MLG) { }
+
+	int operator()(int begin, int end) const {
+		m_placer.placeNodes(m_MLG, begin, end);
+		return end - begin;
+	}
+};
+
+
+static const int minNodesPerThread = 10000;
+
+
+InitialPlacer::InitialPlacer()
+:m_randomOffset(true)
+{
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = max(1, System::numberOfProcessors());
+#endif
+}
+
+
+void InitialPlacer::placeLevel(MultilevelGraph &MLG, bool keepPositions)
+{
+	m_levelNodes.clear();
+	m_levelAnchor.clear();
+	m_levelPositions.clear();
+	m_levelRandom.clear();
+	m_levelIndex.assign(MLG.getGraph().maxNodeIndex()+1, -1);
+
+	// undo all merges of the level (the random numbers are drawn in this order as well)
+	int level = MLG.getLevel();
+	while (MLG.getLevel() == level && MLG.getLastMerge() != 0)
+	{
+		NodeMerge *NM = MLG.getLastMerge();
+		OGDF_ASSERT(!NM->m_changedNodes.empty());
+		int parent = NM->m_changedNodes.front();
+		if (keepPositions) {
+			m_levelPositions.push_back(NM->m_position);
+		}
+
+		node merged = MLG.undoLastMerge();
+		if ((int)m_levelIndex.size() <= merged->index()) {
+			m_levelIndex.resize(merged->index()+1, -1);
+		}
+		m_levelIndex[merged->index()] = (int)m_levelNodes.size();
+		m_levelNodes.push_back(merged);
+		// the parent has been reinserted before if it was merged in this level as well
+		m_levelAnchor.push_back(placedNode(MLG.getNode(parent)));
+		m_levelRandom.push_back(randomDouble(-1.0, 1.0));
+		m_levelRandom.push_back(randomDouble(-1.0, 1.0));
+	}
+
+	parallelRange((int)m_levelNodes.size(), m_maxThreads, minNodesPerThread, RangePlacer(*this, MLG));
+}
+
+} // namespace ogdf
@@ -42,13 +42,116 @@
 
 #include <ogdf/energybased/multilevelmixer/MatchingMerger.h>
 
+#include <ogdf/basic/ParallelRange.h>
+#include <algorithm>
+
 namespace ogdf {
 
+
+static const int minNodesPerThread = 10000;
+
+// matching in rounds is stopped after this many rounds
+static const int maxMatchingRounds = 32;
+
+
 MatchingMerger::MatchingMerger()
 :m_selectByMass(false)
 {
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = max(1, System::numberOfProcessors());
+#endif
 }
 
+
+int MatchingMerger::runPhase(Phase phase)
+{
+	return parallelRange(m_node.size(), m_maxThreads, minNodesPerThread, *this, phase);
+}
+
+
+// every free node selects its first edge to a free neighbor
+int MatchingMerger::selectCandidates(int begin, int end)
+{
+	int numCandidates = 0;
+	for (int v = begin; v < end; v++) {
+		int cand = -1;
+		if (m_mate[v] < 0) {
+			for (int i = m_adjBegin[v]; i < m_adjBegin[v+1]; i++) {
+				if (m_mate[m_adjTwin[i]] < 0 && (cand < 0 || before(m_adjEdge[i], m_adjEdge[cand])))
+					cand = i;
+			}
+			if (cand >= 0)
+				numCandidates++;
+		}
+		m_candidate[v] = cand;
+	}
+	return numCandidates;
+}
+
+
+// an edge is matched if it has been selected by both end nodes
+int MatchingMerger::matchCandidates(int begin, int end)
+{
+	int numMatched = 0;
+	for (int v = begin; v < end; v++) {
+		int cand = m_candidate[v];
+		if (cand < 0)
+			continue;
+		int w = m_adjTwin[cand];
+		if (m_candidate[w] >= 0 && m_adjEdge[m_candidate[w]] == m_adjEdge[cand]) {
+			m_mate[v] = m_adjEdge[cand];
+			numMatched++;
+		}
+	}
+	return numMatched;
+}
+
+
+//! An edge together with its position in the matching order (used for sorting).
+struct MatchingEdgeOrder
+{
+	int rank;
+	unsigned int mass;
+	int key;
+	int e;
+
+	bool operator<(const MatchingEdgeOrder &other) const {
+		if (rank != other.rank) return rank < other.rank;
+		if (mass != other.mass) return mass < other.mass;
+		if (key != other.key) return key < other.key;
+		return e < other.e;
+	}
+};
+
+
+// greedily matches the remaining free edges in matching order
+void MatchingMerger::matchSequential()
+{
+	std::vector<MatchingEdgeOrder> freeEdges;
+	for (int e = 0; e < m_edge.size(); e++) {
+		if (m_mate[m_edgeEnd[2*e]] < 0 && m_mate[m_edgeEnd[2*e+1]] < 0) {
+			MatchingEdgeOrder order;
+			order.rank = m_edgeRank[e];
+			order.mass = m_selectByMass ? m_edgeMass[e] : 0;
+			order.key = m_edgeKey[e];
+			order.e = e;
+			freeEdges.push_back(order);
+		}
+	}
+	std::sort(freeEdges.begin(), freeEdges.end());
+
+	for (std::vector<MatchingEdgeOrder>::iterator it = freeEdges.begin(); it != freeEdges.end(); it++) {
+		int v = m_edgeEnd[2*it->e];
+		int w = m_edgeEnd[2*it->e+1];
+		if (m_mate[v] < 0 && m_mate[w] < 0) {
+			m_mate[v] = m_mate[w] = it->e;
+		}
+	}
+}
+
+
 bool MatchingMerger::buildOneLevel(MultilevelGraph &MLG)
 {
 	Graph &G = MLG.getGraph();
@@ -64,81 +167,121 @@ bool MatchingMerger::buildOneLevel(MultilevelGraph &MLG)
 		return false;
 	}
 
-	NodeArray<bool> nodeMarks(G, false);
-	std::vector<edge> matching;
-	std::vector<node> candidates;
-
+	// copy the graph to adjacency arrays, self-loops are left out
+	NodeArray<int> index(G);
+	m_node.init(numNodes);
+	int n = 0;
 	node v;
 	forall_nodes(v, G) {
-		candidates.push_back(v);
+		m_node[n] = v;
+		index[v] = n++;
 	}
 
-	while (!candidates.empty())
-	{
-		int rndIndex = randomNumber(0, (int)candidates.size()-1);
-		node one = candidates[rndIndex];
-		candidates[rndIndex] = candidates.back();
-		candidates.pop_back();
+	// nodes are visited in random order (given by a random permutation)
+	NodeArray<int> rank(G);
+	Array<int> perm(numNodes);
+	for (int i = 0; i < numNodes; i++) {
+		int j = randomNumber(0, i);
+		perm[i] = perm[j];
+		perm[j] = i;
+	}
+	for (int i = 0; i < numNodes; i++) {
+		rank[m_node[i]] = perm[i];
+	}
 
-		if (nodeMarks[one]) {
+	m_edge.init(G.numberOfEdges());
+	m_edgeRank.init(G.numberOfEdges());
+	m_edgeKey.init(G.numberOfEdges());
+	if (m_selectByMass) {
+		m_edgeMass.init(G.numberOfEdges());
+	}
+	m_adjBegin.init(numNodes+1);
+	m_adjBegin.fill(0);
+	int m = 0;
+	edge e;
+	forall_edges(e, G) {
+		if (e->isSelfLoop()) {
 			continue;
 		}
-		nodeMarks[one] = true;
-
-		std::vector<node> candNeighbors;
-		std::vector<edge> candEdges;
-		adjEntry adj;
-		unsigned int minMass = numeric_limits<unsigned int>::max();
-		forall_adj(adj, one) {
-			node cand = adj->twinNode();
-			if (!nodeMarks[cand] && (!m_selectByMass || m_mass[cand] <= minMass))
-			{
-				if (m_selectByMass && m_mass[cand] < minMass) {
-					minMass = m_mass[cand];
-					candNeighbors.clear();
-					candEdges.clear();
-				}
-				candNeighbors.push_back(cand);
-				candEdges.push_back(adj->theEdge());
-			}
+		// the edge is considered when its first end node is visited
+		node first = e->source(), second = e->target();
+		if (rank[second] < rank[first]) {
+			swap(first, second);
 		}
-		if (candNeighbors.empty()) {
-			continue;
+		m_edge[m] = e;
+		m_edgeRank[m] = rank[first];
+		m_edgeKey[m] = randomNumber(0, 1 << 30);
+		if (m_selectByMass) {
+			m_edgeMass[m] = m_mass[second];
 		}
-		int index = randomNumber(0, int(candNeighbors.size())-1);
-		nodeMarks[candNeighbors[index]] = true;
-		matching.push_back(candEdges[index]);
+		m_adjBegin[index[e->source()]+1]++;
+		m_adjBegin[index[e->target()]+1]++;
+		m++;
+	}
+	m_edge.resize(m);
+	for (int i = 0; i < numNodes; i++) {
+		m_adjBegin[i+1] += m_adjBegin[i];
 	}
 
-	while (!matching.empty()) {
-		edge matchingEdge = matching.back();
-		matching.pop_back();
+	m_adjTwin.init(2*m);
+	m_adjEdge.init(2*m);
+	m_edgeEnd.init(2*m);
+	Array<int> pos(numNodes);
+	for (int i = 0; i < numNodes; i++) {
+		pos[i] = m_adjBegin[i];
+	}
+	for (int i = 0; i < m; i++) {
+		int s = index[m_edge[i]->source()];
+		int t = index[m_edge[i]->target()];
+		m_edgeEnd[2*i] = s;
+		m_edgeEnd[2*i+1] = t;
+		m_adjTwin[pos[s]] = t;
+		m_adjEdge[pos[s]++] = i;
+		m_adjTwin[pos[t]] = s;
+		m_adjEdge[pos[t]++] = i;
+	}
+
+	// compute the matching
+	m_mate.init(numNodes);
+	m_mate.fill(-1);
+	m_candidate.init(numNodes);
+	if (min(m_maxThreads, numNodes / minNodesPerThread) > 1) {
+		for (int round = 0; round < maxMatchingRounds; round++) {
+			int numCandidates = runPhase(&MatchingMerger::selectCandidates);
+			if (numCandidates < minNodesPerThread) {
+				break;
+			}
+			runPhase(&MatchingMerger::matchCandidates);
+		}
+	}
+	matchSequential();
 
-		node mergeNode;
-		node parent;
+	// merge the matched nodes
+	std::vector< std::pair<node, node> > merges;
+	for (int i = 0; i < numNodes; i++) {
+		if (m_mate[i] < 0) {
+			continue;
+		}
+		edge matchingEdge = m_edge[m_mate[i]];
+		if (matchingEdge->source() != m_node[i]) {
+			continue; // each matching edge once
+		}
 
 		// choose high degree node as parent!
-		mergeNode = matchingEdge->source();
-		parent = matchingEdge->target();
+		node mergeNode = matchingEdge->source();
+		node parent = matchingEdge->target();
 		if (mergeNode->degree() > parent->degree()) {
 			mergeNode = matchingEdge->target();
 			parent = matchingEdge->source();
 		}
-
-		NodeMerge * NM = new NodeMerge(level);
-		bool ret = MLG.changeNode(NM, parent, MLG.radius(parent), mergeNode);
-		OGDF_ASSERT( ret );
 		if (m_selectByMass) {
 			m_mass[parent] = m_mass[parent] + m_mass[mergeNode];
 		}
-		MLG.moveEdgesToParent(NM, mergeNode, parent, true, m_adjustEdgeLengths);
-		ret = MLG.postMerge(NM, mergeNode);
-		if( !ret ) {
-			delete NM;
-		}
+		merges.push_back(std::pair<node, node>(mergeNode, parent));
 	}
 
-	return true;
+	// no further level if nothing could be merged (e.g. no edges left)
+	return MLG.mergeLevel(level, merges, true, m_adjustEdgeLengths) > 0;
 }
 
 
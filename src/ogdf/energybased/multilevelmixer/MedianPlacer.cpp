@@ -47,40 +47,49 @@ namespace ogdf {
 
 void MedianPlacer::placeOneLevel(MultilevelGraph &MLG)
 {
-	int level = MLG.getLevel();
-	while (MLG.getLevel() == level && MLG.getLastMerge() != 0)
-	{
-		placeOneNode(MLG);
-	}
+	placeLevel(MLG);
 }
 
 
-void MedianPlacer::placeOneNode(MultilevelGraph &MLG)
+// places each node at the median of its neighbors of the coarser level
+void MedianPlacer::placeNodes(MultilevelGraph &MLG, int begin, int end)
 {
-	node merged = MLG.undoLastMerge();
-	int i = 0;
 	std::vector<double> xVector;
 	std::vector<double> yVector;
-	adjEntry adj;
-	forall_adj(adj, merged) {
-		i++;
-		xVector.push_back(MLG.x(adj->twinNode()));
-		yVector.push_back(MLG.y(adj->twinNode()));
-	}
-	std::nth_element(xVector.begin(), xVector.begin()+(i/2), xVector.end());
-	std::nth_element(yVector.begin(), yVector.begin()+(i/2), yVector.end());
-	double x = xVector[i/2];
-	double y = yVector[i/2];
-	if (i % 2 == 0) {
-		std::nth_element(xVector.begin(), xVector.begin()+(i/2)-1, xVector.end());
-		std::nth_element(yVector.begin(), yVector.begin()+(i/2)-1, yVector.end());
-		x += xVector[i/2 - 1];
-		y += yVector[i/2 - 1];
-		x /= 2.0;
-		y /= 2.0;
+	for (int k = begin; k < end; k++) {
+		node merged = m_levelNodes[k];
+		xVector.clear();
+		yVector.clear();
+		adjEntry adj;
+		forall_adj(adj, merged) {
+			node w = adj->twinNode();
+			if (m_levelIndex[w->index()] < 0) {
+				xVector.push_back(MLG.x(w));
+				yVector.push_back(MLG.y(w));
+			}
+		}
+		// no neighbor in the coarser level
+		if (xVector.empty()) {
+			xVector.push_back(MLG.x(m_levelAnchor[k]));
+			yVector.push_back(MLG.y(m_levelAnchor[k]));
+		}
+		int i = (int)xVector.size();
+
+		std::nth_element(xVector.begin(), xVector.begin()+(i/2), xVector.end());
+		std::nth_element(yVector.begin(), yVector.begin()+(i/2), yVector.end());
+		double x = xVector[i/2];
+		double y = yVector[i/2];
+		if (i % 2 == 0) {
+			std::nth_element(xVector.begin(), xVector.begin()+(i/2)-1, xVector.end());
+			std::nth_element(yVector.begin(), yVector.begin()+(i/2)-1, yVector.end());
+			x += xVector[i/2 - 1];
+			y += yVector[i/2 - 1];
+			x /= 2.0;
+			y /= 2.0;
+		}
+		MLG.x(merged, x + ((m_randomOffset)?(float)m_levelRandom[2*k]:0.f));
+		MLG.y(merged, y + ((m_randomOffset)?(float)m_levelRandom[2*k+1]:0.f));
 	}
-	MLG.x(merged, x + ((m_randomOffset)?(float)randomDouble(-1.0, 1.0):0.f));
-	MLG.y(merged, y + ((m_randomOffset)?(float)randomDouble(-1.0, 1.0):0.f));
 }
 
 } // namespace ogdf
@@ -47,7 +47,6 @@
 #include <ogdf/energybased/multilevelmixer/BarycenterPlacer.h>
 #include <ogdf/energybased/FastMultipoleEmbedder.h>
 #include <ogdf/energybased/SpringEmbedderFR.h>
-#include <time.h>
 
 #ifdef OGDF_MMM_LEVEL_OUTPUTS
 #include <sstream>
@@ -65,6 +64,7 @@ ModularMultilevelMixer::ModularMultilevelMixer()
 	m_coarseningRatio    = 1.0;
 	m_levelBound         = false;
 	m_randomize          = false;
+	m_timeCoarsening     = 0.0;
 
 	// module options
 	setMultilevelBuilder(new SolarMerger);
@@ -86,7 +86,10 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 	const Graph &G = MLG.getGraph();
 
 	m_errorCode = ercNone;
-	clock_t time = clock();
+	m_timeCoarsening = 0.0;
+	m_levelSize.assign(1, G.numberOfNodes());
+	m_timePlacement.assign(1, 0.0);
+	m_timeLayout.assign(1, 0.0);
 	if ((m_multilevelBuilder.valid() == false || m_initialPlacement.valid() == false) && m_oneLevelLayoutModule.valid() == false) {
 		OGDF_THROW(AlgorithmFailureException);
 	}
@@ -108,7 +111,14 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 	if (m_multilevelBuilder.valid() && m_initialPlacement.valid())
 	{
 		double lbound = 16.0 * log(double(G.numberOfNodes()))/log(2.0);
+		__int64 t;
+		System::usedRealTime(t);
 		m_multilevelBuilder.get().buildAllLevels(MLG);
+		m_timeCoarsening = double(System::usedRealTime(t)) / 1000;
+
+		m_levelSize.assign(MLG.getLevel()+1, 0);
+		m_timePlacement.assign(MLG.getLevel()+1, 0.0);
+		m_timeLayout.assign(MLG.getLevel()+1, 0.0);
 
 		//Part for experiments: Stop if number of levels too high
 #ifdef OGDF_MMM_LEVEL_OUTPUTS
@@ -133,11 +143,15 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 
 		while(MLG.getLevel() > 0)
 		{
+			int level = MLG.getLevel();
+			m_levelSize[level] = G.numberOfNodes();
+			System::usedRealTime(t);
 			if (m_oneLevelLayoutModule.valid()) {
 				for(int i = 1; i <= m_times; i++) {
 					m_oneLevelLayoutModule.get().call(MLG.getGraphAttributes());
 				}
 			}
+			m_timeLayout[level] = double(System::usedRealTime(t)) / 1000;
 
 #ifdef OGDF_MMM_LEVEL_OUTPUTS
 			//Debugging output
@@ -154,7 +168,9 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 			MLG.moveToZero();
 
 			int nNodes = G.numberOfNodes();
+			System::usedRealTime(t);
 			m_initialPlacement.get().placeOneLevel(MLG);
+			m_timePlacement[MLG.getLevel()] = double(System::usedRealTime(t)) / 1000;
 			m_coarseningRatio = double(G.numberOfNodes()) / nNodes;
 
 #ifdef OGDF_MMM_LEVEL_OUTPUTS
@@ -171,12 +187,14 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 	{
 		LayoutModule &lastLayoutModule = (m_finalLayoutModule.valid() != 0 ? m_finalLayoutModule.get() : m_oneLevelLayoutModule.get());
 
+		__int64 t;
+		System::usedRealTime(t);
 		for(int i = 1; i <= m_times; i++) {
 			lastLayoutModule.call(MLG.getGraphAttributes());
 		}
+		m_timeLayout[0] = double(System::usedRealTime(t)) / 1000;
 	}
-
-	time = clock() - time;
+	m_levelSize[0] = G.numberOfNodes();
 }
 
 
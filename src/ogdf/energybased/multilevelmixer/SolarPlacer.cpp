@@ -46,47 +46,43 @@ namespace ogdf {
 
 void SolarPlacer::placeOneLevel(MultilevelGraph &MLG)
 {
-	int level = MLG.getLevel();
-	while (MLG.getLevel() == level && MLG.getLastMerge() != 0)
-	{
-		placeOneNode(MLG);
-	}
+	placeLevel(MLG, true);
 }
 
 
-void SolarPlacer::placeOneNode(MultilevelGraph &MLG)
+// places each node according to its path distances to its sun and the other suns
+void SolarPlacer::placeNodes(MultilevelGraph &MLG, int begin, int end)
 {
-	NodeMerge * lastNM = MLG.getLastMerge();
-	double x = 0.0;
-	double y = 0.0;
-	int i = 0;
-
-	node sun = MLG.getNode(lastNM->m_changedNodes.front());
-	std::vector< std::pair<int, double> > positions = lastNM->m_position;
-
-	node merged = MLG.undoLastMerge();
+	for (int k = begin; k < end; k++) {
+		node merged = m_levelNodes[k];
+		node sun = m_levelAnchor[k];
+		const std::vector< std::pair<int, double> > &positions = m_levelPositions[k];
+		double x = 0.0;
+		double y = 0.0;
+		int i = 0;
 
-	if (positions.size() > 0) {
-		for (std::vector< std::pair<int, double> >::iterator j = positions.begin(); j != positions.end(); j++) {
-			double factor = (*j).second;
-			node other_sun = MLG.getNode((*j).first);
+		if (positions.size() > 0) {
+			for (std::vector< std::pair<int, double> >::const_iterator j = positions.begin(); j != positions.end(); j++) {
+				double factor = (*j).second;
+				node other_sun = placedNode(MLG.getNode((*j).first));
+				i++;
+				x += MLG.x(sun) * factor + MLG.x(other_sun) * (1.0f-factor);
+				y += MLG.y(sun) * factor + MLG.y(other_sun) * (1.0f-factor);
+			}
+		} else {
 			i++;
-			x += MLG.x(sun) * factor + MLG.x(other_sun) * (1.0f-factor);
-			y += MLG.y(sun) * factor + MLG.y(other_sun) * (1.0f-factor);
+			x += MLG.x(sun);
+			y += MLG.y(sun);
 		}
-	} else {
-		i++;
-		x += MLG.x(sun);
-		y += MLG.y(sun);
-	}
 
-	OGDF_ASSERT(i > 0);
-	if (positions.size() == 0 || m_randomOffset) {
-		x += randomDouble(-1.0, 1.0);
-		y += randomDouble(-1.0, 1.0);
+		OGDF_ASSERT(i > 0);
+		if (positions.size() == 0 || m_randomOffset) {
+			x += m_levelRandom[2*k];
+			y += m_levelRandom[2*k+1];
+		}
+		MLG.x(merged, (x / static_cast<double>(i)));
+		MLG.y(merged, (y / static_cast<double>(i)));
 	}
-	MLG.x(merged, (x / static_cast<double>(i)));
-	MLG.y(merged, (y / static_cast<double>(i)));
 }
 
 } // namespace ogdf
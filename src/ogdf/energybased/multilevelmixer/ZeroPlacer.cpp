@@ -58,21 +58,19 @@ void ZeroPlacer::setRandomRange(double range)
 
 void ZeroPlacer::placeOneLevel(MultilevelGraph &MLG)
 {
-	int level = MLG.getLevel();
-	while (MLG.getLevel() == level && MLG.getLastMerge() != 0)
-	{
-		placeOneNode(MLG);
-	}
+	placeLevel(MLG);
 }
 
 
-void ZeroPlacer::placeOneNode(MultilevelGraph &MLG)
+// places each node at the position of its parent
+void ZeroPlacer::placeNodes(MultilevelGraph &MLG, int begin, int end)
 {
-	NodeMerge * NM = MLG.getLastMerge();
-	node parent = MLG.getNode(NM->m_changedNodes[0]);
-	node merged = MLG.undoLastMerge();
-	MLG.x(merged, MLG.x(parent) + ((m_randomOffset)?(float)randomDouble(-m_randomRange, m_randomRange):0.f));
-	MLG.y(merged, MLG.y(parent) + ((m_randomOffset)?(float)randomDouble(-m_randomRange, m_randomRange):0.f));
+	for (int k = begin; k < end; k++) {
+		node merged = m_levelNodes[k];
+		node parent = m_levelAnchor[k];
+		MLG.x(merged, MLG.x(parent) + ((m_randomOffset)?(float)(m_randomRange * m_levelRandom[2*k]):0.f));
+		MLG.y(merged, MLG.y(parent) + ((m_randomOffset)?(float)(m_randomRange * m_levelRandom[2*k+1]):0.f));
+	}
 }
 
 } // namespace ogdf
@@ -0,0 +1,485 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class MinCostFlowCostScaling.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include <ogdf/graphalg/MinCostFlowCostScaling.h>
+
+
+namespace ogdf {
+
+
+bool MinCostFlowCostScaling::call(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, 0, false);
+}
+
+
+bool MinCostFlowCostScaling::call(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow,
+	NodeArray<int> &dual)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, &dual, false);
+}
+
+
+bool MinCostFlowCostScaling::callWarmStart(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, 0, true);
+}
+
+
+bool MinCostFlowCostScaling::callWarmStart(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow,
+	NodeArray<int> &dual)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, &dual, true);
+}
+
+
+bool MinCostFlowCostScaling::solve(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow,
+	NodeArray<int> *dual,
+	bool warmStart)
+{
+	OGDF_ASSERT(checkProblem(G,lowerBound,upperBound,supply) == true);
+
+	const int infinity = this->infinity();
+
+	// assign indices 0, ..., n-1 to nodes in G; n is the artificial root
+	const int n = G.numberOfNodes();
+	const int root = n;
+	m_numNodes = n + 1;
+	m_alpha = n + 2;
+
+	NodeArray<int> vIndex(G);
+	Array<__int64> nodeSupply(n);
+
+	node v;
+	int i = 0;
+	forall_nodes(v, G) {
+		nodeSupply[i] = supply[v];
+		vIndex[v] = i++;
+	}
+
+	// remove the lower bounds by shifting the supplies; self-loops are left out
+	m_numArcs = 0;
+	edge e;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+		nodeSupply[vIndex[e->source()]] -= lowerBound[e];
+		nodeSupply[vIndex[e->target()]] += lowerBound[e];
+		m_numArcs++;
+	}
+
+	__int64 maxCost = 0;
+	__int64 bound = 0;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+		maxCost = max(maxCost, (__int64)(cost[e] < 0 ? -(__int64)cost[e] : cost[e]));
+		if (upperBound[e] < infinity)
+			bound += upperBound[e] - lowerBound[e];
+	}
+	for (i = 0; i < n; ++i) {
+		if (nodeSupply[i] > 0)
+			bound += nodeSupply[i];
+	}
+	const __int64 artCost = (maxCost + 1) * m_numNodes;
+	const int infCap = (int)min(bound, (__int64)infinity - 1);
+
+	// the initial flow (zero in a cold start) is moved into the bounds, the
+	// remaining supplies are the excesses of the nodes
+	Array<int> initialFlow(max(m_numArcs, 1));
+	i = 0;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+		int x = 0;
+		if (warmStart) {
+			int cap = (upperBound[e] >= infinity) ? infCap : upperBound[e] - lowerBound[e];
+			__int64 x0 = (__int64)flow[e] - lowerBound[e];
+			x = (int)min(max(x0, (__int64)0), (__int64)cap);
+		}
+		initialFlow[i++] = x;
+		nodeSupply[vIndex[e->source()]] -= x;
+		nodeSupply[vIndex[e->target()]] += x;
+	}
+
+	// artificial arcs connect nodes with nonzero excess to the root; using them
+	// for a unit of flow is more expensive than any path of original arcs
+	int numArtificial = 0;
+	for (i = 0; i < n; ++i) {
+		if (nodeSupply[i] != 0)
+			numArtificial++;
+	}
+
+	const int numAllArcs = m_numArcs + numArtificial;
+	Array<int> tail(numAllArcs), head(numAllArcs), cap(numAllArcs);
+	Array<__int64> arcCost(numAllArcs);
+	m_infinite.init(m_numArcs);
+
+	i = 0;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+		tail   [i] = vIndex[e->source()];
+		head   [i] = vIndex[e->target()];
+		m_infinite[i] = (upperBound[e] >= infinity);
+		cap    [i] = m_infinite[i] ? infCap : upperBound[e] - lowerBound[e];
+		arcCost[i] = cost[e];
+		++i;
+	}
+	for (int u = 0; u < n; ++u) {
+		if (nodeSupply[u] > 0) {
+			tail[i] = u;    head[i] = root; cap[i] = (int)nodeSupply[u];  arcCost[i] = 0;
+			++i;
+		} else if (nodeSupply[u] < 0) {
+			tail[i] = root; head[i] = u;    cap[i] = (int)-nodeSupply[u]; arcCost[i] = artCost;
+			++i;
+		}
+	}
+
+	// build the residual network, the forward residual arc of arc i is placed
+	// before the backward residual arc if both leave the same node
+	m_first.init(m_numNodes + 1);
+	m_first.fill(0);
+	for (i = 0; i < numAllArcs; ++i) {
+		m_first[tail[i] + 1]++;
+		m_first[head[i] + 1]++;
+	}
+	for (int u = 0; u < m_numNodes; ++u)
+		m_first[u + 1] += m_first[u];
+
+	const int numResArcs = 2 * numAllArcs;
+	m_head  .init(numResArcs);
+	m_rev   .init(numResArcs);
+	m_resCap.init(numResArcs);
+	m_cost  .init(numResArcs);
+	m_forward.init(numAllArcs);
+
+	Array<int> pos(m_numNodes);
+	for (int u = 0; u < m_numNodes; ++u)
+		pos[u] = m_first[u];
+
+	for (i = 0; i < numAllArcs; ++i) {
+		int a = pos[tail[i]]++;
+		int b = pos[head[i]]++;
+		m_forward[i] = a;
+		m_head  [a] = head[i];  m_head  [b] = tail[i];
+		m_rev   [a] = b;        m_rev   [b] = a;
+		int x = (i < m_numArcs) ? initialFlow[i] : 0;
+		m_resCap[a] = cap[i]-x; m_resCap[b] = x;
+		m_cost  [a] = arcCost[i] * m_alpha;
+		m_cost  [b] = -m_cost[a];
+	}
+
+	// initialize node data
+	m_price  .init(m_numNodes);
+	m_excess .init(m_numNodes);
+	m_current.init(m_numNodes);
+	m_queue  .init(m_numNodes);
+	m_inQueue.init(m_numNodes);
+	m_price.fill(0);
+	m_inQueue.fill(false);
+	for (int u = 0; u < n; ++u)
+		m_excess[u] = nodeSupply[u];
+	m_excess[root] = 0;
+
+	// the zero flow is eps-optimal for eps = maximum scaled cost
+	__int64 eps = artCost * m_alpha;
+
+	if (warmStart) {
+		// the prices are the negated dual variables; the root gets the smallest
+		// price for which no residual arc leaving the root has negative reduced
+		// cost (the arcs entering the root have cost 0 and are hardly affected)
+		if (dual != 0) {
+			forall_nodes(v, G)
+				m_price[vIndex[v]] = -(__int64)(*dual)[v] * m_alpha;
+		}
+		bool first = true;
+		for (int a = m_first[root]; a < m_first[root + 1]; ++a) {
+			if (m_resCap[a] == 0)
+				continue;
+			__int64 p = m_price[m_head[a]] - m_cost[a];
+			if (first || p > m_price[root])
+				m_price[root] = p;
+			first = false;
+		}
+
+		// the initial flow is eps-optimal for the largest violation of the
+		// optimality conditions
+		eps = 1;
+		for (int u = 0; u < m_numNodes; ++u) {
+			for (int a = m_first[u]; a < m_first[u + 1]; ++a) {
+				if (m_resCap[a] > 0)
+					eps = max(eps, -(m_cost[a] + m_price[u] - m_price[m_head[a]]));
+			}
+		}
+		eps *= 16;
+	}
+
+	do {
+		eps = (eps > 16) ? eps / 16 : 1;
+		refine(eps);
+	} while (eps > 1);
+
+	// the problem is infeasible if an artificial arc carries flow
+	bool feasible = true;
+	for (i = m_numArcs; i < numAllArcs; ++i) {
+		if (m_resCap[m_rev[m_forward[i]]] != 0)
+			feasible = false;
+	}
+
+	// the problem is unbounded if there is a negative cycle of arcs with infinite
+	// capacity; then the optimal flow saturates one of its arcs
+	bool bounded = true;
+	for (i = 0; i < m_numArcs; ++i) {
+		if (m_infinite[i] && m_resCap[m_forward[i]] == 0) {
+			Array<__int64> d(m_numNodes);
+			d.fill(0);
+			bounded = shortestPaths(d, true);
+			break;
+		}
+	}
+
+	// copy resulting flow for return
+	i = 0;
+	forall_edges(e, G) {
+		if (e->isSelfLoop()) {
+			flow[e] = lowerBound[e];
+			continue;
+		}
+		flow[e] = m_resCap[m_rev[m_forward[i]]] + lowerBound[e];
+		++i;
+	}
+
+	// compute dual values satisfying the complementary slackness conditions
+	// exactly (same sign as MinCostFlowReinelt)
+	if (dual != 0 && feasible && bounded) {
+		Array<__int64> d(m_numNodes);
+		for (int u = 0; u < m_numNodes; ++u)
+			d[u] = m_price[u] / m_alpha;
+#ifdef OGDF_DEBUG
+		bool optimal =
+#endif
+			shortestPaths(d, false);
+		OGDF_ASSERT(optimal);
+
+		forall_nodes(v, G)
+			(*dual)[v] = (int)(-d[vIndex[v]]);
+	}
+
+	return feasible && bounded;
+}
+
+
+void MinCostFlowCostScaling::refine(__int64 eps)
+{
+	// saturate all residual arcs with negative reduced cost
+	for (int u = 0; u < m_numNodes; ++u) {
+		for (int a = m_first[u]; a < m_first[u + 1]; ++a) {
+			int w = m_head[a];
+			int delta = m_resCap[a];
+			if (delta > 0 && m_cost[a] + m_price[u] - m_price[w] < 0) {
+				m_resCap[a] = 0;
+				m_resCap[m_rev[a]] += delta;
+				m_excess[u] -= delta;
+				m_excess[w] += delta;
+			}
+		}
+	}
+
+	// collect the active nodes
+	m_queueHead = m_queueSize = 0;
+	for (int u = 0; u < m_numNodes; ++u) {
+		m_current[u] = m_first[u];
+		if (m_excess[u] > 0) {
+			m_queue[m_queueSize++] = u;
+			m_inQueue[u] = true;
+		}
+	}
+
+	// discharge active nodes in FIFO order; every node is at most once in the queue
+	while (m_queueSize > 0) {
+		int u = m_queue[m_queueHead];
+		m_queueHead = (m_queueHead + 1 == m_numNodes) ? 0 : m_queueHead + 1;
+		--m_queueSize;
+		m_inQueue[u] = false;
+		discharge(u, eps);
+	}
+}
+
+
+void MinCostFlowCostScaling::discharge(int u, __int64 eps)
+{
+	const int last = m_first[u + 1];
+
+	while (m_excess[u] > 0) {
+		int a = m_current[u];
+
+		if (a == last) {
+			// relabel u such that at least one residual arc becomes admissible
+			__int64 newPrice = 0;
+			bool found = false;
+			for (int b = m_first[u]; b < last; ++b) {
+				if (m_resCap[b] > 0) {
+					__int64 p = m_price[m_head[b]] - m_cost[b];
+					if (!found || p > newPrice) {
+						newPrice = p;
+						found = true;
+					}
+				}
+			}
+			OGDF_ASSERT(found);
+			m_price[u] = newPrice - eps;
+			m_current[u] = m_first[u];
+			continue;
+		}
+
+		int w = m_head[a];
+		if (m_resCap[a] > 0 && m_cost[a] + m_price[u] - m_price[w] < 0) {
+			int delta = (int)min(m_excess[u], (__int64)m_resCap[a]);
+			m_resCap[a] -= delta;
+			m_resCap[m_rev[a]] += delta;
+			m_excess[u] -= delta;
+			m_excess[w] += delta;
+
+			if (m_excess[w] > 0 && !m_inQueue[w]) {
+				int tail = m_queueHead + m_queueSize;
+				m_queue[(tail >= m_numNodes) ? tail - m_numNodes : tail] = w;
+				++m_queueSize;
+				m_inQueue[w] = true;
+			}
+			if (m_resCap[a] == 0)
+				++m_current[u];
+		} else
+			++m_current[u];
+	}
+}
+
+
+bool MinCostFlowCostScaling::shortestPaths(Array<__int64> &d, bool infiniteOnly)
+{
+	// the residual arcs of original arcs and the arcs with infinite capacity
+	const int numResArcs = 2 * m_numArcs;
+	Array<bool> usable(m_resCap.size());
+	usable.fill(false);
+	for (int i = 0; i < m_numArcs; ++i) {
+		int a = m_forward[i];
+		if (infiniteOnly) {
+			usable[a] = m_infinite[i];
+		} else {
+			usable[a] = (m_resCap[a] > 0);
+			usable[m_rev[a]] = (m_resCap[m_rev[a]] > 0);
+		}
+	}
+	if (numResArcs == 0)
+		return true;
+
+	// label-correcting algorithm with FIFO queue; a node which is scanned more than
+	// m_numNodes times lies on a negative cycle
+	Array<int> numScans(m_numNodes);
+	numScans.fill(0);
+	m_queueHead = m_queueSize = 0;
+	for (int u = 0; u < m_numNodes; ++u) {
+		m_queue[m_queueSize++] = u;
+		m_inQueue[u] = true;
+	}
+
+	while (m_queueSize > 0) {
+		int u = m_queue[m_queueHead];
+		m_queueHead = (m_queueHead + 1 == m_numNodes) ? 0 : m_queueHead + 1;
+		--m_queueSize;
+		m_inQueue[u] = false;
+
+		if (++numScans[u] > m_numNodes) {
+			m_inQueue.fill(false);
+			return false;
+		}
+
+		for (int a = m_first[u]; a < m_first[u + 1]; ++a) {
+			if (!usable[a])
+				continue;
+			int w = m_head[a];
+			__int64 dw = d[u] + m_cost[a] / m_alpha;
+			if (dw < d[w]) {
+				d[w] = dw;
+				if (!m_inQueue[w]) {
+					int tail = m_queueHead + m_queueSize;
+					m_queue[(tail >= m_numNodes) ? tail - m_numNodes : tail] = w;
+					++m_queueSize;
+					m_inQueue[w] = true;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+
+} // end namespace ogdf
@@ -0,0 +1,554 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class MinCostFlowNetworkSimplex.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include <ogdf/graphalg/MinCostFlowNetworkSimplex.h>
+#include <math.h>
+
+
+namespace ogdf {
+
+
+bool MinCostFlowNetworkSimplex::call(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, 0, false);
+}
+
+
+bool MinCostFlowNetworkSimplex::call(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow,
+	NodeArray<int> &dual)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, &dual, false);
+}
+
+
+bool MinCostFlowNetworkSimplex::callWarmStart(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow)
+{
+	return solve(G, lowerBound, upperBound, cost, supply, flow, 0, true);
+}
+
+
+bool MinCostFlowNetworkSimplex::callWarmStart(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow,
+	NodeArray<int> &dual)
+{
+	// the dual variables follow from the initial basis
+	return solve(G, lowerBound, upperBound, cost, supply, flow, &dual, true);
+}
+
+
+bool MinCostFlowNetworkSimplex::solve(
+	const Graph &G,
+	const EdgeArray<int> &lowerBound,
+	const EdgeArray<int> &upperBound,
+	const EdgeArray<int> &cost,
+	const NodeArray<int> &supply,
+	EdgeArray<int> &flow,
+	NodeArray<int> *dual,
+	bool warmStart)
+{
+	OGDF_ASSERT(checkProblem(G,lowerBound,upperBound,supply) == true);
+
+	const int infinity = this->infinity();
+
+	// assign indices 0, ..., n-1 to nodes in G
+	m_numNodes = G.numberOfNodes();
+	NodeArray<int> vIndex(G);
+	Array<int> nodeSupply(m_numNodes);
+
+	node v;
+	int i = 0;
+	forall_nodes(v, G) {
+		nodeSupply[i] = supply[v];
+		vIndex[v] = i++;
+	}
+
+	// self-loops are left out, they are set to their lower bound; the initial
+	// flow (the lower bound in a cold start) is moved into the bounds
+	const int numEdges = G.numberOfEdges();
+	Array<int> initialFlow(numEdges);
+	int numOrigArcs = 0, numSplitArcs = 0;
+	edge e;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+		int x = lowerBound[e];
+		if (warmStart)
+			x = min(max(flow[e], lowerBound[e]), upperBound[e]);
+		initialFlow[numOrigArcs++] = x;
+		if (x > lowerBound[e] && (x < upperBound[e] || upperBound[e] >= infinity))
+			numSplitArcs++;
+	}
+
+	m_numArcs = numOrigArcs + numSplitArcs;
+	const int numAllArcs = m_numArcs + m_numNodes;
+	m_source.init(numAllArcs);
+	m_target.init(numAllArcs);
+	m_cap   .init(numAllArcs);
+	m_cost  .init(numAllArcs);
+	m_flow  .init(numAllArcs);
+	m_state .init(numAllArcs);
+
+	// remove the lower bounds and the initial flow by shifting the supplies;
+	// an arc with initial flow strictly between its bounds is split into an
+	// arc at its upper bound and a parallel arc at its lower bound
+	Array<int> splitArc(numOrigArcs);
+	int split = numOrigArcs;
+	i = 0;
+	forall_edges(e, G) {
+		if (e->isSelfLoop())
+			continue;
+
+		int s = vIndex[e->source()];
+		int t = vIndex[e->target()];
+		int lb = lowerBound[e];
+		int x = initialFlow[i] - lb;
+		int cap = (upperBound[e] >= infinity) ? infinity : upperBound[e] - lb;
+		m_source[i] = s;
+		m_target[i] = t;
+		m_cost  [i] = cost[e];
+		splitArc[i] = -1;
+		if (x == 0) {
+			m_cap  [i] = cap;
+			m_flow [i] = 0;
+			m_state[i] = stateLower;
+		} else {
+			m_cap  [i] = x;
+			m_flow [i] = x;
+			m_state[i] = stateUpper;
+			if (x < cap) {
+				splitArc[i] = split;
+				m_source[split] = s;
+				m_target[split] = t;
+				m_cost  [split] = cost[e];
+				m_cap   [split] = (cap >= infinity) ? infinity : cap - x;
+				m_flow  [split] = 0;
+				m_state [split] = stateLower;
+				++split;
+			}
+		}
+		nodeSupply[s] -= lb + x;
+		nodeSupply[t] += lb + x;
+		++i;
+	}
+
+	init(nodeSupply);
+	bool optimal = simplex();
+
+	// the problem is infeasible if an artificial arc carries flow
+	bool feasible = true;
+	for (i = m_numArcs; i < numAllArcs; ++i) {
+		if (m_flow[i] != 0)
+			feasible = false;
+	}
+
+	// copy resulting flow for return
+	i = 0;
+	forall_edges(e, G) {
+		if (e->isSelfLoop()) {
+			flow[e] = lowerBound[e];
+			continue;
+		}
+		flow[e] = m_flow[i] + lowerBound[e];
+		if (splitArc[i] >= 0)
+			flow[e] += m_flow[splitArc[i]];
+		++i;
+	}
+
+	// copy resulting dual values for return (same sign as MinCostFlowReinelt)
+	if (dual != 0) {
+		forall_nodes(v, G)
+			(*dual)[v] = (int)(-m_pi[vIndex[v]]);
+	}
+
+	return optimal && feasible;
+}
+
+
+// the initial basis is a star with center root consisting of artificial arcs;
+// an artificial arc is directed such that it can carry the supply of its node
+void MinCostFlowNetworkSimplex::init(Array<int> &supply)
+{
+	const int n = m_numNodes;
+	m_root = n;
+
+	m_pi       .init(n+1);
+	m_parent   .init(n+1);
+	m_pred     .init(n+1);
+	m_predDir  .init(n+1);
+	m_thread   .init(n+1);
+	m_revThread.init(n+1);
+	m_succNum  .init(n+1);
+	m_lastSucc .init(n+1);
+	m_dirtyRevs.init(n+1);
+
+	// artificial arcs are more expensive than any path of original arcs
+	__int64 maxCost = 0;
+	for (int e = 0; e < m_numArcs; ++e)
+		maxCost = max(maxCost, m_cost[e] < 0 ? -m_cost[e] : m_cost[e]);
+	const __int64 artCost = (maxCost + 1) * (n + 1);
+
+	m_parent [m_root] = -1;
+	m_pred   [m_root] = -1;
+	m_thread [m_root] = 0;
+	m_revThread[0]    = m_root;
+	m_succNum[m_root] = n + 1;
+	m_lastSucc[m_root] = m_root - 1;
+	m_pi     [m_root] = 0;
+
+	for (int u = 0, e = m_numArcs; u < n; ++u, ++e) {
+		m_parent  [u] = m_root;
+		m_pred    [u] = e;
+		m_thread  [u] = u + 1;
+		m_revThread[u + 1] = u;
+		m_succNum [u] = 1;
+		m_lastSucc[u] = u;
+		m_cap     [e] = infinity();
+		m_state   [e] = stateTree;
+		if (supply[u] >= 0) {
+			m_predDir[u] = dirUp;
+			m_pi     [u] = 0;
+			m_source [e] = u;
+			m_target [e] = m_root;
+			m_flow   [e] = supply[u];
+			m_cost   [e] = 0;
+		} else {
+			m_predDir[u] = dirDown;
+			m_pi     [u] = artCost;
+			m_source [e] = m_root;
+			m_target [e] = u;
+			m_flow   [e] = -supply[u];
+			m_cost   [e] = artCost;
+		}
+	}
+
+	m_blockSize = max((int)sqrt((double)m_numArcs), 10);
+	m_nextArc = 0;
+}
+
+
+bool MinCostFlowNetworkSimplex::simplex()
+{
+	while (findEnteringArc()) {
+		findJoinNode();
+		bool change = findLeavingArc();
+		if (m_delta >= infinity())
+			return false; // unbounded
+		changeFlow(change);
+		if (change) {
+			updateTreeStructure();
+			updatePotential();
+		}
+	}
+	return true;
+}
+
+
+// block search: returns the best arc of the first block containing an improving arc
+bool MinCostFlowNetworkSimplex::findEnteringArc()
+{
+	__int64 minCost = 0;
+	int cnt = m_blockSize;
+	int e;
+	for (e = m_nextArc; e < m_numArcs; ++e) {
+		__int64 c = m_state[e] * (m_cost[e] + m_pi[m_source[e]] - m_pi[m_target[e]]);
+		if (c < minCost) {
+			minCost = c;
+			m_inArc = e;
+		}
+		if (--cnt == 0) {
+			if (minCost < 0) {
+				m_nextArc = e + 1;
+				return true;
+			}
+			cnt = m_blockSize;
+		}
+	}
+	for (e = 0; e < m_nextArc; ++e) {
+		__int64 c = m_state[e] * (m_cost[e] + m_pi[m_source[e]] - m_pi[m_target[e]]);
+		if (c < minCost) {
+			minCost = c;
+			m_inArc = e;
+		}
+		if (--cnt == 0) {
+			if (minCost < 0) {
+				m_nextArc = e + 1;
+				return true;
+			}
+			cnt = m_blockSize;
+		}
+	}
+	if (minCost >= 0)
+		return false;
+
+	m_nextArc = e;
+	return true;
+}
+
+
+// the join node is the first common ancestor of the end nodes of the entering arc
+void MinCostFlowNetworkSimplex::findJoinNode()
+{
+	int u = m_source[m_inArc];
+	int v = m_target[m_inArc];
+	while (u != v) {
+		if (m_succNum[u] < m_succNum[v])
+			u = m_parent[u];
+		else
+			v = m_parent[v];
+	}
+	m_join = u;
+}
+
+
+// finds the leaving arc of the cycle, returns false if the entering arc leaves again
+bool MinCostFlowNetworkSimplex::findLeavingArc()
+{
+	const int infinity = this->infinity();
+
+	// the cycle is traversed in the direction of the entering arc
+	int first, second;
+	if (m_state[m_inArc] == stateLower) {
+		first  = m_source[m_inArc];
+		second = m_target[m_inArc];
+	} else {
+		first  = m_target[m_inArc];
+		second = m_source[m_inArc];
+	}
+	m_delta = m_cap[m_inArc];
+	int result = 0;
+
+	for (int u = first; u != m_join; u = m_parent[u]) {
+		int e = m_pred[u];
+		int d = m_flow[e];
+		if (m_predDir[u] == dirDown)
+			d = (m_cap[e] >= infinity) ? infinity : m_cap[e] - d;
+		if (d < m_delta) {
+			m_delta = d;
+			m_uOut = u;
+			result = 1;
+		}
+	}
+
+	for (int u = second; u != m_join; u = m_parent[u]) {
+		int e = m_pred[u];
+		int d = m_flow[e];
+		if (m_predDir[u] == dirUp)
+			d = (m_cap[e] >= infinity) ? infinity : m_cap[e] - d;
+		if (d <= m_delta) {
+			m_delta = d;
+			m_uOut = u;
+			result = 2;
+		}
+	}
+
+	if (result == 1) {
+		m_uIn = first;
+		m_vIn = second;
+	} else {
+		m_uIn = second;
+		m_vIn = first;
+	}
+	return result != 0;
+}
+
+
+// augments the flow along the cycle and updates the states of the entering and leaving arc
+void MinCostFlowNetworkSimplex::changeFlow(bool change)
+{
+	if (m_delta > 0) {
+		int val = m_state[m_inArc] * m_delta;
+		m_flow[m_inArc] += val;
+		for (int u = m_source[m_inArc]; u != m_join; u = m_parent[u])
+			m_flow[m_pred[u]] -= m_predDir[u] * val;
+		for (int u = m_target[m_inArc]; u != m_join; u = m_parent[u])
+			m_flow[m_pred[u]] += m_predDir[u] * val;
+	}
+
+	if (change) {
+		m_state[m_inArc] = stateTree;
+		m_state[m_pred[m_uOut]] = (m_flow[m_pred[m_uOut]] == 0) ? stateLower : stateUpper;
+	} else {
+		m_state[m_inArc] = -m_state[m_inArc];
+	}
+}
+
+
+// moves the subtree below the leaving arc such that it hangs below the entering arc
+void MinCostFlowNetworkSimplex::updateTreeStructure()
+{
+	int oldRevThread = m_revThread[m_uOut];
+	int oldSuccNum   = m_succNum[m_uOut];
+	int oldLastSucc  = m_lastSucc[m_uOut];
+	m_vOut = m_parent[m_uOut];
+
+	if (m_uIn == m_uOut) {
+		// the subtree is just moved
+		m_parent [m_uIn] = m_vIn;
+		m_pred   [m_uIn] = m_inArc;
+		m_predDir[m_uIn] = (m_uIn == m_source[m_inArc]) ? dirUp : dirDown;
+
+		if (m_thread[m_vIn] != m_uOut) {
+			int after = m_thread[oldLastSucc];
+			m_thread[oldRevThread] = after;
+			m_revThread[after] = oldRevThread;
+			after = m_thread[m_vIn];
+			m_thread[m_vIn] = m_uOut;
+			m_revThread[m_uOut] = m_vIn;
+			m_thread[oldLastSucc] = after;
+			m_revThread[after] = oldLastSucc;
+		}
+	} else {
+		// if oldRevThread equals vIn, then join and vOut coincide
+		int threadContinue = (oldRevThread == m_vIn) ? m_thread[oldLastSucc] : m_thread[m_vIn];
+
+		// update thread and parent along the stem nodes (the nodes between uIn and uOut)
+		int stem = m_uIn;
+		int parStem = m_vIn;
+		int last = m_lastSucc[m_uIn];
+		int after = m_thread[last];
+		m_thread[m_vIn] = m_uIn;
+		m_numDirtyRevs = 0;
+		m_dirtyRevs[m_numDirtyRevs++] = m_vIn;
+		while (stem != m_uOut) {
+			// insert the next stem node into the thread list
+			int nextStem = m_parent[stem];
+			m_thread[last] = nextStem;
+			m_dirtyRevs[m_numDirtyRevs++] = last;
+
+			// remove the subtree of stem from the thread list
+			int before = m_revThread[stem];
+			m_thread[before] = after;
+			m_revThread[after] = before;
+
+			// change the parent and shift the stem nodes
+			m_parent[stem] = parStem;
+			parStem = stem;
+			stem = nextStem;
+
+			last = (m_lastSucc[stem] == m_lastSucc[parStem]) ? m_revThread[parStem] : m_lastSucc[stem];
+			after = m_thread[last];
+		}
+		m_parent[m_uOut] = parStem;
+		m_thread[last] = threadContinue;
+		m_revThread[threadContinue] = last;
+		m_lastSucc[m_uOut] = last;
+
+		// remove the subtree of uOut from the thread list
+		if (oldRevThread != m_vIn) {
+			m_thread[oldRevThread] = after;
+			m_revThread[after] = oldRevThread;
+		}
+
+		for (int i = 0; i < m_numDirtyRevs; ++i) {
+			int u = m_dirtyRevs[i];
+			m_revThread[m_thread[u]] = u;
+		}
+
+		// update pred, predDir, lastSucc and succNum of the stem nodes from uOut to uIn
+		int tmpSc = 0, tmpLs = m_lastSucc[m_uOut];
+		for (int u = m_uOut, p = m_parent[u]; u != m_uIn; u = p, p = m_parent[u]) {
+			m_pred[u] = m_pred[p];
+			m_predDir[u] = -m_predDir[p];
+			tmpSc += m_succNum[u] - m_succNum[p];
+			m_succNum[u] = tmpSc;
+			m_lastSucc[p] = tmpLs;
+		}
+		m_pred   [m_uIn] = m_inArc;
+		m_predDir[m_uIn] = (m_uIn == m_source[m_inArc]) ? dirUp : dirDown;
+		m_succNum[m_uIn] = oldSuccNum;
+	}
+
+	// update lastSucc from vIn towards the root
+	int upLimitOut = (m_lastSucc[m_join] == m_vIn) ? m_join : -1;
+	int lastSuccOut = m_lastSucc[m_uOut];
+	for (int u = m_vIn; u != -1 && m_lastSucc[u] == m_vIn; u = m_parent[u])
+		m_lastSucc[u] = lastSuccOut;
+
+	// update lastSucc from vOut towards the root
+	if (m_join != oldRevThread && m_vIn != oldRevThread) {
+		for (int u = m_vOut; u != upLimitOut && m_lastSucc[u] == oldLastSucc; u = m_parent[u])
+			m_lastSucc[u] = oldRevThread;
+	} else if (lastSuccOut != oldLastSucc) {
+		for (int u = m_vOut; u != upLimitOut && m_lastSucc[u] == oldLastSucc; u = m_parent[u])
+			m_lastSucc[u] = lastSuccOut;
+	}
+
+	// update succNum from vIn and vOut to the join node
+	for (int u = m_vIn; u != m_join; u = m_parent[u])
+		m_succNum[u] += oldSuccNum;
+	for (int u = m_vOut; u != m_join; u = m_parent[u])
+		m_succNum[u] -= oldSuccNum;
+}
+
+
+// the potentials of the moved subtree change by the same amount
+void MinCostFlowNetworkSimplex::updatePotential()
+{
+	__int64 sigma = m_pi[m_vIn] - m_pi[m_uIn] - m_predDir[m_uIn] * m_cost[m_inArc];
+	int end = m_thread[m_lastSucc[m_uIn]];
+	for (int u = m_uIn; u != end; u = m_thread[u])
+		m_pi[u] += sigma;
+}
+
+
+} // end namespace ogdf
@@ -48,11 +48,170 @@
 #include <ogdf/basic/exceptions.h>
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/List.h>
+#include <ogdf/basic/Thread.h>
 
 
 
 namespace ogdf {
 
+//! The proper hierarchy packed into arrays.
+/**
+ * Nodes are identified by their index in hierarchy order, i.e., the nodes on level 0
+ * from left to right, followed by the nodes on level 1, and so on. Hence, the left
+ * neighbour of a node on the same level has the index decreased by one. The adjacent
+ * nodes on the lower and upper level are stored in compressed form (sorted by position).
+ */
+class FastSimpleHierarchyLayout::PackedHierarchy
+{
+public:
+	Array<node>   m_node;       //!< The node with a given index.
+	Array<int>    m_level;      //!< The level of a node.
+	Array<int>    m_first;      //!< The index of the first node on a level (m_first[size()] = n).
+	Array<double> m_width;      //!< The width of a node.
+	Array<bool>   m_dummy;      //!< True iff a node is a long edge dummy.
+
+	Array<int>    m_lowerStart; //!< Adjacent nodes on lower level of v are m_lower[m_lowerStart[v]..m_lowerStart[v+1]-1].
+	Array<int>    m_lower;      //!< Adjacent nodes on lower level.
+	Array<int>    m_upperStart; //!< Adjacent nodes on upper level of v are m_upper[m_upperStart[v]..m_upperStart[v+1]-1].
+	Array<int>    m_upper;      //!< Adjacent nodes on upper level.
+	Array<int>    m_upperTwin;  //!< The corresponding entry in m_lower for each entry in m_upper.
+
+	Array<bool>   m_type1;      //!< Marks type1 conflicts for each segment (stored for the entries in m_lower).
+
+	PackedHierarchy(const HierarchyLevels &levels, const GraphCopyAttributes &AGC);
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return m_node.size(); }
+
+	//! Returns the number of levels.
+	int size() const { return m_first.high(); }
+
+	//! Returns the maximal index of a level.
+	int high() const { return m_first.high() - 1; }
+
+	//! Returns the first node on level \a i according to direction \a leftToRight.
+	int firstOnLevel(int i, bool leftToRight) const {
+		return leftToRight ? m_first[i] : m_first[i+1] - 1;
+	}
+
+	//! Returns the predecessor of \a v on its level according to direction \a leftToRight, or -1 if none exists.
+	int pred(int v, bool leftToRight) const {
+		if (leftToRight)
+			return (v > m_first[m_level[v]]) ? v - 1 : -1;
+		else
+			return (v < m_first[m_level[v]+1] - 1) ? v + 1 : -1;
+	}
+};
+
+
+FastSimpleHierarchyLayout::PackedHierarchy::PackedHierarchy(
+	const HierarchyLevels &levels,
+	const GraphCopyAttributes &AGC)
+{
+	const Hierarchy &H = levels.hierarchy();
+	const GraphCopy &GC = H;
+
+	const int n = GC.numberOfNodes();
+	const int k = levels.size();
+
+	m_node .init(n);
+	m_level.init(n);
+	m_width.init(n);
+	m_dummy.init(n);
+	m_first.init(k+1);
+
+	NodeArray<int> index(GC);
+
+	int v = 0;
+	for (int i = 0; i < k; ++i) {
+		m_first[i] = v;
+		const Level &L = levels[i];
+		for (int j = 0; j <= L.high(); ++j, ++v) {
+			node w = L[j];
+			index[w]   = v;
+			m_node [v] = w;
+			m_level[v] = i;
+			m_width[v] = AGC.getWidth(w);
+			m_dummy[v] = H.isLongEdgeDummy(w);
+		}
+	}
+	m_first[k] = n;
+
+	// adjacent nodes on lower level (sorted by position)
+	const int m = GC.numberOfEdges();
+	m_lowerStart.init(n+1);
+	m_lower.init(m);
+	m_upperStart.init(0, n, 0);
+	m_upper.init(m);
+	m_upperTwin.init(m);
+	m_type1.init(0, m-1, false);
+
+	int e = 0;
+	for (v = 0; v < n; ++v) {
+		m_lowerStart[v] = e;
+		const Array<node> &adj = levels.adjNodes(m_node[v], HierarchyLevels::downward);
+		for (int j = 0; j < adj.size(); ++j) {
+			int u = index[adj[j]];
+			m_lower[e++] = u;
+			++m_upperStart[u+1];
+		}
+	}
+	m_lowerStart[n] = e;
+
+	// adjacent nodes on upper level; since we traverse nodes in hierarchy
+	// order, they are automatically sorted by position
+	for (v = 0; v < n; ++v)
+		m_upperStart[v+1] += m_upperStart[v];
+
+	Array<int> next(n);
+	for (v = 0; v < n; ++v)
+		next[v] = m_upperStart[v];
+
+	for (v = 0; v < n; ++v) {
+		for (int j = m_lowerStart[v]; j < m_lowerStart[v+1]; ++j) {
+			int p = next[m_lower[j]]++;
+			m_upper    [p] = v;
+			m_upperTwin[p] = j;
+		}
+	}
+}
+
+
+//! Computes the layout for a subset of the four directions in a separate thread.
+class FastSimpleHierarchyLayout::Worker : public Thread
+{
+	const FastSimpleHierarchyLayout &m_fshl;
+	const PackedHierarchy &m_H;
+
+	Array<double> *m_x;
+	Array<double> *m_blockWidth;
+	Array<int>    *m_root;
+
+	int m_first; //!< The first direction computed by this thread.
+	int m_step;  //!< The increment for the next direction computed by this thread.
+
+public:
+	Worker(
+		const FastSimpleHierarchyLayout &fshl,
+		const PackedHierarchy &H,
+		Array<double> *x,
+		Array<double> *blockWidth,
+		Array<int> *root,
+		int first,
+		int step)
+		: m_fshl(fshl), m_H(H), m_x(x), m_blockWidth(blockWidth), m_root(root), m_first(first), m_step(step) { }
+
+	//! Computes the directions \a m_first, \a m_first + \a m_step, ...
+	void run() {
+		for (int k = m_first; k < 4; k += m_step)
+			m_fshl.computeDirection(m_H, m_x[k], m_blockWidth[k], m_root[k], k < 2, k % 2 == 0);
+	}
+
+protected:
+	virtual void doWork() { run(); }
+};
+
+
 FastSimpleHierarchyLayout::FastSimpleHierarchyLayout()
 {
 	m_minXSep = LayoutStandards::defaultNodeSeparation();
@@ -61,6 +220,12 @@ FastSimpleHierarchyLayout::FastSimpleHierarchyLayout()
 	m_balanced    = true;
 	m_downward    = true;
 	m_leftToRight = true;
+
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = System::numberOfProcessors();
+#endif
 }
 
 
@@ -71,6 +236,7 @@ FastSimpleHierarchyLayout::FastSimpleHierarchyLayout(const FastSimpleHierarchyLa
 	m_balanced    = fshl.m_balanced;
 	m_downward    = fshl.m_downward;
 	m_leftToRight = fshl.m_leftToRight;
+	m_maxThreads  = fshl.m_maxThreads;
 }
 
 
@@ -81,6 +247,7 @@ FastSimpleHierarchyLayout &FastSimpleHierarchyLayout::operator=(const FastSimple
 	m_balanced    = fshl.m_balanced;
 	m_downward    = fshl.m_downward;
 	m_leftToRight = fshl.m_leftToRight;
+	m_maxThreads  = fshl.m_maxThreads;
 
 	return *this;
 }
@@ -88,13 +255,6 @@ FastSimpleHierarchyLayout &FastSimpleHierarchyLayout::operator=(const FastSimple
 
 void FastSimpleHierarchyLayout::doCall(const HierarchyLevels &levels, GraphCopyAttributes &AGC)
 {
-	const Hierarchy &H  = levels.hierarchy();
-	const GraphCopy &GC = H;
-
-	node v;
-	NodeArray<node> align(GC);
-	NodeArray<node> root(GC);
-
 #ifdef DEBUG_OUTPUT
 	for(int i = 0; i <= levels.high(); ++i) {
 		cout << "level " << i << ": ";
@@ -105,11 +265,19 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevels &levels, GraphCopyA
 	}
 #endif
 
+	PackedHierarchy H(levels, AGC);
+	markType1Conflicts(H);
+
+	const int n = H.numberOfNodes();
+
 	if (m_balanced) {
+		// the four directions are computed by (at most) four threads
+		int nThreads = (n < 2) ? 1 : max(1, min(m_maxThreads, 4));
+
 		// the x positions; x = -infinity <=> x is undefined
-		NodeArray<double> x[4];
-		NodeArray<double> blockWidth[4];
-		NodeArray<node> root[4];
+		Array<double> x[4];
+		Array<double> blockWidth[4];
+		Array<int> root[4];
 		double width[4];
 		double min[4];
 		double max[4];
@@ -121,18 +289,20 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevels &levels, GraphCopyA
 			max[i] = -numeric_limits<double>::max();
 		}
 
-		// calc the layout for down/up and leftToRight/rightToLeft
-		for (int downward = 0; downward <= 1; downward++) {
-			NodeArray<NodeArray<bool> > type1Conflicts(GC);
-			markType1Conflicts(levels, downward == 0, type1Conflicts);
-			for (int leftToRight = 0; leftToRight <= 1; leftToRight++) {
-				int k = 2 * downward + leftToRight;
-				root[k].init(GC);
-				verticalAlignment(levels, root[k], align, type1Conflicts, downward == 0, leftToRight == 0);
-				computeBlockWidths(GC, AGC, root[k], blockWidth[k]);
-				horizontalCompactation(align, levels, root[k], blockWidth[k], x[k], leftToRight == 0, downward == 0);
-			}
-		}
+		// calc the layout for down/up and leftToRight/rightToLeft;
+		// layout k = 2 * (downward ? 0 : 1) + (leftToRight ? 0 : 1)
+		Array<Worker *> worker(nThreads);
+		for (int t = 0; t < nThreads; ++t)
+			worker[t] = new Worker(*this, H, x, blockWidth, root, t, nThreads);
+
+		for (int t = 1; t < nThreads; ++t)
+			worker[t]->start();
+		worker[0]->run();
+
+		for (int t = 1; t < nThreads; ++t)
+			worker[t]->join();
+		for (int t = 0; t < nThreads; ++t)
+			delete worker[t];
 
 		/*
 		* - calc min/max x coordinate for each layout
@@ -140,7 +310,7 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevels &levels, GraphCopyA
 		* - find the layout with the minimal width
 		*/
 		for (int i = 0; i < 4; i++) {
-			forall_nodes(v, GC) {
+			for (int v = 0; v < n; ++v) {
 				double bw = 0.5 * blockWidth[i][root[i][v]];
 				double xp = x[i][v] - bw;
 				if (min[i] > xp) {
@@ -178,25 +348,22 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevels &levels, GraphCopyA
 		* median average coordinate for each node
 		*/
 		Array<double> sorting(4);
-		forall_nodes(v, GC) {
+		for (int v = 0; v < n; ++v) {
 			for (int i = 0; i < 4; i++) {
 				sorting[i] = x[i][v] + shift[i];
 			}
 			sorting.quicksort();
-			AGC.x(v) = 0.5 * (sorting[1] + sorting[2]);
+			AGC.x(H.m_node[v]) = 0.5 * (sorting[1] + sorting[2]);
 		}
 
 	} else {
-		NodeArray<double> x;
-		NodeArray<NodeArray<bool> > type1Conflicts(GC);
-		markType1Conflicts(levels, m_downward, type1Conflicts);
-		NodeArray<double> blockWidth; // the width of each block (max width of node in block)
-
-		verticalAlignment(levels, root, align, type1Conflicts, m_downward, m_leftToRight);
-		computeBlockWidths(GC, AGC, root, blockWidth);
-		horizontalCompactation(align, levels, root, blockWidth, x, m_leftToRight, m_downward);
-		forall_nodes(v, GC) {
-			AGC.x(v) = x[v];
+		Array<double> x;
+		Array<double> blockWidth; // the width of each block (max width of node in block)
+		Array<int> root;
+
+		computeDirection(H, x, blockWidth, root, m_downward, m_leftToRight);
+		for (int v = 0; v < n; ++v) {
+			AGC.x(H.m_node[v]) = x[v];
 		}
 	}
 
@@ -232,74 +399,62 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevels &levels, GraphCopyA
 }
 
 
-void FastSimpleHierarchyLayout::markType1Conflicts(const HierarchyLevels &levels, const bool downward, NodeArray<NodeArray<bool> > &type1Conflicts)
+void FastSimpleHierarchyLayout::computeDirection(
+	const PackedHierarchy &H,
+	Array<double> &x,
+	Array<double> &blockWidth,
+	Array<int> &root,
+	const bool downward,
+	const bool leftToRight) const
 {
-	const GraphCopy& GC = levels.hierarchy();
-	node v;
-
-	forall_nodes(v, GC) {
-		type1Conflicts[v].init(GC,false);
-	}
-
-	if (levels.size() >= 4) {
-		int upper, lower; 	// iteration bounds
-		int k0, k1; 		// node position boundaries of closest inner segments
-		int l; 				// node position on current level
-		HierarchyLevels::TraversingDir relupward; // upward relativ to the direction from downward
-
-		if (downward) {
-			lower = 1;
-			upper = levels.high() - 2;
-
-			relupward = HierarchyLevels::downward;
-		}
-		else {
-			lower = levels.high() - 1;
-			upper = 2;
+	Array<int> align;
 
-			relupward = HierarchyLevels::upward;
-		}
-
-		/*
-		 * iterate level[2..h-2] in the given direction
-		 *
-		 * availible levels: 1 to h
-		 */
-		for (int i = lower; (downward && i <= upper) || (!downward && i >= upper); i = downward ? i + 1 : i - 1)
-		{
-			k0 = 0;
-			l = 0; 			// index of first node on layer
-			const Level &currentLevel = levels[i];
-			const Level &nextLevel = downward ? levels[i+1] : levels[i-1];
-
-			// for all nodes on next level
-			for (int l1 = 0; l1 <= nextLevel.high(); l1++) {
-				const node virtualTwin = virtualTwinNode(levels, nextLevel[l1], relupward);
+	verticalAlignment(H, root, align, downward, leftToRight);
+	computeBlockWidths(H, root, blockWidth);
+	horizontalCompactation(H, align, root, blockWidth, x, leftToRight, downward);
+}
 
-				if (l1 == nextLevel.high() || virtualTwin != 0) {
-					k1 = currentLevel.high();
 
-					if (virtualTwin != 0) {
-						k1 = levels.pos(virtualTwin);
-					}
+void FastSimpleHierarchyLayout::markType1Conflicts(PackedHierarchy &H) const
+{
+	/*
+	 * iterate the pairs of levels (i,i+1) for i = 1..h-2; inner segments
+	 * cannot occur between the first or last two levels
+	 */
+	for (int i = 1; i <= H.high() - 2; ++i)
+	{
+		int k0 = 0;	// position boundaries of closest inner segments
+		int l = H.m_first[i+1]; // first node on next level not yet processed
+
+		const int first = H.m_first[i];
+		const int last  = H.m_first[i+2] - 1;
+
+		// for all nodes on next level
+		for (int l1 = H.m_first[i+1]; l1 <= last; l1++) {
+			// the upper node of an inner segment incident to l1 (or -1)
+			int virtualTwin = -1;
+			if (H.m_dummy[l1] && H.m_lowerStart[l1+1] - H.m_lowerStart[l1] == 1) {
+				int u = H.m_lower[H.m_lowerStart[l1]];
+				if (H.m_dummy[u])
+					virtualTwin = u;
+			}
 
-					for (; l <= l1; l++) {
-						Array<node> upperNeighbours = levels.adjNodes(nextLevel[l1], relupward);
+			if (l1 == last || virtualTwin != -1) {
+				int k1 = H.m_first[i+1] - 1 - first;
 
-						for (int i = 0; i < upperNeighbours.size(); i++) {
-							node currentNeighbour = upperNeighbours[i];
+				if (virtualTwin != -1) {
+					k1 = virtualTwin - first;
+				}
 
-							/*
-							 * XXX: < 0 in first iteration is still ok for indizes starting
-							 * with 0 because no index can be smaller than 0
-							 */
-							if (levels.pos(currentNeighbour) < k0 || levels.pos(currentNeighbour) > k1) {
-								(type1Conflicts[l1])[currentNeighbour] = true;
-							}
+				for (; l <= l1; l++) {
+					for (int j = H.m_lowerStart[l]; j < H.m_lowerStart[l+1]; ++j) {
+						int pos = H.m_lower[j] - first;
+						if (pos < k0 || pos > k1) {
+							H.m_type1[j] = true;
 						}
 					}
-					k0 = k1;
 				}
+				k0 = k1;
 			}
 		}
 	}
@@ -307,143 +462,148 @@ void FastSimpleHierarchyLayout::markType1Conflicts(const HierarchyLevels &levels
 
 
 void FastSimpleHierarchyLayout::verticalAlignment(
-	const HierarchyLevels &levels,
-	NodeArray<node> &root,
-	NodeArray<node> &align,
-	const NodeArray<NodeArray<bool> > &type1Conflicts,
-	bool downward,
-	const bool leftToRight)
+	const PackedHierarchy &H,
+	Array<int> &root,
+	Array<int> &align,
+	const bool downward,
+	const bool leftToRight) const
 {
-	const GraphCopy& GC = levels.hierarchy();
-	node v, u;
-	int r;
-	int median;
-	HierarchyLevels::TraversingDir relupward;		// upward relativ to the direction from downward
-
-	int medianCount;
+	const int n = H.numberOfNodes();
 
-	relupward = downward ? HierarchyLevels::downward : HierarchyLevels::upward;
+	// adjacent nodes in upward direction (relative to downward)
+	const Array<int> &adjStart = downward ? H.m_lowerStart : H.m_upperStart;
+	const Array<int> &adj      = downward ? H.m_lower : H.m_upper;
 
 	// initialize root and align
-	forall_nodes(v, GC) {
+	root .init(n);
+	align.init(n);
+	for (int v = 0; v < n; ++v) {
 		root[v] = v;
 		align[v] = v;
 	}
 
 	// for all Level
-	for (int i = downward ? 0 : levels.high();
-		(downward && i <= levels.high()) || (!downward && i >= 0);
+	for (int i = downward ? 0 : H.high();
+		(downward && i <= H.high()) || (!downward && i >= 0);
 		i = downward ? i + 1 : i - 1)
 	{
-		const Level &currentLevel = levels[i];
-		r = leftToRight ? -1 : numeric_limits<int>::max();
+		if (H.m_first[i] == H.m_first[i+1])
+			continue;
+
+		// since all candidates lie on the same level, we can compare indices instead of positions
+		int r = leftToRight ? -1 : numeric_limits<int>::max();
 
 		// for all nodes on Level i (with direction leftToRight)
-		for (int j = leftToRight ? 0 : currentLevel.high();
-			 (leftToRight && j <= currentLevel.high()) || (!leftToRight && j >= 0);
-			 leftToRight ? j++ : j--)
+		const int start = H.firstOnLevel(i, leftToRight);
+		const int stop  = H.firstOnLevel(i, !leftToRight);
+		for (int v = start; ; leftToRight ? v++ : v--)
 		{
-			v = currentLevel[j];
-			// the first median
-			median = (int)floor((levels.adjNodes(v, relupward).size() + 1) / 2.0);
-
-			medianCount = (levels.adjNodes(v, relupward).size() % 2 == 1) ? 1 : 2;
-			if (levels.adjNodes(v, relupward).size() == 0) {
-				medianCount = 0;
-			}
-
-			// for all median neighbours in direction of H
-			for (int count = 0; count < medianCount; count++) {
-				u = levels.adjNodes(v, relupward)[median + count - 1];
-
-				if (align[v] == v) {
-					// if segment (u,v) not marked by type1 conflicts AND ...
-					if ((type1Conflicts[v])[u] == false &&
-						((leftToRight && r < levels.pos(u)) || (!leftToRight && r > levels.pos(u))))
-					{
-						align[u] = v;
-						root[v] = root[u];
-						align[v] = root[v];
-						r = levels.pos(u);
+			const int deg = adjStart[v+1] - adjStart[v];
+
+			if (deg > 0) {
+				// the first median
+				const int median = adjStart[v] + (deg + 1) / 2 - 1;
+				const int medianCount = (deg % 2 == 1) ? 1 : 2;
+
+				// for all median neighbours in direction of H
+				for (int j = median; j < median + medianCount; j++) {
+					const int u = adj[j];
+
+					if (align[v] == v) {
+						// if segment (u,v) not marked by type1 conflicts AND ...
+						bool marked = downward ? H.m_type1[j] : H.m_type1[H.m_upperTwin[j]];
+						if (!marked && ((leftToRight && r < u) || (!leftToRight && r > u)))
+						{
+							align[u] = v;
+							root[v] = root[u];
+							align[v] = root[v];
+							r = u;
+						}
 					}
 				}
 			}
+
+			if (v == stop)
+				break;
 		}
 	}
 
 #ifdef DEBUG_OUTPUT
-	forall_nodes(v, GC) {
-		cout << "node: " << GC.original(v) << "/" << v << ", root: " << GC.original(root[v]) << "/" << root[v] << ", alignment: " << GC.original(align[v]) << "/" << align[v] << endl;
+	for (int v = 0; v < n; ++v) {
+		cout << "node: " << H.m_node[v] << ", root: " << H.m_node[root[v]] << ", alignment: " << H.m_node[align[v]] << endl;
 	}
 #endif
 }
 
 
 void FastSimpleHierarchyLayout::computeBlockWidths(
-	const GraphCopy &GC,
-	const GraphCopyAttributes &GCA,
-	NodeArray<node> &root,
-	NodeArray<double> &blockWidth)
+	const PackedHierarchy &H,
+	const Array<int> &root,
+	Array<double> &blockWidth) const
 {
-	blockWidth.init(GC, 0.0);
-	node v;
-	forall_nodes(v,GC) {
-		node r = root[v];
-		blockWidth[r] = max(blockWidth[r], GCA.getWidth(v));
+	const int n = H.numberOfNodes();
+
+	blockWidth.init(0, n-1, 0.0);
+	for (int v = 0; v < n; ++v) {
+		int r = root[v];
+		blockWidth[r] = max(blockWidth[r], H.m_width[v]);
 	}
 }
 
 
 void FastSimpleHierarchyLayout::horizontalCompactation(
-	const NodeArray<node> &align,
-	const HierarchyLevels &levels,
-	const NodeArray<node> &root,
-	const NodeArray<double> &blockWidth,
-	NodeArray<double> &x,
-	const bool leftToRight, bool downward)
+	const PackedHierarchy &H,
+	const Array<int> &align,
+	const Array<int> &root,
+	const Array<double> &blockWidth,
+	Array<double> &x,
+	const bool leftToRight,
+	const bool downward) const
 {
 #ifdef DEBUG_OUTPUT
 	cout << "-------- Horizontal Compactation --------" << endl;
 #endif
 
-	const GraphCopy& GC = levels.hierarchy();
+	const int n = H.numberOfNodes();
 
-	node v;
-	NodeArray<node> sink(GC);
-	NodeArray<double> shift(GC, numeric_limits<double>::max());
+	Array<int> sink(n);
+	Array<double> shift(0, n-1, numeric_limits<double>::max());
 
-	x.init(GC, -numeric_limits<double>::max());
+	x.init(0, n-1, -numeric_limits<double>::max());
 
-	forall_nodes(v, GC) {
+	for (int v = 0; v < n; ++v) {
 		sink[v] = v;
 	}
 
 	// calculate class relative coordinates for all roots
-	for (int i = downward ? 0 : levels.high();
-		(downward && i <= levels.high()) || (!downward && i >= 0);
+	for (int i = downward ? 0 : H.high();
+		(downward && i <= H.high()) || (!downward && i >= 0);
 		i = downward ? i + 1 : i - 1)
 	{
-		const Level &currentLevel = levels[i];
+		if (H.m_first[i] == H.m_first[i+1])
+			continue;
 
-		for (int j = leftToRight ? 0 : currentLevel.high();
-			(leftToRight && j <= currentLevel.high()) || (!leftToRight && j >= 0);
-			leftToRight ? j++ : j--)
+		const int start = H.firstOnLevel(i, leftToRight);
+		const int stop  = H.firstOnLevel(i, !leftToRight);
+		for (int v = start; ; leftToRight ? v++ : v--)
 		{
-			v = currentLevel[j];
 			if (root[v] == v) {
-				placeBlock(v, sink, shift, x, align, levels, blockWidth, root, leftToRight);
+				placeBlock(v, sink, shift, x, H, align, blockWidth, root, leftToRight);
 			}
+			if (v == stop)
+				break;
 		}
 	}
 
 	double d = 0;
-	for (int i = downward ? 0 : levels.high();
-		(downward && i <= levels.high()) || (!downward && i >= 0);
+	for (int i = downward ? 0 : H.high();
+		(downward && i <= H.high()) || (!downward && i >= 0);
 		i = downward ? i + 1 : i - 1)
 	{
-		const Level &currentLevel = levels[i];
+		if (H.m_first[i] == H.m_first[i+1])
+			continue;
 
-		v = currentLevel[leftToRight ? 0 : currentLevel.high()];
+		int v = H.firstOnLevel(i, leftToRight);
 
 		if(v == sink[root[v]]) {
 			double oldShift = shift[v];
@@ -455,15 +615,12 @@ void FastSimpleHierarchyLayout::horizontalCompactation(
 		}
 	}
 
-#ifdef DEBUG_OUTPUT
-	cout << "------- Sinks ----------" << endl;
-#endif
 	// apply root coordinates for all aligned nodes
 	// (place block did this only for the roots)
-	forall_nodes(v, GC) {
+	for (int v = 0; v < n; ++v) {
 #ifdef DEBUG_OUTPUT
 		if (sink[root[v]] == v) {
-			cout << "Topmost Root von Senke!: " << GC.original(v) << endl;
+			cout << "Topmost Root von Senke!: " << H.m_node[v] << endl;
 			cout << "-> Shift: " << shift[v] << endl;
 			cout << "-> x: " << x[v] << endl;
 		}
@@ -471,59 +628,46 @@ void FastSimpleHierarchyLayout::horizontalCompactation(
 		x[v] = x[root[v]];
 	}
 
-	// apply shift for each class
-	forall_nodes(v, GC) {
+	// apply shift for each class (roots must not be shifted before
+	// their blocks have been assigned the root coordinate)
+	for (int v = 0; v < n; ++v) {
 		x[v] += shift[sink[root[v]]];
 	}
 }
 
 
 void FastSimpleHierarchyLayout::placeBlock(
-	node v,
-	NodeArray<node> &sink,
-	NodeArray<double> &shift,
-	NodeArray<double> &x,
-	const NodeArray<node> &align,
-	const HierarchyLevels &levels,
-	const NodeArray<double> &blockWidth,
-	const NodeArray<node> &root,
-	const bool leftToRight)
+	int v,
+	Array<int> &sink,
+	Array<double> &shift,
+	Array<double> &x,
+	const PackedHierarchy &H,
+	const Array<int> &align,
+	const Array<double> &blockWidth,
+	const Array<int> &root,
+	const bool leftToRight) const
 {
-	const Hierarchy &H = levels.hierarchy();
-
-	node w;
-	node u;
-
-#ifdef DEBUG_OUTPUT
-	const GraphCopy& GC = H;
-#endif
-
 	if (x[v] == -numeric_limits<double>::max()) {
 		x[v] = 0;
-		w = v;
+		int w = v;
 #ifdef DEBUG_OUTPUT
-		cout << "---placeblock: " << GC.original(v) << " ---" << endl;
+		cout << "---placeblock: " << H.m_node[v] << " ---" << endl;
 #endif
 		do {
 			// if not first node on layer
-			if ((leftToRight && levels.pos(w) > 0) || (!leftToRight && levels.pos(w) < levels[H.rank(w)].high())) {
-				u = root[pred(w, levels, leftToRight)];
-				placeBlock(u, sink, shift, x, align, levels, blockWidth, root, leftToRight);
+			int p = H.pred(w, leftToRight);
+			if (p != -1) {
+				int u = root[p];
+				placeBlock(u, sink, shift, x, H, align, blockWidth, root, leftToRight);
 				if (sink[v] == v) {
 					sink[v] = sink[u];
 				}
 				if (sink[v] != sink[u]) {
-#ifdef DEBUG_OUTPUT
-					cout << "old shift " << GC.original(sink[u]) << ": " << shift[sink[u]] << "<>" << x[v] - x[u] - m_minXSep << endl;
-#endif
 					if (leftToRight) {
 						shift[sink[u]] = min<double>(shift[sink[u]], x[v] - x[u] - m_minXSep - 0.5 * (blockWidth[u] + blockWidth[v]));
 					} else {
 						shift[sink[u]] = max<double>(shift[sink[u]], x[v] - x[u] + m_minXSep + 0.5 * (blockWidth[u] + blockWidth[v]));
 					}
-#ifdef DEBUG_OUTPUT
-					cout << "-> new shift: " << shift[sink[u]] << endl;
-#endif
 				}
 				else {
 					if (leftToRight) {
@@ -532,55 +676,13 @@ void FastSimpleHierarchyLayout::placeBlock(
 						x[v] = min<double>(x[v], x[u] - m_minXSep - 0.5 * (blockWidth[u] + blockWidth[v]));
 					}
 				}
-#ifdef DEBUG_OUTPUT
-				cout << "placing w: " << GC.original(w) << "; predecessor: " << GC.original(pred(w, levels, leftToRight)) <<
-					"; root(w)=v: " << GC.original(v) << "; root(pred(u)): " << GC.original(u) <<
-					"; sink(v): " << GC.original(sink[v]) << "; sink(u): " << GC.original(sink[u]) << endl;
-				cout << "x(v): " << x[v] << endl;
-			} else {
-				cout << "not placing w: " << GC.original(w) << " because at beginning of layer" << endl;
-#endif
 			}
 			w = align[w];
 		} while (w != v);
 #ifdef DEBUG_OUTPUT
-		cout << "---END placeblock: " << GC.original(v) << " ---" << endl;
+		cout << "---END placeblock: " << H.m_node[v] << " ---" << endl;
 #endif
 	}
 }
 
-
-node FastSimpleHierarchyLayout::virtualTwinNode(const HierarchyLevels &levels, const node v, const HierarchyLevels::TraversingDir dir) const
-{
-	const Hierarchy &H = levels.hierarchy();
-
-	if (!H.isLongEdgeDummy(v) || levels.adjNodes(v, dir).size() == 0) {
-		return 0;
-	}
-
-	if (levels.adjNodes(v, dir).size() > 1) {
-		// since v is a dummy there sould be only one upper neighbour
-		throw AlgorithmFailureException("FastSimpleHierarchyLayout.cpp");
-	}
-
-	return *levels.adjNodes(v, dir).begin();
-}
-
-
-node FastSimpleHierarchyLayout::pred(const node v, const HierarchyLevels &levels, const bool leftToRight)
-{
-	const Hierarchy &H = levels.hierarchy();
-
-	int pos = levels.pos(v);
-	int rank = H.rank(v);
-
-	const Level &level = levels[rank];
-	if ((leftToRight && pos != 0) || (!leftToRight && pos != level.high())) {
-		return level[leftToRight ? pos - 1 : pos + 1];
-	}
-	else {
-		return 0;
-	}
-}
-
 } // end namespace ogdf
@@ -0,0 +1,762 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of the network simplex ranking algorithm
+ *        (first phase of Sugiyama).
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/layered/NetworkSimplexRanking.h>
+#include <ogdf/layered/DfsAcyclicSubgraph.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/BinaryHeap2.h>
+
+
+namespace ogdf {
+
+
+//---------------------------------------------------------
+// NetworkSimplexRanking::Solver
+// network simplex on feasible spanning trees (forests)
+//
+// Nodes and (non-loop) edges are numbered consecutively; all
+// data is kept in arrays indexed by these numbers. The tree is
+// rooted (one root per connected component) and its nodes are
+// numbered in postorder (m_lim); the subtree of v consists of
+// the nodes with m_low[v] <= m_lim[w] <= m_lim[v].
+//---------------------------------------------------------
+
+class NetworkSimplexRanking::Solver
+{
+public:
+	Solver(const Graph &G,
+		const EdgeArray<bool> &reversed,
+		const EdgeArray<int> &length,
+		const EdgeArray<int> &cost);
+
+	//! Computes an initial feasible ranking by longest paths.
+	void initRank();
+
+	//! Makes the given ranking feasible (used for warm starts); nodes with negative rank are placed as in initRank().
+	void initRank(const NodeArray<int> &rank);
+
+	//! Runs the network simplex; returns the number of pivots.
+	int solve(int searchSize);
+
+	//! Assigns the computed ranks (normalized per connected component).
+	void assignRanks(NodeArray<int> &rank);
+
+private:
+	int m_n, m_m;
+
+	Array<node> m_node;     //!< The node with a given number.
+	Array<int>  m_tail;     //!< The tail of an edge (after reversal).
+	Array<int>  m_head;     //!< The head of an edge (after reversal).
+	Array<int>  m_minLen;   //!< The minimal length of an edge.
+	Array<int>  m_weight;   //!< The weight (cost) of an edge.
+
+	Array<int>  m_adjStart; //!< Incident edges of v are m_adj[m_adjStart[v]..m_adjStart[v+1]-1].
+	Array<int>  m_adj;
+
+	Array<int>  m_rank;
+
+	Array<bool> m_inTree;   //!< True iff an edge is a tree edge.
+	Array<int>  m_cutValue; //!< The cut value of a tree edge.
+	Array<int>  m_treeEdge; //!< The list of all tree edges.
+	Array<int>  m_treePos;  //!< The position of a tree edge in m_treeEdge.
+	int         m_numTree;  //!< The number of tree edges.
+
+	Array<int>  m_par;      //!< The tree edge to the parent (-1 for roots).
+	Array<int>  m_low;      //!< The smallest postorder number in the subtree.
+	Array<int>  m_lim;      //!< The postorder number.
+	Array<int>  m_byLim;    //!< The node with a given postorder number.
+
+	Array<int>  m_root;     //!< The roots of the tree (one per connected component).
+
+	int slack(int e) const {
+		return m_rank[m_head[e]] - m_rank[m_tail[e]] - m_minLen[e];
+	}
+
+	int opposite(int e, int v) const {
+		return (m_tail[e] == v) ? m_head[e] : m_tail[e];
+	}
+
+	//! Returns true iff \a w lies in the subtree of \a v.
+	bool inSubtree(int w, int v) const {
+		return m_low[v] <= m_lim[w] && m_lim[w] <= m_lim[v];
+	}
+
+	void topologicalOrder(Array<int> &order) const;
+	void feasibleTree();
+	void addTreeNode(int v, int shift, Array<bool> &inTreeNode, ArrayBuffer<int> &treeNodes,
+		BinaryHeap2<int,int> &outEdges, BinaryHeap2<int,int> &inEdges);
+	void addTreeEdge(int e);
+	int  postorder(int v, int par, int low);
+	void initCutValues();
+	int  computeCutValue(int f) const;
+	int  leaveEdge(int searchSize, int &start) const;
+	int  enterEdge(int f) const;
+	int  treeUpdate(int v, int w, int cutValue, bool dir);
+	void update(int f, int e);
+};
+
+
+NetworkSimplexRanking::Solver::Solver(
+	const Graph &G,
+	const EdgeArray<bool> &reversed,
+	const EdgeArray<int> &length,
+	const EdgeArray<int> &cost)
+{
+	m_n = G.numberOfNodes();
+
+	NodeArray<int> index(G);
+	m_node.init(m_n);
+
+	int i = 0;
+	node v;
+	forall_nodes(v,G) {
+		m_node[i] = v;
+		index[v] = i++;
+	}
+
+	m_m = 0;
+	edge e;
+	forall_edges(e,G)
+		if(!e->isSelfLoop())
+			++m_m;
+
+	m_tail  .init(m_m);
+	m_head  .init(m_m);
+	m_minLen.init(m_m);
+	m_weight.init(m_m);
+	m_adjStart.init(0, m_n, 0);
+	m_adj.init(2*m_m);
+
+	i = 0;
+	forall_edges(e,G) {
+		if(e->isSelfLoop())
+			continue;
+
+		int s = index[e->source()], t = index[e->target()];
+		if(reversed[e])
+			swap(s,t);
+
+		m_tail  [i] = s;
+		m_head  [i] = t;
+		m_minLen[i] = length[e];
+		m_weight[i] = cost[e];
+		++m_adjStart[s+1];
+		++m_adjStart[t+1];
+		++i;
+	}
+
+	for(i = 0; i < m_n; ++i)
+		m_adjStart[i+1] += m_adjStart[i];
+
+	Array<int> next(m_n);
+	for(i = 0; i < m_n; ++i)
+		next[i] = m_adjStart[i];
+
+	for(i = 0; i < m_m; ++i) {
+		m_adj[next[m_tail[i]]++] = i;
+		m_adj[next[m_head[i]]++] = i;
+	}
+
+	m_rank.init(m_n);
+}
+
+
+// computes a topological ordering of the nodes (the graph is acyclic)
+void NetworkSimplexRanking::Solver::topologicalOrder(Array<int> &order) const
+{
+	Array<int> indeg(0, m_n-1, 0);
+	for(int e = 0; e < m_m; ++e)
+		++indeg[m_head[e]];
+
+	order.init(m_n);
+	int first = 0, last = 0;
+	for(int v = 0; v < m_n; ++v)
+		if(indeg[v] == 0)
+			order[last++] = v;
+
+	while(first < last) {
+		int v = order[first++];
+		for(int j = m_adjStart[v]; j < m_adjStart[v+1]; ++j) {
+			int e = m_adj[j];
+			if(m_tail[e] == v && --indeg[m_head[e]] == 0)
+				order[last++] = m_head[e];
+		}
+	}
+
+	OGDF_ASSERT(last == m_n);
+}
+
+
+void NetworkSimplexRanking::Solver::initRank()
+{
+	Array<int> order;
+	topologicalOrder(order);
+
+	for(int i = 0; i < m_n; ++i) {
+		int v = order[i];
+		int r = 0;
+		for(int j = m_adjStart[v]; j < m_adjStart[v+1]; ++j) {
+			int e = m_adj[j];
+			if(m_head[e] == v)
+				r = max(r, m_rank[m_tail[e]] + m_minLen[e]);
+		}
+		m_rank[v] = r;
+	}
+}
+
+
+void NetworkSimplexRanking::Solver::initRank(const NodeArray<int> &rank)
+{
+	Array<int> order;
+	topologicalOrder(order);
+
+	// push nodes down (in topological order) until all edges are feasible;
+	// nodes without a previous rank are placed like in a cold start
+	for(int i = 0; i < m_n; ++i) {
+		int v = order[i];
+		int r = max(rank[m_node[v]], 0);
+		for(int j = m_adjStart[v]; j < m_adjStart[v+1]; ++j) {
+			int e = m_adj[j];
+			if(m_head[e] == v)
+				r = max(r, m_rank[m_tail[e]] + m_minLen[e]);
+		}
+		m_rank[v] = r;
+	}
+}
+
+
+void NetworkSimplexRanking::Solver::addTreeEdge(int e)
+{
+	m_inTree[e] = true;
+	m_treePos[e] = m_numTree;
+	m_treeEdge[m_numTree++] = e;
+}
+
+
+// adds v to the tree of the current component; the ranks of tree nodes are
+// stored relative to shift. The incident edges leading out of the tree are
+// inserted into outEdges (tail in the tree) and inEdges (head in the tree),
+// keyed such that their slack is key - shift resp. key + shift
+void NetworkSimplexRanking::Solver::addTreeNode(
+	int v,
+	int shift,
+	Array<bool> &inTreeNode,
+	ArrayBuffer<int> &treeNodes,
+	BinaryHeap2<int,int> &outEdges,
+	BinaryHeap2<int,int> &inEdges)
+{
+	inTreeNode[v] = true;
+	treeNodes.push(v);
+	m_rank[v] -= shift;
+
+	for(int j = m_adjStart[v]; j < m_adjStart[v+1]; ++j) {
+		int e = m_adj[j];
+		if(inTreeNode[opposite(e,v)])
+			continue;
+		int key = slack(e);
+		if(m_tail[e] == v)
+			outEdges.insert(e, key);
+		else
+			inEdges.insert(e, key);
+	}
+}
+
+
+// computes a feasible tree as proposed by Gansner et al.: the tree of each
+// connected component is grown by the incident edge with minimal slack, after
+// shifting the tree such that this edge becomes tight. The shifts are applied
+// lazily, so each edge is inserted into a heap at most once.
+void NetworkSimplexRanking::Solver::feasibleTree()
+{
+	m_inTree  .init(0, m_m-1, false);
+	m_treePos .init(0, m_m-1, -1);
+	m_treeEdge.init(max(m_n-1, 0));
+	m_numTree = 0;
+
+	Array<bool> inTreeNode(0, m_n-1, false);
+	ArrayBuffer<int> roots;
+	BinaryHeap2<int,int> outEdges(m_m+1), inEdges(m_m+1);
+
+	for(int r = 0; r < m_n; ++r)
+	{
+		if(inTreeNode[r])
+			continue;
+
+		roots.push(r);
+
+		ArrayBuffer<int> treeNodes;
+		int shift = 0;
+		addTreeNode(r, shift, inTreeNode, treeNodes, outEdges, inEdges);
+
+		for(;;) {
+			// discard edges whose endpoints are both in the tree
+			while(!outEdges.empty() && inTreeNode[m_head[outEdges.minRet()]])
+				outEdges.extractMin();
+			while(!inEdges.empty() && inTreeNode[m_tail[inEdges.minRet()]])
+				inEdges.extractMin();
+
+			if(outEdges.empty() && inEdges.empty())
+				break;
+
+			// take the edge with minimal slack and shift the tree such that it becomes tight
+			int e, w;
+			if(inEdges.empty() || (!outEdges.empty()
+				&& outEdges.getPriority(1) - shift <= inEdges.getPriority(1) + shift))
+			{
+				shift += outEdges.getPriority(1) - shift;
+				e = outEdges.extractMin();
+				w = m_head[e];
+			} else {
+				shift -= inEdges.getPriority(1) + shift;
+				e = inEdges.extractMin();
+				w = m_tail[e];
+			}
+
+			addTreeEdge(e);
+			addTreeNode(w, shift, inTreeNode, treeNodes, outEdges, inEdges);
+		}
+
+		for(int i = 0; i < treeNodes.size(); ++i)
+			m_rank[treeNodes[i]] += shift;
+	}
+
+	m_root.init(roots.size());
+	for(int i = 0; i < roots.size(); ++i)
+		m_root[i] = roots[i];
+}
+
+
+// assigns postorder numbers to the subtree of v (reached via tree edge par),
+// starting with low; returns the next free number
+int NetworkSimplexRanking::Solver::postorder(int v, int par, int low)
+{
+	// explicit stack of nodes and the next position in their adjacency
+	ArrayBuffer<int> S, P;
+
+	m_par[v] = par;
+	m_low[v] = low;
+	S.push(v);
+	P.push(m_adjStart[v]);
+
+	int lim = low;
+	while(!S.empty()) {
+		int w = S.top();
+		int &j = P.top();
+		bool descended = false;
+
+		while(j < m_adjStart[w+1]) {
+			int e = m_adj[j++];
+			if(m_inTree[e] && e != m_par[w]) {
+				int u = opposite(e,w);
+				m_par[u] = e;
+				m_low[u] = lim;
+				S.push(u);
+				P.push(m_adjStart[u]);
+				descended = true;
+				break;
+			}
+		}
+
+		if(!descended) {
+			m_lim[w] = lim;
+			m_byLim[lim] = w;
+			++lim;
+			S.pop();
+			P.pop();
+		}
+	}
+
+	return lim;
+}
+
+
+// computes the cut value of tree edge f; requires that the cut values
+// of all tree edges in the subtree below f are known
+int NetworkSimplexRanking::Solver::computeCutValue(int f) const
+{
+	// v is the endpoint of f in the subtree
+	int v = (m_par[m_tail[f]] == f) ? m_tail[f] : m_head[f];
+	bool tailSide = (v == m_tail[f]);
+
+	int sum = 0;
+	for(int j = m_adjStart[v]; j < m_adjStart[v+1]; ++j) {
+		int e = m_adj[j];
+		int w = opposite(e,v);
+
+		int rv;
+		bool out;
+		if(!inSubtree(w,v)) {
+			// e crosses the cut
+			out = true;
+			rv = m_weight[e];
+		} else {
+			// e connects v with its subtree
+			out = false;
+			rv = (m_inTree[e] ? m_cutValue[e] : 0) - m_weight[e];
+		}
+
+		int d;
+		if(tailSide)
+			d = (m_head[e] == v) ? 1 : -1;
+		else
+			d = (m_tail[e] == v) ? 1 : -1;
+		if(out)
+			d = -d;
+
+		sum += (d < 0) ? -rv : rv;
+	}
+
+	return sum;
+}
+
+
+void NetworkSimplexRanking::Solver::initCutValues()
+{
+	m_par  .init(m_n);
+	m_low  .init(m_n);
+	m_lim  .init(m_n);
+	m_byLim.init(m_n);
+	m_cutValue.init(0, m_m-1, 0);
+
+	int low = 0;
+	for(int i = 0; i < m_root.size(); ++i)
+		low = postorder(m_root[i], -1, low);
+
+	// postorder guarantees that children are processed first
+	for(int l = 0; l < m_n; ++l) {
+		int f = m_par[m_byLim[l]];
+		if(f != -1)
+			m_cutValue[f] = computeCutValue(f);
+	}
+}
+
+
+// returns a tree edge with negative cut value (the minimal one among the
+// next searchSize candidates starting at position start), or -1 if none exists
+int NetworkSimplexRanking::Solver::leaveEdge(int searchSize, int &start) const
+{
+	if(m_numTree == 0)
+		return -1;
+
+	int f = -1, cnt = 0;
+	int i = start;
+	do {
+		int e = m_treeEdge[i];
+		if(m_cutValue[e] < 0) {
+			if(f == -1 || m_cutValue[e] < m_cutValue[f])
+				f = e;
+			if(++cnt >= searchSize)
+				break;
+		}
+		if(++i == m_numTree)
+			i = 0;
+	} while(i != start);
+
+	start = i;
+	return f;
+}
+
+
+// returns the non-tree edge with minimal slack that reconnects the
+// two components obtained by removing tree edge f
+int NetworkSimplexRanking::Solver::enterEdge(int f) const
+{
+	// v is the endpoint of f in the subtree; we search edges crossing the
+	// cut in the direction opposite to f
+	int v;
+	bool outSearch;
+	if(m_lim[m_tail[f]] < m_lim[m_head[f]]) {
+		v = m_tail[f];
+		outSearch = false;
+	} else {
+		v = m_head[f];
+		outSearch = true;
+	}
+
+	int eMin = -1, sMin = numeric_limits<int>::max();
+	for(int l = m_low[v]; l <= m_lim[v]; ++l) {
+		int w = m_byLim[l];
+		for(int j = m_adjStart[w]; j < m_adjStart[w+1]; ++j) {
+			int e = m_adj[j];
+			if(m_inTree[e])
+				continue;
+			int u;
+			if(outSearch) {
+				if(m_tail[e] != w) continue;
+				u = m_head[e];
+			} else {
+				if(m_head[e] != w) continue;
+				u = m_tail[e];
+			}
+			if(!inSubtree(u,v)) {
+				int s = slack(e);
+				if(s < sMin) {
+					sMin = s;
+					eMin = e;
+					if(s == 0)
+						return eMin;
+				}
+			}
+		}
+	}
+
+	return eMin;
+}
+
+
+// updates the cut values on the tree path from v upwards until the
+// subtree contains w; returns the lowest common ancestor of v and w
+int NetworkSimplexRanking::Solver::treeUpdate(int v, int w, int cutValue, bool dir)
+{
+	while(!inSubtree(w,v)) {
+		int e = m_par[v];
+		bool d = (v == m_tail[e]) ? dir : !dir;
+		if(d)
+			m_cutValue[e] += cutValue;
+		else
+			m_cutValue[e] -= cutValue;
+		v = (m_lim[m_tail[e]] > m_lim[m_head[e]]) ? m_tail[e] : m_head[e];
+	}
+	return v;
+}
+
+
+// exchanges tree edge f by non-tree edge e
+void NetworkSimplexRanking::Solver::update(int f, int e)
+{
+	int delta = slack(e);
+
+	// shift the subtree below f such that e becomes tight
+	if(delta > 0) {
+		int v = (m_lim[m_tail[f]] < m_lim[m_head[f]]) ? m_tail[f] : m_head[f];
+		if(!inSubtree(m_tail[e], v))
+			delta = -delta;
+		for(int l = m_low[v]; l <= m_lim[v]; ++l)
+			m_rank[m_byLim[l]] += delta;
+	}
+
+	int cutValue = m_cutValue[f];
+	int lca = treeUpdate(m_tail[e], m_head[e], cutValue, true);
+#ifdef OGDF_DEBUG
+	int lca2 =
+#endif
+		treeUpdate(m_head[e], m_tail[e], cutValue, false);
+	OGDF_ASSERT(lca == lca2);
+
+	m_cutValue[e] = -cutValue;
+	m_cutValue[f] = 0;
+
+	// exchange the tree edges
+	int pos = m_treePos[f];
+	m_inTree[f] = false;
+	m_treePos[f] = -1;
+	m_inTree[e] = true;
+	m_treePos[e] = pos;
+	m_treeEdge[pos] = e;
+
+	// renumber the subtree of the lowest common ancestor
+	postorder(lca, m_par[lca], m_low[lca]);
+}
+
+
+int NetworkSimplexRanking::Solver::solve(int searchSize)
+{
+	feasibleTree();
+	initCutValues();
+
+	int numPivots = 0;
+	int start = 0;
+	int f;
+	while((f = leaveEdge(searchSize, start)) != -1) {
+		int e = enterEdge(f);
+		OGDF_ASSERT(e != -1);
+		update(f, e);
+		++numPivots;
+	}
+
+	return numPivots;
+}
+
+
+void NetworkSimplexRanking::Solver::assignRanks(NodeArray<int> &rank)
+{
+	// normalize each connected component (i.e., each tree) such that its minimal rank is 0
+	for(int i = 0; i < m_root.size(); ++i) {
+		int r = m_root[i];
+		int minRank = numeric_limits<int>::max();
+		for(int l = m_low[r]; l <= m_lim[r]; ++l)
+			minRank = min(minRank, m_rank[m_byLim[l]]);
+		for(int l = m_low[r]; l <= m_lim[r]; ++l) {
+			int v = m_byLim[l];
+			rank[m_node[v]] = m_rank[v] - minRank;
+		}
+	}
+}
+
+
+//---------------------------------------------------------
+// NetworkSimplexRanking
+//---------------------------------------------------------
+
+NetworkSimplexRanking::NetworkSimplexRanking()
+{
+	m_subgraph.set(new DfsAcyclicSubgraph);
+	m_separateMultiEdges = true;
+	m_searchSize = 30;
+	m_numPivots = 0;
+}
+
+
+void NetworkSimplexRanking::prepare(const Graph &G, EdgeArray<bool> &reversed, EdgeArray<int> *pLength)
+{
+	List<edge> R;
+
+	m_subgraph.get().call(G,R);
+
+	reversed.init(G,false);
+	for (ListConstIterator<edge> it = R.begin(); it.valid(); ++it)
+		reversed[*it] = true;
+	R.clear();
+
+	if(pLength == 0)
+		return;
+
+	EdgeArray<int> &length = *pLength;
+	length.init(G,1);
+
+	if(m_separateMultiEdges) {
+		SListPure<edge> edges;
+		EdgeArray<int> minIndex(G), maxIndex(G);
+		parallelFreeSortUndirected(G, edges, minIndex, maxIndex);
+
+		SListConstIterator<edge> it = edges.begin();
+		if(it.valid())
+		{
+			int prevSrc = minIndex[*it];
+			int prevTgt = maxIndex[*it];
+
+			for(it = it.succ(); it.valid(); ++it) {
+				edge e = *it;
+				if (minIndex[e] == prevSrc && maxIndex[e] == prevTgt)
+					length[e] = 2;
+				else {
+					prevSrc = minIndex[e];
+					prevTgt = maxIndex[e];
+				}
+			}
+		}
+	}
+}
+
+
+void NetworkSimplexRanking::call(const Graph &G, NodeArray<int> &rank)
+{
+	EdgeArray<bool> reversed;
+	EdgeArray<int> length;
+	prepare(G, reversed, &length);
+
+	EdgeArray<int> cost(G,1);
+	doCall(G, rank, reversed, length, cost, false);
+}
+
+
+void NetworkSimplexRanking::call(
+	const Graph &G,
+	const EdgeArray<int> &length,
+	const EdgeArray<int> &cost,
+	NodeArray<int> &rank)
+{
+	EdgeArray<bool> reversed;
+	prepare(G, reversed, 0);
+
+	doCall(G, rank, reversed, length, cost, false);
+}
+
+
+void NetworkSimplexRanking::callIncremental(const Graph &G, NodeArray<int> &rank)
+{
+	EdgeArray<bool> reversed;
+	EdgeArray<int> length;
+	prepare(G, reversed, &length);
+
+	EdgeArray<int> cost(G,1);
+	doCall(G, rank, reversed, length, cost, rank.graphOf() == &G);
+}
+
+
+void NetworkSimplexRanking::callIncremental(
+	const Graph &G,
+	const EdgeArray<int> &length,
+	const EdgeArray<int> &cost,
+	NodeArray<int> &rank)
+{
+	EdgeArray<bool> reversed;
+	prepare(G, reversed, 0);
+
+	doCall(G, rank, reversed, length, cost, rank.graphOf() == &G);
+}
+
+
+void NetworkSimplexRanking::doCall(
+	const Graph& G,
+	NodeArray<int> &rank,
+	const EdgeArray<bool> &reversed,
+	const EdgeArray<int> &length,
+	const EdgeArray<int> &cost,
+	bool warmStart)
+{
+	Solver solver(G, reversed, length, cost);
+
+	if(warmStart)
+		solver.initRank(rank);
+	else {
+		solver.initRank();
+		rank.init(G,-1);
+	}
+
+	m_numPivots = solver.solve(m_searchSize);
+	solver.assignRanks(rank);
+}
+
+
+} // end namespace ogdf
@@ -44,7 +44,10 @@
 
 #include <ogdf/layered/OptimalHierarchyLayout.h>
 #include <ogdf/layered/Hierarchy.h>
+#include <ogdf/layered/FastSimpleHierarchyLayout.h>
 #include <ogdf/lpsolver/LPSolver.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/ParallelRange.h>
 
 
 #ifdef OGDF_LP_SOLVER
@@ -62,6 +65,12 @@ OptimalHierarchyLayout::OptimalHierarchyLayout()
 	m_fixedLayerDistance = false;
 	m_weightSegments     = 2.0;
 	m_weightBalancing    = 0.1;
+	m_maxPartSize        = 0;
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads         = 1;
+#else
+	m_maxThreads         = System::numberOfProcessors();
+#endif
 }
 
 
@@ -75,6 +84,8 @@ OptimalHierarchyLayout::OptimalHierarchyLayout(const OptimalHierarchyLayout &ohl
 	m_fixedLayerDistance = ohl.fixedLayerDistance();
 	m_weightSegments     = ohl.weightSegments();
 	m_weightBalancing    = ohl.weightBalancing();
+	m_maxPartSize        = ohl.maxPartSize();
+	m_maxThreads         = ohl.maxThreads();
 }
 
 
@@ -88,6 +99,8 @@ OptimalHierarchyLayout &OptimalHierarchyLayout::operator=(const OptimalHierarchy
 	m_fixedLayerDistance = ohl.fixedLayerDistance();
 	m_weightSegments     = ohl.weightSegments();
 	m_weightBalancing    = ohl.weightBalancing();
+	m_maxPartSize        = ohl.maxPartSize();
+	m_maxThreads         = ohl.maxThreads();
 
 	return *this;
 }
@@ -118,6 +131,80 @@ void OptimalHierarchyLayout::doCall(const HierarchyLevels &levels,GraphCopyAttri
 }
 
 
+//---------------------------------------------------------
+// Subproblems of the x-coordinate assignment
+//---------------------------------------------------------
+
+// A subproblem consists of consecutive parts of the hierarchy in left-to-right
+// order, or of a block of levels of a single part. Its nodes are stored level by
+// level; the nodes of each level are consecutive on that level.
+struct OptimalHierarchyLayout::SubLP
+{
+	SList<node> m_nodes;     // nodes in hierarchy order
+	int m_firstLevel;        // first level containing nodes of the subproblem
+	int m_lastLevel;         // last level containing nodes of the subproblem
+	int m_unit;              // subproblems with the same unit are aligned at their shared nodes
+	bool m_continued;        // the first node is the last node of the previous subproblem
+	bool m_fallback;         // x-coordinates are taken from FastSimpleHierarchyLayout
+	Array<double> m_x;       // the x-coordinates of m_nodes
+
+	SubLP(int level, int unit, bool continued)
+		: m_firstLevel(level), m_lastLevel(level), m_unit(unit),
+		  m_continued(continued), m_fallback(false) { }
+
+	void append(node v, int level) {
+		m_nodes.pushBack(v);
+		if(level < m_firstLevel) m_firstLevel = level;
+		if(level > m_lastLevel)  m_lastLevel  = level;
+	}
+
+	OGDF_NEW_DELETE
+};
+
+
+// Solves the LPs of a range of subproblems.
+class OptimalHierarchyLayout::SubLPSolver
+{
+	const OptimalHierarchyLayout &m_ohl;
+	const HierarchyLevels &m_levels;
+	const GraphCopyAttributes &m_AGC;
+	const NodeArray<bool> &m_isVirtual;
+	const NodeArray<int> &m_segment;
+	int m_nSegments;
+	const Array<SubLP*> &m_jobs;
+
+public:
+	SubLPSolver(
+		const OptimalHierarchyLayout &ohl,
+		const HierarchyLevels &levels,
+		const GraphCopyAttributes &AGC,
+		const NodeArray<bool> &isVirtual,
+		const NodeArray<int> &segment,
+		int nSegments,
+		const Array<SubLP*> &jobs)
+		: m_ohl(ohl), m_levels(levels), m_AGC(AGC), m_isVirtual(isVirtual), m_segment(segment),
+		  m_nSegments(nSegments), m_jobs(jobs) { }
+
+	// solves the jobs begin, ..., end-1
+	int operator()(int begin, int end) const {
+		// scratch arrays of solveSubLP(); plain arrays, since node arrays
+		// must not be registered at the graph concurrently
+		const GraphCopy &GC = m_levels.hierarchy();
+		Array<int> col(0, GC.maxNodeIndex(), -1);
+		Array<int> segCol(0, m_nSegments-1, -1);
+
+		for(int i = begin; i < end; ++i)
+			m_ohl.solveSubLP(m_levels, m_AGC, m_isVirtual, m_segment, *m_jobs[i], col, segCol);
+		return end - begin;
+	}
+};
+
+
+// minimal number of nodes of a subproblem; smaller parts are combined and
+// blocks are only split off if they have at least that many nodes
+static const int minSubLPSize = 500;
+
+
 //---------------------------------------------------------
 // Compute x-coordinates (LP-based approach) (for graphs)
 //---------------------------------------------------------
@@ -162,424 +249,421 @@ void OptimalHierarchyLayout::computeXCoordinates(
 		}
 	}
 
-	//
-	// determine variables of LP
-	//
-	int nSegments     = 0;	// number of vertical segments
-	int nRealVertices = 0;	// number of real vertices
-	int nEdges        = 0;	// number of edges not in vertical segments
-	int nBalanced     = 0;	// number of real vertices with deg > 1 for which
-							// balancing constraints may be applied
-
-	NodeArray<int> vIndex(GC,-1);	// for real node: index of x[v]
-									// for dummy: index of corresponding segment
-	NodeArray<int> bIndex(GC,-1);	// (relative) index of b[v]
-	EdgeArray<int> eIndex(GC,-1);	// for edge not in vertical segment:
-									//   its index
-	Array<int> count(GC.numberOfEdges());	// counts the number of dummy vertices
-											// in corresponding segment that are not at
-											// position 0
-
-	for(i = 0; i < k; ++i)
-	{
+	// vertical segments are maximal chains of virtual nodes; they are
+	// represented by a single variable
+	NodeArray<int> segment(GC,-1);
+	int nSegments = 0;
+	for(i = 0; i < k; ++i) {
 		const Level &L = levels[i];
 		for(int j = 0; j < L.size(); ++j) {
 			node v = L[j];
-			if(isVirtual[v] == true)
-				continue;
-
-			// we've found a real vertex
-			vIndex[v] = nRealVertices++;
-			if(v->degree() > 1)
-				bIndex[v] = nBalanced++;
-
-			// consider all outgoing edges
-			edge e;
-			forall_adj_edges(e,v) {
-				node w = e->target();
-				if(w == v)
-					continue;
-
-				// we've found an edge not belonging to a vetical segment
-				eIndex[e] = nEdges++;
-
-				if(isVirtual[w] == false)
-					continue;
-
-				// we've found a vertical segment
-				count[nSegments] = 0;
-				do {
-					vIndex[w] = nSegments;
-					const int high = levels[H.rank(w)].high();
-					if(high > 0) {
-						if (levels.pos(w) == 0 || levels.pos(w) == high)
-							++count[nSegments];
-						else
-							count[nSegments] += 2;
-					}
-
-					// next edge / dummy in segment
-					e = e->adjTarget()->cyclicSucc()->theEdge();
-					w = e->target();
-				} while(isVirtual[w]);
-
-				// edge following vertical segment
-				eIndex[e] = nEdges++;
-
-				++nSegments;
+			if(isVirtual[v]) {
+				node u = v->firstAdj()->theEdge()->source();
+				if(u == v) u = v->lastAdj()->theEdge()->source();
+				segment[v] = isVirtual[u] ? segment[u] : nSegments++;
 			}
 		}
 	}
 
-	// assignment of variables to matrix columns
-	//   d_e              0, ..., nEdges-1
-	//   x_v   vertexOffset, ..., vertexOffset+nRealVertices-1
-	//   x_s  segmentOffset, ..., segmentOffset+nSegments-1
-	//   b_v balancedOffset, ..., balancedOffset+nBalanced-1
-	LPSolver solver;
+	//
+	// decomposition
+	//
+	// Parts are the connected components of the hierarchy; components whose
+	// left-to-right order differs between levels (order graph contains a cycle)
+	// are merged. The parts are numbered in left-to-right order.
+	NodeArray<int> component(GC);
+	const int nComponents = connectedComponents(GC,component);
 
-	if(m_weightBalancing <= 0.0)
-		nBalanced = 0; // no balancing
+	Graph order;
+	Array<node> cNode(nComponents);
+	for(i = 0; i < nComponents; ++i)
+		cNode[i] = order.newNode();
 
-	const int nCols = nEdges + nRealVertices + nSegments + nBalanced;
-	const int nRows = 2*nEdges + GC.numberOfNodes() - k + 2*nBalanced;
+	for(i = 0; i < k; ++i) {
+		const Level &L = levels[i];
+		for(int j = 1; j < L.size(); ++j) {
+			int cu = component[L[j-1]], cv = component[L[j]];
+			if(cu != cv)
+				order.newEdge(cNode[cu],cNode[cv]);
+		}
+	}
 
-	const int vertexOffset   = nEdges;
-	const int segmentOffset  = nEdges + nRealVertices;
-	const int balancedOffset = segmentOffset + nSegments;
+	NodeArray<int> scc(order);
+	const int nParts = strongComponents(order,scc);
 
-	// allocation of matrix
-	Array<int> matrixBegin(nCols);
-	Array<int> matrixCount(nCols);
+	Graph partOrder;
+	Array<node> pNode(nParts);
+	for(i = 0; i < nParts; ++i)
+		pNode[i] = partOrder.newNode();
 
-	int nNonZeroes = 0;
-	for(i = 0; i < nEdges; ++i) {
-		matrixBegin[i] = nNonZeroes;
-		nNonZeroes += (matrixCount[i] = 2);
+	edge e;
+	forall_edges(e,order) {
+		int pu = scc[e->source()], pv = scc[e->target()];
+		if(pu != pv)
+			partOrder.newEdge(pNode[pu],pNode[pv]);
 	}
 
-	for(int jj = 0; jj < k; ++jj) {
-		const Level &L = levels[jj];
+	NodeArray<int> num(partOrder);
+	topologicalNumbering(partOrder,num);
+
+	Array<SList<node> > partNodes(nParts);
+	for(i = 0; i < k; ++i) {
+		const Level &L = levels[i];
 		for(int j = 0; j < L.size(); ++j) {
 			node v = L[j];
+			partNodes[num[pNode[scc[cNode[component[v]]]]]].pushBack(v);
+		}
+	}
 
-			if(isVirtual[v] == false) {
-				i = vertexOffset + vIndex[v];
-				matrixBegin[i] = nNonZeroes;
-
-				int high = levels[H.rank(v)].high();
-				int cstrSep;
-				if(high == 0)
-					cstrSep = 0;
-				else if (levels.pos(v) == 0 || levels.pos(v) == high)
-					cstrSep = 1;
-				else
-					cstrSep = 2;
-
-				int count =  cstrSep + 2*v->degree();
-				if(nBalanced > 0) {
-					if(v->degree() > 1)
-						count += 2;
-					adjEntry adj;
-					forall_adj(adj,v) {
-						node w = adj->twinNode();
-						if(bIndex[w] != -1)
-							count += 2;
-					}
-				}
+	// Subproblems: consecutive small parts are combined; large parts are split at
+	// levels on which they consist of a single node without balancing variable.
+	// Such a node belongs to both subproblems.
+	const bool balancing = (m_weightBalancing > 0.0);
 
-				matrixCount[i] = count;
-				nNonZeroes += matrixCount[i];
+	ArrayBuffer<SubLP*> subLPs(nParts);
+	int nUnits = 0;
+	SubLP *group = 0;
 
-			} else if (nBalanced > 0) {
-				i = vIndex[v];
-				adjEntry adj;
-				forall_adj(adj,v) {
-					node w = adj->twinNode();
-					if(bIndex[w] != -1)
-						count[i] += 2;
-				}
+	for(int p = 0; p < nParts; ++p) {
+		SListConstIterator<node> it = partNodes[p].begin();
+
+		if(partNodes[p].size() < minSubLPSize) {
+			if(group == 0 || group->m_nodes.size() >= minSubLPSize) {
+				group = new SubLP(H.rank(*it), nUnits++, false);
+				subLPs.push(group);
 			}
+			for(; it.valid(); ++it)
+				group->append(*it, H.rank(*it));
+			continue;
 		}
-	}
 
-	for(i = 0; i < nSegments; ++i) {
-		matrixBegin[segmentOffset+i] = nNonZeroes;
-		nNonZeroes += (matrixCount[segmentOffset+i] = count[i] + 4);
+		group = 0;
+		const int lastLevel = H.rank(partNodes[p].back());
+		SubLP *block = new SubLP(H.rank(*it), nUnits++, false);
+		subLPs.push(block);
+
+		while(it.valid()) {
+			const int level = H.rank(*it);
+			node v = *it;
+			block->append(v, level);
+			++it;
+
+			bool single = !it.valid() || H.rank(*it) != level;
+			if(single && level != block->m_firstLevel && level != lastLevel
+				&& block->m_nodes.size() >= minSubLPSize
+				&& (isVirtual[v] || !balancing || v->degree() <= 1))
+			{
+				block = new SubLP(level, block->m_unit, true);
+				block->append(v, level);
+				subLPs.push(block);
+			}
+
+			for(; it.valid() && H.rank(*it) == level; ++it)
+				block->append(*it, level);
+		}
 	}
 
-	for(i = 0; i < nBalanced; ++i) {
-		matrixBegin[balancedOffset+i] = nNonZeroes;
-		nNonZeroes += (matrixCount[balancedOffset+i] = 2);
+	//
+	// solve the LPs of the subproblems
+	//
+	ArrayBuffer<SubLP*> jobs(subLPs.size());
+	bool fallback = false;
+	for(i = 0; i < subLPs.size(); ++i) {
+		SubLP &lp = *subLPs[i];
+		if(m_maxPartSize > 0 && lp.m_nodes.size() > m_maxPartSize) {
+			lp.m_fallback = fallback = true;
+		} else
+			jobs.push(&lp);
 	}
 
+	Array<SubLP*> jobArray;
+	jobs.compactCopy(jobArray);
 
-	int debugNonZeroCount = 0; // for debugging only
+	SubLPSolver solver(*this, levels, AGC, isVirtual, segment, nSegments, jobArray);
+	parallelRange(jobArray.size(), m_maxThreads, 1, solver);
 
-	//
-	// constraints
-	//
-	Array<int>    matrixIndex(nNonZeroes);
-	Array<double> matrixValue(nNonZeroes);
-	Array<char>   equationSense(nRows);
-	Array<double> rightHandSide(nRows);
+	for(i = 0; i < jobArray.size(); ++i)
+		if(jobArray[i]->m_fallback)
+			fallback = true;
 
-	int currentRow = 0;
-	Array<int> currentCol(nCols);
-	for(i = 0; i < nCols; ++i)
-		currentCol[i] = matrixBegin[i];
+	if(fallback) {
+		FastSimpleHierarchyLayout fshl;
+		fshl.nodeDistance(m_nodeDistance);
+		fshl.layerDistance(m_layerDistance);
+		fshl.call(levels,AGC);
 
-	// Constraints:
-	//   d_(u,v) - x_u + x_v >= 0
-	//   d_(u,v) + x_u - x_v >= 0
-	edge e;
-	forall_edges(e,GC)
-	{
-		int dCol = eIndex[e];
-		if(dCol >= 0) {
-			node u = e->source();
-			int uCol = vIndex[u];
-			uCol += (isVirtual[u]) ? segmentOffset : vertexOffset;
+		// the horizontal compaction of FastSimpleHierarchyLayout may let nodes on
+		// a level overlap; such nodes are moved to the right
+		for(i = 0; i < k; ++i) {
+			const Level &L = levels[i];
+			for(int j = 1; j < L.size(); ++j) {
+				double minX = AGC.x(L[j-1]) + m_nodeDistance
+					+ 0.5*(AGC.getWidth(L[j-1])+AGC.getWidth(L[j]));
+				if(AGC.x(L[j]) < minX)
+					AGC.x(L[j]) = minX;
+			}
+		}
 
-			node v = e->target();
-			int vCol = vIndex[v];
-			vCol += (isVirtual[v]) ? segmentOffset : vertexOffset;
-
-			// d_(u,v) - x_u + x_v >= 0
-			matrixValue[currentCol[dCol]] = 1.0;
-			matrixIndex[currentCol[dCol]] = currentRow;
-			++currentCol[dCol];
-			debugNonZeroCount++;
-
-			matrixValue[currentCol[uCol]] = -1.0;
-			matrixIndex[currentCol[uCol]] = currentRow;
-			++currentCol[uCol];
-			debugNonZeroCount++;
-
-			matrixValue[currentCol[vCol]] = 1.0;
-			matrixIndex[currentCol[vCol]] = currentRow;
-			++currentCol[vCol];
-			debugNonZeroCount++;
-
-			equationSense[currentRow] = 'G';
-			rightHandSide[currentRow] = 0.0;
-
-			++currentRow;
-
-			// d_(u,v) + x_u - x_v >= 0
-			matrixValue[currentCol[dCol]] = 1.0;
-			matrixIndex[currentCol[dCol]] = currentRow;
-			++currentCol[dCol];
-			debugNonZeroCount++;
-
-			matrixValue[currentCol[uCol]] = 1.0;
-			matrixIndex[currentCol[uCol]] = currentRow;
-			++currentCol[uCol];
-			debugNonZeroCount++;
-
-			matrixValue[currentCol[vCol]] = -1.0;
-			matrixIndex[currentCol[vCol]] = currentRow;
-			++currentCol[vCol];
-			debugNonZeroCount++;
-
-			equationSense[currentRow] = 'G';
-			rightHandSide[currentRow] = 0.0;
-
-			++currentRow;
+		for(i = 0; i < subLPs.size(); ++i) {
+			SubLP &lp = *subLPs[i];
+			if(lp.m_fallback) {
+				lp.m_x.init(lp.m_nodes.size());
+				int j = 0;
+				for(SListConstIterator<node> it = lp.m_nodes.begin(); it.valid(); ++it)
+					lp.m_x[j++] = AGC.x(*it);
+			}
 		}
 	}
 
-	// Constraints:
-	//   x[v_i] - x[v_(i-1)] >= nodeDistance + 0.5*(width(v_i)+width(v_(i-1))
-	for(i = 0; i < k; ++i)
-	{
+	//
+	// combine the solutions
+	//
+	// blocks of a part are aligned at their shared node
+	NodeArray<double> x(GC);
+	NodeArray<int> unit(GC);
+	for(i = 0; i < subLPs.size(); ++i) {
+		SubLP &lp = *subLPs[i];
+		double dx = lp.m_continued ? x[lp.m_nodes.front()] - lp.m_x[0] : 0.0;
+		int j = 0;
+		for(SListConstIterator<node> it = lp.m_nodes.begin(); it.valid(); ++it) {
+			x[*it] = lp.m_x[j++] + dx;
+			unit[*it] = lp.m_unit;
+		}
+		delete subLPs[i];
+	}
+
+	// units are placed from left to right, each as far left as the separation
+	// constraints to its left neighbours on the levels allow
+	Array<SListPure<node> > leftBorder(nUnits);
+	for(i = 0; i < k; ++i) {
 		const Level &L = levels[i];
 		for(int j = 1; j < L.size(); ++j)
-		{
-			node u = L[j-1];
-			int uCol = vIndex[u];
-			uCol += (isVirtual[u]) ? segmentOffset : vertexOffset;
+			if(unit[L[j-1]] != unit[L[j]]) {
+				OGDF_ASSERT(unit[L[j-1]] < unit[L[j]]);
+				leftBorder[unit[L[j]]].pushBack(L[j]);
+			}
+	}
 
-			node v = L[j];
-			int vCol = vIndex[v];
-			vCol += (isVirtual[v]) ? segmentOffset : vertexOffset;
+	Array<double> shift(nUnits);
+	for(int u = 0; u < nUnits; ++u) {
+		shift[u] = 0.0;
+		bool first = true;
+		for(SListConstIterator<node> it = leftBorder[u].begin(); it.valid(); ++it) {
+			node v = *it;
+			node w = levels[H.rank(v)][levels.pos(v)-1];
+			double s = x[w] + shift[unit[w]]
+				+ m_nodeDistance + 0.5*(AGC.getWidth(v)+AGC.getWidth(w)) - x[v];
+			if(first || s > shift[u]) {
+				shift[u] = s;
+				first = false;
+			}
+		}
+	}
 
-			// x_v - x_u >= nodeDistance + 0.5*(width(v)+width(u))
-			matrixValue[currentCol[uCol]] = -1.0;
-			matrixIndex[currentCol[uCol]] = currentRow;
-			++currentCol[uCol];
-			debugNonZeroCount++;
+	// assign x coordinates
+	node v;
+	double minX = 0.0;
+	forall_nodes(v,GC) {
+		x[v] += shift[unit[v]];
+		if(v == GC.firstNode() || x[v] < minX)
+			minX = x[v];
+	}
+	forall_nodes(v,GC)
+		AGC.x(v) = x[v] - minX;
+}
 
-			matrixValue[currentCol[vCol]] = 1.0;
-			matrixIndex[currentCol[vCol]] = currentRow;
-			++currentCol[vCol];
-			debugNonZeroCount++;
 
-			equationSense[currentRow] = 'G';
-			rightHandSide[currentRow] =
-				m_nodeDistance + 0.5*(AGC.getWidth(v)+AGC.getWidth(u));
+//---------------------------------------------------------
+// Solve the LP of a subproblem
+//---------------------------------------------------------
+void OptimalHierarchyLayout::solveSubLP(
+	const HierarchyLevels &levels,
+	const GraphCopyAttributes &AGC,
+	const NodeArray<bool> &isVirtual,
+	const NodeArray<int> &segment,
+	SubLP &lp,
+	Array<int> &col,
+	Array<int> &segCol) const
+{
+	const Hierarchy &H  = levels.hierarchy();
+	const GraphCopy &GC = H;
 
-			++currentRow;
+	// the LP is collected row-wise as (row, column, value) triples
+	ArrayBuffer<double> obj;
+	ArrayBuffer<int>    entryRow, entryCol;
+	ArrayBuffer<double> entryValue;
+	ArrayBuffer<double> rightHandSide;
+
+	// variables:
+	//   x_v for real vertices, x_s for vertical segments (objective 0)
+	// (col[v->index()] == -1 for all nodes not in the subproblem)
+	SListConstIterator<node> it;
+	for(it = lp.m_nodes.begin(); it.valid(); ++it) {
+		node v = *it;
+		if(isVirtual[v]) {
+			int &c = segCol[segment[v]];
+			if(c == -1) {
+				c = obj.size();
+				obj.push(0.0);
+			}
+			col[v->index()] = c;
+		} else {
+			col[v->index()] = obj.size();
+			obj.push(0.0);
 		}
 	}
 
 	// Constraints:
-	//   b[v] - x[v] + 1/deg(v) * sum_{u in Adj(v)} x[u] >= 0
-	//   b[v] + x[v] - 1/deg(v) * sum_{u in Adj(v)} x[u] >= 0
-	if(nBalanced > 0) {
-		for(i = 0; i < k; ++i)
-		{
-			const Level &L = levels[i];
-			for(int j = 0; j < L.size(); ++j)
-			{
-				node v = L[j];
-				int bCol = bIndex[v];
-				if(bCol == -1)
-					continue;
-				bCol += balancedOffset;
-
-				int vCol = vertexOffset+vIndex[v];
-
-				// b[v] - x[v] + 1/deg(v) * sum_{u in Adj(v)} x[u] >= 0
-				matrixValue[currentCol[bCol]] = 1.0;
-				matrixIndex[currentCol[bCol]] = currentRow;
-				++currentCol[bCol];
-				debugNonZeroCount++;
+	//   d_(u,v) - x_u + x_v >= 0
+	//   d_(u,v) + x_u - x_v >= 0
+	for(it = lp.m_nodes.begin(); it.valid(); ++it) {
+		node u = *it;
+		if(H.rank(u) == lp.m_lastLevel)
+			continue;
 
-				matrixValue[currentCol[vCol]] = -1.0;
-				matrixIndex[currentCol[vCol]] = currentRow;
-				++currentCol[vCol];
-				debugNonZeroCount++;
+		edge e;
+		forall_adj_edges(e,u) {
+			node v = e->target();
+			if(v == u || (isVirtual[u] && isVirtual[v]))
+				continue; // incoming edge or edge in vertical segment
 
-				double f = 1.0 / v->degree();
-				adjEntry adj;
-				forall_adj(adj,v) {
-					node u = adj->twinNode();
-					int uCol = vIndex[u];
-					uCol += (isVirtual[u]) ? segmentOffset : vertexOffset;
-
-					matrixValue[currentCol[uCol]] = f;
-					matrixIndex[currentCol[uCol]] = currentRow;
-					++currentCol[uCol];
-					debugNonZeroCount++;
-				}
+			// edge segments connecting to a vertical segment
+			// (i.e. the original edge is represented by at least
+			// three edges in GC) get a special weight; all others
+			// have weight 1.0
+			double weight = (GC.chain(GC.original(e)).size() >= 3) ? m_weightSegments : 1.0;
+			if(isVirtual[u] == false && u->degree() == 1)
+				weight += m_weightBalancing;
+			if(isVirtual[v] == false && v->degree() == 1)
+				weight += m_weightBalancing;
+
+			int dCol = obj.size();
+			obj.push(weight);
+
+			for(int sgn = -1; sgn <= 1; sgn += 2) {
+				int row = rightHandSide.size();
+				entryRow.push(row); entryCol.push(dCol);   entryValue.push(1.0);
+				entryRow.push(row); entryCol.push(col[u->index()]); entryValue.push(sgn);
+				entryRow.push(row); entryCol.push(col[v->index()]); entryValue.push(-sgn);
+				rightHandSide.push(0.0);
+			}
+		}
+	}
 
-				equationSense[currentRow] = 'G';
-				rightHandSide[currentRow] = 0.0;
+	// Constraints:
+	//   x[v_i] - x[v_(i-1)] >= nodeDistance + 0.5*(width(v_i)+width(v_(i-1))
+	// for all neighbours on a level that belong to the subproblem
+	for(it = lp.m_nodes.begin(); it.valid(); ++it) {
+		node v = *it;
+		const int pos = levels.pos(v);
+		if(pos == 0)
+			continue;
+
+		node u = levels[H.rank(v)][pos-1];
+		if(col[u->index()] == -1)
+			continue;
+
+		int row = rightHandSide.size();
+		entryRow.push(row); entryCol.push(col[u->index()]); entryValue.push(-1.0);
+		entryRow.push(row); entryCol.push(col[v->index()]); entryValue.push(1.0);
+		rightHandSide.push(m_nodeDistance + 0.5*(AGC.getWidth(v)+AGC.getWidth(u)));
+	}
 
-				++currentRow;
+	// Constraints:
+	//   b[v] - x[v] + 1/deg(v) * sum_{u in Adj(v)} x[u] >= 0
+	//   b[v] + x[v] - 1/deg(v) * sum_{u in Adj(v)} x[u] >= 0
+	if(m_weightBalancing > 0.0) {
+		for(it = lp.m_nodes.begin(); it.valid(); ++it) {
+			node v = *it;
+			if(isVirtual[v] || v->degree() <= 1)
+				continue;
 
-				// b[v] + x[v] - 1/deg(v) * sum_{u in Adj(v)} x[u] >= 0
-				matrixValue[currentCol[bCol]] = 1.0;
-				matrixIndex[currentCol[bCol]] = currentRow;
-				++currentCol[bCol];
-				debugNonZeroCount++;
+			int bCol = obj.size();
+			obj.push(m_weightBalancing);
 
-				matrixValue[currentCol[vCol]] = 1.0;
-				matrixIndex[currentCol[vCol]] = currentRow;
-				++currentCol[vCol];
-				debugNonZeroCount++;
+			for(int sgn = -1; sgn <= 1; sgn += 2) {
+				int row = rightHandSide.size();
+				entryRow.push(row); entryCol.push(bCol);   entryValue.push(1.0);
+				entryRow.push(row); entryCol.push(col[v->index()]); entryValue.push(sgn);
 
-				f = -1.0 / v->degree();
+				double f = -sgn * (1.0 / v->degree());
+				adjEntry adj;
 				forall_adj(adj,v) {
-					node u = adj->twinNode();
-					int uCol = vIndex[u];
-					uCol += (isVirtual[u]) ? segmentOffset : vertexOffset;
-
-					matrixValue[currentCol[uCol]] = f;
-					matrixIndex[currentCol[uCol]] = currentRow;
-					++currentCol[uCol];
-					debugNonZeroCount++;
+					entryRow.push(row); entryCol.push(col[adj->twinNode()->index()]); entryValue.push(f);
 				}
-
-				equationSense[currentRow] = 'G';
-				rightHandSide[currentRow] = 0.0;
-
-				++currentRow;
+				rightHandSide.push(0.0);
 			}
 		}
 	}
 
-	OGDF_ASSERT(nNonZeroes == debugNonZeroCount);
+	for(it = lp.m_nodes.begin(); it.valid(); ++it)
+		if(isVirtual[*it])
+			segCol[segment[*it]] = -1;
 
-	// lower and upper bounds
-	Array<double> lowerBound(nCols);
-	Array<double> upperBound(nCols);
+	// convert to the column-wise format
+	const int nCols = obj.size();
+	const int nRows = rightHandSide.size();
+	const int nNonZeroes = entryValue.size();
 
-	for(i = 0; i < nCols; ++i) {
-		lowerBound[i] = 0.0;
-		upperBound[i] = solver.infinity();
-	}
+	Array<int> matrixBegin(nCols);
+	Array<int> matrixCount(0,nCols-1,0);
+	int j;
+	for(j = 0; j < nNonZeroes; ++j)
+		++matrixCount[entryCol[j]];
 
-	// objective function
-	Array<double> obj(nCols);
-	forall_edges(e,GC) {
-		i = eIndex[e];
-		if(i >= 0) {
-			// edge segments connecting to a vertical segment
-			// (i.e. the original edge is represented by at least
-			// three edges in GC) get a special weight; all others
-			// have weight 1.0
-			obj[i] = (GC.chain(GC.original(e)).size() >= 3) ? m_weightSegments : 1.0;
-			if(isVirtual[e->source()] == false && e->source()->degree() == 1)
-				obj[i] += m_weightBalancing;
-			if(isVirtual[e->target()] == false && e->target()->degree() == 1)
-				obj[i] += m_weightBalancing;
-		}
+	Array<int> currentCol(nCols);
+	int nz = 0;
+	for(j = 0; j < nCols; ++j) {
+		currentCol[j] = matrixBegin[j] = nz;
+		nz += matrixCount[j];
 	}
 
-	for(i = nEdges; i < balancedOffset; ++i)
-		obj[i] = 0.0; // all x_v and x_s do not contribute
-
-	for(; i < nCols; ++i)
-		obj[i] = m_weightBalancing;
-
-
-	// output problem
-	/*ofstream os("c:\\work\\GDE\\out.txt");
-	os << "nRows = " << nRows << "\n";
-	os << "nCols = " << nCols << "\n";
-	os << "nNonZeroes = " << nNonZeroes << "\n";
-	os << "\nmatrixBegin, matrixCount:\n";
-	for(i = 0; i < nCols; ++i)
-		os << " [" << i << "]  " << matrixBegin[i] << ", " << matrixCount[i] << "\n";
-	os << "\nmatrixIndex, matrixValue:\n";
-	for(i = 0; i < nNonZeroes; ++i)
-		os << " [" << i << "]  " << matrixIndex[i] << ", " << matrixValue[i] << "\n";
-	os << "\nequationSense, rightHandSide:\n";
-	for(i = 0; i < nRows; ++i)
-		os << " [" << i << "]  " << equationSense[i] << ", " << rightHandSide[i] << "\n";
-
-	os.flush();*/
+	Array<int>    matrixIndex(nNonZeroes);
+	Array<double> matrixValue(nNonZeroes);
+	for(j = 0; j < nNonZeroes; ++j) {
+		int &c = currentCol[entryCol[j]];
+		matrixIndex[c] = entryRow[j];
+		matrixValue[c] = entryValue[j];
+		++c;
+	}
 
+	Array<double> objective;
+	obj.compactCopy(objective);
+	Array<double> rhs;
+	rightHandSide.compactCopy(rhs);
+	Array<char> equationSense(0,nRows-1,'G');
 
 	// solve LP
+	LPSolver solver;
+	Array<double> lowerBound(0,nCols-1,0.0);
+	Array<double> upperBound(0,nCols-1,solver.infinity());
+
 	double optimum;
 	Array<double> x(nCols);
 
-	LPSolver::Status status =
-		solver.optimize(LPSolver::lpMinimize, obj,
-		matrixBegin, matrixCount, matrixIndex, matrixValue,
-		rightHandSide, equationSense,
-		lowerBound, upperBound,
-		optimum, x);
+	try {
+		LPSolver::Status status =
+			solver.optimize(LPSolver::lpMinimize, objective,
+			matrixBegin, matrixCount, matrixIndex, matrixValue,
+			rhs, equationSense,
+			lowerBound, upperBound,
+			optimum, x);
 
-	OGDF_ASSERT(status == LPSolver::lpOptimal);
+		lp.m_fallback = (status != LPSolver::lpOptimal);
 
-	/*os << "\nx\n";
-	for(i = 0; i < nCols; ++i)
-		os << " [" << i << "]  " << x[i] << "\n";
-
-	os.close();*/
+	} catch(...) {
+		lp.m_fallback = true;
+	}
 
-	// assign x coordinates
-	node v;
-	forall_nodes(v,GC) {
-		if(isVirtual[v])
-			AGC.x(v) = x[segmentOffset+vIndex[v]];
-		else
-			AGC.x(v) = x[vertexOffset+vIndex[v]];
+	if(!lp.m_fallback) {
+		lp.m_x.init(lp.m_nodes.size());
+		j = 0;
+		for(it = lp.m_nodes.begin(); it.valid(); ++it)
+			lp.m_x[j++] = x[col[(*it)->index()]];
 	}
+
+	for(it = lp.m_nodes.begin(); it.valid(); ++it)
+		col[(*it)->index()] = -1;
 }
 
 
@@ -59,6 +59,7 @@ namespace ogdf {
 OptimalRanking::OptimalRanking()
 {
 	m_subgraph.set(new DfsAcyclicSubgraph);
+	m_minCostFlow.set(new MinCostFlowReinelt);
 	m_separateMultiEdges = true;
 }
 
@@ -137,7 +138,7 @@ void OptimalRanking::doCall(
 	const EdgeArray<int> &length,
 	const EdgeArray<int> &costOrig)
 {
-	MinCostFlowReinelt mcf;
+	MinCostFlowModule &mcf = m_minCostFlow.get();
 
 	// construct min-cost flow problem
 	GraphCopy GC;
@@ -47,10 +47,11 @@
 #ifdef USE_COIN
 
 #include <ogdf/internal/lpsolver/LPSolver_coin.h>
+#include <coin/CoinPackedMatrix.hpp>
 
 namespace ogdf {
 
-LPSolver::LPSolver()
+LPSolver::LPSolver() : m_solved(false)
 {
 	osi = CoinManager::createCorrectOsiSolverInterface();
 }
@@ -86,35 +87,33 @@ bool LPSolver::checkFeasibility(
 		}
 	}
 
-	for(int i = 0; i < numRows; ++i) {
-		double leftHandSide = 0.0;
-
-		for(int c = 0; c < numCols; ++c) {
-			for(int j = matrixBegin[c]; j < matrixBegin[c]+matrixCount[c]; ++j)
-				if(matrixIndex[j] == i) {
-					leftHandSide += matrixValue[j] * x[c];
-				}
-		}
+	// compute all left-hand sides in a single pass over the columns
+	Array<double> leftHandSide(0, numRows-1, 0.0);
+	for(int c = 0; c < numCols; ++c) {
+		for(int j = matrixBegin[c]; j < matrixBegin[c]+matrixCount[c]; ++j)
+			leftHandSide[matrixIndex[j]] += matrixValue[j] * x[c];
+	}
 
+	for(int i = 0; i < numRows; ++i) {
 		switch(equationSense[i]) {
 			case 'G':
-				if(leftHandSide+eps < rightHandSide[i]) {
+				if(leftHandSide[i]+eps < rightHandSide[i]) {
 					cerr << "row " << i << " violated " << endl;
-					cerr << leftHandSide << " > " << rightHandSide[i] << endl;
+					cerr << leftHandSide[i] << " > " << rightHandSide[i] << endl;
 					return false;
 				}
 				break;
 			case 'L':
-				if(leftHandSide-eps > rightHandSide[i]) {
+				if(leftHandSide[i]-eps > rightHandSide[i]) {
 					cerr << "row " << i << " violated " << endl;
-					cerr << leftHandSide << " < " << rightHandSide[i] << endl;
+					cerr << leftHandSide[i] << " < " << rightHandSide[i] << endl;
 					return false;
 				}
 				break;
 			case 'E':
-				if(leftHandSide+eps < rightHandSide[i] || leftHandSide-eps > rightHandSide[i]) {
+				if(leftHandSide[i]+eps < rightHandSide[i] || leftHandSide[i]-eps > rightHandSide[i]) {
 					cerr << "row " << i << " violated " << endl;
-					cerr << leftHandSide << " = " << rightHandSide[i] << endl;
+					cerr << leftHandSide[i] << " = " << rightHandSide[i] << endl;
 					return false;
 				}
 				break;
@@ -141,16 +140,43 @@ LPSolver::Status LPSolver::optimize(
 	Array<double> &x              // x-vector of optimal solution (if result is lpOptimal)
 )
 {
-	if(osi->getNumCols()>0) { // get a fresh one if necessary
+	loadProblem(goal, obj, matrixBegin, matrixCount, matrixIndex, matrixValue,
+		rightHandSide, equationSense, lowerBound, upperBound);
+
+	OGDF_ASSERT(x.low() == 0 && x.size() == obj.size());
+
+	Status status = resolve(optimum, x);
+
+	OGDF_ASSERT_IF(dlExtendedChecking, status != lpOptimal ||
+		checkFeasibility(matrixBegin,matrixCount,matrixIndex,matrixValue,
+		rightHandSide,equationSense,lowerBound,upperBound,x));
+
+	return status;
+}
+
+
+void LPSolver::loadProblem(
+	OptimizationGoal goal,               // goal of optimization (minimize or maximize)
+	const Array<double> &obj,            // objective function vector
+	const Array<int>    &matrixBegin,    // matrixBegin[i] = begin of column i
+	const Array<int>    &matrixCount,    // matrixCount[i] = number of nonzeroes in column i
+	const Array<int>    &matrixIndex,    // matrixIndex[n] = index of matrixValue[n] in its column
+	const Array<double> &matrixValue,    // matrixValue[n] = non-zero value in matrix
+	const Array<double> &rightHandSide,  // right-hand side of LP constraints
+	const Array<char>   &equationSense,  // 'E' ==   'G' >=   'L' <=
+	const Array<double> &lowerBound,     // lower bound of x[i]
+	const Array<double> &upperBound      // upper bound of x[i]
+)
+{
+	if(osi->getNumCols()>0 || osi->getNumRows()>0) { // get a fresh one if necessary
 		delete osi;
 		osi = CoinManager::createCorrectOsiSolverInterface();
 	}
+	m_solved = false;
 
 	const int numRows = rightHandSide.size();
 	const int numCols = obj.size();
-#ifdef OGDF_DEBUG
 	const int numNonzeroes = matrixIndex.size();
-#endif
 
 	// assert correctness of array boundaries
 	OGDF_ASSERT(obj          .low() == 0 && obj          .size() == numCols);
@@ -162,37 +188,63 @@ LPSolver::Status LPSolver::optimize(
 	OGDF_ASSERT(equationSense.low() == 0 && equationSense.size() == numRows);
 	OGDF_ASSERT(lowerBound   .low() == 0 && lowerBound   .size() == numCols);
 	OGDF_ASSERT(upperBound   .low() == 0 && upperBound   .size() == numCols);
-	OGDF_ASSERT(x            .low() == 0 && x            .size() == numCols);
 
+	// the column-ordered matrix is passed in one piece instead of row by row
+	// and column by column
+	CoinPackedMatrix matrix(true, numRows, numCols, numNonzeroes,
+		matrixValue.begin(), matrixIndex.begin(),
+		matrixBegin.begin(), matrixCount.begin());
+
+	osi->loadProblem(matrix, lowerBound.begin(), upperBound.begin(), obj.begin(),
+		equationSense.begin(), rightHandSide.begin(), 0);
 	osi->setObjSense(goal==lpMinimize ? 1 : -1);
+}
 
-	int i;
 
-	CoinPackedVector zero;
-	for(i = 0; i < numRows; ++i) {
-		osi->addRow(zero,equationSense[i],rightHandSide[i],0);
-	}
-	for(int colNo = 0; colNo < numCols; ++colNo) {
-		CoinPackedVector cpv;
-		for(i = matrixBegin[colNo]; i<matrixBegin[colNo]+matrixCount[colNo]; ++i) {
-			cpv.insert(matrixIndex[i],matrixValue[i]);
-		}
-		osi->addCol(cpv,lowerBound[colNo],upperBound[colNo],obj[colNo]);
-	}
+int LPSolver::addRow(
+	const Array<int>    &index,          // column indices of the non-zeroes
+	const Array<double> &value,          // non-zero values
+	char equationSense,                  // 'E' ==   'G' >=   'L' <=
+	double rightHandSide)
+{
+	OGDF_ASSERT(index.low() == 0 && value.low() == 0 && index.size() == value.size());
+
+	CoinPackedVector row(index.size(), index.begin(), value.begin());
+	osi->addRow(row, equationSense, rightHandSide, 0.0);
+	return osi->getNumRows()-1;
+}
 
 
-	osi->initialSolve();
+void LPSolver::removeRows(const Array<int> &rows)
+{
+	OGDF_ASSERT(rows.low() == 0);
+	osi->deleteRows(rows.size(), rows.begin());
+}
+
+
+LPSolver::Status LPSolver::resolve(
+	double &optimum,              // optimum value of objective function (if result is lpOptimal)
+	Array<double> &x              // x-vector of optimal solution (if result is lpOptimal)
+)
+{
+	if(m_solved)
+		osi->resolve(); // warm start from the previous basis
+	else {
+		osi->initialSolve();
+		m_solved = true;
+	}
 
 	Status status;
 	if(osi->isProvenOptimal()) {
+		const int numCols = osi->getNumCols();
+		if(x.low() != 0 || x.size() != numCols)
+			x.init(numCols);
+
 		optimum = osi->getObjValue();
 		const double* sol = osi->getColSolution();
-		for(i = numCols; i-->0;)
+		for(int i = numCols; i-->0;)
 			x[i]=sol[i];
 		status = lpOptimal;
-		OGDF_ASSERT_IF(dlExtendedChecking,
-			checkFeasibility(matrixBegin,matrixCount,matrixIndex,matrixValue,
-			rightHandSide,equationSense,lowerBound,upperBound,x));
 
 	} else if(osi->isProvenPrimalInfeasible())
 		status = lpInfeasible;
@@ -39,7 +39,10 @@
 
 
 #include <ogdf/misclayout/BertaultLayout.h>
+#include <ogdf/internal/energybased/SpatialGrid.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/ParallelRange.h>
 #include <algorithm>
 #include <math.h>
 #include <stdlib.h>
@@ -47,11 +50,162 @@
 
 namespace ogdf {
 
+//! Uniform grids over the nodes (as points) and the edges (as bounding boxes of their segments)
+class BertaultLayout::SpatialIndex
+{
+	const GraphAttributes &m_AG;
+	const Graph &m_G;
+	SpatialGrid m_nodeGrid;
+	SpatialGrid m_edgeGrid;
+	Array<node> m_node;		// node with given index
+	Array<edge> m_edge;		// edge with given index
+
+	// returns true if a query rectangle overlaps more cells than there are elements
+	bool tooLarge(double x1, double y1, double x2, double y2, int numElements) const {
+		double cs=m_nodeGrid.cellSize();
+		return !(((x2-x1)/cs+2)*((y2-y1)/cs+2)<=numElements);
+	}
+
+	// returns true if node v lies in rectangle (x1,y1)-(x2,y2)
+	bool inside(node v, double x1, double y1, double x2, double y2) const {
+		return x1<=m_AG.x(v)&&m_AG.x(v)<=x2&&y1<=m_AG.y(v)&&m_AG.y(v)<=y2;
+	}
+
+	// returns true if the bounding box of edge e intersects rectangle (x1,y1)-(x2,y2)
+	bool intersects(edge e, double x1, double y1, double x2, double y2) const {
+		node a=e->source();
+		node b=e->target();
+		return x1<=max(m_AG.x(a),m_AG.x(b))&&min(m_AG.x(a),m_AG.x(b))<=x2
+			&&y1<=max(m_AG.y(a),m_AG.y(b))&&min(m_AG.y(a),m_AG.y(b))<=y2;
+	}
+
+public:
+	SpatialIndex(const GraphAttributes &AG, double cellSize) :
+		m_AG(AG),
+		m_G(AG.constGraph()),
+		m_nodeGrid(AG.constGraph().maxNodeIndex()+1, cellSize),
+		m_edgeGrid(AG.constGraph().maxEdgeIndex()+1, cellSize),
+		m_node(0, max(0,AG.constGraph().maxNodeIndex()), 0),
+		m_edge(0, max(0,AG.constGraph().maxEdgeIndex()), 0)
+	{
+		node v;
+		forall_nodes(v,m_G)
+		{
+			m_node[v->index()]=v;
+			m_nodeGrid.insert(v->index(),AG.x(v),AG.y(v),AG.x(v),AG.y(v));
+		}
+		edge e;
+		forall_edges(e,m_G)
+		{
+			node a=e->source();
+			node b=e->target();
+			m_edge[e->index()]=e;
+			m_edgeGrid.insertSegment(e->index(),AG.x(a),AG.y(a),AG.x(b),AG.y(b));
+		}
+	}
+
+	//! Updates the grids after the nodes have been moved; only elements leaving their cells are touched
+	void update() {
+		node v;
+		forall_nodes(v,m_G)
+			m_nodeGrid.update(v->index(),m_AG.x(v),m_AG.y(v),m_AG.x(v),m_AG.y(v));
+		edge e;
+		forall_edges(e,m_G)
+		{
+			node a=e->source();
+			node b=e->target();
+			m_edgeGrid.updateSegment(e->index(),m_AG.x(a),m_AG.y(a),m_AG.x(b),m_AG.y(b));
+		}
+	}
+
+	//! Sets result to the indices of the nodes in rectangle (x1,y1)-(x2,y2)
+	void nodesNear(double x1, double y1, double x2, double y2, ArrayBuffer<int> &result) const {
+		result.clear();
+		if(tooLarge(x1,y1,x2,y2,m_G.numberOfNodes())) {
+			node v;
+			forall_nodes(v,m_G)
+				if(inside(v,x1,y1,x2,y2))
+					result.push(v->index());
+		} else {
+			// the grid reports all nodes in overlapped cells; keep those inside the rectangle
+			m_nodeGrid.query(x1,y1,x2,y2,result);
+			int n=0;
+			for(int k=0;k<result.size();k++)
+				if(inside(m_node[result[k]],x1,y1,x2,y2))
+					result[n++]=result[k];
+			while(result.size()>n)
+				result.pop();
+		}
+	}
+
+	//! Sets result to the indices of the edges intersecting rectangle (x1,y1)-(x2,y2), and maybe other edges whose bounding boxes intersect it
+	void edgesNear(double x1, double y1, double x2, double y2, ArrayBuffer<int> &result) const {
+		result.clear();
+		if(tooLarge(x1,y1,x2,y2,m_G.numberOfEdges())) {
+			edge e;
+			forall_edges(e,m_G)
+				if(intersects(e,x1,y1,x2,y2))
+					result.push(e->index());
+		} else {
+			// the grid reports all edges crossing overlapped cells; keep those whose bounding boxes intersect the rectangle
+			m_edgeGrid.query(x1,y1,x2,y2,result);
+			int n=0;
+			for(int k=0;k<result.size();k++)
+				if(intersects(m_edge[result[k]],x1,y1,x2,y2))
+					result[n++]=result[k];
+			while(result.size()>n)
+				result.pop();
+		}
+	}
+
+	node nodeOf(int index) const { return m_node[index]; }
+	edge edgeOf(int index) const { return m_edge[index]; }
+
+	double cellSize() const { return m_nodeGrid.cellSize(); }
+};
+
+
+//! Computes the forces (or zones) of a range of nodes (called by parallelRange())
+class BertaultLayout::NodeComputation
+{
+	BertaultLayout &m_layout;
+	GraphAttributes &m_AG;
+	const SpatialIndex &m_index;
+	const Array<node> &m_nodes;
+	bool m_zones;
+
+public:
+	NodeComputation(BertaultLayout &layout, GraphAttributes &AG, const SpatialIndex &index,
+		const Array<node> &nodes, bool zones)
+		: m_layout(layout), m_AG(AG), m_index(index), m_nodes(nodes), m_zones(zones) { }
+
+	int operator()(int begin, int end) const {
+		ArrayBuffer<int> buffer;
+		for(int k = begin; k < end; k++) {
+			if(m_zones)
+				m_layout.computeZones(m_nodes[k], m_AG, m_index, buffer);
+			else
+				m_layout.computeForces(m_nodes[k], m_AG, m_index, buffer);
+		}
+		return end - begin;
+	}
+};
+
+
+static const int minNodesPerThread = 256;
+
+
 BertaultLayout::BertaultLayout()
 {
 	req_length=0;
 	iter_no=0;
 		impred=false;
+	rep_cutoff=0;
+#ifdef OGDF_MEMORY_POOL_NTS
+	max_threads=1;
+#else
+	max_threads=System::numberOfProcessors();
+#endif
 }
 
 BertaultLayout::BertaultLayout(double length, int number)
@@ -59,6 +213,12 @@ BertaultLayout::BertaultLayout(double length, int number)
 	req_length=length;
 	iter_no=number;
 		impred=false;
+	rep_cutoff=0;
+#ifdef OGDF_MEMORY_POOL_NTS
+	max_threads=1;
+#else
+	max_threads=System::numberOfProcessors();
+#endif
 }
 
 BertaultLayout::BertaultLayout(int number)
@@ -66,6 +226,12 @@ BertaultLayout::BertaultLayout(int number)
 	req_length=0;
 	iter_no=number;
 		impred=false;
+	rep_cutoff=0;
+#ifdef OGDF_MEMORY_POOL_NTS
+	max_threads=1;
+#else
+	max_threads=System::numberOfProcessors();
+#endif
 }
 
 BertaultLayout::~BertaultLayout()
@@ -104,97 +270,176 @@ void BertaultLayout::call(GraphAttributes &AG)
 	if(impred)
 		preprocess(AG);
 
-	for(int k=0;k<iter_no;k++)
+	// the grid cells are as large as the required edge length
+	SpatialIndex index(AG, (req_length>0) ? req_length : 1.0);
+
+	Array<node> nodes(G.numberOfNodes());
+	int k=0;
+	node v;
+	forall_nodes(v,G)
+		nodes[k++]=v;
+
+	for(k=0;k<iter_no;k++)
 	{
-		node v;
-		forall_nodes(v,G)
-		{
-				//initialise everything
-			F_x[v]=0;
-			F_y[v]=0;
-			sect[v].initialize();
-	   /*     int i;
-			for(i=1;i<9;i++)
-			{
-				cout << sect[v].R[i];
-				cout << " ";
-			}
-			cout << "\n";*/
+		//calculate the total force on each node
+		computeAll(false,nodes,AG,index);
 
-		}
+		//calculate the zones in which the nodes may move
+		computeAll(true,nodes,AG,index);
 
+		//moves the nodes according to forces
 		forall_nodes(v,G)
+			move(&v,AG);
+
+		index.update();
+	}
+
+}
+
+
+void BertaultLayout::computeAll(bool zones, const Array<node> &nodes, GraphAttributes &AG, const SpatialIndex &index)
+{
+	parallelRange(nodes.size(),max_threads,minNodesPerThread,NodeComputation(*this,AG,index,nodes,zones));
+}
+
+
+void BertaultLayout::computeForces(node v, GraphAttributes &AG, const SpatialIndex &index, ArrayBuffer<int> &buffer)
+{
+	const double x=AG.x(v);
+	const double y=AG.y(v);
+	F_x[v]=0;
+	F_y[v]=0;
+
+	//calculate total node-node repulsive force
+	if(rep_cutoff>0)
+	{
+		double r=rep_cutoff*req_length;
+		index.nodesNear(x-r,y-r,x+r,y+r,buffer);
+		for(int k=0;k<buffer.size();k++)
 		{
-			node j;
-			//calculate total node-node repulsive force
-			forall_nodes(j,G)
-			{
-				if(j!=v)
+			node j=index.nodeOf(buffer[k]);
+			if(j!=v&&(AG.x(j)-x)*(AG.x(j)-x)+(AG.y(j)-y)*(AG.y(j)-y)<=r*r)
 				f_Node_Repulsive(&v,&j,AG);
-			}
+		}
+	}
+	else
+	{
+		node j;
+		forall_nodes(j,AG.constGraph())
+		{
+			if(j!=v)
+				f_Node_Repulsive(&v,&j,AG);
+		}
+	}
+
+	//calculate total node-node attractive force
+	adjEntry adj;
+	forall_adj(adj,v)
+	{
+		node ad=adj->twinNode();
+		f_Node_Attractive(&v,&ad,AG);
+	}
 
-			//calculate total node-node attractive force
-			adjEntry adj;
-			forall_adj(adj,v)
+	//calculate total node-edge repulsive force; only edges within distance limit exert a force
+	proj i;
+	double fx,fy;
+	index.edgesNear(x-limit,y-limit,x+limit,y+limit,buffer);
+	for(int k=0;k<buffer.size();k++)
+	{
+		edge e=index.edgeOf(buffer[k]);
+		if(e->target()!=v&&e->source()!=v&&((!impred)||surr(v->index(),e->index())==1))
+		{
+			compute_I(&v,&e,i,AG);			//computes the projection
+			if(i_On_Edge(&e,i,AG))		//computes if projection is on the edge
 			{
-				node ad=adj->twinNode();
-				f_Node_Attractive(&v,&ad,AG);
+				f_Edge(&v,&e,i,fx,fy,AG);
+				F_x[v]+=fx;
+				F_y[v]+=fy;
 			}
-			//calculate total node-edge repulsive force
-			edge e;
-			forall_edges(e,G)
+		}
+	}
+
+	//the edges incident to v get the opposite of the forces they exert on nearby nodes
+	forall_adj(adj,v)
+	{
+		edge e=adj->theEdge();
+		node a=e->source();
+		node b=e->target();
+		index.nodesNear(min(AG.x(a),AG.x(b))-limit,min(AG.y(a),AG.y(b))-limit,max(AG.x(a),AG.x(b))+limit,max(AG.y(a),AG.y(b))+limit,buffer);
+		for(int k=0;k<buffer.size();k++)
+		{
+			node w=index.nodeOf(buffer[k]);
+			if(w!=a&&w!=b&&((!impred)||surr(w->index(),e->index())==1))
 			{
-				if(e->target()!=v&&e->source()!=v)
+				compute_I(&w,&e,i,AG);
+				if(i_On_Edge(&e,i,AG))
 				{
+					f_Edge(&w,&e,i,fx,fy,AG);
+					F_x[v]-=fx;
+					F_y[v]-=fy;
+				}
+			}
+		}
+	}
+}
 
-					compute_I(&v,&e,AG);			//computes the projection
 
-					if(i_On_Edge(&e,AG))		//computes if projection is on the edge
-					{
-						if((!impred)||surr(v->index(),e->index())==1)
-						{
-							 f_Edge(&v,&e,AG);
-						}
-						r_Calc_On_Edge(&v,&e,AG);					// updates values of section radii
-					}
-					else
-					{
-						r_Calc_Outside_Edge(&v,&e,AG);				// updates values of section radii
-					}
+void BertaultLayout::computeZones(node v, GraphAttributes &AG, const SpatialIndex &index, ArrayBuffer<int> &buffer)
+{
+	sect[v].initialize();
+
+	// Each zone radius is a third of the distance to some node or edge, and only the radius
+	// of the section in which v moves matters if it is smaller than the move. Hence, we
+	// consider the edges and nodes within distance r of v (and its edges) for growing r until
+	// this radius is at most r/3 or r is three times the length of the move.
+	double mov_mag=sqrt(F_x[v]*F_x[v]+F_y[v]*F_y[v]);
+	if(!(mov_mag>0))
+		return;
+	int s=section(F_x[v],F_y[v]);
 
-				}
+	const double x=AG.x(v);
+	const double y=AG.y(v);
+	proj i;
+
+	for(double r=min(3*mov_mag,index.cellSize()); ; r=min(2*r,3*mov_mag))
+	{
+		//zones due to the edges near v
+		index.edgesNear(x-r,y-r,x+r,y+r,buffer);
+		for(int k=0;k<buffer.size();k++)
+		{
+			edge e=index.edgeOf(buffer[k]);
+			if(e->target()!=v&&e->source()!=v)
+			{
+				compute_I(&v,&e,i,AG);
+				if(i_On_Edge(&e,i,AG))
+					r_Calc_On_Edge(&v,&e,i,AG);					// updates values of section radii
+				else
+					r_Calc_Outside_Edge(&v,&e,AG);				// updates values of section radii
 			}
 		}
 
-		forall_nodes(v,G)
+		//zones due to the nodes near the edges incident to v
+		adjEntry adj;
+		forall_adj(adj,v)
 		{
-			/*   cout << "F_x : ";
-			cout << F_x[v];
-
-			cout << "   F_y : ";
-			cout << F_y[v];
-			cout << "\n";
-			*/
-			//moves the nodes according to forces
-			move(&v,AG);
-			/*
-			cout << "move_x : ";
-			cout << F_x[v];
-
-			cout << "   move_y : ";
-			cout << F_y[v];
-			cout << "\n";
-
-			int i;
-			for(i=1;i<9;i++)
+			edge e=adj->theEdge();
+			node a=e->source();
+			node b=e->target();
+			index.nodesNear(min(AG.x(a),AG.x(b))-r,min(AG.y(a),AG.y(b))-r,max(AG.x(a),AG.x(b))+r,max(AG.y(a),AG.y(b))+r,buffer);
+			for(int k=0;k<buffer.size();k++)
 			{
-				cout << sect[v].R[i];
-				cout << " ";
+				node w=index.nodeOf(buffer[k]);
+				if(w!=a&&w!=b)
+				{
+					compute_I(&w,&e,i,AG);
+					r_Calc_Endpoint(&v,&w,i,i_On_Edge(&e,i,AG),AG);
+				}
 			}
-			cout << "\n\n";*/
 		}
-	}
 
+		if(sect[v].R[s]<=r/3||!(r<3*mov_mag))
+			break;
+	}
 }
 
 
@@ -212,7 +457,7 @@ void BertaultLayout::f_Node_Attractive(node *v,node *j, GraphAttributes &AG)
 	(F_y)[*v]+=(-(dist/req_length)*(AG.y(*v)-AG.y(*j)));
 }
 
-void BertaultLayout::compute_I(node *v,edge *e, GraphAttributes &AG)
+void BertaultLayout::compute_I(node *v,edge *e, proj &i, GraphAttributes &AG)
 {
 	node a=(*e)->source();
 	node b=(*e)->target();
@@ -224,40 +469,28 @@ void BertaultLayout::compute_I(node *v,edge *e, GraphAttributes &AG)
 	i.y=m*i.x+c;											//solve for y
 }
 
-bool BertaultLayout::i_On_Edge(edge *e, GraphAttributes &AG)
+bool BertaultLayout::i_On_Edge(edge *e, const proj &i, GraphAttributes &AG)
 {
 	node a=(*e)->source();
 	node b=(*e)->target();
 	return ((i.x<=AG.x(a)&&i.x>=AG.x(b))||(i.x>=AG.x(a)&&i.x<=AG.x(b)))&&((i.y<=AG.y(a)&&i.y>=AG.y(b))||(i.y>=AG.y(a)&&i.y<=AG.y(b)));				// x and y coordinates of i must be in between that of a and b
 }
 
-void BertaultLayout::f_Edge(node *v,edge *e, GraphAttributes &AG)
+void BertaultLayout::f_Edge(node *v,edge * /* e */, const proj &i, double &fx, double &fy, GraphAttributes &AG)
 {
+	fx=0;
+	fy=0;
 	double dist=sqrt((AG.x(*v)-i.x)*(AG.x(*v)-i.x)+(AG.y(*v)-i.y)*(AG.y(*v)-i.y));
 	if(dist<=limit&&dist>0)
 	{
-		double fx=(limit-dist)*(limit-dist)*(AG.x(*v)-i.x)/dist;
-		double fy=(limit-dist)*(limit-dist)*(AG.y(*v)-i.y)/dist;
-		(F_x)[*v]+=fx;
-		(F_y)[*v]+=fy;
-		node a=(*e)->source();
-		node b=(*e)->target();
-		(F_x)[a]-=fx;
-		(F_y)[a]-=fy;
-		(F_x)[b]-=fx;
-		(F_y)[b]-=fy;
+		fx=(limit-dist)*(limit-dist)*(AG.x(*v)-i.x)/dist;
+		fy=(limit-dist)*(limit-dist)*(AG.y(*v)-i.y)/dist;
 	}
 }
 
-void BertaultLayout::r_Calc_On_Edge(node *v, edge *e, GraphAttributes &AG)
+int BertaultLayout::section(double x_diff, double y_diff)
 {
-	node a=(*e)->source();
-	node b=(*e)->target();
 	int s=0;
-	double x_diff=i.x-AG.x(*v);
-	double y_diff=i.y-AG.y(*v);
-
-	//determines the section in which the line-segment (v,i) lies
 	if(x_diff>=0)
 	{
 		if(y_diff>=0)
@@ -292,39 +525,29 @@ void BertaultLayout::r_Calc_On_Edge(node *v, edge *e, GraphAttributes &AG)
 				s=6;
 		}
 	}
+	return s;
+}
+
+void BertaultLayout::r_Calc_On_Edge(node *v, edge * /* e */, const proj &i, GraphAttributes &AG)
+{
+	double x_diff=i.x-AG.x(*v);
+	double y_diff=i.y-AG.y(*v);
+
+	//determines the section in which the line-segment (v,i) lies
+	int s=section(x_diff,y_diff);
 
 	OGDF_ASSERT(s!=0);			//section>=1
 	double max_radius=(sqrt(x_diff*x_diff+y_diff*y_diff))/3;
 
-	//cout << "node:" << (*v)->index() << "edge:" << (*e)->index() << "between" << a->index() << "and" << b->index() << "INSIDE\nsection:" << s << "x_a:" << AG.x(a) << "x_b:" << AG.x(b) << "y_a:" << AG.y(a) << "y_b:" << AG.y(b) << "i_x:" << i.x << "i_y:" << i.y << "dist_v-i:" << max_radius*3 << "\n\n" ;
-
-  //  if(max_radius>=0)
-	//{
-		int r,num;
-		//determines which sections should have their values changed
+	int r,num;
+	//determines which sections should have their values changed
 	for(r=s-2;r<=(s+2);r++)
 	{
-			num=1+((r-1)%8);
-			if(num<=0)
-				num+=8;
-			(sect)[*v].R[num]=min((sect)[*v].R[num],max_radius);
-		}
-		for(r=s+2;r<=(s+6);r++)
-	{
-			 num=1+((r-1)%8);
-			 if(num<=0)
-				 num+=8;
-			(sect)[a].R[num]=min((sect)[a].R[num],max_radius);
-			(sect)[b].R[num]=min((sect)[b].R[num],max_radius);
-		}
-	//}
-	/*int i;
-	for(i=1;i<9;i++)
-	{
-		cout << sect[*v].R[i];
-		cout << " ";
+		num=1+((r-1)%8);
+		if(num<=0)
+			num+=8;
+		(sect)[*v].R[num]=min((sect)[*v].R[num],max_radius);
 	}
-	cout << "\n";*/
 }
 
 
@@ -334,66 +557,47 @@ void BertaultLayout::r_Calc_Outside_Edge(node *v, edge *e, GraphAttributes &AG)
 	node b=(*e)->target();
 	double dav=sqrt((AG.x(*v)-AG.x(a))*(AG.x(*v)-AG.x(a))+(AG.y(*v)-AG.y(a))*(AG.y(*v)-AG.y(a)));
 	double dbv=sqrt((AG.x(*v)-AG.x(b))*(AG.x(*v)-AG.x(b))+(AG.y(*v)-AG.y(b))*(AG.y(*v)-AG.y(b)));
-	//cout << "node:" << (*v)->index() << "edge:" << (*e)->index() << "between" << a->index() << "and" << b->index() << "OUTSIDE\ndist_v_a:" << dav << "dist_v_b:" << dbv << "\n\n" ;
 
 	int r;
 	for(r=1;r<=8;r++)
-	{
 		(sect)[*v].R[r]=min((sect)[*v].R[r],min(dav,dbv)/3);
-		(sect)[a].R[r]=min((sect)[a].R[r],dav/3);
-		(sect)[b].R[r]=min((sect)[b].R[r],dbv/3);
-	}
+}
 
-	/*int i;
-	for(i=1;i<9;i++)
+void BertaultLayout::r_Calc_Endpoint(node *a, node *w, const proj &i, bool onEdge, GraphAttributes &AG)
+{
+	int r;
+	if(onEdge)
 	{
-		cout << sect[*v].R[i];
-		cout << " ";
+		double x_diff=i.x-AG.x(*w);
+		double y_diff=i.y-AG.y(*w);
+		int s=section(x_diff,y_diff);
+		OGDF_ASSERT(s!=0);
+		double max_radius=(sqrt(x_diff*x_diff+y_diff*y_diff))/3;
+
+		//the sections of the edge facing w
+		for(r=s+2;r<=(s+6);r++)
+		{
+			int num=1+((r-1)%8);
+			if(num<=0)
+				num+=8;
+			(sect)[*a].R[num]=min((sect)[*a].R[num],max_radius);
+		}
+	}
+	else
+	{
+		double daw=sqrt((AG.x(*w)-AG.x(*a))*(AG.x(*w)-AG.x(*a))+(AG.y(*w)-AG.y(*a))*(AG.y(*w)-AG.y(*a)));
+		for(r=1;r<=8;r++)
+			(sect)[*a].R[r]=min((sect)[*a].R[r],daw/3);
 	}
-	cout << "\n";*/
 }
 
 void BertaultLayout::move(node *v, GraphAttributes &AG)
 {
-	int s=0;
 	double x_diff=(F_x)[*v];
 	double y_diff=(F_y)[*v];
 
 	//determines the section in which the node has to move
-	if(x_diff>=0)
-	{
-		if(y_diff>=0)
-		{
-			if(x_diff>=y_diff)
-				s=1;
-			else
-				s=2;
-		}
-		else
-		{
-			if(x_diff>=-(y_diff))
-				s=8;
-			else
-				s=7;
-		}
-	}
-	else
-	{
-		if(y_diff>=0)
-		{
-			if(-(x_diff)>=y_diff)
-				s=4;
-			else
-				s=3;
-		}
-		else
-		{
-			if(-(x_diff)>=-(y_diff))
-				s=5;
-			else
-				s=6;
-		}
-	}
+	int s=section(x_diff,y_diff);
 
 	OGDF_ASSERT(s!=0);
 
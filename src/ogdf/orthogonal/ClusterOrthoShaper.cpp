@@ -44,7 +44,6 @@
 
 #include <ogdf/cluster/ClusterOrthoShaper.h>
 #include <ogdf/basic/FaceArray.h>
-#include <ogdf/graphalg/MinCostFlowReinelt.h>
 
 
 const int flowBound = 4;	//No more than 4 bends in cage boundary,
@@ -71,7 +70,7 @@ void ClusterOrthoShaper::call(ClusterPlanRep &PG,
 	m_fourPlanar = fourPlanar;
 
 	// the min cost flow we use
-	MinCostFlowReinelt flowModule;
+	MinCostFlowModule &flowModule = m_minCostFlow.get();
 	const int infinity = flowModule.infinity();
 
 	//************************************************************
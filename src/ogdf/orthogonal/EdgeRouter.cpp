@@ -471,6 +471,10 @@ void EdgeRouter::call(
 	//       }//debug stop
 	//}//forall_nodes
 
+	//place() introduces the bends by splitting the edges directly, so
+	//the orthogonal representation stays normalized after this
+	H.normalize();
+
 	forall_nodes(v, pru)
 	{
 		if ( (pru.expandAdj(v) != 0) && (pru.typeOf(v) != Graph::generalizationMerger) )
@@ -2327,7 +2331,7 @@ void EdgeRouter::compute_place(node v, NodeInfo& inf/*, int l_sep, int l_overh*/
 void EdgeRouter::place(node l_v)
 {
 	//two steps: first, introduce the bends on the incoming edges,
-	// normalise, then adjust the layout information for the cage nodes and bend nodes
+	// then adjust the layout information for the cage nodes and bend nodes
 	string m;
 	string msg;
 	OrthoRep::VertexInfoUML* vinfo = m_orp->cageInfo(l_v);
@@ -2526,7 +2530,6 @@ void EdgeRouter::place(node l_v)
 					break; //double bend upwards
 				default: break;
 			}//switch
-			m_orp->normalize();
 		}//if not bendfree
 		ipos++;
 		it++;
@@ -2722,7 +2725,6 @@ void EdgeRouter::place(node l_v)
 					break; //double bend upwards
 				default: break;
 			}//switch
-			m_orp->normalize();
 		}//if
 		ipos++;
 		it++;
@@ -2911,7 +2913,6 @@ void EdgeRouter::place(node l_v)
 					break; //double bend downwards
 				default: break;
 			}//switch
-			m_orp->normalize();
 		}//if
 		ipos++;
 		it++;
@@ -3101,7 +3102,6 @@ void EdgeRouter::place(node l_v)
 					break; //double bend upwards
 				default: break;
 			}//switch
-			m_orp->normalize();
 		}//if
 
 		ipos++;
@@ -3499,6 +3499,7 @@ void EdgeRouter::initialize_node_info(node v, int sep)
 				}//while
 				od =  OrthoRep::nextDir(od);
 			} while (od != odNorth);
+			infos[v].buildSideIndex();
 
 			infos[v].get_data(*m_orp, *m_layoutp, v, *m_rc, *m_nodewidth, *m_nodeheight);
 		}//if no adj, this should never happen
@@ -47,6 +47,7 @@
 #include <ogdf/orthogonal/CompactionConstraintGraph.h>
 #include <ogdf/graphalg/MinCostFlowReinelt.h>
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/Thread.h>
 //#include <ogdf/planarity/PlanRepUML.h>
 
 
@@ -82,6 +83,70 @@ void writeGridDrawing(const char *name, PlanRep &PG, GridLayoutMapped &drawing)
 
 
 
+//! Builds the constraint graph of one direction including its vertex size arcs.
+class FlowCompaction::Worker : public Thread
+{
+	const OrthoRep &m_OR;
+	const PlanRep &m_PG;
+	OrthoDir m_arcDir;
+	int m_sep;
+	int m_costGen;
+	int m_costAssoc;
+	bool m_align;
+	const NodeArray<int> &m_sizeOrig;
+	const RoutingChannel<int> *m_rc;           // variable cages
+	const MinimumEdgeDistances<int> *m_minDist; // tight cages
+	CompactionConstraintGraph<int> *m_D;
+	bool m_running;                             // started and not yet joined
+
+public:
+	Worker(const FlowCompaction &fc, const OrthoRep &OR, const PlanRep &PG, OrthoDir arcDir,
+		int sep, const NodeArray<int> &sizeOrig, const RoutingChannel<int> &rc)
+		: m_OR(OR), m_PG(PG), m_arcDir(arcDir), m_sep(sep),
+		  m_costGen(fc.m_costGen), m_costAssoc(fc.m_costAssoc), m_align(fc.m_align),
+		  m_sizeOrig(sizeOrig), m_rc(&rc), m_minDist(0), m_D(0), m_running(false) { }
+
+	Worker(const FlowCompaction &fc, const OrthoRep &OR, const PlanRep &PG, OrthoDir arcDir,
+		int sep, const NodeArray<int> &sizeOrig, const MinimumEdgeDistances<int> &minDist)
+		: m_OR(OR), m_PG(PG), m_arcDir(arcDir), m_sep(sep),
+		  m_costGen(fc.m_costGen), m_costAssoc(fc.m_costAssoc), m_align(fc.m_align),
+		  m_sizeOrig(sizeOrig), m_rc(0), m_minDist(&minDist), m_D(0), m_running(false) { }
+
+	// only joins if the thread is still running, e.g., if an exception left end() out
+	~Worker() { if (m_running) join(); delete m_D; }
+
+	void run() {
+		m_D = new CompactionConstraintGraph<int>(m_OR, m_PG, m_arcDir, m_sep,
+			m_costGen, m_costAssoc, m_align);
+		if (m_rc != 0)
+			m_D->insertVertexSizeArcs(m_PG, m_sizeOrig, *m_rc);
+		else
+			m_D->insertVertexSizeArcs(m_PG, m_sizeOrig, *m_minDist);
+	}
+
+	//! Starts building, on a separate thread if \a concurrent is true.
+	void begin(bool concurrent) {
+		if (concurrent) {
+			start();
+			m_running = true;
+		}
+	}
+
+	//! Waits until the constraint graph is built and returns it.
+	CompactionConstraintGraph<int> &end() {
+		if (m_running) {
+			join();
+			m_running = false;
+		} else
+			run();
+		return *m_D;
+	}
+
+protected:
+	virtual void doWork() { run(); }
+};
+
+
 // constructor
 FlowCompaction::FlowCompaction(int maxImprovementSteps,
 	int costGen,
@@ -94,6 +159,12 @@ FlowCompaction::FlowCompaction(int maxImprovementSteps,
 	m_numGenSteps = 3; //number of improvement steps for generalizations only + 1
 	m_scalingSteps = 0;
 	m_align = false;
+	m_minCostFlow.set(new MinCostFlowReinelt);
+#ifdef OGDF_MEMORY_POOL_NTS
+	m_maxThreads = 1;
+#else
+	m_maxThreads = max(1, System::numberOfProcessors());
+#endif
 }
 
 
@@ -106,6 +177,12 @@ void FlowCompaction::constructiveHeuristics(
 {
 	OGDF_ASSERT(OR.isOrientated());
 
+	const bool concurrent = (m_maxThreads > 1);
+
+	// the constraint graph for the y-direction is built meanwhile
+	Worker yWorker(*this, OR, PG, odNorth, rc.separation(), drawing.height(), rc);
+	yWorker.begin(concurrent);
+
 	// x-coordinates of vertical segments
 	CompactionConstraintGraph<int> Dx(OR, PG, odEast, rc.separation(),
 		m_costGen, m_costAssoc, m_align);
@@ -115,9 +192,7 @@ void FlowCompaction::constructiveHeuristics(
 	computeCoords(Dx, xDx);
 
 	// y-coordinates of horizontal segments
-	CompactionConstraintGraph<int> Dy(OR, PG, odNorth, rc.separation(),
-		m_costGen, m_costAssoc, m_align);
-	Dy.insertVertexSizeArcs(PG, drawing.height(), rc);
+	CompactionConstraintGraph<int> &Dy = yWorker.end();
 
 	NodeArray<int> yDy(Dy.getGraph(), 0);
 	computeCoords(Dy, yDy);
@@ -144,6 +219,8 @@ void FlowCompaction::improvementHeuristics(
 	int steps = 0, maxSteps = m_maxImprovementSteps;
 	if (maxSteps == 0) maxSteps = numeric_limits<int>::max();
 
+	const bool concurrent = (m_maxThreads > 1);
+
 	// OPTIMIZATION POTENTIAL:
 	// update constraint graphs "incrementally" by only re-inserting
 	// visibility arcs
@@ -151,6 +228,11 @@ void FlowCompaction::improvementHeuristics(
 		lastCosts = costs;
 		++steps;
 
+		// the constraint graph for the y-direction does not depend on the
+		// x-coordinates, so it is built while the x-direction is compacted
+		Worker yWorker(*this, OR, PG, odNorth, rc.separation(), drawing.height(), rc);
+		yWorker.begin(concurrent);
+
 		// x-coordinates of vertical segments
 		CompactionConstraintGraph<int> Dx(OR, PG, odEast, rc.separation(),
 			m_costGen, m_costAssoc, m_align);
@@ -197,10 +279,7 @@ void FlowCompaction::improvementHeuristics(
 #endif
 
 		// y-coordinates of horizontal segments
-		CompactionConstraintGraph<int> Dy(OR, PG, odNorth, rc.separation(),
-			m_costGen, m_costAssoc, m_align);
-
-		Dy.insertVertexSizeArcs(PG, drawing.height(), rc);
+		CompactionConstraintGraph<int> &Dy = yWorker.end();
 		Dy.insertVisibilityArcs(PG, drawing.y(), drawing.x());
 
 
@@ -258,6 +337,8 @@ void FlowCompaction::improvementHeuristics(
 	int steps = 0, maxSteps = m_maxImprovementSteps;
 	if (maxSteps == 0) maxSteps = numeric_limits<int>::max();
 
+	const bool concurrent = (m_maxThreads > 1);
+
 	// OPTIMIZATION POTENTIAL:
 	// update constraint graphs "incrementally" by only re-inserting
 	// visibility arcs
@@ -265,6 +346,11 @@ void FlowCompaction::improvementHeuristics(
 		lastCosts = costs;
 		++steps;
 
+		// the constraint graph for the y-direction does not depend on the
+		// x-coordinates, so it is built while the x-direction is compacted
+		Worker yWorker(*this, OR, PG, odNorth, originalSeparation, drawing.height(), minDist);
+		yWorker.begin(concurrent);
+
 		// x-coordinates of vertical segments
 		CompactionConstraintGraph<int> Dx(OR, PG, odEast, originalSeparation,
 			//minDist.separation(),
@@ -313,11 +399,7 @@ void FlowCompaction::improvementHeuristics(
 #endif
 
 		// y-coordinates of horizontal segments
-		CompactionConstraintGraph<int> Dy(OR, PG, odNorth, originalSeparation,
-			//minDist.separation(),
-			m_costGen, m_costAssoc, m_align);
-
-		Dy.insertVertexSizeArcs(PG, drawing.height(), minDist);
+		CompactionConstraintGraph<int> &Dy = yWorker.end();
 		Dy.insertVisibilityArcs(PG,drawing.y(),drawing.x(),minDist);
 
 		NodeArray<int> yDy(Dy.getGraph(), 0);
@@ -420,7 +502,7 @@ void FlowCompaction::computeCoords(
 	}
 
 
-	MinCostFlowReinelt mcf;
+	MinCostFlowModule &mcf = m_minCostFlow.get();
 
 	const int infinity = mcf.infinity();
 
@@ -441,6 +523,10 @@ void FlowCompaction::computeCoords(
 		// This has to be changed if we use special constructs for allowing
 		// left or right bends
 		int currentLength = pos[e->target()] - pos[e->source()];
+
+		// in the improvement heuristics, the current lengths form a circulation
+		// in the dual graph which is used as warm start
+		m_flow[eDual] = currentLength;
 		if ((fixZeroLength && currentLength == 0) && (D.typeOf(e) == cetFixToZeroArc))
 			lowerBound[eDual] = upperBound[eDual] = 0;
 		else if (improvementHeuristics && currentLength < lowerBound[eDual])
@@ -513,7 +599,9 @@ void FlowCompaction::computeCoords(
 #ifdef OGDF_DEBUG
 		bool feasible =
 #endif
-			mcf.call(dual,lowerBound,upperBound,cost,supply,m_flow);
+			(improvementHeuristics ?
+				mcf.callWarmStart(dual,lowerBound,upperBound,cost,supply,m_flow) :
+				mcf.call(dual,lowerBound,upperBound,cost,supply,m_flow));
 
 		OGDF_ASSERT(feasible);
 	}
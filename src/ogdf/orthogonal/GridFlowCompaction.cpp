@@ -89,6 +89,7 @@ GridFlowCompaction::GridFlowCompaction(int maxImprovementSteps)
 	m_cageExpense = true;
 	m_scalingSteps = 0;
 	m_sep = 1;
+	m_minCostFlow.set(new MinCostFlowReinelt);
 }
 
 
@@ -386,7 +387,7 @@ void GridFlowCompaction::computeCoords(
 	}
 
 
-	MinCostFlowReinelt mcf;
+	MinCostFlowModule &mcf = m_minCostFlow.get();
 
 	const int infinity = mcf.infinity();
 
@@ -407,6 +408,10 @@ void GridFlowCompaction::computeCoords(
 		// This has to be changed if we use special constructs for allowing
 		// left or right bends
 		int currentLength = pos[e->target()] - pos[e->source()];
+
+		// in the improvement heuristics, the current lengths form a circulation
+		// in the dual graph which is used as warm start
+		m_flow[eDual] = currentLength;
 		if ((fixZeroLength && currentLength == 0) && (D.typeOf(e) == cetFixToZeroArc))
 			lowerBound[eDual] = upperBound[eDual] = 0;
 		else if (improvementHeuristics && currentLength < lowerBound[eDual])
@@ -456,7 +461,9 @@ void GridFlowCompaction::computeCoords(
 #ifdef OGDF_DEBUG
 		bool feasible =
 #endif
-			mcf.call(dual,lowerBound,upperBound,cost,supply,m_flow);
+			(improvementHeuristics ?
+				mcf.callWarmStart(dual,lowerBound,upperBound,cost,supply,m_flow) :
+				mcf.call(dual,lowerBound,upperBound,cost,supply,m_flow));
 
 		OGDF_ASSERT(feasible);
 	}
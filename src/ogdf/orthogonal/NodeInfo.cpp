@@ -102,6 +102,26 @@ void NodeInfo::get_data(
 }
 
 
+void NodeInfo::buildSideIndex()
+{
+	for (int od = 0; od < 4; od++)
+	{
+		OGDF_ASSERT(in_edges[od].size() == point_in[od].size());
+		m_inEdgeAt[od].init(in_edges[od].size());
+		m_pointInAt[od].init(point_in[od].size());
+
+		int pos = 0;
+		ListConstIterator<edge> itE = in_edges[od].begin();
+		ListConstIterator<bool> itB = point_in[od].begin();
+		for (; itE.valid(); ++itE, ++itB, ++pos)
+		{
+			m_inEdgeAt[od][pos] = *itE;
+			m_pointInAt[od][pos] = *itB;
+		}
+	}
+}//buildSideIndex
+
+
 int NodeInfo::free_coord(OrthoDir s_main, OrthoDir s_to)
 {
 	int result = coord(s_main);
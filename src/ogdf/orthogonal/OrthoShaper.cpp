@@ -44,7 +44,6 @@
 
 #include <ogdf/orthogonal/OrthoShaper.h>
 #include <ogdf/basic/FaceArray.h>
-#include <ogdf/graphalg/MinCostFlowReinelt.h>
 
 
 const int flowBound = 4; //cant have more than 4 bends in cage boundary, not > 360 degree
@@ -72,7 +71,7 @@ void OrthoShaper::call(PlanRepUML &PG,
 
 
 	// the min cost flow we use
-	MinCostFlowReinelt flowModule;
+	MinCostFlowModule &flowModule = m_minCostFlow.get();
 	const int infinity = flowModule.infinity();
 
 
@@ -1761,7 +1760,7 @@ void OrthoShaper::call(PlanRep &PG,
 
 
 	// the min cost flow we use
-	MinCostFlowReinelt flowModule;
+	MinCostFlowModule &flowModule = m_minCostFlow.get();
 	const int infinity = flowModule.infinity();
 
 
@@ -43,6 +43,7 @@
 
 #include <ogdf/planarity/BoyerMyrvold.h>
 #include <ogdf/planarity/ExtractKuratowskis.h>
+#include <ogdf/basic/ParallelRange.h>
 
 
 namespace ogdf {
@@ -373,4 +374,68 @@ bool BoyerMyrvold::planarEmbed(
 	return planar;
 }
 
+// performs the runs begin,...,end-1 of extractRandomizedKuratowskis();
+// returns 1 iff g is planar (determined by the first run), 0 otherwise
+class BoyerMyrvold::RandomizedRuns
+{
+	const Graph &m_g;
+	Array<SList<KuratowskiWrapper> > &m_output;
+	int m_embeddingGrade;
+	bool m_bundles, m_limitStructures, m_avoidE2Minors;
+	int m_seed;
+
+public:
+	RandomizedRuns(const Graph &g, Array<SList<KuratowskiWrapper> > &output,
+		int embeddingGrade, bool bundles, bool limitStructures, bool avoidE2Minors, int seed)
+		: m_g(g), m_output(output),
+		  m_embeddingGrade(embeddingGrade), m_bundles(bundles),
+		  m_limitStructures(limitStructures), m_avoidE2Minors(avoidE2Minors),
+		  m_seed(seed) { }
+
+	int operator()(int begin, int end) const {
+#ifdef OGDF_SYSTEM_WINDOWS
+		// the state of rand() is local to each thread there; the first
+		// range is processed by the calling thread
+		if (begin > 0)
+			srand(m_seed + begin);
+#endif
+		bool planar = true;
+		for (int i = begin; i < end; ++i) {
+			GraphCopySimple h(m_g);
+			BoyerMyrvold bm;
+			planar = bm.planarEmbed(h, m_output[i], m_embeddingGrade, m_bundles,
+				m_limitStructures, true, m_avoidE2Minors);
+			if (planar) break; // all runs are planar
+		}
+		return planar ? 1 : 0;
+	}
+};
+
+
+// extracts kuratowski subdivisions in several runs with random dfs-trees, each on
+// its own copy of g; the runs are distributed over up to nThreads threads.
+bool BoyerMyrvold::extractRandomizedKuratowskis(
+	const Graph& g,
+	Array<SList<KuratowskiWrapper> >& output,
+	int runs,
+	int embeddingGrade,
+	bool bundles,
+	bool limitStructures,
+	bool avoidE2Minors,
+	int nThreads)
+{
+	OGDF_ASSERT(embeddingGrade != BoyerMyrvoldPlanar::doNotEmbed);
+
+	output.init(max(runs, 0));
+#ifdef OGDF_MEMORY_POOL_NTS
+	nThreads = 1;
+#endif
+	if (runs <= 0)
+		return true;
+
+	RandomizedRuns randomizedRuns(g, output, embeddingGrade, bundles, limitStructures, avoidE2Minors,
+		nThreads > 1 ? rand() : 0);
+	return parallelRange(runs, nThreads, 1, randomizedRuns) > 0;
+}
+
 }
@@ -75,6 +75,8 @@ namespace ogdf {
 		if (origEdges.size() == 0)
 			return Module::retOptimal;  // nothing to do
 
+		const int nG = m_pr.numberOfNodes();
+
 		// initialization
 		CombinatorialEmbedding E(m_pr);  // embedding of PG
 
@@ -126,6 +128,12 @@ namespace ogdf {
 
 			insertEdge(E, eOrig, crossed);
 
+			// abort if we cannot beat the crossing bound anymore
+			if(exceedsCrossingBound(m_pCrossingBound, rrPost, m_pCost, m_pSubgraph, m_pr.numberOfNodes() - nG)) {
+				cleanup();
+				return Module::retNoFeasibleSolution;
+			}
+
 			if(doIncrementalPostprocessing) {
 				currentOrigEdges.pushBack(eOrig);
 
@@ -97,6 +97,7 @@ namespace ogdf {
 	{
 		FixEdgeInserterCore core(pr, pCostOrig, pForbiddenOrig, pEdgeSubgraphs);
 		core.timeLimit(timeLimit());
+		core.crossingBound(crossingBound());
 
 		ReturnType retVal = core.call(origEdges, m_keepEmbedding, m_rrOption, m_percentMostCrossed);
 		m_runsPostprocessing = core.runsPostprocessing();
@@ -0,0 +1,355 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class IncrementalPlanarityTest.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/planarity/IncrementalPlanarityTest.h>
+#include <ogdf/decomposition/DynamicSPQRForest.h>
+#include <ogdf/basic/CombinatorialEmbedding.h>
+#include <ogdf/basic/FaceArray.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/extended_graph_alg.h>
+
+
+namespace ogdf {
+
+
+//! The embedded skeleton of an R-node.
+struct IncrementalPlanarityTest::RSkeleton
+{
+	Graph                       m_skel; //!< The skeleton graph.
+	ConstCombinatorialEmbedding m_E;    //!< The embedding of the skeleton (unique up to mirroring).
+	FaceArray<int>              m_mark; //!< The stamp of the last query that marked a face.
+};
+
+
+IncrementalPlanarityTest::IncrementalPlanarityTest(Graph &G) : m_G(G), m_pForest(0), m_stamp(0)
+{
+	OGDF_ASSERT(isConnected(G));
+
+	if(G.numberOfEdges() > 0) {
+		m_pForest = new DynamicSPQRForest(G);
+		initForest();
+	}
+}
+
+
+IncrementalPlanarityTest::~IncrementalPlanarityTest()
+{
+	clearSkeletons();
+
+	// detach the arrays before the graphs of the forest are destroyed
+	m_skelNode .init();
+	m_skelEdge .init();
+	m_rSkeleton.init();
+
+	delete m_pForest;
+}
+
+
+void IncrementalPlanarityTest::initForest()
+{
+	m_skelNode .init(m_pForest->auxiliaryGraph(), 0);
+	m_skelEdge .init(m_pForest->auxiliaryGraph(), 0);
+	m_rSkeleton.init(m_pForest->spqrTree(), 0);
+}
+
+
+void IncrementalPlanarityTest::clearSkeletons()
+{
+	if(m_pForest == 0)
+		return;
+
+	node vT;
+	forall_nodes(vT, m_pForest->spqrTree()) {
+		delete m_rSkeleton[vT];
+		m_rSkeleton[vT] = 0;
+	}
+}
+
+
+bool IncrementalPlanarityTest::canInsertEdge(node u, node v)
+{
+	// self-loops and edges in a tree (a graph with a single node) never destroy planarity
+	if(u == v || m_pForest == 0)
+		return true;
+
+	DynamicSPQRForest &F = *m_pForest;
+
+	// check each block on the path from u to v in the BC-tree;
+	// blocks with at most 3 nodes cannot cause crossings
+	bool planar = true;
+	SList<node> &path = F.findPath(u,v);
+	SListIterator<node> it = path.begin();
+	node repS = F.repVertex(u,*it);
+	for(SListIterator<node> jt = it; planar && it.valid(); ++it) {
+		node repT = (++jt).valid() ? F.cutVertex(*jt,*it) : F.repVertex(v,*it);
+
+		if(F.numberOfNodes(*it) > 3)
+			planar = blockInsertable(repS,repT);
+
+		if(jt.valid()) repS = F.cutVertex(*it,*jt);
+	}
+	delete &path;
+
+	return planar;
+}
+
+
+edge IncrementalPlanarityTest::insertEdge(node u, node v)
+{
+	if(canInsertEdge(u,v) == false)
+		return 0;
+
+	edge e = m_G.newEdge(u,v);
+	updateInsertedEdge(e);
+	return e;
+}
+
+
+void IncrementalPlanarityTest::updateInsertedEdge(edge e)
+{
+	if(e->isSelfLoop())
+		return;
+
+	if(m_pForest == 0) {
+		m_pForest = new DynamicSPQRForest(m_G);
+		initForest();
+	} else {
+		invalidatePath(e->source(), e->target());
+		m_pForest->updateInsertedEdge(e);
+	}
+}
+
+
+void IncrementalPlanarityTest::invalidatePath(node u, node v)
+{
+	DynamicSPQRForest &F = *m_pForest;
+
+	// inserting (u,v) merges the blocks on the path from u to v in the BC-tree;
+	// in each of them, only the nodes on the path in the SPQR-tree between the
+	// representatives of u and v are changed (blocks with at most 3 nodes have no R-nodes)
+	SList<node> &path = F.findPath(u,v);
+	SListIterator<node> it = path.begin();
+	node repS = F.repVertex(u,*it);
+	for(SListIterator<node> jt = it; it.valid(); ++it) {
+		node repT = (++jt).valid() ? F.cutVertex(*jt,*it) : F.repVertex(v,*it);
+
+		if(F.numberOfNodes(*it) > 3) {
+			SList<node> &pathSPQR = F.findPathSPQR(repS,repT);
+			for(SListConstIterator<node> kt = pathSPQR.begin(); kt.valid(); ++kt) {
+				delete m_rSkeleton[*kt];
+				m_rSkeleton[*kt] = 0;
+			}
+			delete &pathSPQR;
+		}
+
+		if(jt.valid()) repS = F.cutVertex(*it,*jt);
+	}
+	delete &path;
+}
+
+
+bool IncrementalPlanarityTest::containsVertex(node vT, node xH) const
+{
+	// every skeleton containing xH contains an edge incident to xH
+	adjEntry adj;
+	forall_adj(adj,xH)
+		if(m_pForest->spqrproper(adj->theEdge()) == vT)
+			return true;
+	return false;
+}
+
+
+bool IncrementalPlanarityTest::blockInsertable(node sH, node tH)
+{
+	DynamicSPQRForest &F = *m_pForest;
+
+	// only R-nodes on the path in the SPQR-tree from an allocation node
+	// of sH to an allocation node of tH can cause crossings
+	SList<node> &pathList = F.findPathSPQR(sH,tH);
+	Array<node> path(pathList.size());
+	int k = 0;
+	for(SListConstIterator<node> it = pathList.begin(); it.valid(); ++it)
+		path[k++] = *it;
+	delete &pathList;
+
+	if(k == 0)
+		return true;
+
+	// The returned path need not be minimal. Since the nodes containing sH (tH)
+	// form a subtree, they form a prefix (suffix) of the path; the minimal
+	// path starts at the last node of the prefix and ends at the first node
+	// of the suffix.
+	int first = 0;
+	while(first+1 < k && containsVertex(path[first+1],sH))
+		++first;
+	int last = k-1;
+	while(last > 0 && containsVertex(path[last-1],tH))
+		--last;
+
+	// two nodes containing both sH and tH are joined by a virtual edge (sH,tH)
+	if(last < first)
+		return true;
+
+	if(last == first)
+		return F.typeOfTNode(path[first]) != DynamicSPQRForest::RComp
+			|| shareFace(path[first], 0, 0, sH, tH);
+
+	bool insertable = true;
+	for(int i = first; insertable && i <= last; ++i)
+	{
+		node vT = path[i];
+		if(F.typeOfTNode(vT) == DynamicSPQRForest::RComp)
+			insertable = shareFace(vT,
+				(i > first) ? F.virtualEdge(path[i-1],vT) : 0,
+				(i < last)  ? F.virtualEdge(path[i+1],vT) : 0,
+				sH, tH);
+	}
+
+	return insertable;
+}
+
+
+IncrementalPlanarityTest::RSkeleton &IncrementalPlanarityTest::skeleton(node vT)
+{
+	RSkeleton *&pS = m_rSkeleton[vT];
+	if(pS != 0)
+		return *pS;
+
+	// build and embed the skeleton of vT
+	pS = new RSkeleton;
+	Graph &skel = pS->m_skel;
+	List<node> nodesH;
+
+	ListConstIterator<edge> it;
+	for(it = m_pForest->hEdgesSPQR(vT).begin(); it.valid(); ++it)
+	{
+		edge eH = *it;
+		node &rSrc = m_skelNode[eH->source()];
+		node &rTgt = m_skelNode[eH->target()];
+
+		if(rSrc == 0) {
+			rSrc = skel.newNode();
+			nodesH.pushBack(eH->source());
+		}
+		if(rTgt == 0) {
+			rTgt = skel.newNode();
+			nodesH.pushBack(eH->target());
+		}
+
+		m_skelEdge[eH] = skel.newEdge(rSrc,rTgt);
+	}
+
+	while(!nodesH.empty())
+		m_skelNode[nodesH.popFrontRet()] = 0;
+
+	planarEmbed(skel);
+	pS->m_E.init(skel);
+	pS->m_mark.init(pS->m_E, -1);
+
+	return *pS;
+}
+
+
+node IncrementalPlanarityTest::skeletonNode(node vT, node xH) const
+{
+	// every skeleton containing xH contains an edge incident to xH
+	adjEntry adj;
+	forall_adj(adj,xH) {
+		edge eH = adj->theEdge();
+		if(m_pForest->spqrproper(eH) == vT) {
+			edge e = m_skelEdge[eH];
+			return (eH->source() == xH) ? e->source() : e->target();
+		}
+	}
+	return 0;
+}
+
+
+bool IncrementalPlanarityTest::shareFace(node vT, edge eS, edge eT, node sH, node tH)
+{
+	RSkeleton &S = skeleton(vT);
+	const ConstCombinatorialEmbedding &E = S.m_E;
+	FaceArray<int> &mark = S.m_mark;
+	const int stamp = ++m_stamp;
+
+	// Incremental updates may add edges to an R-node that are parallel to
+	// an existing (virtual) edge, so the representative of a virtual edge
+	// is the bundle of all skeleton edges parallel to it.
+
+	// mark faces incident to the representative of s
+	adjEntry adj;
+	if(eS != 0) {
+		edge e = m_skelEdge[eS];
+		node x = e->source(), y = e->target();
+		forall_adj(adj,x) {
+			if(adj->twinNode() == y)
+				mark[E.leftFace(adj)] = mark[E.rightFace(adj)] = stamp;
+		}
+	} else {
+		node nS = skeletonNode(vT,sH);
+		OGDF_ASSERT(nS != 0);
+		forall_adj(adj,nS)
+			mark[E.rightFace(adj)] = stamp;
+	}
+
+	// check faces incident to the representative of t
+	if(eT != 0) {
+		edge e = m_skelEdge[eT];
+		node x = e->source(), y = e->target();
+		forall_adj(adj,x) {
+			if(adj->twinNode() == y
+				&& (mark[E.leftFace(adj)] == stamp || mark[E.rightFace(adj)] == stamp))
+				return true;
+		}
+		return false;
+	}
+
+	node nT = skeletonNode(vT,tH);
+	OGDF_ASSERT(nT != 0);
+	forall_adj(adj,nT)
+		if(mark[E.rightFace(adj)] == stamp)
+			return true;
+
+	return false;
+}
+
+
+} // end namespace ogdf
@@ -42,7 +42,7 @@
 
 
 #include <ogdf/planarity/MaximalPlanarSubgraphSimple.h>
-#include <ogdf/basic/extended_graph_alg.h>
+#include <ogdf/planarity/IncrementalPlanarityTest.h>
 
 
 namespace ogdf {
@@ -85,6 +85,9 @@ Module::ReturnType MaximalPlanarSubgraphSimple::doCall(
 {
 	delEdges.clear();
 
+	if(G.numberOfNodes() == 0)
+		return retFeasible;
+
 	Graph H;
 	NodeArray<node> mapToH(G);
 
@@ -92,38 +95,92 @@ Module::ReturnType MaximalPlanarSubgraphSimple::doCall(
 	forall_nodes(v,G)
 		mapToH[v] = H.newNode();
 
+	// Insert a spanning forest of G first (prefered edges first); these edges
+	// are bridges in every subgraph considered below and thus never destroy planarity.
+	// The trees are connected by additional edges, which do not change the
+	// blocks containing edges of G.
+	NodeArray<node> parent(G);
+	forall_nodes(v,G)
+		parent[v] = v;
+
 	EdgeArray<bool> visited(G,false);
 
 	ListConstIterator<edge> it;
+	for(it = preferedEdges.begin(); it.valid(); ++it)
+		insertForestEdge(*it, parent, mapToH, visited, H);
+
+	edge eG;
+	forall_edges(eG,G)
+		insertForestEdge(eG, parent, mapToH, visited, H);
+
+	node vRoot = 0;
+	forall_nodes(v,G) {
+		if(findRoot(parent, v) == v) {
+			if(vRoot != 0)
+				H.newEdge(mapToH[vRoot], mapToH[v]);
+			vRoot = v;
+		}
+	}
+
+	// the remaining edges are tested incrementally
+	IncrementalPlanarityTest planarityTest(H);
+
 	for(it = preferedEdges.begin(); it.valid(); ++it)
 	{
-		edge eG = *it;
+		eG = *it;
+		if(visited[eG] == true)
+			continue;
 		visited[eG] = true;
 
-		edge eH = H.newEdge(mapToH[eG->source()],mapToH[eG->target()]);
-
-		if (preferedImplyPlanar == false && isPlanar(H) == false) {
-			H.delEdge(eH);
+		node s = mapToH[eG->source()], t = mapToH[eG->target()];
+		if(preferedImplyPlanar)
+			planarityTest.updateInsertedEdge(H.newEdge(s,t));
+		else if(planarityTest.insertEdge(s,t) == 0)
 			delEdges.pushBack(eG);
-		}
 	}
 
-	edge eG;
 	forall_edges(eG,G)
 	{
 		if(visited[eG] == true)
 			continue;
 
-		edge eH = H.newEdge(mapToH[eG->source()],mapToH[eG->target()]);
-
-		if (isPlanar(H) == false) {
-			H.delEdge(eH);
+		if(planarityTest.insertEdge(mapToH[eG->source()], mapToH[eG->target()]) == 0)
 			delEdges.pushBack(eG);
-		}
 	}
 
 	return retFeasible;
 }
 
 
+node MaximalPlanarSubgraphSimple::findRoot(NodeArray<node> &parent, node v)
+{
+	while(parent[v] != v) {
+		parent[v] = parent[parent[v]];
+		v = parent[v];
+	}
+	return v;
+}
+
+
+void MaximalPlanarSubgraphSimple::insertForestEdge(
+	edge eG,
+	NodeArray<node> &parent,
+	const NodeArray<node> &mapToH,
+	EdgeArray<bool> &visited,
+	Graph &H)
+{
+	if(visited[eG] == true)
+		return;
+
+	node r1 = findRoot(parent, eG->source());
+	node r2 = findRoot(parent, eG->target());
+
+	if(r1 != r2) {
+		parent[r1] = r2;
+		visited[eG] = true;
+		H.newEdge(mapToH[eG->source()], mapToH[eG->target()]);
+	}
+}
+
+
 } // end namespace ogdf
@@ -396,34 +396,39 @@ int OptimalCrossingMinimizer::Subproblem::separateBoyerMyrvold(const BoyerMyrvol
 	ArrayBuffer<Constraint*> cuts(p.maxCuts(),false);
 	DeletingTop10Heap<KuratowskiConstraint, double, Compare_Equals<KuratowskiConstraint> > PL(p.maxCuts());
 
-	for(int h = 0; h < p.desperateRuns(); ++h) {
+	// the randomized runs are performed in batches of p.threads() parallel runs
+	for(int h = 0; h < p.desperateRuns(); ) {
+		int batch = min(max(p.threads(), 1), p.desperateRuns() - h);
 		BoyerMyrvold bm;
-		DeletingTop10Heap<KuratowskiConstraint, double, Compare_Equals<KuratowskiConstraint> > PLr(p.runCuts());
-		SList< KuratowskiWrapper > lkw;
-		bm.planarEmbed(R, lkw, p.extractions(),
-			p.bundle(), false, true, //limit & randomDfs
-			p.noE2());
-
-		SList< KuratowskiSubdivision > lks;
-		bm.transform(lkw, lks, R, p.veryDifferent());
-
-		for(SListIterator<KuratowskiSubdivision> it = lks.begin(); it.valid(); ++it) {
-			KuratowskiConstraint* kc = new KuratowskiConstraint(master(), this, R, *it, false); //dynamic!
-			double slack;
-			if(!kc->violated(actVar() , xVal_, &slack ))  {
-				delete kc;
-			} else {
-				++found2;
-				PLr.pushAndDeleteNoRedundancy( kc, slack );
+		Array< SList< KuratowskiWrapper > > lkw;
+		bm.extractRandomizedKuratowskis(R, lkw, batch, p.extractions(),
+			p.bundle(), false, //limit
+			p.noE2(), batch);
+
+		for(int r = 0; r < batch; ++r) {
+			DeletingTop10Heap<KuratowskiConstraint, double, Compare_Equals<KuratowskiConstraint> > PLr(p.runCuts());
+			SList< KuratowskiSubdivision > lks;
+			bm.transform(lkw[r], lks, R, p.veryDifferent());
+
+			for(SListIterator<KuratowskiSubdivision> it = lks.begin(); it.valid(); ++it) {
+				KuratowskiConstraint* kc = new KuratowskiConstraint(master(), this, R, *it, false); //dynamic!
+				double slack;
+				if(!kc->violated(actVar() , xVal_, &slack ))  {
+					delete kc;
+				} else {
+					++found2;
+					PLr.pushAndDeleteNoRedundancy( kc, slack );
+				}
 			}
-		}
 
-		for(int pli = 0; pli<PLr.size(); pli++) {
-			++found1;
-			PL.pushAndDeleteNoRedundancy( PLr[pli].item(), PLr[pli].priority() );
+			for(int pli = 0; pli<PLr.size(); pli++) {
+				++found1;
+				PL.pushAndDeleteNoRedundancy( PLr[pli].item(), PLr[pli].priority() );
+			}
 		}
 
-		if(h >= p.runs() && !PL.empty()) // okidoki
+		h += batch;
+		if(h > p.runs() && !PL.empty()) // okidoki
 			break;
 	}
 
@@ -59,8 +59,8 @@ namespace ogdf
 
 class SubgraphPlanarizer::ThreadMaster {
 
-	CrossingStructure *m_pCS;
-	int                m_bestCR;
+	CrossingStructure  m_bestCS;   //!< The best solution found so far.
+	volatile __int32   m_bestCR;   //!< The best crossing number found so far (shared bound).
 
 	const PlanRep     &m_pr;
 	int                m_cc;
@@ -87,8 +87,6 @@ public:
 		int perms,
 		__int64 stopTime);
 
-	~ThreadMaster() { delete m_pCS; }
-
 	const PlanRep &planRep() const { return m_pr; }
 	int currentCC() const { return m_cc; }
 
@@ -100,10 +98,11 @@ public:
 	int rseed(long id) const { return (int)id * m_seed; }
 
 	int queryBestKnown() const { return m_bestCR; }
-	CrossingStructure *postNewResult(CrossingStructure *pCS);
+	const __int32 volatile *bestKnownBound() const { return &m_bestCR; }
+	bool postNewResult(int cr, PlanRepLight &prl);
 	bool getNextPerm();
 
-	void restore(PlanRep &pr, int &cr);
+	bool restore(PlanRep &pr, int &cr);
 };
 
 
@@ -132,26 +131,29 @@ SubgraphPlanarizer::ThreadMaster::ThreadMaster(
 	int perms,
 	__int64 stopTime)
 	:
-	m_pCS(0), m_bestCR(numeric_limits<int>::max()), m_pr(pr), m_cc(cc),
+	m_bestCR(numeric_limits<__int32>::max()), m_pr(pr), m_cc(cc),
 	m_pCost(pCost), m_pForbid(pForbid), m_pEdgeSubGraph(pEdgeSubGraphs),
 	m_delEdges(delEdges), m_seed(seed), m_perms(perms), m_stopTime(stopTime)
 { }
 
 
-CrossingStructure *SubgraphPlanarizer::ThreadMaster::postNewResult(CrossingStructure *pCS)
+bool SubgraphPlanarizer::ThreadMaster::postNewResult(int cr, PlanRepLight &prl)
 {
-	int newCR = pCS->numberOfCrossings();
+	// we only need to lock if we have a chance to improve
+	if(cr >= m_bestCR)
+		return false;
 
 	m_criticalSection.enter();
 
-	if(newCR < m_bestCR) {
-		std::swap(pCS, m_pCS);
-		m_bestCR = newCR;
+	bool improved = (cr < m_bestCR);
+	if(improved) {
+		m_bestCS.init(prl, cr);
+		atomicExchange(&m_bestCR, cr);
 	}
 
 	m_criticalSection.leave();
 
-	return pCS;
+	return improved;
 }
 
 
@@ -163,26 +165,27 @@ bool SubgraphPlanarizer::ThreadMaster::getNextPerm()
 }
 
 
-void SubgraphPlanarizer::ThreadMaster::restore(PlanRep &pr, int &cr)
+// restores the best solution found by any thread in pr
+bool SubgraphPlanarizer::ThreadMaster::restore(PlanRep &pr, int &cr)
 {
-	m_pCS->restore(pr, m_cc);
-	cr = m_bestCR;
+	if(m_bestCR == numeric_limits<__int32>::max())
+		return false;
+
+	m_bestCS.restore(pr, m_cc);
+	cr = m_bestCS.weightedCrossingNumber();
+	return true;
 }
 
 
-bool SubgraphPlanarizer::doSinglePermutation(
+bool SubgraphPlanarizer::insertEdges(
 	PlanRepLight &prl,
 	int cc,
 	const EdgeArray<int>  *pCost,
 	const EdgeArray<bool> *pForbid,
 	const EdgeArray<__uint32> *pEdgeSubGraphs,
-	Array<edge> &deletedEdges,
+	const Array<edge> &deletedEdges,
 	EdgeInsertionModule &inserter,
-#ifdef OGDF_HAVE_CPP11
-	minstd_rand &rng,
-#endif
-	int &crossingNumber
-	)
+	int &crossingNumber)
 {
 	prl.initCC(cc);
 
@@ -192,21 +195,10 @@ bool SubgraphPlanarizer::doSinglePermutation(
 	for(int j = 0; j <= high; ++j)
 		prl.delEdge(prl.copy(deletedEdges[j]));
 
-	// permute
-#ifdef OGDF_HAVE_CPP11
-	std::uniform_int_distribution<int> dist(0,high);
-
-	for(int j = 0; j <= high; ++j)
-		deletedEdges.swap(j, dist(rng));
-#else
-	for(int j = 0; j <= high; ++j)
-		deletedEdges.swap(j, randomNumber(0,high));
-#endif
-
 	ReturnType ret = inserter.callEx(prl, deletedEdges, pCost, pForbid, pEdgeSubGraphs);
 
 	if(isSolution(ret) == false)
-		return false; // no solution found, that's bad...
+		return false; // no solution found (or crossing bound reached)
 
 	if(pCost == 0)
 		crossingNumber = prl.numberOfNodes() - nG;
@@ -233,6 +225,37 @@ bool SubgraphPlanarizer::doSinglePermutation(
 	return true;
 }
 
+
+bool SubgraphPlanarizer::doSinglePermutation(
+	PlanRepLight &prl,
+	int cc,
+	const EdgeArray<int>  *pCost,
+	const EdgeArray<bool> *pForbid,
+	const EdgeArray<__uint32> *pEdgeSubGraphs,
+	Array<edge> &deletedEdges,
+	EdgeInsertionModule &inserter,
+#ifdef OGDF_HAVE_CPP11
+	minstd_rand &rng,
+#endif
+	int &crossingNumber
+	)
+{
+	const int high = deletedEdges.high();
+
+	// permute
+#ifdef OGDF_HAVE_CPP11
+	std::uniform_int_distribution<int> dist(0,high);
+
+	for(int j = 0; j <= high; ++j)
+		deletedEdges.swap(j, dist(rng));
+#else
+	for(int j = 0; j <= high; ++j)
+		deletedEdges.swap(j, randomNumber(0,high));
+#endif
+
+	return insertEdges(prl, cc, pCost, pForbid, pEdgeSubGraphs, deletedEdges, inserter, crossingNumber);
+}
+
 void SubgraphPlanarizer::doWorkHelper(ThreadMaster &master, EdgeInsertionModule &inserter
 #ifdef OGDF_HAVE_CPP11
 	, minstd_rand &rng
@@ -254,6 +277,11 @@ void SubgraphPlanarizer::doWorkHelper(ThreadMaster &master, EdgeInsertionModule
 	const EdgeArray<bool> *pForbid = master.forbid();
 	const EdgeArray<__uint32> *pEdgeSubGraphs = master.edgeSubGraphs();
 
+	// abort insertion as soon as the best known solution cannot be improved
+	const __int32 volatile *pOldBound = inserter.crossingBound();
+	inserter.crossingBound(master.bestKnownBound());
+
+	int localBest = numeric_limits<int>::max();
 	do {
 		int crossingNumber;
 		if(doSinglePermutation(prl, cc, pCost, pForbid, pEdgeSubGraphs, deletedEdges, inserter,
@@ -261,15 +289,15 @@ void SubgraphPlanarizer::doWorkHelper(ThreadMaster &master, EdgeInsertionModule
 			rng,
 #endif
 			crossingNumber)
-			&& crossingNumber < master.queryBestKnown())
+			&& crossingNumber < localBest)
 		{
-			CrossingStructure *pCS = new CrossingStructure;
-			pCS->init(prl, crossingNumber);
-			pCS = master.postNewResult(pCS);
-			delete pCS;
+			localBest = crossingNumber;
+			master.postNewResult(crossingNumber, prl);
 		}
 
 	} while(master.getNextPerm());
+
+	inserter.crossingBound(pOldBound);
 }
 
 
@@ -428,7 +456,8 @@ Module::ReturnType SubgraphPlanarizer::doCall(
 			delete thread[i];
 		}
 
-		master.restore(pr, crossingNumber);
+		if(master.restore(pr, crossingNumber) == false)
+			return retTimeoutInfeasible; // not able to find a solution...
 
 	} else {
 		//
@@ -443,6 +472,12 @@ Module::ReturnType SubgraphPlanarizer::doCall(
 
 		bool foundSolution = false;
 		CrossingStructure cs;
+
+		// abort insertion as soon as the best known solution cannot be improved
+		__int32 volatile bestCR = numeric_limits<__int32>::max();
+		const __int32 volatile *pOldBound = inserter.crossingBound();
+		inserter.crossingBound(&bestCR);
+
 		for(int i = 1; i <= m_permutations; ++i)
 		{
 			int cr;
@@ -455,15 +490,18 @@ Module::ReturnType SubgraphPlanarizer::doCall(
 			if(ok && (foundSolution == false || cr < cs.weightedCrossingNumber())) {
 				foundSolution = true;
 				cs.init(prl, cr);
+				bestCR = cr;
 			}
 
-			if(stopTime >= 0 && System::realTime() >= stopTime) {
-				if(foundSolution == false)
-					return retTimeoutInfeasible; // not able to find a solution...
+			if(stopTime >= 0 && System::realTime() >= stopTime)
 				break;
-			}
 		}
 
+		inserter.crossingBound(pOldBound);
+
+		if(foundSolution == false)
+			return retTimeoutInfeasible; // not able to find a solution...
+
 		cs.restore(pr,cc); // restore best solution in pr
 		crossingNumber = cs.weightedCrossingNumber();
 
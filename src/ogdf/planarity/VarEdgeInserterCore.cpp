@@ -85,6 +85,8 @@ namespace ogdf {
 		if (origEdges.size() == 0)
 			return Module::retOptimal;  // nothing to do
 
+		const int nG = m_pr.numberOfNodes();
+
 		SListPure<edge> currentOrigEdges;
 		if(rrPost == rrIncremental) {
 			edge e;
@@ -106,6 +108,10 @@ namespace ogdf {
 
 			m_pr.insertEdgePath(eOrig,eip);
 
+			// abort if we cannot beat the crossing bound anymore
+			if(exceedsCrossingBound(m_pCrossingBound, rrPost, m_pCost, m_pSubgraph, m_pr.numberOfNodes() - nG))
+				return Module::retNoFeasibleSolution;
+
 			if(doIncrementalPostprocessing) {
 				currentOrigEdges.pushBack(eOrig);
 
@@ -726,6 +726,8 @@ namespace ogdf {
 		if (origEdges.size() == 0)
 			return Module::retOptimal;  // nothing to do
 
+		const int nG = m_pr.numberOfNodes();
+
 		SListPure<edge> currentOrigEdges;
 
 		if(rrPost == rrIncremental) {
@@ -792,6 +794,12 @@ namespace ogdf {
 				SList<adjEntry> eip;
 				insert(eOrig,eip);
 				m_pBC->insertEdgePath(eOrig,eip);
+
+				// abort if we cannot beat the crossing bound anymore
+				if(exceedsCrossingBound(m_pCrossingBound, rrPost, m_pCost, m_pSubgraph, m_pr.numberOfNodes() - nG)) {
+					delete m_pBC;
+					return Module::retNoFeasibleSolution;
+				}
 			}
 
 			delete m_pBC;
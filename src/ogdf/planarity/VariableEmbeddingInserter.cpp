@@ -94,6 +94,7 @@ namespace ogdf {
 	{
 		VarEdgeInserterCore core(pr, pCostOrig, pForbiddenOrig, pEdgeSubgraph);
 		core.timeLimit(timeLimit());
+		core.crossingBound(crossingBound());
 
 		ReturnType retVal = core.call(origEdges, m_rrOption, m_percentMostCrossed);
 		m_runsPostprocessing = core.runsPostprocessing();
@@ -93,6 +93,7 @@ namespace ogdf {
 	{
 		VarEdgeInserterDynCore core(pr, pCostOrig, pForbiddenOrig, pEdgeSubgraphs);
 		core.timeLimit(timeLimit());
+		core.crossingBound(crossingBound());
 
 		ReturnType retVal = core.call(origEdges, m_rrOption, m_percentMostCrossed);
 		m_runsPostprocessing = core.runsPostprocessing();